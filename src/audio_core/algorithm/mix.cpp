@@ -0,0 +1,177 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <limits>
+
+#include "audio_core/algorithm/mix.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <smmintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+// Signed 32-bit multiplies need SSE4.1. Limiting it to these functions keeps the rest of the
+// binary runnable on hosts without it.
+#if defined(ARCHITECTURE_x86_64) && (defined(__GNUC__) || defined(__clang__))
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#else
+#define SSE41_TARGET
+#endif
+
+namespace AudioCore::Mix {
+namespace {
+/// Number of samples processed per vector step
+constexpr std::size_t LANES = 4;
+
+s32 ScaleQ15(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+s32 SaturatingAdd(s32 lhs, s32 rhs) {
+    return static_cast<s32>(std::clamp<s64>(s64{lhs} + rhs, std::numeric_limits<s32>::min(),
+                                            std::numeric_limits<s32>::max()));
+}
+
+s32 ScaleRamp(s32 sample, float gain, float delta, std::size_t index) {
+    const float ramp = gain + delta * static_cast<float>(static_cast<s32>(index));
+    return static_cast<s32>(static_cast<float>(sample) * ramp);
+}
+
+void MixIntoScalar(s32* output, const s32* input, s32 gain, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        output[i] = SaturatingAdd(output[i], ScaleQ15(input[i], gain));
+    }
+}
+
+s32 MixRampScalar(s32* output, const s32* input, float gain, float delta, std::size_t begin,
+                  std::size_t end) {
+    s32 scaled = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        scaled = ScaleRamp(input[i], gain, delta, i);
+        output[i] = SaturatingAdd(output[i], scaled);
+    }
+    return scaled;
+}
+
+void ApplyGainScalar(s32* output, const s32* input, s32 gain, s32 delta, std::size_t begin,
+                     std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        output[i] = ScaleQ15(input[i], gain + delta * static_cast<s32>(i));
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+bool HasSse41() {
+    static const bool supported = Common::GetCPUCaps().sse4_1;
+    return supported;
+}
+
+/// Multiplies four samples by four Q15 gains, keeping the low 32 bits like ScaleQ15
+SSE41_TARGET __m128i ScaleQ15(__m128i samples, __m128i gains) {
+    const __m128i round = _mm_set1_epi64x(0x4000);
+    const __m128i even = _mm_add_epi64(_mm_mul_epi32(samples, gains), round);
+    const __m128i odd = _mm_add_epi64(
+        _mm_mul_epi32(_mm_srli_epi64(samples, 32), _mm_srli_epi64(gains, 32)), round);
+    // Bits 15 to 46 of the products are the same after a logical or an arithmetic shift
+    return _mm_blend_epi16(_mm_srli_epi64(even, 15), _mm_slli_epi64(_mm_srli_epi64(odd, 15), 32),
+                           0xcc);
+}
+
+SSE41_TARGET __m128i SaturatingAdd(__m128i lhs, __m128i rhs) {
+    const __m128i sum = _mm_add_epi32(lhs, rhs);
+    // The sum overflowed when both operands have the same sign and the sum has the other one
+    const __m128i overflow = _mm_andnot_si128(_mm_xor_si128(lhs, rhs), _mm_xor_si128(lhs, sum));
+    const __m128i saturated =
+        _mm_xor_si128(_mm_srai_epi32(lhs, 31), _mm_set1_epi32(std::numeric_limits<s32>::max()));
+    return _mm_blendv_epi8(sum, saturated, _mm_srai_epi32(overflow, 31));
+}
+
+SSE41_TARGET std::size_t MixIntoSse41(s32* output, const s32* input, s32 gain,
+                                      std::size_t count) {
+    const __m128i gains = _mm_set1_epi32(gain);
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         SaturatingAdd(mixed, ScaleQ15(samples, gains)));
+    }
+    return i;
+}
+
+SSE41_TARGET std::size_t MixRampSse41(s32* output, const s32* input, float gain, float delta,
+                                      std::size_t count, s32& last) {
+    const __m128 gain_base = _mm_set1_ps(gain);
+    const __m128 gain_delta = _mm_set1_ps(delta);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i scaled = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m128 ramp = _mm_add_ps(gain_base, _mm_mul_ps(gain_delta, _mm_cvtepi32_ps(index)));
+        const __m128 samples =
+            _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+        scaled = _mm_cvttps_epi32(_mm_mul_ps(samples, ramp));
+        const __m128i mixed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), SaturatingAdd(mixed, scaled));
+        index = _mm_add_epi32(index, _mm_set1_epi32(static_cast<int>(LANES)));
+    }
+    last = _mm_extract_epi32(scaled, 3);
+    return i;
+}
+
+SSE41_TARGET std::size_t ApplyGainSse41(s32* output, const s32* input, s32 gain, s32 delta,
+                                        std::size_t count) {
+    __m128i gains = _mm_add_epi32(_mm_set1_epi32(gain),
+                                  _mm_mullo_epi32(_mm_set1_epi32(delta), _mm_setr_epi32(0, 1, 2, 3)));
+    const __m128i gains_step = _mm_set1_epi32(delta * static_cast<s32>(LANES));
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), ScaleQ15(samples, gains));
+        gains = _mm_add_epi32(gains, gains_step);
+    }
+    return i;
+}
+#endif
+} // Anonymous namespace
+
+void MixInto(std::span<s32> output, std::span<const s32> input, s32 gain) {
+    const std::size_t count = std::min(output.size(), input.size());
+    std::size_t done = 0;
+#ifdef ARCHITECTURE_x86_64
+    if (HasSse41()) {
+        done = MixIntoSse41(output.data(), input.data(), gain, count);
+    }
+#endif
+    MixIntoScalar(output.data(), input.data(), gain, done, count);
+}
+
+s32 MixRamp(std::span<s32> output, std::span<const s32> input, float gain, float delta) {
+    const std::size_t count = std::min(output.size(), input.size());
+    std::size_t done = 0;
+    s32 last = 0;
+#ifdef ARCHITECTURE_x86_64
+    if (HasSse41()) {
+        done = MixRampSse41(output.data(), input.data(), gain, delta, count, last);
+    }
+#endif
+    if (done == count) {
+        return last;
+    }
+    return MixRampScalar(output.data(), input.data(), gain, delta, done, count);
+}
+
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta) {
+    const std::size_t count = std::min(output.size(), input.size());
+    std::size_t done = 0;
+#ifdef ARCHITECTURE_x86_64
+    if (HasSse41()) {
+        done = ApplyGainSse41(output.data(), input.data(), gain, delta, count);
+    }
+#endif
+    ApplyGainScalar(output.data(), input.data(), gain, delta, done, count);
+}
+
+} // namespace AudioCore::Mix
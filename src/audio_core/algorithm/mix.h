@@ -0,0 +1,34 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+// Mixing kernels of the command generator. Gains in s32 are Q15 fixed point, products are rounded
+// to nearest. Every kernel processes min(output.size(), input.size()) samples, output may alias
+// input. The SSE4.1 paths give the same results as the scalar ones.
+namespace AudioCore::Mix {
+
+/// Adds input scaled by gain to output, the sums saturate to the s32 range
+void MixInto(std::span<s32> output, std::span<const s32> input, s32 gain);
+
+/**
+ * Adds input scaled by a linear ramp of gain + delta * i to output, the sums saturate to the s32
+ * range.
+ * @return The scaled value of the last sample, or 0 when there are no samples
+ */
+s32 MixRamp(std::span<s32> output, std::span<const s32> input, float gain, float delta);
+
+/// Writes input scaled by a linear ramp of gain + delta * i to output
+void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta);
+
+/// Writes input scaled by gain to output
+inline void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain) {
+    ApplyGain(output, input, gain, 0);
+}
+
+} // namespace AudioCore::Mix
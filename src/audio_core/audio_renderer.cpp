@@ -126,7 +126,7 @@ Stream::State AudioRenderer::GetStreamState() const {
     return stream->GetState();
 }
 
-ResultCode AudioRenderer::UpdateAudioRenderer(const std::vector<u8>& input_params,
+ResultCode AudioRenderer::UpdateAudioRenderer(std::span<const u8> input_params,
                                               std::vector<u8>& output_params) {
     std::scoped_lock lock{mutex};
     InfoUpdater info_updater{input_params, output_params, behavior_info};
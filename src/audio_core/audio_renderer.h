@@ -7,6 +7,7 @@
 #include <array>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <vector>
 
 #include "audio_core/behavior_info.h"
@@ -44,7 +45,7 @@ public:
                   Stream::ReleaseCallback&& release_callback, std::size_t instance_number);
     ~AudioRenderer();
 
-    [[nodiscard]] ResultCode UpdateAudioRenderer(const std::vector<u8>& input_params,
+    [[nodiscard]] ResultCode UpdateAudioRenderer(std::span<const u8> input_params,
                                                  std::vector<u8>& output_params);
     [[nodiscard]] ResultCode Start();
     [[nodiscard]] ResultCode Stop();
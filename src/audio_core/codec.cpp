@@ -75,4 +75,46 @@ std::vector<s16> DecodeADPCM(const u8* const data, std::size_t size, const ADPCM
     return ret;
 }
 
+void DecodeADPCMFrames(std::span<const u8> frames, const ADPCM_Coeff& coeff, ADPCMState& state,
+                       std::span<s32> output) {
+    constexpr std::size_t FRAME_LEN = 8;
+    constexpr std::size_t SAMPLES_PER_FRAME = 14;
+
+    const std::size_t frame_count =
+        std::min(frames.size() / FRAME_LEN, output.size() / SAMPLES_PER_FRAME);
+    int yn1 = state.yn1, yn2 = state.yn2;
+
+    for (std::size_t framei = 0; framei < frame_count; framei++) {
+        const u8* const frame = frames.data() + framei * FRAME_LEN;
+        s32* const samples = output.data() + framei * SAMPLES_PER_FRAME;
+        const int scale_shift = frame[0] & 0xF;
+        const int idx = (frame[0] >> 4) & 0x7;
+        const int coef1 = coeff[idx * 2 + 0];
+        const int coef2 = coeff[idx * 2 + 1];
+
+        // The filter feeds back on itself, only the nibble unpacking is independent. Unpack the
+        // whole frame up front so the filter loop is a tight chain of multiply-adds.
+        std::array<int, SAMPLES_PER_FRAME> xn;
+        for (std::size_t i = 0; i < SAMPLES_PER_FRAME; i += 2) {
+            const u8 byte = frame[1 + i / 2];
+            // Sign extend the nibbles, then scale them into 11 bit fixed point with the rounding
+            xn[i] = ((static_cast<int>(static_cast<s8>(byte)) >> 4) * (1 << scale_shift) << 11) +
+                    0x400;
+            xn[i + 1] =
+                ((static_cast<int>(static_cast<s8>(byte << 4)) >> 4) * (1 << scale_shift) << 11) +
+                0x400;
+        }
+        for (std::size_t i = 0; i < SAMPLES_PER_FRAME; i++) {
+            const int val = std::clamp<s32>((xn[i] + coef1 * yn1 + coef2 * yn2) >> 11, -32768,
+                                            32767);
+            yn2 = yn1;
+            yn1 = val;
+            samples[i] = val;
+        }
+    }
+
+    state.yn1 = static_cast<s16>(yn1);
+    state.yn2 = static_cast<s16>(yn2);
+}
+
 } // namespace AudioCore::Codec
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -41,4 +42,14 @@ using ADPCM_Coeff = std::array<s16, 16>;
 std::vector<s16> DecodeADPCM(const u8* data, std::size_t size, const ADPCM_Coeff& coeff,
                              ADPCMState& state);
 
+/**
+ * Decodes whole ADPCM frames in one pass, without allocating
+ * @param frames ADPCM frames to decode, 8 bytes each
+ * @param coeff ADPCM coefficients
+ * @param state ADPCM state, this is updated with new state
+ * @param output Receives the decoded samples, 14 per frame
+ */
+void DecodeADPCMFrames(std::span<const u8> frames, const ADPCM_Coeff& coeff, ADPCMState& state,
+                       std::span<s32> output);
+
 }; // namespace AudioCore::Codec
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <numbers>
 #include "audio_core/algorithm/interpolate.h"
+#include "audio_core/algorithm/mix.h"
 #include "audio_core/command_generator.h"
 #include "audio_core/effect_context.h"
 #include "audio_core/mix_context.h"
@@ -30,42 +31,6 @@ constexpr std::array<f32, AudioCommon::I3DL2REVERB_TAPS> EARLY_GAIN{
     0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.38270f,
     0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
 
-template <std::size_t N>
-void ApplyMix(std::span<s32> output, std::span<const s32> input, s32 gain, s32 sample_count) {
-    for (std::size_t i = 0; i < static_cast<std::size_t>(sample_count); i += N) {
-        for (std::size_t j = 0; j < N; j++) {
-            output[i + j] +=
-                static_cast<s32>((static_cast<s64>(input[i + j]) * gain + 0x4000) >> 15);
-        }
-    }
-}
-
-s32 ApplyMixRamp(std::span<s32> output, std::span<const s32> input, float gain, float delta,
-                 s32 sample_count) {
-    s32 x = 0;
-    for (s32 i = 0; i < sample_count; i++) {
-        x = static_cast<s32>(static_cast<float>(input[i]) * gain);
-        output[i] += x;
-        gain += delta;
-    }
-    return x;
-}
-
-void ApplyGain(std::span<s32> output, std::span<const s32> input, s32 gain, s32 delta,
-               s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-        gain += delta;
-    }
-}
-
-void ApplyGainWithoutDelta(std::span<s32> output, std::span<const s32> input, s32 gain,
-                           s32 sample_count) {
-    for (s32 i = 0; i < sample_count; i++) {
-        output[i] = static_cast<s32>((static_cast<s64>(input[i]) * gain + 0x4000) >> 15);
-    }
-}
-
 s32 ApplyMixDepop(std::span<s32> output, s32 first_sample, s32 delta, s32 sample_count) {
     const bool positive = first_sample > 0;
     auto final_sample = std::abs(first_sample);
@@ -609,7 +574,7 @@ void CommandGenerator::GenerateBiquadFilterEffectCommand(s32 mix_buffer_offset,
         if (params.input[i] != params.output[i]) {
             std::span<const s32> input = GetMixBuffer(mix_buffer_offset + params.input[i]);
             std::span<s32> output = GetMixBuffer(mix_buffer_offset + params.output[i]);
-            ApplyMix<1>(output, input, 32768, worker_params.sample_count);
+            Mix::MixInto(output, input, 32768);
         }
     }
 }
@@ -875,8 +840,7 @@ void CommandGenerator::GenerateVolumeRampCommand(float last_volume, float curren
                   last_volume, current_volume);
     }
     // Apply generic gain on samples
-    ApplyGain(GetChannelMixBuffer(channel), GetChannelMixBuffer(channel), last, delta,
-              worker_params.sample_count);
+    Mix::ApplyGain(GetChannelMixBuffer(channel), GetChannelMixBuffer(channel), last, delta);
 }
 
 void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volumes,
@@ -898,8 +862,8 @@ void CommandGenerator::GenerateVoiceMixCommand(const MixVolumeBuffer& mix_volume
             }
 
             dsp_state.previous_samples[i] =
-                ApplyMixRamp(GetMixBuffer(mix_buffer_offset + i), GetMixBuffer(voice_index),
-                             last_mix_volumes[i], delta, worker_params.sample_count);
+                Mix::MixRamp(GetMixBuffer(mix_buffer_offset + i), GetMixBuffer(voice_index),
+                             last_mix_volumes[i], delta);
         } else {
             dsp_state.previous_samples[i] = 0;
         }
@@ -975,14 +939,7 @@ void CommandGenerator::GenerateMixCommand(std::size_t output_offset, std::size_t
     std::span<const s32> input = GetMixBuffer(input_offset);
 
     const s32 gain = static_cast<s32>(volume * 32768.0f);
-    // Mix with loop unrolling
-    if (worker_params.sample_count % 4 == 0) {
-        ApplyMix<4>(output, input, gain, worker_params.sample_count);
-    } else if (worker_params.sample_count % 2 == 0) {
-        ApplyMix<2>(output, input, gain, worker_params.sample_count);
-    } else {
-        ApplyMix<1>(output, input, gain, worker_params.sample_count);
-    }
+    Mix::MixInto(output, input, gain);
 }
 
 void CommandGenerator::GenerateFinalMixCommand() {
@@ -1006,9 +963,8 @@ void CommandGenerator::GenerateFinalMixCommand() {
                 in_params.node_id, in_params.buffer_offset + i, in_params.buffer_offset + i,
                 in_params.volume);
         }
-        ApplyGainWithoutDelta(GetMixBuffer(in_params.buffer_offset + i),
-                              GetMixBuffer(in_params.buffer_offset + i), gain,
-                              worker_params.sample_count);
+        Mix::ApplyGain(GetMixBuffer(in_params.buffer_offset + i),
+                       GetMixBuffer(in_params.buffer_offset + i), gain);
     }
 }
 
@@ -1034,8 +990,9 @@ s32 CommandGenerator::DecodePcm(ServerVoiceInfo& voice_info, VoiceState& dsp_sta
     const auto samples_processed = std::min(sample_count, samples_remaining);
 
     const auto channel_count = in_params.channel_count;
-    std::vector<T> buffer(samples_processed * channel_count);
-    memory.ReadBlock(buffer_pos, buffer.data(), buffer.size() * sizeof(T));
+    wave_data.resize(samples_processed * channel_count * sizeof(T));
+    memory.ReadBlock(buffer_pos, wave_data.data(), wave_data.size());
+    const T* const buffer = reinterpret_cast<const T*>(wave_data.data());
 
     if constexpr (std::is_floating_point_v<T>) {
         for (std::size_t i = 0; i < static_cast<std::size_t>(samples_processed); i++) {
@@ -1124,16 +1081,40 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
         return yn1;
     };
 
+    // Read up to the end of the frame holding the last sample
     std::size_t buffer_offset{};
-    std::vector<u8> buffer(
-        std::max((samples_processed / FRAME_LEN) * SAMPLES_PER_FRAME, FRAME_LEN));
-    memory.ReadBlock(wave_buffer.buffer_address + (position_in_frame / 2), buffer.data(),
-                     buffer.size());
+    const auto frames_spanned =
+        (samples_remaining_in_frame + std::max(samples_processed, 1) + SAMPLES_PER_FRAME - 1) /
+        SAMPLES_PER_FRAME;
+    wave_data.resize(frames_spanned * FRAME_LEN);
+    const std::span<const u8> buffer = wave_data;
+    memory.ReadBlock(wave_buffer.buffer_address + (position_in_frame / 2), wave_data.data(),
+                     wave_data.size());
     std::size_t cur_mix_offset = mix_offset;
 
     auto remaining_samples = samples_processed;
     while (remaining_samples > 0) {
         if (position_in_frame % NIBBLES_PER_SAMPLE == 0) {
+            // Decode every whole frame in one batch
+            const auto frame_count =
+                static_cast<std::size_t>(remaining_samples) / SAMPLES_PER_FRAME;
+            if (frame_count != 0) {
+                const auto batch_samples = frame_count * SAMPLES_PER_FRAME;
+                Codec::ADPCMState state{yn1, yn2};
+                Codec::DecodeADPCMFrames(buffer.subspan(buffer_offset, frame_count * FRAME_LEN),
+                                         coeffs, state,
+                                         std::span(sample_buffer).subspan(cur_mix_offset,
+                                                                          batch_samples));
+                yn1 = state.yn1;
+                yn2 = state.yn2;
+                buffer_offset += frame_count * FRAME_LEN;
+                frame_header = buffer[buffer_offset - FRAME_LEN];
+                cur_mix_offset += batch_samples;
+                remaining_samples -= static_cast<int>(batch_samples);
+                position_in_frame += frame_count * NIBBLES_PER_SAMPLE;
+                continue;
+            }
+
             // Read header
             frame_header = buffer[buffer_offset++];
             idx = (frame_header >> 4) & 0xf;
@@ -1141,22 +1122,6 @@ s32 CommandGenerator::DecodeAdpcm(ServerVoiceInfo& voice_info, VoiceState& dsp_s
             coef1 = coeffs[idx * 2];
             coef2 = coeffs[idx * 2 + 1];
             position_in_frame += 2;
-
-            // Decode entire frame
-            if (remaining_samples >= static_cast<int>(SAMPLES_PER_FRAME)) {
-                for (std::size_t i = 0; i < SAMPLES_PER_FRAME / 2; i++) {
-                    // Sample 1
-                    const s32 s0 = SIGNED_NIBBLES[buffer[buffer_offset] >> 4];
-                    const s32 s1 = SIGNED_NIBBLES[buffer[buffer_offset++] & 0xf];
-                    const s16 sample_1 = decode_sample(s0);
-                    const s16 sample_2 = decode_sample(s1);
-                    sample_buffer[cur_mix_offset++] = sample_1;
-                    sample_buffer[cur_mix_offset++] = sample_2;
-                }
-                remaining_samples -= static_cast<int>(SAMPLES_PER_FRAME);
-                position_in_frame += SAMPLES_PER_FRAME;
-                continue;
-            }
         }
         // Decode mid frame
         s32 current_nibble = buffer[buffer_offset];
@@ -106,6 +106,7 @@ private:
     std::vector<s32> mix_buffer{};
     std::vector<s32> sample_buffer{};
     std::vector<s32> depop_buffer{};
+    std::vector<u8> wave_data{}; ///< Scratch buffer for the wave data of the decoded voice
     bool dumping_frame{false};
 };
 } // namespace AudioCore
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <vector>
 #include "audio_core/common.h"
 #include "common/common_types.h"
@@ -21,7 +22,7 @@ class SplitterContext;
 class InfoUpdater {
 public:
     // TODO(ogniK): Pass process handle when we support it
-    InfoUpdater(const std::vector<u8>& in_params_, std::vector<u8>& out_params_,
+    InfoUpdater(std::span<const u8> in_params_, std::vector<u8>& out_params_,
                 BehaviorInfo& behavior_info_);
     ~InfoUpdater();
 
@@ -44,7 +45,7 @@ public:
     bool WriteOutputHeader();
 
 private:
-    const std::vector<u8>& in_params;
+    std::span<const u8> in_params;
     std::vector<u8>& out_params;
     BehaviorInfo& behavior_info;
 
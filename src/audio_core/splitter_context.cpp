@@ -171,7 +171,7 @@ void SplitterContext::Initialize(BehaviorInfo& behavior_info, std::size_t _info_
     Setup(_info_count, _data_count, behavior_info.IsSplitterBugFixed());
 }
 
-bool SplitterContext::Update(const std::vector<u8>& input, std::size_t& input_offset,
+bool SplitterContext::Update(std::span<const u8> input, std::size_t& input_offset,
                              std::size_t& bytes_read) {
     const auto UpdateOffsets = [&](std::size_t read) {
         input_offset += read;
@@ -284,7 +284,7 @@ void SplitterContext::Setup(std::size_t info_count_, std::size_t data_count_,
     bug_fixed = is_splitter_bug_fixed;
 }
 
-bool SplitterContext::UpdateInfo(const std::vector<u8>& input, std::size_t& input_offset,
+bool SplitterContext::UpdateInfo(std::span<const u8> input, std::size_t& input_offset,
                                  std::size_t& bytes_read, s32 in_splitter_count) {
     const auto UpdateOffsets = [&](std::size_t read) {
         input_offset += read;
@@ -324,7 +324,7 @@ bool SplitterContext::UpdateInfo(const std::vector<u8>& input, std::size_t& inpu
     return true;
 }
 
-bool SplitterContext::UpdateData(const std::vector<u8>& input, std::size_t& input_offset,
+bool SplitterContext::UpdateData(std::span<const u8> input, std::size_t& input_offset,
                                  std::size_t& bytes_read, s32 in_data_count) {
     const auto UpdateOffsets = [&](std::size_t read) {
         input_offset += read;
@@ -359,7 +359,7 @@ bool SplitterContext::UpdateData(const std::vector<u8>& input, std::size_t& inpu
 
 bool SplitterContext::RecomposeDestination(ServerSplitterInfo& info,
                                            SplitterInfo::InInfoPrams& header,
-                                           const std::vector<u8>& input,
+                                           std::span<const u8> input,
                                            const std::size_t& input_offset) {
     // Clear our current destinations
     auto* current_head = info.GetHead();
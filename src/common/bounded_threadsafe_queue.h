@@ -0,0 +1,254 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+
+namespace detail {
+// TODO: Remove this ifdef whenever clang and GCC support
+//       std::hardware_destructive_interference_size.
+#if defined(_MSC_VER) && _MSC_VER >= 1911
+constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
+#else
+constexpr std::size_t cache_line_size = 128;
+#endif
+} // namespace detail
+
+/**
+ * Bounded, preallocated multiple producer, single consumer queue.
+ *
+ * Producers claim a slot with a single compare-exchange on the enqueue position and publish it
+ * through a per-slot sequence number, so pushing never takes a lock while the queue has room.
+ * Locks are only taken on the slow paths: when the consumer is asleep waiting for work, or when a
+ * producer finds the queue full. Wakeups are batched; producers only signal the consumer when it
+ * has announced that it is about to sleep.
+ *
+ * @tparam T         Element type, must be default constructible and move assignable
+ * @tparam capacity  Number of slots in the queue, must be a power of two
+ */
+template <typename T, std::size_t capacity>
+class BoundedMPSCQueue {
+    static_assert(capacity >= 2, "capacity must be at least two");
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T>);
+    static_assert(std::is_move_assignable_v<T>);
+    static_assert(std::atomic_size_t::is_always_lock_free);
+
+    /// Number of failed polls before a waiting thread goes to sleep
+    static constexpr std::size_t spin_count = 64;
+
+public:
+    BoundedMPSCQueue() {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+    BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+    BoundedMPSCQueue(BoundedMPSCQueue&&) = delete;
+    BoundedMPSCQueue& operator=(BoundedMPSCQueue&&) = delete;
+
+    /**
+     * Tries to push an element without blocking.
+     * @param t       Element to push
+     * @param ticket  If not null, receives the position of the element in the push order
+     * @returns True on success, false when the queue is full
+     */
+    template <typename Arg>
+    bool TryPush(Arg&& t, std::size_t* ticket = nullptr) {
+        std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & mask];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The consumer has not released this slot yet, the queue is full
+                return false;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::forward<Arg>(t);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        if (ticket) {
+            *ticket = pos;
+        }
+        WakeConsumer();
+        return true;
+    }
+
+    /**
+     * Pushes an element, waiting for the consumer to make room when the queue is full.
+     * @note Must not be called from the consumer thread, it could deadlock on a full queue.
+     * @param t           Element to push
+     * @param stop_token  Token used to give up waiting on a full queue
+     * @returns The position of the element in the push order, or nullopt when stop was requested
+     *          before the element could be pushed
+     */
+    template <typename Arg>
+    std::optional<std::size_t> Push(Arg&& t, std::stop_token stop_token = {}) {
+        std::size_t ticket{};
+        for (std::size_t spin = 0; spin < spin_count; ++spin) {
+            if (TryPush(std::forward<Arg>(t), &ticket)) {
+                return ticket;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock lock{producer_mutex};
+        while (true) {
+            producers_waiting.fetch_add(1, std::memory_order_seq_cst);
+            if (TryPush(std::forward<Arg>(t), &ticket)) {
+                producers_waiting.fetch_sub(1, std::memory_order_relaxed);
+                return ticket;
+            }
+            const bool has_room = producer_cv.wait(lock, stop_token, [this] { return !Full(); });
+            producers_waiting.fetch_sub(1, std::memory_order_relaxed);
+            if (!has_room) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    /**
+     * Tries to pop an element without blocking. Must only be called from the consumer thread.
+     * @returns True on success, false when the queue is empty
+     */
+    bool TryPop(T& t) {
+        Slot& slot = slots[dequeue_pos & mask];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_pos + 1) {
+            return false;
+        }
+        t = std::move(slot.value);
+        slot.sequence.store(dequeue_pos + capacity, std::memory_order_release);
+        ++dequeue_pos;
+        WakeProducers();
+        return true;
+    }
+
+    /// Waits until an element is available. Must only be called from the consumer thread.
+    void Wait() {
+        for (std::size_t spin = 0; spin < spin_count; ++spin) {
+            if (!Empty()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock lock{consumer_mutex};
+        consumer_waiting.store(true, std::memory_order_seq_cst);
+        consumer_cv.wait(lock, [this] { return !Empty(); });
+        consumer_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    /// Pops an element, waiting for one to be pushed if the queue is empty.
+    void PopWait(T& t) {
+        while (!TryPop(t)) {
+            Wait();
+        }
+    }
+
+    T PopWait() {
+        T t;
+        PopWait(t);
+        return t;
+    }
+
+    /// @returns True when the consumer has no published element to pop
+    [[nodiscard]] bool Empty() const {
+        const std::size_t pos = dequeue_pos_shadow.load(std::memory_order_relaxed);
+        return slots[pos & mask].sequence.load(std::memory_order_seq_cst) != pos + 1;
+    }
+
+    /// @returns Approximate number of elements in the queue
+    [[nodiscard]] std::size_t Size() const {
+        const std::size_t tail = dequeue_pos_shadow.load(std::memory_order_relaxed);
+        const std::size_t head = enqueue_pos.load(std::memory_order_relaxed);
+        return head >= tail ? head - tail : 0;
+    }
+
+    /// @returns Position in the push order that the next pushed element will get
+    [[nodiscard]] std::size_t NextTicket() const {
+        return enqueue_pos.load(std::memory_order_relaxed);
+    }
+
+    /// @returns Maximum number of elements the queue can hold
+    [[nodiscard]] static constexpr std::size_t Capacity() {
+        return capacity;
+    }
+
+private:
+    static constexpr std::size_t mask = capacity - 1;
+
+    struct alignas(detail::cache_line_size) Slot {
+        std::atomic_size_t sequence{};
+        T value{};
+    };
+
+    [[nodiscard]] bool Full() const {
+        const std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        const std::size_t sequence = slots[pos & mask].sequence.load(std::memory_order_seq_cst);
+        return static_cast<std::ptrdiff_t>(sequence - pos) < 0;
+    }
+
+    void WakeConsumer() {
+        // Pairs with the seq_cst store in Wait, either the consumer sees the published slot or
+        // this thread sees the consumer going to sleep.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!consumer_waiting.load(std::memory_order_relaxed)) {
+            return;
+        }
+        {
+            std::scoped_lock lock{consumer_mutex};
+        }
+        consumer_cv.notify_one();
+    }
+
+    void WakeProducers() {
+        dequeue_pos_shadow.store(dequeue_pos, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producers_waiting.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        {
+            std::scoped_lock lock{producer_mutex};
+        }
+        producer_cv.notify_all();
+    }
+
+    // Producer and consumer indices live on their own cache lines to avoid false sharing.
+    alignas(detail::cache_line_size) std::atomic_size_t enqueue_pos{0};
+    alignas(detail::cache_line_size) std::size_t dequeue_pos{0};
+    std::atomic_size_t dequeue_pos_shadow{0};
+    std::atomic_bool consumer_waiting{false};
+    std::mutex consumer_mutex;
+    std::condition_variable consumer_cv;
+
+    alignas(detail::cache_line_size) std::atomic_size_t producers_waiting{0};
+    std::mutex producer_mutex;
+    std::condition_variable_any producer_cv;
+
+    std::array<Slot, capacity> slots;
+};
+
+} // namespace Common
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <filesystem>
 #include <functional>
 
 #include "common/common_funcs.h"
@@ -53,6 +54,13 @@ enum class FileShareFlag {
     ShareReadWrite, // Provides read and write shared access to the file.
 };
 
+enum class AccessPattern {
+    Normal,     // No particular pattern, the OS defaults apply.
+    Sequential, // The range is about to be read in order, read ahead aggressively.
+    Random,     // The range is about to be read at random offsets, don't read ahead.
+    WillNeed,   // The range is about to be read, start paging it in.
+};
+
 enum class DirEntryFilter {
     File = 1 << 0,
     Directory = 1 << 1,
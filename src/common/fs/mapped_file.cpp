@@ -0,0 +1,179 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include "common/fs/mapped_file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common::FS {
+
+namespace {
+
+#ifdef _WIN32
+
+std::error_code LastError() {
+    return std::error_code{static_cast<int>(GetLastError()), std::system_category()};
+}
+
+#else
+
+std::error_code LastError() {
+    return std::error_code{errno, std::generic_category()};
+}
+
+[[nodiscard]] int ToAdvice(AccessPattern pattern) {
+    switch (pattern) {
+    case AccessPattern::Normal:
+        return MADV_NORMAL;
+    case AccessPattern::Sequential:
+        return MADV_SEQUENTIAL;
+    case AccessPattern::Random:
+        return MADV_RANDOM;
+    case AccessPattern::WillNeed:
+        return MADV_WILLNEED;
+    default:
+        return MADV_NORMAL;
+    }
+}
+
+#endif
+
+} // Anonymous namespace
+
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    return *this;
+}
+
+void MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}, ec_message={}",
+                  PathToUTF8String(path), LastError().message());
+        return;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+    // The view keeps the file and the mapping object alive, their handles can be closed right away
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, ec_message={}",
+                  PathToUTF8String(path), LastError().message());
+        return;
+    }
+    void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == nullptr) {
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, ec_message={}",
+                  PathToUTF8String(path), LastError().message());
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_ERROR(Common_Filesystem, "Failed to open the file at path={}, ec_message={}",
+                  PathToUTF8String(path), LastError().message());
+        return;
+    }
+    struct stat file_stat {};
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        close(fd);
+        return;
+    }
+    const auto file_size = static_cast<size_t>(file_stat.st_size);
+    // The mapping keeps its own reference to the file, the descriptor can be closed right away
+    void* const view = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Common_Filesystem, "Failed to map the file at path={}, ec_message={}",
+                  PathToUTF8String(path), LastError().message());
+        return;
+    }
+    data = static_cast<const u8*>(view);
+    size = file_size;
+#endif
+}
+
+void MappedFile::Close() {
+    if (!IsOpen()) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<u8*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+size_t MappedFile::Read(std::span<u8> out, u64 offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    const size_t length = std::min<size_t>(out.size(), size - static_cast<size_t>(offset));
+    std::memcpy(out.data(), data + offset, length);
+    return length;
+}
+
+void MappedFile::Advise([[maybe_unused]] AccessPattern pattern, [[maybe_unused]] u64 offset,
+                        [[maybe_unused]] u64 length) const {
+#ifdef _WIN32
+    // PrefetchVirtualMemory would cover WillNeed, but it needs a newer Windows than we target
+#else
+    if (offset >= size) {
+        return;
+    }
+    static const auto page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+    const u64 begin = offset & ~(page_size - 1);
+    const u64 end = std::min<u64>(offset + length, size);
+    if (madvise(const_cast<u8*>(data) + begin, static_cast<size_t>(end - begin),
+                ToAdvice(pattern)) != 0) {
+        LOG_WARNING(Common_Filesystem, "madvise failed, ec_message={}", LastError().message());
+    }
+#endif
+}
+
+} // namespace Common::FS
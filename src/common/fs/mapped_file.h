@@ -0,0 +1,125 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "common/common_types.h"
+#include "common/fs/fs_types.h"
+#include "common/fs/fs_util.h"
+
+namespace Common::FS {
+
+/**
+ * A read-only view of a whole file mapped into host memory.
+ * Reads are plain copies out of the mapping and don't move a shared file pointer, so a
+ * MappedFile can be read from several threads at once.
+ *
+ * The file must not be truncated by anyone while it is mapped, accessing the pages past the new
+ * end of the file raises a bus error.
+ */
+class MappedFile final {
+public:
+    MappedFile();
+
+    /**
+     * Maps the file at path for reading.
+     * Empty files cannot be mapped, check IsOpen() to see if the mapping succeeded.
+     *
+     * @param path Filesystem path
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+
+#ifdef _WIN32
+    template <typename Path>
+    explicit MappedFile(const Path& path) {
+        Open(path);
+    }
+#endif
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * Maps the file at path for reading, unmapping the current file first.
+     *
+     * @param path Filesystem path
+     */
+    void Open(const std::filesystem::path& path);
+
+#ifdef _WIN32
+    template <typename Path>
+    void Open(const Path& path) {
+        using ValueType = typename Path::value_type;
+        if constexpr (IsChar<ValueType>) {
+            Open(ToU8String(path));
+        } else {
+            Open(std::filesystem::path{path});
+        }
+    }
+#endif
+
+    /// Unmaps the file if it is mapped. Spans previously returned by GetSpan() become invalid.
+    void Close();
+
+    /**
+     * Checks whether a file is mapped.
+     *
+     * @returns True if a file is mapped, false otherwise.
+     */
+    [[nodiscard]] bool IsOpen() const {
+        return data != nullptr;
+    }
+
+    /**
+     * Gets the contents of the mapped file.
+     *
+     * @returns A span of the whole mapping, empty if no file is mapped.
+     */
+    [[nodiscard]] std::span<const u8> GetSpan() const {
+        return {data, size};
+    }
+
+    /**
+     * Gets the size of the mapped file.
+     *
+     * @returns The size in bytes of the mapped file, 0 if no file is mapped.
+     */
+    [[nodiscard]] u64 GetSize() const {
+        return size;
+    }
+
+    /**
+     * Copies bytes of the mapped file at offset into out.
+     *
+     * @param out Destination span, the read is clamped to the end of the file
+     * @param offset Offset in the file
+     *
+     * @returns Number of bytes copied.
+     */
+    [[nodiscard]] size_t Read(std::span<u8> out, u64 offset) const;
+
+    /**
+     * Hints the OS how a range of the mapping is about to be accessed.
+     * The range is clamped to the mapping. This is a no-op where the OS has no such hints.
+     *
+     * @param pattern Expected access pattern
+     * @param offset Offset of the range in the file
+     * @param length Length of the range
+     */
+    void Advise(AccessPattern pattern, u64 offset, u64 length) const;
+
+private:
+    const u8* data = nullptr;
+    size_t size = 0;
+};
+
+} // namespace Common::FS
@@ -3,12 +3,16 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <climits>
 #include <condition_variable>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -16,6 +20,7 @@
 #include <windows.h> // For OutputDebugStringW
 #endif
 
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
@@ -26,10 +31,120 @@
 #include "common/logging/text_formatter.h"
 #include "common/settings.h"
 #include "common/string_util.h"
-#include "common/threadsafe_queue.h"
 
 namespace Common::Log {
 
+namespace {
+using namespace Common::Literals;
+
+/**
+ * Single producer, single consumer ring of binary log records. Every thread that logs owns one,
+ * so logging a message doesn't take locks or allocate memory, it copies the format string and the
+ * arguments and leaves formatting to the backend thread.
+ */
+class LogRing {
+public:
+    static constexpr std::size_t CAPACITY = 256_KiB;
+
+    struct Record {
+        std::chrono::microseconds timestamp{};
+        const char* filename{};
+        const char* function{};
+        DeferredFormatter formatter{}; ///< nullptr when the arguments are the formatted message
+        u32 size{};                    ///< Size of the record including its format and arguments
+        u32 format_size{};             ///< Size of the format string stored after the record
+        u32 arguments_size{};
+        unsigned int line_num{};
+        Class log_class{};
+        Level log_level{};
+        bool is_padding{};
+    };
+
+    /**
+     * Reserves a record and copies its format string, the caller may reuse the format as soon as
+     * this returns.
+     * @returns Where the arguments have to be written, or nullptr when the message is dropped
+     */
+    [[nodiscard]] char* Reserve(const Record& header, std::string_view format,
+                                std::size_t arguments_size) {
+        const std::size_t record_size =
+            Common::AlignUp(sizeof(Record) + format.size() + arguments_size, alignof(Record));
+        const u64 head = write_head.load(std::memory_order_relaxed);
+        const std::size_t offset = static_cast<std::size_t>(head % CAPACITY);
+        // Records never wrap around, the end of the ring is skipped when the record doesn't fit
+        const std::size_t padding = offset + record_size > CAPACITY ? CAPACITY - offset : 0;
+        if (record_size > CAPACITY / 2 ||
+            head + padding + record_size - read_head.load(std::memory_order_acquire) > CAPACITY) {
+            num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if (padding >= sizeof(Record)) {
+            new (buffer.data() + offset) Record{
+                .size = static_cast<u32>(padding),
+                .is_padding = true,
+            };
+        }
+        const std::size_t record_offset = padding == 0 ? offset : 0;
+        Record* const record = new (buffer.data() + record_offset) Record{header};
+        record->size = static_cast<u32>(record_size);
+        record->format_size = static_cast<u32>(format.size());
+        record->arguments_size = static_cast<u32>(arguments_size);
+        pending_head = head + padding + record_size;
+        char* const data = buffer.data() + record_offset + sizeof(Record);
+        std::memcpy(data, format.data(), format.size());
+        return data + format.size();
+    }
+
+    void Commit() {
+        write_head.store(pending_head, std::memory_order_release);
+    }
+
+    /// Calls func with every published record and its format string and arguments, only the
+    /// backend thread can consume
+    template <typename Func>
+    void Consume(Func&& func) {
+        const u64 end = write_head.load(std::memory_order_acquire);
+        u64 head = read_head.load(std::memory_order_relaxed);
+        while (head != end) {
+            const std::size_t offset = static_cast<std::size_t>(head % CAPACITY);
+            if (CAPACITY - offset < sizeof(Record)) {
+                head += CAPACITY - offset;
+                continue;
+            }
+            const Record& record =
+                *std::launder(reinterpret_cast<const Record*>(buffer.data() + offset));
+            if (!record.is_padding) {
+                const char* const data = buffer.data() + offset + sizeof(Record);
+                func(record, std::string_view{data, record.format_size},
+                     data + record.format_size);
+            }
+            head += record.size;
+        }
+        read_head.store(head, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool IsEmpty() const {
+        return read_head.load(std::memory_order_acquire) ==
+               write_head.load(std::memory_order_acquire);
+    }
+
+    /// Returns the number of messages dropped since the last call
+    [[nodiscard]] u64 TakeNumDropped() {
+        return num_dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    /// Set when the owning thread exits, the ring is freed once it has been drained
+    std::atomic_bool is_orphaned{false};
+
+private:
+    alignas(64) std::atomic<u64> write_head{0};
+    u64 pending_head = 0;
+    std::atomic<u64> num_dropped{0};
+    alignas(64) std::atomic<u64> read_head{0};
+    alignas(Record) std::array<char, CAPACITY> buffer;
+};
+} // Anonymous namespace
+
 /**
  * Static state as a singleton.
  */
@@ -46,10 +161,37 @@ public:
     Impl(Impl&&) = delete;
     Impl& operator=(Impl&&) = delete;
 
-    void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string message) {
-        message_queue.Push(
-            CreateEntry(log_class, log_level, filename, line_num, function, std::move(message)));
+    char* ReserveEntry(Class log_class, Level log_level, const char* filename,
+                       unsigned int line_num, const char* function, const char* format,
+                       DeferredFormatter formatter, std::size_t arguments_size) {
+        // Preformatted messages don't need their format anymore
+        const std::string_view stored_format = formatter ? std::string_view{format} : "";
+        return ThreadRing().Reserve(
+            {
+                .timestamp = Now(),
+                .filename = filename,
+                .function = function,
+                .formatter = formatter,
+                .line_num = line_num,
+                .log_class = log_class,
+                .log_level = log_level,
+            },
+            stored_format, arguments_size);
+    }
+
+    void CommitEntry() {
+        ThreadRing().Commit();
+        // Pairs with the backend thread publishing is_sleeping before it looks for new records,
+        // either it sees this record or this thread sees it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // Only wake up the backend thread when it went to sleep with nothing to write
+        if (!is_sleeping.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::scoped_lock lock{backend_mutex};
+        if (is_sleeping.exchange(false, std::memory_order_relaxed)) {
+            backend_cv.notify_one();
+        }
     }
 
     void AddBackend(std::unique_ptr<Backend> backend) {
@@ -83,62 +225,157 @@ public:
     }
 
 private:
+    /// Releases the ring of a thread when the thread exits
+    struct ThreadRingHandle {
+        ~ThreadRingHandle() {
+            if (ring) {
+                ring->is_orphaned.store(true, std::memory_order_release);
+            }
+        }
+        LogRing* ring = nullptr;
+    };
+
     Impl() {
         backend_thread = std::thread([&] {
-            Entry entry;
-            auto write_logs = [&](Entry& e) {
-                std::lock_guard lock{writing_mutex};
-                for (const auto& backend : backends) {
-                    backend->Write(e);
-                }
-            };
-            while (true) {
-                entry = message_queue.PopWait();
-                if (entry.final_entry) {
-                    break;
+            while (!is_stopping.load(std::memory_order_acquire)) {
+                if (WriteEntries(std::numeric_limits<std::size_t>::max()) > 0) {
+                    continue;
                 }
-                write_logs(entry);
+                std::unique_lock lock{backend_mutex};
+                is_sleeping.store(true, std::memory_order_seq_cst);
+                backend_cv.wait_for(lock, std::chrono::milliseconds{50}, [this] {
+                    return !is_sleeping.load(std::memory_order_relaxed) ||
+                           is_stopping.load(std::memory_order_acquire) || HasPendingRecords();
+                });
+                is_sleeping.store(false, std::memory_order_relaxed);
             }
 
-            // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
+            // Drain the logging rings. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
             // case where a system is repeatedly spamming logs even on close.
-            const int MAX_LOGS_TO_WRITE = filter.IsDebug() ? INT_MAX : 100;
-            int logs_written = 0;
-            while (logs_written++ < MAX_LOGS_TO_WRITE && message_queue.Pop(entry)) {
-                write_logs(entry);
-            }
+            const std::size_t MAX_LOGS_TO_WRITE =
+                filter.IsDebug() ? std::numeric_limits<std::size_t>::max() : 100;
+            WriteEntries(MAX_LOGS_TO_WRITE);
         });
     }
 
     ~Impl() {
-        Entry entry;
-        entry.final_entry = true;
-        message_queue.Push(entry);
+        {
+            std::scoped_lock lock{backend_mutex};
+            is_stopping.store(true, std::memory_order_release);
+        }
+        backend_cv.notify_one();
         backend_thread.join();
     }
 
-    Entry CreateEntry(Class log_class, Level log_level, const char* filename, unsigned int line_nr,
-                      const char* function, std::string message) const {
+    std::chrono::microseconds Now() const {
         using std::chrono::duration_cast;
         using std::chrono::microseconds;
         using std::chrono::steady_clock;
 
+        return duration_cast<microseconds>(steady_clock::now() - time_origin);
+    }
+
+    LogRing& ThreadRing() {
+        thread_local ThreadRingHandle handle;
+        if (!handle.ring) {
+            auto ring = std::make_unique<LogRing>();
+            handle.ring = ring.get();
+            std::scoped_lock lock{rings_mutex};
+            rings.push_back(std::move(ring));
+        }
+        return *handle.ring;
+    }
+
+    /// Returns true when any ring has records the backend thread hasn't consumed
+    bool HasPendingRecords() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::scoped_lock lock{rings_mutex};
+        return std::ranges::any_of(rings, [](const auto& ring) { return !ring->IsEmpty(); });
+    }
+
+    /// Formats the messages published to all rings and writes them in timestamp order
+    std::size_t WriteEntries(std::size_t max_entries) {
+        // Rings are only freed by this thread, so they can be consumed without holding the lock
+        {
+            std::scoped_lock lock{rings_mutex};
+            consuming_rings.clear();
+            for (const auto& ring : rings) {
+                consuming_rings.push_back(ring.get());
+            }
+        }
+        for (LogRing* const ring : consuming_rings) {
+            ring->Consume([this](const LogRing::Record& record, std::string_view format,
+                                 const char* arguments) {
+                entries.push_back(CreateEntry(record, format, arguments));
+            });
+            if (const u64 num_dropped = ring->TakeNumDropped(); num_dropped > 0) {
+                entries.push_back(Entry{
+                    .timestamp = Now(),
+                    .log_class = Class::Log,
+                    .log_level = Level::Warning,
+                    .filename = "",
+                    .function = "",
+                    .message =
+                        fmt::format("{} messages were dropped, a log ring was full", num_dropped),
+                });
+            }
+        }
+        {
+            // Rings of threads that exited can't get new messages, free them once drained
+            std::scoped_lock lock{rings_mutex};
+            std::erase_if(rings, [](const auto& ring) {
+                return ring->is_orphaned.load(std::memory_order_acquire) && ring->IsEmpty();
+            });
+        }
+        std::ranges::stable_sort(entries, {}, &Entry::timestamp);
+
+        const std::size_t num_entries = std::min(entries.size(), max_entries);
+        {
+            std::lock_guard lock{writing_mutex};
+            for (std::size_t i = 0; i < num_entries; ++i) {
+                for (const auto& backend : backends) {
+                    backend->Write(entries[i]);
+                }
+            }
+        }
+        entries.clear();
+        return num_entries;
+    }
+
+    static Entry CreateEntry(const LogRing::Record& record, std::string_view format,
+                             const char* arguments) {
+        std::string message;
+        if (!record.formatter) {
+            message.assign(arguments, record.arguments_size);
+        } else {
+            try {
+                message = record.formatter(format, arguments);
+            } catch (const fmt::format_error& error) {
+                message = fmt::format("Failed to format \"{}\": {}", format, error.what());
+            }
+        }
         return {
-            .timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin),
-            .log_class = log_class,
-            .log_level = log_level,
-            .filename = filename,
-            .line_num = line_nr,
-            .function = function,
+            .timestamp = record.timestamp,
+            .log_class = record.log_class,
+            .log_level = record.log_level,
+            .filename = record.filename,
+            .line_num = record.line_num,
+            .function = record.function,
             .message = std::move(message),
-            .final_entry = false,
         };
     }
 
     std::mutex writing_mutex;
     std::thread backend_thread;
     std::vector<std::unique_ptr<Backend>> backends;
-    MPSCQueue<Entry> message_queue;
+    std::mutex rings_mutex;
+    std::vector<std::unique_ptr<LogRing>> rings;
+    std::vector<LogRing*> consuming_rings;
+    std::vector<Entry> entries;
+    std::mutex backend_mutex;
+    std::condition_variable backend_cv;
+    std::atomic_bool is_sleeping{false};
+    std::atomic_bool is_stopping{false};
     Filter filter;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
 };
@@ -220,15 +457,31 @@ Backend* GetBackend(std::string_view backend_name) {
     return Impl::Instance().GetBackend(backend_name);
 }
 
+bool CheckLogFilter(Class log_class, Level log_level) {
+    return Impl::Instance().GetGlobalFilter().CheckMessage(log_class, log_level);
+}
+
+char* ReserveLogMessage(Class log_class, Level log_level, const char* filename,
+                        unsigned int line_num, const char* function, const char* format,
+                        DeferredFormatter formatter, std::size_t arguments_size) {
+    return Impl::Instance().ReserveEntry(log_class, log_level, filename, line_num, function,
+                                         format, formatter, arguments_size);
+}
+
+void CommitLogMessage() {
+    Impl::Instance().CommitEntry();
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
-    auto& instance = Impl::Instance();
-    const auto& filter = instance.GetGlobalFilter();
-    if (!filter.CheckMessage(log_class, log_level))
+    const std::string message = fmt::vformat(format, args);
+    char* const out = ReserveLogMessage(log_class, log_level, filename, line_num, function,
+                                        format, nullptr, message.size());
+    if (!out) {
         return;
-
-    instance.PushEntry(log_class, log_level, filename, line_num, function,
-                       fmt::vformat(format, args));
+    }
+    std::memcpy(out, message.data(), message.size());
+    CommitLogMessage();
 }
 } // namespace Common::Log
@@ -4,6 +4,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
 #include <fmt/format.h>
 #include "common/logging/types.h"
 
@@ -18,16 +26,141 @@ constexpr const char* TrimSourcePath(std::string_view source) {
     return source.data() + idx;
 }
 
-/// Logs a message to the global logger, using fmt
+/// Rebuilds the arguments of a deferred message from the log ring and formats its text
+using DeferredFormatter = std::string (*)(std::string_view format, const char* arguments);
+
+/// Returns true when a message of the given class and level passes the global filter
+[[nodiscard]] bool CheckLogFilter(Class log_class, Level log_level);
+
+/**
+ * Reserves space for a message and its arguments in the log ring of the calling thread.
+ * The message is published by CommitLogMessage, nothing else can be logged from this thread in
+ * between.
+ *
+ * @param format         Format string of the message, it is copied into the ring when the message
+ *                       is formatted later, so it doesn't have to outlive the call
+ * @param formatter      Function that formats the arguments, nullptr when the reserved space holds
+ *                       the already formatted message
+ * @param arguments_size Number of bytes of arguments to store
+ * @returns Pointer where the arguments have to be written, nullptr when the ring is full and the
+ *          message was dropped
+ */
+[[nodiscard]] char* ReserveLogMessage(Class log_class, Level log_level, const char* filename,
+                                      unsigned int line_num, const char* function,
+                                      const char* format, DeferredFormatter formatter,
+                                      std::size_t arguments_size);
+
+/// Publishes the message reserved by the calling thread to the backend thread
+void CommitLogMessage();
+
+/// Logs a message to the global logger, formatting it in the calling thread using fmt
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args);
 
+namespace detail {
+
+template <typename T>
+constexpr bool IsDeferredString =
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>);
+
+template <typename T>
+constexpr bool IsDeferredValue = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+/// Arguments that can be copied into the log ring and formatted later in the backend thread.
+/// Everything else is formatted in the calling thread.
+template <typename T>
+concept Deferrable = IsDeferredString<T> || IsDeferredValue<T>;
+
+template <typename T>
+using StoredArgument = std::conditional_t<IsDeferredString<T>, std::string_view, T>;
+
+/// Views a string argument, null C strings are logged as "(null)"
+template <typename T>
+[[nodiscard]] std::string_view ToStringView(const T& arg) {
+    if constexpr (std::is_pointer_v<T>) {
+        if (arg == nullptr) {
+            return "(null)";
+        }
+    }
+    return std::string_view{arg};
+}
+
+template <Deferrable T>
+[[nodiscard]] std::size_t ArgumentSize(const T& arg) {
+    if constexpr (IsDeferredValue<T>) {
+        return sizeof(T);
+    } else {
+        return sizeof(std::size_t) + ToStringView(arg).size();
+    }
+}
+
+/// Strings are stored as their length followed by their characters, values are copied as is
+template <Deferrable T>
+[[nodiscard]] char* WriteArgument(char* out, const T& arg) {
+    if constexpr (IsDeferredValue<T>) {
+        std::memcpy(out, &arg, sizeof(T));
+        return out + sizeof(T);
+    } else {
+        const std::string_view string = ToStringView(arg);
+        const std::size_t length = string.size();
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), string.data(), length);
+        return out + sizeof(length) + length;
+    }
+}
+
+template <Deferrable T>
+[[nodiscard]] StoredArgument<T> ReadArgument(const char*& in) {
+    if constexpr (IsDeferredValue<T>) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    } else {
+        std::size_t length;
+        std::memcpy(&length, in, sizeof(length));
+        const std::string_view string{in + sizeof(length), length};
+        in += sizeof(length) + length;
+        return string;
+    }
+}
+
+template <Deferrable... Args>
+std::string FormatDeferred(std::string_view format, const char* arguments) {
+    // Braced initialization evaluates the reads in order
+    const std::tuple<StoredArgument<Args>...> values{ReadArgument<Args>(arguments)...};
+    return std::apply(
+        [format](const auto&... args) {
+            return fmt::vformat(format, fmt::make_format_args(args...));
+        },
+        values);
+}
+
+} // namespace detail
+
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
-    FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+    if (!CheckLogFilter(log_class, log_level)) {
+        return;
+    }
+    // Messages without arguments are formatted right away, there is nothing to save by deferring
+    if constexpr (sizeof...(Args) > 0 && (detail::Deferrable<Args> && ...)) {
+        const std::size_t arguments_size = (std::size_t{0} + ... + detail::ArgumentSize(args));
+        char* out = ReserveLogMessage(log_class, log_level, filename, line_num, function, format,
+                                      &detail::FormatDeferred<Args...>, arguments_size);
+        if (!out) {
+            return;
+        }
+        ((out = detail::WriteArgument(out, args)), ...);
+        CommitLogMessage();
+    } else {
+        FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
+                          fmt::make_format_args(args...));
+    }
 }
 
 } // namespace Common::Log
@@ -57,4 +57,14 @@ namespace Common::Compression {
 [[nodiscard]] std::vector<u8> DecompressDataLZ4(std::span<const u8> compressed,
                                                 std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 into a destination memory region.
+ *
+ * @param compressed the compressed source memory region.
+ * @param uncompressed the destination memory region, its size is the expected uncompressed size.
+ *
+ * @return true if the destination was filled with exactly the uncompressed data, false otherwise.
+ */
+[[nodiscard]] bool DecompressDataLZ4(std::span<const u8> compressed, std::span<u8> uncompressed);
+
 } // namespace Common::Compression
@@ -0,0 +1,77 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Common {
+
+/**
+ * Page table split in two levels. Second level tables are only allocated once one of their entries
+ * is set to something other than an empty entry. They are kept until the table is destroyed, so
+ * other threads can keep calling Get while entries are being set.
+ *
+ * @tparam Entry            Type of the entries, a value initialized entry is an empty one
+ * @tparam num_entries_bits log2 of the number of entries in the table
+ * @tparam leaf_bits        log2 of the number of entries in each second level table
+ */
+template <typename Entry, std::size_t num_entries_bits, std::size_t leaf_bits>
+requires std::equality_comparable<Entry> && std::is_trivially_copyable_v<Entry> &&
+    (leaf_bits <= num_entries_bits)
+class MultiLevelPageTable {
+public:
+    static constexpr std::size_t NUM_ENTRIES = std::size_t{1} << num_entries_bits;
+    static constexpr std::size_t LEAF_SIZE = std::size_t{1} << leaf_bits;
+
+    MultiLevelPageTable() : leaves(NUM_ENTRIES / LEAF_SIZE) {}
+
+    /// Returns the entry at the given index, empty entries don't allocate anything
+    [[nodiscard]] Entry Get(std::size_t index) const {
+        const Leaf* const leaf = leaves[index / LEAF_SIZE].load(std::memory_order_acquire);
+        return leaf ? leaf->entries[index % LEAF_SIZE] : Entry{};
+    }
+
+    /// Sets the entry at the given index, allocating its second level table as needed
+    void Set(std::size_t index, const Entry& entry) {
+        std::atomic<Leaf*>& slot = leaves[index / LEAF_SIZE];
+        Leaf* leaf = slot.load(std::memory_order_relaxed);
+        if (!leaf) {
+            if (entry == Entry{}) {
+                return;
+            }
+            leaf = allocated_leaves.emplace_back(std::make_unique<Leaf>()).get();
+            slot.store(leaf, std::memory_order_release);
+        }
+        leaf->entries[index % LEAF_SIZE] = entry;
+    }
+
+    /// Returns the number of allocated second level tables
+    [[nodiscard]] std::size_t NumLeaves() const {
+        return allocated_leaves.size();
+    }
+
+    /// Returns the number of bytes used by the table
+    [[nodiscard]] std::size_t MemoryUsage() const {
+        return leaves.size() * sizeof(leaves[0]) +
+               allocated_leaves.capacity() * sizeof(allocated_leaves[0]) +
+               allocated_leaves.size() * sizeof(Leaf);
+    }
+
+private:
+    struct Leaf {
+        std::array<Entry, LEAF_SIZE> entries{};
+    };
+
+    std::vector<std::atomic<Leaf*>> leaves;
+    std::vector<std::unique_ptr<Leaf>> allocated_leaves;
+};
+
+} // namespace Common
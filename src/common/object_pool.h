@@ -0,0 +1,93 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Common {
+
+/**
+ * Allocates objects of a single type from fixed size chunks and destroys all of them at once.
+ * Objects are never moved, pointers to them stay valid until the contents are released.
+ *
+ * @tparam T  Type of the allocated objects
+ */
+template <typename T>
+requires std::is_destructible_v<T>
+class ObjectPool {
+public:
+    explicit ObjectPool(std::size_t chunk_size_ = 1024) : chunk_size{chunk_size_} {}
+
+    ~ObjectPool() {
+        ReleaseContents();
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ObjectPool(ObjectPool&&) = delete;
+    ObjectPool& operator=(ObjectPool&&) = delete;
+
+    /// Constructs a new object in the pool and returns a pointer to it
+    template <typename... Args>
+    requires std::is_constructible_v<T, Args...>
+    [[nodiscard]] T* Create(Args&&... args) {
+        if (chunks.empty() || used_in_chunk == chunk_size) {
+            chunks.push_back(std::make_unique<Storage[]>(chunk_size));
+            used_in_chunk = 0;
+        }
+        T* const object = std::construct_at(&chunks.back()[used_in_chunk].object,
+                                            std::forward<Args>(args)...);
+        ++used_in_chunk;
+        return object;
+    }
+
+    /// Destroys all the objects in the pool, the first chunk is kept for reuse
+    void ReleaseContents() {
+        if (chunks.empty()) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+                const bool is_last = chunk + 1 == chunks.size();
+                const std::size_t count = is_last ? used_in_chunk : chunk_size;
+                for (std::size_t i = 0; i < count; ++i) {
+                    std::destroy_at(&chunks[chunk][i].object);
+                }
+            }
+        }
+        chunks.resize(1);
+        used_in_chunk = 0;
+    }
+
+    /// Returns the number of live objects in the pool
+    [[nodiscard]] std::size_t Size() const {
+        return chunks.empty() ? 0 : (chunks.size() - 1) * chunk_size + used_in_chunk;
+    }
+
+    /// Returns the number of bytes reserved by the pool
+    [[nodiscard]] std::size_t MemoryUsage() const {
+        return chunks.size() * chunk_size * sizeof(Storage);
+    }
+
+private:
+    /// Uninitialized storage for a single object, constructed and destroyed by the pool
+    union Storage {
+        Storage() noexcept {}
+        ~Storage() noexcept {}
+
+        T object;
+    };
+
+    std::size_t chunk_size;
+    std::size_t used_in_chunk = 0;
+    std::vector<std::unique_ptr<Storage[]>> chunks;
+};
+
+} // namespace Common
@@ -214,6 +214,7 @@ struct Values {
     bool gamecard_inserted;
     bool gamecard_current_game;
     std::string gamecard_path;
+    u32 vfs_cache_size; ///< Budget of the cache of decrypted RomFS blocks in MiB
 
     // Debugging
     bool record_frame_times;
@@ -226,6 +227,8 @@ struct Values {
     bool reporting_services;
     bool quest_flag;
     bool disable_macro_jit;
+    bool dump_macro_statistics;
+    bool dump_nvdec;
     bool extended_logging;
     bool use_debug_asserts;
     bool use_auto_stub;
@@ -87,6 +87,33 @@ private:
     std::size_t generation = 0; // Incremented once each time the barrier is used
 };
 
+/// Counts work that is still pending, Wait() blocks until all of it has been marked as done
+class WaitGroup {
+public:
+    void Add(std::size_t count = 1) {
+        std::lock_guard lk{mutex};
+        pending += count;
+    }
+
+    /// The waiter may destroy the group as soon as this returns
+    void Done() {
+        std::lock_guard lk{mutex};
+        if (--pending == 0) {
+            condvar.notify_all();
+        }
+    }
+
+    void Wait() {
+        std::unique_lock lk{mutex};
+        condvar.wait(lk, [this] { return pending == 0; });
+    }
+
+private:
+    std::condition_variable condvar;
+    std::mutex mutex;
+    std::size_t pending = 0;
+};
+
 enum class ThreadPriority : u32 {
     Low = 0,
     Normal = 1,
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "common/thread.h"
 #include "common/thread_worker.h"
 
@@ -50,9 +52,15 @@ ThreadWorker::~ThreadWorker() {
 void ThreadWorker::QueueWork(std::function<void()>&& work) {
     {
         std::unique_lock lock{queue_mutex};
-        requests.emplace(work);
+        requests.emplace(std::move(work));
     }
     condition.notify_one();
 }
 
+ThreadWorker& SharedThreadWorker() {
+    static ThreadWorker workers(std::max(std::thread::hardware_concurrency(), 2U) - 1,
+                                "yuzu:Worker");
+    return workers;
+}
+
 } // namespace Common
@@ -5,9 +5,11 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <queue>
 
@@ -19,6 +21,10 @@ public:
     ~ThreadWorker();
     void QueueWork(std::function<void()>&& work);
 
+    [[nodiscard]] std::size_t NumWorkers() const {
+        return threads.size();
+    }
+
 private:
     std::vector<std::thread> threads;
     std::queue<std::function<void()>> requests;
@@ -27,4 +33,8 @@ private:
     std::atomic_bool stop{};
 };
 
+/// Worker pool shared by short lived parallel jobs, it has one thread less than the host has
+/// cores so the thread waiting on the job can help with it
+[[nodiscard]] ThreadWorker& SharedThreadWorker();
+
 } // namespace Common
@@ -25,6 +25,7 @@
 #include "core/file_sys/romfs_factory.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/sdmc_factory.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_concat.h"
 #include "core/file_sys/vfs_real.h"
 #include "core/hardware_interrupt_manager.h"
@@ -217,6 +218,8 @@ struct System::Impl {
 
     ResultStatus Load(System& system, Frontend::EmuWindow& emu_window, const std::string& filepath,
                       std::size_t program_index) {
+        FileSys::BlockCache::Instance().SetCapacity(std::size_t{Settings::values.vfs_cache_size}
+                                                    << 20);
         app_loader = Loader::GetLoader(system, GetGameFileFromPath(virtual_filesystem, filepath),
                                        program_index);
 
@@ -298,6 +301,14 @@ struct System::Impl {
                                         perf_stats->GetMeanFrametime());
         }
 
+        const auto cache_stats = FileSys::BlockCache::Instance().GetStats();
+        if (cache_stats.hits + cache_stats.misses != 0) {
+            LOG_INFO(Core, "VFS block cache: {} hits, {} misses, {} evictions, {} KiB held",
+                     cache_stats.hits, cache_stats.misses, cache_stats.evictions,
+                     cache_stats.size >> 10);
+        }
+        FileSys::BlockCache::Instance().Clear();
+
         is_powered_on = false;
         exit_lock = false;
 
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -16,6 +17,9 @@ namespace Core::Timing {
 
 constexpr s64 MAX_SLICE_LENGTH = 4000;
 
+/// Ends the lists of event handles
+constexpr u32 INVALID_EVENT_HANDLE = std::numeric_limits<u32>::max();
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -25,6 +29,8 @@ struct CoreTiming::Event {
     u64 fifo_order;
     std::uintptr_t user_data;
     std::weak_ptr<EventType> type;
+    /// Index into event_handles
+    u32 handle;
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
@@ -37,6 +43,13 @@ struct CoreTiming::Event {
     }
 };
 
+/// Position of a pending event in the heap, and its links in the list of its type
+struct CoreTiming::EventHandle {
+    std::size_t position;
+    u32 prev;
+    u32 next;
+};
+
 CoreTiming::CoreTiming()
     : clock{Common::CreateBestMatchingClock(Hardware::BASE_CLOCK_RATE, Hardware::CNTFREQ)} {}
 
@@ -112,9 +125,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const u64 timeout = static_cast<u64>((GetGlobalTimeNs() + ns_into_future).count());
 
-        event_queue.emplace_back(Event{timeout, event_fifo_id++, user_data, event_type});
-
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        PushEvent(timeout, user_data, event_type);
     }
     event.Set();
 }
@@ -122,15 +133,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
                                  std::uintptr_t user_data) {
     std::scoped_lock scope{basic_lock};
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.user_data == user_data;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-    }
+    RemoveEvents(*event_type, user_data);
 }
 
 void CoreTiming::AddTicks(u64 ticks_to_add) {
@@ -169,21 +172,124 @@ u64 CoreTiming::GetClockTicks() const {
 }
 
 void CoreTiming::ClearPendingEvents() {
+    // Event types outlive the queue, drop their lists before the handles go away
+    for (const Event& evt : event_queue) {
+        if (const auto event_type{evt.type.lock()}) {
+            event_type->pending_events_head = INVALID_EVENT_HANDLE;
+        }
+    }
     event_queue.clear();
+    event_handles.clear();
+    free_event_handles.clear();
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::scoped_lock lock{basic_lock};
+    RemoveEvents(*event_type, std::nullopt);
+}
+
+void CoreTiming::PushEvent(u64 time, std::uintptr_t user_data,
+                           const std::shared_ptr<EventType>& event_type) {
+    u32 handle;
+    if (free_event_handles.empty()) {
+        handle = static_cast<u32>(event_handles.size());
+        event_handles.emplace_back();
+    } else {
+        handle = free_event_handles.back();
+        free_event_handles.pop_back();
+    }
+    EventHandle& entry = event_handles[handle];
+    entry.position = event_queue.size();
+    entry.prev = INVALID_EVENT_HANDLE;
+    entry.next = event_type->pending_events_head;
+    if (entry.next != INVALID_EVENT_HANDLE) {
+        event_handles[entry.next].prev = handle;
+    }
+    event_type->pending_events_head = handle;
+
+    event_queue.push_back(Event{time, event_fifo_id++, user_data, event_type, handle});
+    SiftUp(event_queue.size() - 1);
+}
+
+CoreTiming::Event CoreTiming::TakeEvent(std::size_t index) {
+    Event evt = std::move(event_queue[index]);
+    const EventHandle& entry = event_handles[evt.handle];
+    if (entry.next != INVALID_EVENT_HANDLE) {
+        event_handles[entry.next].prev = entry.prev;
+    }
+    if (entry.prev != INVALID_EVENT_HANDLE) {
+        event_handles[entry.prev].next = entry.next;
+    } else if (const auto event_type{evt.type.lock()}) {
+        // The list of a destroyed type is unreachable, only live types need their head moved
+        event_type->pending_events_head = entry.next;
+    }
+    free_event_handles.push_back(evt.handle);
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
+    // Fill the hole with the last event and restore the heap invariant around it
+    const std::size_t last = event_queue.size() - 1;
+    if (index != last) {
+        event_queue[index] = std::move(event_queue[last]);
+        event_handles[event_queue[index].handle].position = index;
+    }
+    event_queue.pop_back();
+    if (index < event_queue.size()) {
+        if (index > 0 && event_queue[index] < event_queue[(index - 1) / 2]) {
+            SiftUp(index);
+        } else {
+            SiftDown(index);
+        }
+    }
+    return evt;
+}
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+void CoreTiming::RemoveEvents(EventType& event_type, std::optional<std::uintptr_t> user_data) {
+    u32 handle = event_type.pending_events_head;
+    while (handle != INVALID_EVENT_HANDLE) {
+        // Taking the event frees its handle, the next one is left untouched
+        const u32 next_handle = event_handles[handle].next;
+        const std::size_t index = event_handles[handle].position;
+        if (!user_data || event_queue[index].user_data == *user_data) {
+            TakeEvent(index);
+        }
+        handle = next_handle;
+    }
+}
+
+void CoreTiming::SiftUp(std::size_t index) {
+    Event evt = std::move(event_queue[index]);
+    while (index > 0) {
+        const std::size_t parent = (index - 1) / 2;
+        if (!(evt < event_queue[parent])) {
+            break;
+        }
+        event_queue[index] = std::move(event_queue[parent]);
+        event_handles[event_queue[index].handle].position = index;
+        index = parent;
+    }
+    event_handles[evt.handle].position = index;
+    event_queue[index] = std::move(evt);
+}
+
+void CoreTiming::SiftDown(std::size_t index) {
+    const std::size_t size = event_queue.size();
+    Event evt = std::move(event_queue[index]);
+    while (true) {
+        std::size_t child = index * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && event_queue[child + 1] < event_queue[child]) {
+            ++child;
+        }
+        if (!(event_queue[child] < evt)) {
+            break;
+        }
+        event_queue[index] = std::move(event_queue[child]);
+        event_handles[event_queue[index].handle].position = index;
+        index = child;
     }
+    event_handles[evt.handle].position = index;
+    event_queue[index] = std::move(evt);
 }
 
 std::optional<s64> CoreTiming::Advance() {
@@ -191,9 +297,7 @@ std::optional<s64> CoreTiming::Advance() {
     global_timer = GetGlobalTimeNs().count();
 
     while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+        Event evt = TakeEvent(0);
         basic_lock.unlock();
 
         if (const auto event_type{evt.type.lock()}) {
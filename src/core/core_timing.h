@@ -7,6 +7,7 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -34,6 +35,8 @@ struct EventType {
     TimedCallback callback;
     /// A pointer to the name of the event.
     const std::string name;
+    /// First of the pending events of this type, maintained by CoreTiming under its lock.
+    u32 pending_events_head = std::numeric_limits<u32>::max();
 };
 
 /**
@@ -129,10 +132,24 @@ public:
 
 private:
     struct Event;
+    struct EventHandle;
 
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Inserts an event into the queue, assigning it a handle.
+    void PushEvent(u64 time, std::uintptr_t user_data,
+                   const std::shared_ptr<EventType>& event_type);
+
+    /// Removes the event at the given heap index from the queue and releases its handle.
+    Event TakeEvent(std::size_t index);
+
+    /// Removes the pending events of the given type, or only those with the given user data.
+    void RemoveEvents(EventType& event_type, std::optional<std::uintptr_t> user_data);
+
+    void SiftUp(std::size_t index);
+    void SiftDown(std::size_t index);
+
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
@@ -140,11 +157,15 @@ private:
 
     u64 global_timer = 0;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
+    // The queue is an indexed min-heap. Every pending event owns a handle that tracks its
+    // position in the heap, so arbitrary events can be erased (UnscheduleEvent(), RemoveEvent())
+    // in O(log n) without rebuilding the heap. Handles are also linked into an intrusive list
+    // headed by their EventType, so finding the events to erase only visits events of that type.
+    // Handles are recycled and the vectors keep their capacity, so scheduling, unscheduling and
+    // firing events do not allocate once the queue has grown to its working size.
     std::vector<Event> event_queue;
+    std::vector<EventHandle> event_handles;
+    std::vector<u32> free_event_handles;
     u64 event_fifo_id = 0;
 
     std::shared_ptr<EventType> ev_lost;
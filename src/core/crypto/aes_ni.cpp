@@ -0,0 +1,249 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <immintrin.h>
+#include "common/swap.h"
+#include "common/x64/cpu_detect.h"
+#include "core/crypto/aes_ni.h"
+
+// The AES intrinsics can only be used in functions compiled for that extension. Limiting it to
+// these functions keeps the rest of the binary runnable on hosts without AES-NI.
+#if defined(__GNUC__) || defined(__clang__)
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+#else
+#define AESNI_TARGET
+#endif
+
+namespace Core::Crypto::AESNI {
+namespace {
+constexpr std::size_t BLOCK_SIZE = 16;
+constexpr std::size_t NUM_ROUNDS = 10;
+
+/// Number of blocks processed at once to hide the latency of the AES instructions.
+constexpr std::size_t CTR_PARALLEL_BLOCKS = 8;
+constexpr std::size_t XTS_PARALLEL_BLOCKS = 4;
+
+struct KeySchedule {
+    __m128i& operator[](std::size_t index) {
+        return round_keys[index];
+    }
+    const __m128i& operator[](std::size_t index) const {
+        return round_keys[index];
+    }
+
+    __m128i round_keys[NUM_ROUNDS + 1];
+};
+
+AESNI_TARGET KeySchedule LoadKeys(const RoundKeys& keys) {
+    KeySchedule schedule;
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        schedule[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(keys.data.data()) + i);
+    }
+    return schedule;
+}
+
+AESNI_TARGET void StoreKeys(const KeySchedule& schedule, RoundKeys& keys) {
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(keys.data.data()) + i, schedule[i]);
+    }
+}
+
+template <int rcon>
+AESNI_TARGET __m128i ExpandRound(__m128i key) {
+    __m128i generated = _mm_aeskeygenassist_si128(key, rcon);
+    generated = _mm_shuffle_epi32(generated, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, generated);
+}
+
+AESNI_TARGET __m128i EncryptBlock(const KeySchedule& keys, __m128i block) {
+    block = _mm_xor_si128(block, keys[0]);
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        block = _mm_aesenc_si128(block, keys[round]);
+    }
+    return _mm_aesenclast_si128(block, keys[NUM_ROUNDS]);
+}
+
+AESNI_TARGET __m128i DecryptBlock(const KeySchedule& keys, __m128i block) {
+    block = _mm_xor_si128(block, keys[0]);
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        block = _mm_aesdec_si128(block, keys[round]);
+    }
+    return _mm_aesdeclast_si128(block, keys[NUM_ROUNDS]);
+}
+
+template <std::size_t count>
+AESNI_TARGET void EncryptBlocks(const KeySchedule& keys, __m128i (&blocks)[count]) {
+    for (__m128i& block : blocks) {
+        block = _mm_xor_si128(block, keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (__m128i& block : blocks) {
+            block = _mm_aesenc_si128(block, keys[round]);
+        }
+    }
+    for (__m128i& block : blocks) {
+        block = _mm_aesenclast_si128(block, keys[NUM_ROUNDS]);
+    }
+}
+
+template <std::size_t count>
+AESNI_TARGET void DecryptBlocks(const KeySchedule& keys, __m128i (&blocks)[count]) {
+    for (__m128i& block : blocks) {
+        block = _mm_xor_si128(block, keys[0]);
+    }
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        for (__m128i& block : blocks) {
+            block = _mm_aesdec_si128(block, keys[round]);
+        }
+    }
+    for (__m128i& block : blocks) {
+        block = _mm_aesdeclast_si128(block, keys[NUM_ROUNDS]);
+    }
+}
+
+/// Big-endian 128-bit counter kept as two native integers.
+struct Counter {
+    u64 high;
+    u64 low;
+
+    AESNI_TARGET __m128i Next() {
+        const __m128i block = _mm_set_epi64x(static_cast<s64>(Common::swap64(low)),
+                                             static_cast<s64>(Common::swap64(high)));
+        if (++low == 0) {
+            ++high;
+        }
+        return block;
+    }
+};
+
+/// Multiplies the tweak by x in GF(2^128), as defined by IEEE 1619.
+AESNI_TARGET __m128i MultiplyTweak(__m128i tweak) {
+    // Shift every dword left by one, then carry the top bits into the next dword up. The bit
+    // shifted out of the top dword is reduced by the polynomial x^128 + x^7 + x^2 + x + 1.
+    __m128i carry = _mm_srai_epi32(tweak, 31);
+    carry = _mm_shuffle_epi32(carry, _MM_SHUFFLE(2, 1, 0, 3));
+    carry = _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1), carry);
+}
+} // Anonymous namespace
+
+bool IsSupported() {
+    return Common::GetCPUCaps().aes;
+}
+
+AESNI_TARGET void ExpandKey(const u8* key, RoundKeys& encryption_keys,
+                            RoundKeys* decryption_keys) {
+    KeySchedule schedule;
+    schedule[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    schedule[1] = ExpandRound<0x01>(schedule[0]);
+    schedule[2] = ExpandRound<0x02>(schedule[1]);
+    schedule[3] = ExpandRound<0x04>(schedule[2]);
+    schedule[4] = ExpandRound<0x08>(schedule[3]);
+    schedule[5] = ExpandRound<0x10>(schedule[4]);
+    schedule[6] = ExpandRound<0x20>(schedule[5]);
+    schedule[7] = ExpandRound<0x40>(schedule[6]);
+    schedule[8] = ExpandRound<0x80>(schedule[7]);
+    schedule[9] = ExpandRound<0x1B>(schedule[8]);
+    schedule[10] = ExpandRound<0x36>(schedule[9]);
+    StoreKeys(schedule, encryption_keys);
+
+    if (decryption_keys == nullptr) {
+        return;
+    }
+    // The equivalent inverse cipher runs the rounds backwards with InvMixColumns applied to the
+    // inner round keys.
+    KeySchedule inverse;
+    inverse[0] = schedule[NUM_ROUNDS];
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        inverse[round] = _mm_aesimc_si128(schedule[NUM_ROUNDS - round]);
+    }
+    inverse[NUM_ROUNDS] = schedule[0];
+    StoreKeys(inverse, *decryption_keys);
+}
+
+AESNI_TARGET void CTRTranscode(const RoundKeys& keys, std::array<u8, 16>& counter, const u8* src,
+                               std::size_t size, u8* dest) {
+    const KeySchedule schedule = LoadKeys(keys);
+
+    Counter ctr;
+    std::memcpy(&ctr.high, counter.data(), sizeof(u64));
+    std::memcpy(&ctr.low, counter.data() + sizeof(u64), sizeof(u64));
+    ctr.high = Common::swap64(ctr.high);
+    ctr.low = Common::swap64(ctr.low);
+
+    constexpr std::size_t batch_size = CTR_PARALLEL_BLOCKS * BLOCK_SIZE;
+    for (; size >= batch_size; size -= batch_size, src += batch_size, dest += batch_size) {
+        __m128i blocks[CTR_PARALLEL_BLOCKS];
+        for (__m128i& block : blocks) {
+            block = ctr.Next();
+        }
+        EncryptBlocks(schedule, blocks);
+        for (std::size_t i = 0; i < CTR_PARALLEL_BLOCKS; ++i) {
+            const auto* const in = reinterpret_cast<const __m128i*>(src) + i;
+            auto* const out = reinterpret_cast<__m128i*>(dest) + i;
+            _mm_storeu_si128(out, _mm_xor_si128(blocks[i], _mm_loadu_si128(in)));
+        }
+    }
+    for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE, src += BLOCK_SIZE, dest += BLOCK_SIZE) {
+        const __m128i keystream = EncryptBlock(schedule, ctr.Next());
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_xor_si128(keystream, in));
+    }
+    if (size > 0) {
+        // The rest of the keystream block is discarded, like mbedtls does between updates
+        std::array<u8, BLOCK_SIZE> keystream;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(keystream.data()),
+                         EncryptBlock(schedule, ctr.Next()));
+        for (std::size_t i = 0; i < size; ++i) {
+            dest[i] = static_cast<u8>(src[i] ^ keystream[i]);
+        }
+    }
+
+    ctr.high = Common::swap64(ctr.high);
+    ctr.low = Common::swap64(ctr.low);
+    std::memcpy(counter.data(), &ctr.high, sizeof(u64));
+    std::memcpy(counter.data() + sizeof(u64), &ctr.low, sizeof(u64));
+}
+
+AESNI_TARGET void XTSTranscode(const RoundKeys& data_keys, const RoundKeys& tweak_keys,
+                               const std::array<u8, 16>& tweak, const u8* src, std::size_t size,
+                               u8* dest, bool decrypt) {
+    const KeySchedule data_schedule = LoadKeys(data_keys);
+    __m128i current_tweak = EncryptBlock(
+        LoadKeys(tweak_keys), _mm_loadu_si128(reinterpret_cast<const __m128i*>(tweak.data())));
+
+    constexpr std::size_t batch_size = XTS_PARALLEL_BLOCKS * BLOCK_SIZE;
+    for (; size >= batch_size; size -= batch_size, src += batch_size, dest += batch_size) {
+        __m128i tweaks[XTS_PARALLEL_BLOCKS];
+        __m128i blocks[XTS_PARALLEL_BLOCKS];
+        for (std::size_t i = 0; i < XTS_PARALLEL_BLOCKS; ++i) {
+            tweaks[i] = current_tweak;
+            current_tweak = MultiplyTweak(current_tweak);
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + i);
+            blocks[i] = _mm_xor_si128(in, tweaks[i]);
+        }
+        if (decrypt) {
+            DecryptBlocks(data_schedule, blocks);
+        } else {
+            EncryptBlocks(data_schedule, blocks);
+        }
+        for (std::size_t i = 0; i < XTS_PARALLEL_BLOCKS; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest) + i,
+                             _mm_xor_si128(blocks[i], tweaks[i]));
+        }
+    }
+    for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE, src += BLOCK_SIZE, dest += BLOCK_SIZE) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        block = _mm_xor_si128(block, current_tweak);
+        block = decrypt ? DecryptBlock(data_schedule, block) : EncryptBlock(data_schedule, block);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_xor_si128(block, current_tweak));
+        current_tweak = MultiplyTweak(current_tweak);
+    }
+}
+
+} // namespace Core::Crypto::AESNI
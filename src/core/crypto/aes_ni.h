@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+
+// Hardware accelerated AES-128 used by AESCipher when the host CPU supports AES-NI.
+// Only the CTR and XTS modes used to decrypt game data are implemented, everything else goes
+// through mbedtls.
+namespace Core::Crypto::AESNI {
+
+/// Expanded AES-128 key schedule, 11 round keys of 16 bytes each.
+struct alignas(16) RoundKeys {
+    std::array<u8, 11 * 16> data;
+};
+
+/// Returns whether the host CPU supports the AES-NI instructions.
+bool IsSupported();
+
+/// Expands a 128-bit key into its encryption and, if requested, decryption round keys.
+void ExpandKey(const u8* key, RoundKeys& encryption_keys, RoundKeys* decryption_keys);
+
+/**
+ * Transcodes data in CTR mode, encryption and decryption are the same operation.
+ * @param keys     Encryption round keys
+ * @param counter  Big-endian 128-bit counter block, advanced by the number of (partial) blocks
+ * @param src      Source data, may be the same as dest
+ * @param size     Size of the data in bytes, does not need to be a multiple of the block size
+ * @param dest     Destination buffer
+ */
+void CTRTranscode(const RoundKeys& keys, std::array<u8, 16>& counter, const u8* src,
+                  std::size_t size, u8* dest);
+
+/**
+ * Transcodes a single XTS data unit, with the tweak given as raw bytes like mbedtls expects it.
+ * @param data_keys   Encryption or decryption round keys of the data key, depending on decrypt
+ * @param tweak_keys  Encryption round keys of the tweak key
+ * @param tweak       Initial tweak value
+ * @param src         Source data, may be the same as dest
+ * @param size        Size of the data in bytes, must be a multiple of the block size
+ * @param dest        Destination buffer
+ * @param decrypt     True to decrypt, false to encrypt
+ */
+void XTSTranscode(const RoundKeys& data_keys, const RoundKeys& tweak_keys,
+                  const std::array<u8, 16>& tweak, const u8* src, std::size_t size, u8* dest,
+                  bool decrypt);
+
+} // namespace Core::Crypto::AESNI
@@ -3,12 +3,17 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include "core/crypto/aes_ni.h"
+#endif
+
 namespace Core::Crypto {
 namespace {
 using NintendoTweak = std::array<u8, 16>;
@@ -37,6 +42,16 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+#ifdef ARCHITECTURE_x86_64
+    // AES-NI replaces mbedtls for AES-128 CTR and XTS when the host supports it.
+    bool use_aesni{};
+    Mode mode{};
+    AESNI::RoundKeys encryption_keys{};
+    AESNI::RoundKeys decryption_keys{};
+    AESNI::RoundKeys tweak_keys{};
+    std::array<u8, 16> iv{};
+#endif
 };
 
 template <typename Key, std::size_t KeySize>
@@ -58,6 +73,21 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+#ifdef ARCHITECTURE_x86_64
+    if (AESNI::IsSupported()) {
+        ctx->mode = mode;
+        if (mode == Mode::CTR && KeySize == 0x10) {
+            AESNI::ExpandKey(key.data(), ctx->encryption_keys, nullptr);
+            ctx->use_aesni = true;
+        } else if (mode == Mode::XTS && KeySize == 0x20) {
+            // XTS-AES-128 keys are the data key followed by the tweak key
+            AESNI::ExpandKey(key.data(), ctx->encryption_keys, &ctx->decryption_keys);
+            AESNI::ExpandKey(key.data() + 0x10, ctx->tweak_keys, nullptr);
+            ctx->use_aesni = true;
+        }
+    }
+#endif
 }
 
 template <typename Key, std::size_t KeySize>
@@ -68,6 +98,22 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+#ifdef ARCHITECTURE_x86_64
+    if (ctx->use_aesni) {
+        if (ctx->mode == Mode::CTR) {
+            AESNI::CTRTranscode(ctx->encryption_keys, ctx->iv, src, size, dest);
+            return;
+        }
+        // Ciphertext stealing is left to mbedtls, game data always uses whole blocks
+        if (size % ctx->iv.size() == 0) {
+            const bool decrypt = op == Op::Decrypt;
+            AESNI::XTSTranscode(decrypt ? ctx->decryption_keys : ctx->encryption_keys,
+                                ctx->tweak_keys, ctx->iv, src, size, dest, decrypt);
+            return;
+        }
+    }
+#endif
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -123,6 +169,13 @@ void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
+
+#ifdef ARCHITECTURE_x86_64
+    if (ctx->use_aesni) {
+        ASSERT_MSG(data.size() == ctx->iv.size(), "AES-NI IV must be one block.");
+        std::memcpy(ctx->iv.data(), data.data(), ctx->iv.size());
+    }
+#endif
 }
 
 template class AESCipher<Key128>;
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include "common/assert.h"
 #include "core/crypto/ctr_encryption_layer.h"
@@ -17,26 +18,33 @@ std::size_t CTREncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     if (length == 0)
         return 0;
 
+    std::size_t total_read = 0;
     const auto sector_offset = offset & 0xF;
-    if (sector_offset == 0) {
-        UpdateIV(base_offset + offset);
-        std::vector<u8> raw = base->ReadBytes(length, offset);
-        cipher.Transcode(raw.data(), raw.size(), data, Op::Decrypt);
-        return length;
+    if (sector_offset != 0) {
+        // offset does not fall on block boundary (0x10), decrypt the first block on its own
+        std::array<u8, 0x10> block{};
+        const std::size_t block_read =
+            base->Read(block.data(), block.size(), offset - sector_offset);
+        UpdateIV(base_offset + offset - sector_offset);
+        cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
+
+        const std::size_t read =
+            std::min(length, block_read > sector_offset ? block_read - sector_offset : 0);
+        std::memcpy(data, block.data() + sector_offset, read);
+        if (read == length || block_read < block.size()) {
+            return read;
+        }
+        data += read;
+        length -= read;
+        offset += read;
+        total_read = read;
     }
 
-    // offset does not fall on block boundary (0x10)
-    std::vector<u8> block = base->ReadBytes(0x10, offset - sector_offset);
-    UpdateIV(base_offset + offset - sector_offset);
-    cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
-    std::size_t read = 0x10 - sector_offset;
-
-    if (length + sector_offset < 0x10) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
-    }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    // The rest is block aligned, so it can be decrypted in place in the caller's buffer
+    const std::size_t read = base->Read(data, length, offset);
+    UpdateIV(base_offset + offset);
+    cipher.Transcode(data, read, data, Op::Decrypt);
+    return total_read + read;
 }
 
 void CTREncryptionLayer::SetIV(const IVData& iv_) {
@@ -36,6 +36,12 @@ std::size_t EncryptionLayer::Write(const u8* data, std::size_t length, std::size
     return 0;
 }
 
+void EncryptionLayer::AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                                   std::size_t length) const {
+    // Ciphertext is laid out like the plaintext, the hint applies to the same range of the base
+    base->AdviseAccess(pattern, offset, length);
+}
+
 bool EncryptionLayer::Rename(std::string_view name) {
     return base->Rename(name);
 }
@@ -24,6 +24,8 @@ public:
     bool IsWritable() const override;
     bool IsReadable() const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    void AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                      std::size_t length) const override;
     bool Rename(std::string_view name) override;
 
 protected:
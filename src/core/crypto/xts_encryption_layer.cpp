@@ -3,13 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "core/crypto/xts_encryption_layer.h"
 
 namespace Core::Crypto {
 
-constexpr u64 XTS_SECTOR_SIZE = 0x4000;
+constexpr std::size_t XTS_SECTOR_SIZE = 0x4000;
 
 XTSEncryptionLayer::XTSEncryptionLayer(FileSys::VirtualFile base_, Key256 key_)
     : EncryptionLayer(std::move(base_)), cipher(key_, Mode::XTS) {}
@@ -18,41 +20,54 @@ std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t o
     if (length == 0)
         return 0;
 
-    const auto sector_offset = offset & 0x3FFF;
-    if (sector_offset == 0) {
-        if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
-                                XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
+    // Decrypts the sector containing offset on the stack and copies out the requested part
+    const auto read_partial_sector = [this](u8* out, std::size_t out_length, std::size_t pos) {
+        const std::size_t sector_offset = pos & (XTS_SECTOR_SIZE - 1);
+        std::array<u8, XTS_SECTOR_SIZE> sector{};
+        const std::size_t sector_read = base->Read(sector.data(), sector.size(), pos - sector_offset);
+        cipher.XTSTranscode(sector.data(), sector.size(), sector.data(),
+                            (pos - sector_offset) / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
+        const std::size_t read = std::min(
+            out_length, sector_read > sector_offset ? sector_read - sector_offset : 0);
+        std::memcpy(out, sector.data() + sector_offset, read);
+        return read;
+    };
+
+    std::size_t total_read = 0;
+    const auto sector_offset = offset & (XTS_SECTOR_SIZE - 1);
+    if (sector_offset != 0 || length < XTS_SECTOR_SIZE) {
+        // offset does not fall on block boundary (0x4000)
+        const std::size_t wanted = std::min(length, XTS_SECTOR_SIZE - sector_offset);
+        const std::size_t read = read_partial_sector(data, wanted, offset);
+        if (read < wanted || read == length) {
+            return read;
         }
-        if (length > XTS_SECTOR_SIZE) {
-            const auto rem = length % XTS_SECTOR_SIZE;
-            const auto read = length - rem;
-            return Read(data, read, offset) + Read(data + read, rem, offset + read);
+        data += read;
+        length -= read;
+        offset += read;
+        total_read = read;
+    }
+
+    // Whole sectors are read and decrypted in place in the caller's buffer
+    const std::size_t whole_length = length - length % XTS_SECTOR_SIZE;
+    if (whole_length != 0) {
+        const std::size_t read = base->Read(data, whole_length, offset);
+        const std::size_t padded_read = Common::AlignUp(read, XTS_SECTOR_SIZE);
+        std::memset(data + read, 0, padded_read - read);
+        cipher.XTSTranscode(data, padded_read, data, offset / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE,
+                            Op::Decrypt);
+        total_read += read;
+        if (read < whole_length) {
+            return total_read;
         }
-        std::vector<u8> buffer = base->ReadBytes(XTS_SECTOR_SIZE, offset);
-        if (buffer.size() < XTS_SECTOR_SIZE)
-            buffer.resize(XTS_SECTOR_SIZE);
-        cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), offset / XTS_SECTOR_SIZE,
-                            XTS_SECTOR_SIZE, Op::Decrypt);
-        std::memcpy(data, buffer.data(), std::min(buffer.size(), length));
-        return std::min(buffer.size(), length);
+        data += read;
+        length -= read;
+        offset += read;
     }
 
-    // offset does not fall on block boundary (0x4000)
-    std::vector<u8> block = base->ReadBytes(0x4000, offset - sector_offset);
-    if (block.size() < XTS_SECTOR_SIZE)
-        block.resize(XTS_SECTOR_SIZE);
-    cipher.XTSTranscode(block.data(), block.size(), block.data(),
-                        (offset - sector_offset) / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
-    const std::size_t read = XTS_SECTOR_SIZE - sector_offset;
-
-    if (length + sector_offset < XTS_SECTOR_SIZE) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
+    if (length != 0) {
+        total_read += read_partial_sector(data, length, offset);
     }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    return total_read;
 }
 } // namespace Core::Crypto
@@ -15,6 +15,7 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/nca_patch.h"
 #include "core/file_sys/partition_filesystem.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_offset.h"
 #include "core/loader/loader.h"
 
@@ -360,6 +361,8 @@ bool NCA::ReadRomFSSection(const NCASectionHeader& section, const NCASectionTabl
         files.push_back(std::move(dec));
     }
 
+    // Games read the same assets over and over, keep the decrypted blocks around
+    files.back() = std::make_shared<CachedVfsFile>(std::move(files.back()));
     romfs = files.back();
     return true;
 }
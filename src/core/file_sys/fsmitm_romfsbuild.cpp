@@ -22,10 +22,21 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/vfs.h"
@@ -38,6 +49,9 @@ constexpr u64 FS_MAX_PATH = 0x301;
 constexpr u32 ROMFS_ENTRY_EMPTY = 0xFFFFFFFF;
 constexpr u32 ROMFS_FILEPARTITION_OFS = 0x200;
 
+constexpr u32 ROMFS_CACHE_MAGIC = Common::MakeMagic('R', 'F', 'S', 'C');
+constexpr u32 ROMFS_CACHE_VERSION = 1;
+
 // Types for building a RomFS.
 struct RomFSHeader {
     u64 header_size;
@@ -73,17 +87,49 @@ struct RomFSFileEntry {
 };
 static_assert(sizeof(RomFSFileEntry) == 0x20, "RomFSFileEntry has incorrect size.");
 
-struct RomFSBuildFileContext;
+// An entry of the listing of a layer, paths are relative to the root of the layer.
+struct RomFSBuildLayerEntry {
+    std::string path;
+    VirtualFile file; // nullptr for directories
+    u64 size = 0;
+};
+
+// Where the data of a file comes from, as indices into the listings of the layers.
+struct RomFSSourceLocation {
+    u32 layer = 0;
+    u32 entry = 0;
+    u32 ips_layer = ROMFS_ENTRY_EMPTY;
+    u32 ips_entry = ROMFS_ENTRY_EMPTY;
+};
+static_assert(sizeof(RomFSSourceLocation) == 0x10, "RomFSSourceLocation has incorrect size.");
+
+// Types for caching the layout of a build.
+struct RomFSCacheHeader {
+    u32 magic;
+    u32 version;
+    u64 key;
+    u64 num_files;
+    u64 metadata_size;
+};
+static_assert(sizeof(RomFSCacheHeader) == 0x20, "RomFSCacheHeader has incorrect size.");
+
+struct RomFSCachedFile {
+    u64 offset;
+    u64 size;
+    RomFSSourceLocation location;
+};
+static_assert(sizeof(RomFSCachedFile) == 0x20, "RomFSCachedFile has incorrect size.");
 
+// Contexts are kept in flat arrays, links between them are indices into those arrays.
 struct RomFSBuildDirectoryContext {
     std::string path;
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildDirectoryContext> child;
-    std::shared_ptr<RomFSBuildDirectoryContext> sibling;
-    std::shared_ptr<RomFSBuildFileContext> file;
+    u32 parent = 0;
+    u32 child = ROMFS_ENTRY_EMPTY;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
+    u32 file = ROMFS_ENTRY_EMPTY;
 };
 
 struct RomFSBuildFileContext {
@@ -93,9 +139,10 @@ struct RomFSBuildFileContext {
     u32 entry_offset = 0;
     u64 offset = 0;
     u64 size = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildFileContext> sibling;
+    u32 parent = 0;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
     VirtualFile source;
+    RomFSSourceLocation location;
 };
 
 static u32 romfs_calc_path_hash(u32 parent, std::string_view path, u32 start,
@@ -126,124 +173,344 @@ static u64 romfs_get_hash_table_count(u64 num_entries) {
     return count;
 }
 
-void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext_dir,
-                                       std::shared_ptr<RomFSBuildDirectoryContext> parent) {
-    std::vector<std::shared_ptr<RomFSBuildDirectoryContext>> child_dirs;
+namespace {
 
-    VirtualDir dir;
+template <typename T>
+std::vector<std::pair<std::string, T>> SortByName(std::vector<T> entries) {
+    std::vector<std::pair<std::string, T>> out;
+    out.reserve(entries.size());
+    for (T& entry : entries) {
+        if (entry != nullptr) {
+            out.emplace_back(entry->GetName(), std::move(entry));
+        }
+    }
+    std::sort(out.begin(), out.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return out;
+}
 
-    if (parent->path_len == 0) {
-        dir = root_romfs;
-    } else {
-        dir = root_romfs->GetDirectoryRelative(parent->path);
+// Lists the files of dir followed by its subdirectories, each one followed by its own contents.
+void ListDirectory(const VirtualDir& dir, const std::string& path,
+                   std::vector<RomFSBuildLayerEntry>& out) {
+    for (auto& [name, file] : SortByName(dir->GetFiles())) {
+        const u64 size = file->GetSize();
+        out.push_back({path + '/' + name, std::move(file), size});
     }
+    for (const auto& [name, subdir] : SortByName(dir->GetSubdirectories())) {
+        std::string subdir_path = path + '/' + name;
+        out.push_back({subdir_path, nullptr, 0});
+        ListDirectory(subdir, subdir_path, out);
+    }
+}
 
-    const auto entries = dir->GetEntries();
+// Lists every directory, the subdirectories at the root of each one are listed on their own
+// workers. Listings are sorted by name so the same tree always gives the same listing.
+std::vector<std::vector<RomFSBuildLayerEntry>> ListLayers(const std::vector<VirtualDir>& dirs) {
+    struct Subtree {
+        std::size_t layer;
+        VirtualDir dir;
+        std::string path;
+        std::vector<RomFSBuildLayerEntry> entries;
+    };
+
+    std::vector<std::vector<RomFSBuildLayerEntry>> listings(dirs.size());
+    std::vector<Subtree> subtrees;
+    for (std::size_t layer = 0; layer < dirs.size(); ++layer) {
+        for (auto& [name, file] : SortByName(dirs[layer]->GetFiles())) {
+            const u64 size = file->GetSize();
+            listings[layer].push_back({'/' + name, std::move(file), size});
+        }
+        for (auto& [name, subdir] : SortByName(dirs[layer]->GetSubdirectories())) {
+            subtrees.push_back({layer, std::move(subdir), '/' + name, {}});
+        }
+    }
 
-    for (const auto& kv : entries) {
-        if (kv.second == VfsEntryType::Directory) {
-            const auto child = std::make_shared<RomFSBuildDirectoryContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+    Common::WaitGroup pending;
+    pending.Add(subtrees.size());
+    for (Subtree& subtree : subtrees) {
+        Common::SharedThreadWorker().QueueWork([&pending, subtree = &subtree] {
+            ListDirectory(subtree->dir, subtree->path, subtree->entries);
+            pending.Done();
+        });
+    }
+    pending.Wait();
 
-            if (ext_dir != nullptr && ext_dir->GetFileRelative(child->path + ".stub") != nullptr) {
-                continue;
+    for (Subtree& subtree : subtrees) {
+        auto& listing = listings[subtree.layer];
+        listing.push_back({std::move(subtree.path), nullptr, 0});
+        std::move(subtree.entries.begin(), subtree.entries.end(), std::back_inserter(listing));
+    }
+    return listings;
+}
+
+// Hashes everything the layout of a build depends on: the paths and sizes of the entries, and the
+// contents of the IPS patches that may change the sizes.
+u64 HashListings(u64 seed, const std::vector<std::vector<RomFSBuildLayerEntry>>& listings) {
+    u64 hash = seed;
+    for (const auto& listing : listings) {
+        hash = Common::Hash128to64({hash, listing.size()});
+        for (const RomFSBuildLayerEntry& entry : listing) {
+            hash = Common::CityHash64WithSeed(entry.path.data(), entry.path.size(), hash);
+            hash = Common::Hash128to64({hash, entry.file == nullptr ? ~0ULL : entry.size});
+            if (entry.file != nullptr && std::string_view{entry.path}.ends_with(".ips")) {
+                const std::vector<u8> patch = entry.file->ReadAllBytes();
+                hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(patch.data()),
+                                                  patch.size(), hash);
             }
+        }
+    }
+    return hash;
+}
 
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+VirtualFile OpenSource(const std::vector<std::vector<RomFSBuildLayerEntry>>& layers,
+                       const std::vector<std::vector<RomFSBuildLayerEntry>>& ext_layers,
+                       const RomFSSourceLocation& location) {
+    const auto find = [](const auto& listings, u32 layer, u32 entry) -> VirtualFile {
+        if (layer >= listings.size() || entry >= listings[layer].size()) {
+            return nullptr;
+        }
+        return listings[layer][entry].file;
+    };
+
+    VirtualFile source = find(layers, location.layer, location.entry);
+    if (source == nullptr || location.ips_layer == ROMFS_ENTRY_EMPTY) {
+        return source;
+    }
+    if (auto patched = PatchIPS(source, find(ext_layers, location.ips_layer, location.ips_entry))) {
+        return patched;
+    }
+    return source;
+}
+
+} // Anonymous namespace
+
+RomFSBuildContext::RomFSBuildContext(VirtualDir base, VirtualDir ext)
+    : RomFSBuildContext(std::vector<VirtualDir>{std::move(base)},
+                        ext != nullptr ? std::vector<VirtualDir>{std::move(ext)}
+                                       : std::vector<VirtualDir>{}) {}
+
+RomFSBuildContext::RomFSBuildContext(std::vector<VirtualDir> layers_,
+                                     std::vector<VirtualDir> ext_layers_,
+                                     std::filesystem::path cache_path_)
+    : cache_path(std::move(cache_path_)) {
+    // All of them are listed at once, so the ext layers overlap with the largest layer
+    const std::size_t num_layers = layers_.size();
+    std::vector<VirtualDir> dirs = std::move(layers_);
+    std::move(ext_layers_.begin(), ext_layers_.end(), std::back_inserter(dirs));
+
+    auto listings = ListLayers(dirs);
+    layers.assign(std::make_move_iterator(listings.begin()),
+                  std::make_move_iterator(listings.begin() + num_layers));
+    ext_layers.assign(std::make_move_iterator(listings.begin() + num_layers),
+                      std::make_move_iterator(listings.end()));
+
+    if (!cache_path.empty()) {
+        key = HashListings(HashListings(ROMFS_CACHE_VERSION, layers), ext_layers);
+    }
+}
+
+RomFSBuildContext::~RomFSBuildContext() = default;
 
-            if (AddDirectory(parent, child)) {
-                child_dirs.push_back(child);
+void RomFSBuildContext::Merge() {
+    // Paths removed by a .stub, and the patch of every path patched by an .ips
+    std::unordered_set<std::string_view> stubs;
+    std::unordered_map<std::string_view, std::pair<u32, u32>> patches;
+    for (u32 layer = 0; layer < ext_layers.size(); ++layer) {
+        for (u32 entry = 0; entry < ext_layers[layer].size(); ++entry) {
+            const RomFSBuildLayerEntry& ext = ext_layers[layer][entry];
+            const std::string_view path = ext.path;
+            if (ext.file == nullptr) {
+                continue;
+            }
+            if (path.ends_with(".stub")) {
+                stubs.insert(path.substr(0, path.size() - 5));
+            } else if (path.ends_with(".ips")) {
+                patches.try_emplace(path.substr(0, path.size() - 4), layer, entry);
             }
-        } else {
-            const auto child = std::make_shared<RomFSBuildFileContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
-
-            if (ext_dir != nullptr && ext_dir->GetFileRelative(child->path + ".stub") != nullptr) {
+        }
+    }
+
+    // Views of the paths of the listings, they don't move while the contexts are added
+    std::unordered_map<std::string_view, u32> directory_indices;
+    std::unordered_set<std::string_view> file_paths;
+
+    directories.clear();
+    files.clear();
+    directories.emplace_back();
+    directory_indices.emplace("", 0);
+    dir_table_size = sizeof(RomFSDirectoryEntry);
+    file_table_size = 0;
+
+    for (u32 layer = 0; layer < layers.size(); ++layer) {
+        for (u32 entry = 0; entry < layers[layer].size(); ++entry) {
+            const RomFSBuildLayerEntry& layer_entry = layers[layer][entry];
+            const std::string_view path = layer_entry.path;
+            const std::size_t name_ofs = path.rfind('/') + 1;
+
+            // Entries of a directory removed by a stub are skipped with it
+            if (!directory_indices.contains(path.substr(0, name_ofs - 1)) ||
+                stubs.contains(path)) {
+                continue;
+            }
+            // Layers are visited by priority, the first entry with a path is the one kept
+            if (directory_indices.contains(path) || file_paths.contains(path)) {
                 continue;
             }
 
             // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
-
-            child->source = root_romfs->GetFileRelative(child->path);
+            ASSERT(path.size() < FS_MAX_PATH);
+
+            const auto name_size = static_cast<u32>(path.size() - name_ofs);
+            if (layer_entry.file == nullptr) {
+                RomFSBuildDirectoryContext& dir_ctx = directories.emplace_back();
+                dir_ctx.path = layer_entry.path;
+                dir_ctx.cur_path_ofs = static_cast<u32>(name_ofs);
+                dir_ctx.path_len = static_cast<u32>(path.size());
+                directory_indices.emplace(path, static_cast<u32>(directories.size() - 1));
+                dir_table_size += sizeof(RomFSDirectoryEntry) + Common::AlignUp(name_size, 4);
+                continue;
+            }
 
-            if (ext_dir != nullptr) {
-                if (const auto ips = ext_dir->GetFileRelative(child->path + ".ips")) {
-                    if (auto patched = PatchIPS(child->source, ips)) {
-                        child->source = std::move(patched);
-                    }
+            RomFSBuildFileContext& file_ctx = files.emplace_back();
+            file_ctx.path = layer_entry.path;
+            file_ctx.cur_path_ofs = static_cast<u32>(name_ofs);
+            file_ctx.path_len = static_cast<u32>(path.size());
+            file_ctx.location.layer = layer;
+            file_ctx.location.entry = entry;
+            file_ctx.source = layer_entry.file;
+            if (const auto patch = patches.find(path); patch != patches.end()) {
+                const auto& ips = ext_layers[patch->second.first][patch->second.second];
+                if (auto patched = PatchIPS(file_ctx.source, ips.file)) {
+                    file_ctx.source = std::move(patched);
+                    file_ctx.location.ips_layer = patch->second.first;
+                    file_ctx.location.ips_entry = patch->second.second;
                 }
             }
-
-            child->size = child->source->GetSize();
-
-            AddFile(parent, child);
+            file_ctx.size = file_ctx.source->GetSize();
+            file_paths.insert(path);
+            file_table_size += sizeof(RomFSFileEntry) + Common::AlignUp(name_size, 4);
         }
     }
 
-    for (auto& child : child_dirs) {
-        this->VisitDirectory(root_romfs, ext_dir, child);
+    // Entries are laid out in path order, the root comes first
+    std::sort(directories.begin(), directories.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.path < rhs.path; });
+    std::sort(files.begin(), files.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.path < rhs.path; });
+
+    directory_indices.clear();
+    for (u32 i = 0; i < directories.size(); ++i) {
+        directory_indices.emplace(directories[i].path, i);
+    }
+    const auto parent_of = [&](const std::string& path, u32 cur_path_ofs) {
+        return directory_indices.at(std::string_view{path}.substr(0, cur_path_ofs - 1));
+    };
+    for (u32 i = 1; i < directories.size(); ++i) {
+        directories[i].parent = parent_of(directories[i].path, directories[i].cur_path_ofs);
+    }
+    for (RomFSBuildFileContext& file_ctx : files) {
+        file_ctx.parent = parent_of(file_ctx.path, file_ctx.cur_path_ofs);
     }
 }
 
-bool RomFSBuildContext::AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                     std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx) {
-    // Check whether it's already in the known directories.
-    const auto existing = directories.find(dir_ctx->path);
-    if (existing != directories.end())
+bool RomFSBuildContext::LoadCache(std::multimap<u64, VirtualFile>& out) const {
+    if (cache_path.empty()) {
         return false;
+    }
+    Common::FS::IOFile file{cache_path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return false;
+    }
 
-    // Add a new directory.
-    num_dirs++;
-    dir_table_size +=
-        sizeof(RomFSDirectoryEntry) + Common::AlignUp(dir_ctx->path_len - dir_ctx->cur_path_ofs, 4);
-    dir_ctx->parent = parent_dir_ctx;
-    directories.emplace(dir_ctx->path, dir_ctx);
-
-    return true;
-}
+    RomFSCacheHeader cache_header{};
+    RomFSHeader header{};
+    if (!file.ReadObject(cache_header) || cache_header.magic != ROMFS_CACHE_MAGIC ||
+        cache_header.version != ROMFS_CACHE_VERSION || cache_header.key != key ||
+        !file.ReadObject(header)) {
+        LOG_INFO(Loader, "LayeredFS cache is stale, rebuilding the RomFS");
+        return false;
+    }
+    const u64 remaining = file.GetSize() - static_cast<u64>(file.Tell());
+    if (cache_header.metadata_size > remaining ||
+        cache_header.num_files >
+            (remaining - cache_header.metadata_size) / sizeof(RomFSCachedFile)) {
+        LOG_ERROR(Loader, "LayeredFS cache is truncated, rebuilding the RomFS");
+        return false;
+    }
 
-bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                std::shared_ptr<RomFSBuildFileContext> file_ctx) {
-    // Check whether it's already in the known files.
-    const auto existing = files.find(file_ctx->path);
-    if (existing != files.end()) {
+    std::vector<u8> metadata(cache_header.metadata_size);
+    std::vector<RomFSCachedFile> cached_files(cache_header.num_files);
+    if (file.Read(metadata) != metadata.size() || file.Read(cached_files) != cached_files.size()) {
+        LOG_ERROR(Loader, "Failed to read the LayeredFS cache, rebuilding the RomFS");
         return false;
     }
 
-    // Add a new file.
-    num_files++;
-    file_table_size +=
-        sizeof(RomFSFileEntry) + Common::AlignUp(file_ctx->path_len - file_ctx->cur_path_ofs, 4);
-    file_ctx->parent = parent_dir_ctx;
-    files.emplace(file_ctx->path, file_ctx);
+    std::multimap<u64, VirtualFile> result;
+    for (const RomFSCachedFile& cached : cached_files) {
+        auto source = OpenSource(layers, ext_layers, cached.location);
+        if (source == nullptr || source->GetSize() != cached.size) {
+            LOG_ERROR(Loader, "LayeredFS cache doesn't match the layers, rebuilding the RomFS");
+            return false;
+        }
+        result.emplace(cached.offset + ROMFS_FILEPARTITION_OFS, std::move(source));
+    }
+
+    std::vector<u8> header_data(sizeof(RomFSHeader));
+    std::memcpy(header_data.data(), &header, header_data.size());
+    result.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
+    result.emplace(header.dir_hash_table_ofs, std::make_shared<VectorVfsFile>(std::move(metadata)));
 
+    LOG_INFO(Loader, "Reused the LayeredFS layout of {} files from the cache", cached_files.size());
+    out = std::move(result);
     return true;
 }
 
-RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
-    : base(std::move(base_)), ext(std::move(ext_)) {
-    root = std::make_shared<RomFSBuildDirectoryContext>();
-    root->path = "\0";
-    directories.emplace(root->path, root);
-    num_dirs = 1;
-    dir_table_size = 0x18;
+void RomFSBuildContext::SaveCache(const std::vector<u8>& header,
+                                  const std::vector<u8>& metadata) const {
+    if (cache_path.empty()) {
+        return;
+    }
 
-    VisitDirectory(base, ext, root);
+    std::vector<RomFSCachedFile> cached_files;
+    cached_files.reserve(files.size());
+    for (const RomFSBuildFileContext& file_ctx : files) {
+        cached_files.push_back({file_ctx.offset, file_ctx.size, file_ctx.location});
+    }
+    const RomFSCacheHeader cache_header{
+        .magic = ROMFS_CACHE_MAGIC,
+        .version = ROMFS_CACHE_VERSION,
+        .key = key,
+        .num_files = cached_files.size(),
+        .metadata_size = metadata.size(),
+    };
+
+    Common::FS::IOFile file{cache_path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Loader, "Failed to open LayeredFS cache in path={}",
+                  Common::FS::PathToUTF8String(cache_path));
+        return;
+    }
+    if (!file.WriteObject(cache_header) || file.Write(header) != header.size() ||
+        file.Write(metadata) != metadata.size() ||
+        file.Write(cached_files) != cached_files.size()) {
+        LOG_ERROR(Loader, "Failed to write LayeredFS cache in path={}",
+                  Common::FS::PathToUTF8String(cache_path));
+        file.Close();
+        Common::FS::RemoveFile(cache_path);
+    }
 }
 
-RomFSBuildContext::~RomFSBuildContext() = default;
-
 std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
-    const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(num_dirs);
-    const u64 file_hash_table_entry_count = romfs_get_hash_table_count(num_files);
+    std::multimap<u64, VirtualFile> out;
+    if (LoadCache(out)) {
+        return out;
+    }
+    Merge();
+
+    const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(directories.size());
+    const u64 file_hash_table_entry_count = romfs_get_hash_table_count(files.size());
     dir_hash_table_size = 4 * dir_hash_table_entry_count;
     file_hash_table_size = 4 * file_hash_table_entry_count;
 
@@ -256,102 +523,95 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
     std::vector<u8> dir_table(dir_table_size);
     std::vector<u8> file_table(file_table_size);
 
-    std::shared_ptr<RomFSBuildFileContext> cur_file;
-
     // Determine file offsets.
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildFileContext> prev_file = nullptr;
-    for (const auto& it : files) {
-        cur_file = it.second;
+    file_partition_size = 0;
+    for (RomFSBuildFileContext& cur_file : files) {
         file_partition_size = Common::AlignUp(file_partition_size, 16);
-        cur_file->offset = file_partition_size;
-        file_partition_size += cur_file->size;
-        cur_file->entry_offset = entry_offset;
-        entry_offset +=
-            static_cast<u32>(sizeof(RomFSFileEntry) +
-                             Common::AlignUp(cur_file->path_len - cur_file->cur_path_ofs, 4));
-        prev_file = cur_file;
+        cur_file.offset = file_partition_size;
+        file_partition_size += cur_file.size;
+        cur_file.entry_offset = entry_offset;
+        const u32 name_size = cur_file.path_len - cur_file.cur_path_ofs;
+        entry_offset += static_cast<u32>(sizeof(RomFSFileEntry) + Common::AlignUp(name_size, 4));
     }
     // Assign deferred parent/sibling ownership.
-    for (auto it = files.rbegin(); it != files.rend(); ++it) {
-        cur_file = it->second;
-        cur_file->sibling = cur_file->parent->file;
-        cur_file->parent->file = cur_file;
+    for (u32 i = static_cast<u32>(files.size()); i-- > 0;) {
+        RomFSBuildFileContext& cur_file = files[i];
+        cur_file.sibling = directories[cur_file.parent].file;
+        directories[cur_file.parent].file = i;
     }
 
-    std::shared_ptr<RomFSBuildDirectoryContext> cur_dir;
-
     // Determine directory offsets.
     entry_offset = 0;
-    for (const auto& it : directories) {
-        cur_dir = it.second;
-        cur_dir->entry_offset = entry_offset;
+    for (RomFSBuildDirectoryContext& cur_dir : directories) {
+        cur_dir.entry_offset = entry_offset;
+        const u32 name_size = cur_dir.path_len - cur_dir.cur_path_ofs;
         entry_offset +=
-            static_cast<u32>(sizeof(RomFSDirectoryEntry) +
-                             Common::AlignUp(cur_dir->path_len - cur_dir->cur_path_ofs, 4));
+            static_cast<u32>(sizeof(RomFSDirectoryEntry) + Common::AlignUp(name_size, 4));
     }
-    // Assign deferred parent/sibling ownership.
-    for (auto it = directories.rbegin(); it->second != root; ++it) {
-        cur_dir = it->second;
-        cur_dir->sibling = cur_dir->parent->child;
-        cur_dir->parent->child = cur_dir;
+    // Assign deferred parent/sibling ownership, the root is the first directory.
+    for (u32 i = static_cast<u32>(directories.size()); i-- > 1;) {
+        RomFSBuildDirectoryContext& cur_dir = directories[i];
+        cur_dir.sibling = directories[cur_dir.parent].child;
+        directories[cur_dir.parent].child = i;
     }
 
-    std::multimap<u64, VirtualFile> out;
+    const auto dir_offset = [this](u32 index) {
+        return index == ROMFS_ENTRY_EMPTY ? ROMFS_ENTRY_EMPTY : directories[index].entry_offset;
+    };
+    const auto file_offset = [this](u32 index) {
+        return index == ROMFS_ENTRY_EMPTY ? ROMFS_ENTRY_EMPTY : files[index].entry_offset;
+    };
 
     // Populate file tables.
-    for (const auto& it : files) {
-        cur_file = it.second;
+    for (const RomFSBuildFileContext& cur_file : files) {
         RomFSFileEntry cur_entry{};
 
-        cur_entry.parent = cur_file->parent->entry_offset;
-        cur_entry.sibling =
-            cur_file->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_file->sibling->entry_offset;
-        cur_entry.offset = cur_file->offset;
-        cur_entry.size = cur_file->size;
+        cur_entry.parent = dir_offset(cur_file.parent);
+        cur_entry.sibling = file_offset(cur_file.sibling);
+        cur_entry.offset = cur_file.offset;
+        cur_entry.size = cur_file.size;
 
-        const auto name_size = cur_file->path_len - cur_file->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_file->parent->entry_offset, cur_file->path,
-                                               cur_file->cur_path_ofs, name_size);
+        const auto name_size = cur_file.path_len - cur_file.cur_path_ofs;
+        const auto hash = romfs_calc_path_hash(cur_entry.parent, cur_file.path,
+                                               cur_file.cur_path_ofs, name_size);
         cur_entry.hash = file_hash_table[hash % file_hash_table_entry_count];
-        file_hash_table[hash % file_hash_table_entry_count] = cur_file->entry_offset;
+        file_hash_table[hash % file_hash_table_entry_count] = cur_file.entry_offset;
 
         cur_entry.name_size = name_size;
 
-        out.emplace(cur_file->offset + ROMFS_FILEPARTITION_OFS, cur_file->source);
-        std::memcpy(file_table.data() + cur_file->entry_offset, &cur_entry, sizeof(RomFSFileEntry));
-        std::memset(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry), 0,
+        out.emplace(cur_file.offset + ROMFS_FILEPARTITION_OFS, cur_file.source);
+        std::memcpy(file_table.data() + cur_file.entry_offset, &cur_entry, sizeof(RomFSFileEntry));
+        std::memset(file_table.data() + cur_file.entry_offset + sizeof(RomFSFileEntry), 0,
                     Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry),
-                    cur_file->path.data() + cur_file->cur_path_ofs, name_size);
+        std::memcpy(file_table.data() + cur_file.entry_offset + sizeof(RomFSFileEntry),
+                    cur_file.path.data() + cur_file.cur_path_ofs, name_size);
     }
 
     // Populate dir tables.
-    for (const auto& it : directories) {
-        cur_dir = it.second;
+    for (u32 i = 0; i < directories.size(); ++i) {
+        const RomFSBuildDirectoryContext& cur_dir = directories[i];
         RomFSDirectoryEntry cur_entry{};
 
-        cur_entry.parent = cur_dir == root ? 0 : cur_dir->parent->entry_offset;
-        cur_entry.sibling =
-            cur_dir->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->sibling->entry_offset;
-        cur_entry.child =
-            cur_dir->child == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->child->entry_offset;
-        cur_entry.file = cur_dir->file == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->file->entry_offset;
+        cur_entry.parent = i == 0 ? 0 : dir_offset(cur_dir.parent);
+        cur_entry.sibling = dir_offset(cur_dir.sibling);
+        cur_entry.child = dir_offset(cur_dir.child);
+        cur_entry.file = file_offset(cur_dir.file);
 
-        const auto name_size = cur_dir->path_len - cur_dir->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_dir == root ? 0 : cur_dir->parent->entry_offset,
-                                               cur_dir->path, cur_dir->cur_path_ofs, name_size);
+        const auto name_size = cur_dir.path_len - cur_dir.cur_path_ofs;
+        const auto hash = romfs_calc_path_hash(cur_entry.parent, cur_dir.path,
+                                               cur_dir.cur_path_ofs, name_size);
         cur_entry.hash = dir_hash_table[hash % dir_hash_table_entry_count];
-        dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir->entry_offset;
+        dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir.entry_offset;
 
         cur_entry.name_size = name_size;
 
-        std::memcpy(dir_table.data() + cur_dir->entry_offset, &cur_entry,
+        std::memcpy(dir_table.data() + cur_dir.entry_offset, &cur_entry,
                     sizeof(RomFSDirectoryEntry));
-        std::memset(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry), 0,
+        std::memset(dir_table.data() + cur_dir.entry_offset + sizeof(RomFSDirectoryEntry), 0,
                     Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry),
-                    cur_dir->path.data() + cur_dir->cur_path_ofs, name_size);
+        std::memcpy(dir_table.data() + cur_dir.entry_offset + sizeof(RomFSDirectoryEntry),
+                    cur_dir.path.data() + cur_dir.cur_path_ofs, name_size);
     }
 
     // Set header fields.
@@ -368,7 +628,6 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
 
     std::vector<u8> header_data(sizeof(RomFSHeader));
     std::memcpy(header_data.data(), &header, header_data.size());
-    out.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
 
     std::vector<u8> metadata(file_hash_table_size + file_table_size + dir_hash_table_size +
                              dir_table_size);
@@ -381,6 +640,10 @@ std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
                 file_hash_table.size() * sizeof(u32));
     index += file_hash_table.size() * sizeof(u32);
     std::memcpy(metadata.data() + index, file_table.data(), file_table.size());
+
+    SaveCache(header_data, metadata);
+
+    out.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
     out.emplace(header.dir_hash_table_ofs, std::make_shared<VectorVfsFile>(std::move(metadata)));
 
     return out;
@@ -24,9 +24,10 @@
 
 #pragma once
 
+#include <filesystem>
 #include <map>
-#include <memory>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -34,38 +35,48 @@ namespace FileSys {
 
 struct RomFSBuildDirectoryContext;
 struct RomFSBuildFileContext;
-struct RomFSDirectoryEntry;
-struct RomFSFileEntry;
+struct RomFSBuildLayerEntry;
 
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
+
+    /**
+     * Builds a RomFS of directories stacked on top of each other.
+     * The layers are listed in parallel when the context is created.
+     *
+     * @param layers     Directories to merge, the first one has the highest priority
+     * @param ext_layers Directories of .stub files that remove entries of the layers and .ips
+     *                   files that patch them, the first one has the highest priority
+     * @param cache_path File that keeps the layout of the last build, keyed by a hash of the
+     *                   listings of the layers. An empty path disables the cache.
+     */
+    RomFSBuildContext(std::vector<VirtualDir> layers, std::vector<VirtualDir> ext_layers,
+                      std::filesystem::path cache_path = {});
     ~RomFSBuildContext();
 
     // This finalizes the context.
     std::multimap<u64, VirtualFile> Build();
 
 private:
-    VirtualDir base;
-    VirtualDir ext;
-    std::shared_ptr<RomFSBuildDirectoryContext> root;
-    std::map<std::string, std::shared_ptr<RomFSBuildDirectoryContext>, std::less<>> directories;
-    std::map<std::string, std::shared_ptr<RomFSBuildFileContext>, std::less<>> files;
-    u64 num_dirs = 0;
-    u64 num_files = 0;
+    using Listing = std::vector<RomFSBuildLayerEntry>;
+
+    std::vector<Listing> layers;
+    std::vector<Listing> ext_layers;
+    std::filesystem::path cache_path;
+    u64 key = 0;
+    std::vector<RomFSBuildDirectoryContext> directories;
+    std::vector<RomFSBuildFileContext> files;
     u64 dir_table_size = 0;
     u64 file_table_size = 0;
     u64 dir_hash_table_size = 0;
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
-    void VisitDirectory(VirtualDir filesys, VirtualDir ext_dir,
-                        std::shared_ptr<RomFSBuildDirectoryContext> parent);
+    void Merge();
 
-    bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                      std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx);
-    bool AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                 std::shared_ptr<RomFSBuildFileContext> file_ctx);
+    bool LoadCache(std::multimap<u64, VirtualFile>& out) const;
+    void SaveCache(const std::vector<u8>& header, const std::vector<u8>& metadata) const;
 };
 
 } // namespace FileSys
@@ -140,11 +140,12 @@ std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
 
     const auto block_offset = section_offset & 0xF;
     if (block_offset != 0) {
-        auto block = bktr_romfs->ReadBytes(0x10, section_offset & ~0xF);
-        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
+        std::array<u8, 0x10> block{};
+        const auto block_read = bktr_romfs->Read(block.data(), block.size(), section_offset & ~0xF);
+        cipher.Transcode(block.data(), block_read, block.data(), Core::Crypto::Op::Decrypt);
         if (length + block_offset < 0x10) {
-            std::memcpy(data, block.data() + block_offset, std::min(length, block.size()));
-            return std::min(length, block.size());
+            std::memcpy(data, block.data() + block_offset, std::min(length, block_read));
+            return std::min(length, block_read);
         }
 
         const auto read = 0x10 - block_offset;
@@ -7,6 +7,8 @@
 #include <cstddef>
 #include <cstring>
 
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -390,14 +392,16 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     layers.push_back(std::move(extracted));
 
-    auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
-    if (layered == nullptr) {
-        return;
+    // The layout of the merged RomFS is reused while the game and its mods don't change
+    std::filesystem::path cache_path;
+    const auto cache_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::CacheDir) / "layeredfs";
+    if (Common::FS::CreateDirs(cache_dir)) {
+        cache_path = cache_dir / fmt::format("{:016X}_{:02X}.bin", title_id, static_cast<u8>(type));
+    } else {
+        LOG_ERROR(Loader, "Failed to create directory={}", Common::FS::PathToUTF8String(cache_dir));
     }
 
-    auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
-
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    auto packed = CreateLayeredRomFS(std::move(layers), std::move(layers_ext), cache_path);
     if (packed == nullptr) {
         return;
     }
@@ -2,7 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/string_util.h"
@@ -12,7 +22,6 @@
 #include "core/file_sys/vfs.h"
 #include "core/file_sys/vfs_concat.h"
 #include "core/file_sys/vfs_offset.h"
-#include "core/file_sys/vfs_vector.h"
 
 namespace FileSys {
 namespace {
@@ -35,13 +44,14 @@ struct RomFSHeader {
 static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
 
 struct DirectoryEntry {
+    u32_le parent;
     u32_le sibling;
     u32_le child_dir;
     u32_le child_file;
     u32_le hash;
     u32_le name_length;
 };
-static_assert(sizeof(DirectoryEntry) == 0x14, "DirectoryEntry has incorrect size.");
+static_assert(sizeof(DirectoryEntry) == 0x18, "DirectoryEntry has incorrect size.");
 
 struct FileEntry {
     u32_le parent;
@@ -54,54 +64,332 @@ struct FileEntry {
 static_assert(sizeof(FileEntry) == 0x20, "FileEntry has incorrect size.");
 
 template <typename Entry>
-std::pair<Entry, std::string> GetEntry(const VirtualFile& file, std::size_t offset) {
-    Entry entry{};
-    if (file->ReadObject(&entry, offset) != sizeof(Entry))
-        return {};
-    std::string string(entry.name_length, '\0');
-    if (file->ReadArray(&string[0], string.size(), offset + sizeof(Entry)) != string.size())
-        return {};
-    return {entry, string};
+struct IndexedEntry {
+    Entry entry;
+    std::string_view name;
+};
+
+/// Hash of an entry name in the hash tables, chained with the offset of its parent directory
+u32 CalculatePathHash(u32 parent, std::string_view name) {
+    u32 hash = parent ^ 123456789;
+    for (const char c : name) {
+        hash = (hash >> 5) | (hash << 27);
+        hash ^= static_cast<u8>(c);
+    }
+    return hash;
 }
 
-void ProcessFile(VirtualFile file, std::size_t file_offset, std::size_t data_offset,
-                 u32 this_file_offset, std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<FileEntry>(file, file_offset + this_file_offset);
+bool IsAscii(std::string_view name) {
+    return std::all_of(name.begin(), name.end(), [](char c) { return static_cast<u8>(c) < 0x80; });
+}
 
-        parent->AddFile(std::make_shared<OffsetVfsFile>(
-            file, entry.first.size, entry.first.offset + data_offset, entry.second));
+/**
+ * The metadata tables of a RomFS image, shared by every directory of its view.
+ * Entries are looked up in the native hash tables of the image, nothing is built up front.
+ */
+class RomFSIndex {
+public:
+    static std::shared_ptr<const RomFSIndex> Open(VirtualFile file, const RomFSHeader& header) {
+        auto index = std::shared_ptr<RomFSIndex>(new RomFSIndex(std::move(file), header));
+        if (!index->Load(header)) {
+            return nullptr;
+        }
+        return index;
+    }
 
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
+    std::optional<IndexedEntry<DirectoryEntry>> GetDirectory(u32 offset) const {
+        return GetEntry<DirectoryEntry>(dir_table, offset);
+    }
 
-        this_file_offset = entry.first.sibling;
+    std::optional<IndexedEntry<FileEntry>> GetFile(u32 offset) const {
+        return GetEntry<FileEntry>(file_table, offset);
     }
-}
 
-void ProcessDirectory(VirtualFile file, std::size_t dir_offset, std::size_t file_offset,
-                      std::size_t data_offset, u32 this_dir_offset,
-                      std::shared_ptr<VectorVfsDirectory> parent) {
-    while (true) {
-        auto entry = GetEntry<DirectoryEntry>(file, dir_offset + this_dir_offset);
-        auto current = std::make_shared<VectorVfsDirectory>(
-            std::vector<VirtualFile>{}, std::vector<VirtualDir>{}, entry.second);
+    /// Returns the offset of the subdirectory name of the directory at parent
+    u32 FindDirectory(u32 parent, std::string_view name) const {
+        return Find<DirectoryEntry>(dir_hash, dir_table, parent, name);
+    }
 
-        if (entry.first.child_file != ROMFS_ENTRY_EMPTY) {
-            ProcessFile(file, file_offset, data_offset, entry.first.child_file, current);
+    /// Returns the offset of the file name in the directory at parent
+    u32 FindFile(u32 parent, std::string_view name) const {
+        return Find<FileEntry>(file_hash, file_table, parent, name);
+    }
+
+    VirtualFile MakeFile(const IndexedEntry<FileEntry>& file_entry) const {
+        return std::make_shared<OffsetVfsFile>(file, file_entry.entry.size,
+                                               file_entry.entry.offset + data_offset,
+                                               std::string(file_entry.name));
+    }
+
+private:
+    RomFSIndex(VirtualFile file_, const RomFSHeader& header)
+        : file(std::move(file_)), data_offset(header.data_offset) {}
+
+    bool Load(const RomFSHeader& header) {
+        // The tables are copied, views into a mapping would only be valid as long as the mapping
+        // the file hands out. Reads of a mapped image are plain copies.
+        const std::array locations{header.directory_hash, header.directory_meta, header.file_hash,
+                                   header.file_meta};
+        std::size_t storage_size = 0;
+        for (const TableLocation& location : locations) {
+            if (location.size > file->GetSize() ||
+                location.offset > file->GetSize() - location.size) {
+                return false;
+            }
+            storage_size += location.size;
         }
+        storage.resize(storage_size);
 
-        if (entry.first.child_dir != ROMFS_ENTRY_EMPTY) {
-            ProcessDirectory(file, dir_offset, file_offset, data_offset, entry.first.child_dir,
-                             current);
+        std::array<std::span<const u8>, 4> tables;
+        std::size_t storage_offset = 0;
+        for (std::size_t i = 0; i < locations.size(); ++i) {
+            u8* const out = storage.data() + storage_offset;
+            if (file->Read(out, locations[i].size, locations[i].offset) != locations[i].size) {
+                return false;
+            }
+            tables[i] = {out, static_cast<std::size_t>(locations[i].size)};
+            storage_offset += locations[i].size;
         }
+        dir_hash = tables[0];
+        dir_table = tables[1];
+        file_hash = tables[2];
+        file_table = tables[3];
+        return GetDirectory(0).has_value();
+    }
 
-        parent->AddDirectory(current);
-        if (entry.first.sibling == ROMFS_ENTRY_EMPTY)
-            break;
-        this_dir_offset = entry.first.sibling;
+    template <typename Entry>
+    static std::optional<IndexedEntry<Entry>> GetEntry(std::span<const u8> table, u32 offset) {
+        if (offset > table.size() || table.size() - offset < sizeof(Entry)) {
+            return std::nullopt;
+        }
+        Entry entry;
+        std::memcpy(&entry, table.data() + offset, sizeof(Entry));
+        if (table.size() - offset - sizeof(Entry) < entry.name_length) {
+            return std::nullopt;
+        }
+        const auto* const name =
+            reinterpret_cast<const char*>(table.data() + offset + sizeof(Entry));
+        return IndexedEntry<Entry>{entry, {name, entry.name_length}};
     }
-}
+
+    template <typename Entry>
+    u32 Find(std::span<const u8> hash_table, std::span<const u8> table, u32 parent,
+             std::string_view name) const {
+        const std::size_t bucket_count = hash_table.size() / sizeof(u32);
+        if (bucket_count == 0) {
+            return ROMFS_ENTRY_EMPTY;
+        }
+        const std::size_t bucket = CalculatePathHash(parent, name) % bucket_count;
+        u32 offset;
+        std::memcpy(&offset, hash_table.data() + bucket * sizeof(u32), sizeof(u32));
+
+        // Bounded so a corrupted chain can't loop forever
+        for (std::size_t i = 0; i < table.size() / sizeof(Entry) && offset != ROMFS_ENTRY_EMPTY;
+             ++i) {
+            const auto indexed = GetEntry<Entry>(table, offset);
+            if (!indexed) {
+                break;
+            }
+            if (indexed->entry.parent == parent && indexed->name == name) {
+                return offset;
+            }
+            offset = indexed->entry.hash;
+        }
+
+        // Builders running on hosts with a signed char hash names that aren't ASCII differently
+        if (!IsAscii(name)) {
+            return FindInChildren<Entry>(table, parent, name);
+        }
+        return ROMFS_ENTRY_EMPTY;
+    }
+
+    template <typename Entry>
+    u32 FindInChildren(std::span<const u8> table, u32 parent, std::string_view name) const {
+        const auto parent_entry = GetDirectory(parent);
+        if (!parent_entry) {
+            return ROMFS_ENTRY_EMPTY;
+        }
+        u32 offset = std::is_same_v<Entry, FileEntry> ? parent_entry->entry.child_file
+                                                      : parent_entry->entry.child_dir;
+        for (std::size_t i = 0; i < table.size() / sizeof(Entry) && offset != ROMFS_ENTRY_EMPTY;
+             ++i) {
+            const auto indexed = GetEntry<Entry>(table, offset);
+            if (!indexed) {
+                break;
+            }
+            if (indexed->name == name) {
+                return offset;
+            }
+            offset = indexed->entry.sibling;
+        }
+        return ROMFS_ENTRY_EMPTY;
+    }
+
+    VirtualFile file;
+    u64 data_offset;
+    std::vector<u8> storage;
+    std::span<const u8> dir_hash;
+    std::span<const u8> dir_table;
+    std::span<const u8> file_hash;
+    std::span<const u8> file_table;
+};
+
+/**
+ * A directory of a RomFS image. Its files and subdirectories are created when they are asked for,
+ * lookups by name or path go through the hash tables of the image.
+ */
+class RomFSVfsDirectory final : public ReadOnlyVfsDirectory {
+public:
+    RomFSVfsDirectory(std::shared_ptr<const RomFSIndex> index_, u32 entry_offset_,
+                      std::string name_)
+        : index(std::move(index_)), entry_offset(entry_offset_), name(std::move(name_)) {}
+
+    VirtualFile GetFileRelative(std::string_view path) const override {
+        const auto components = SplitPath(path);
+        if (components.empty()) {
+            return nullptr;
+        }
+        const u32 parent = Resolve({components.data(), components.size() - 1});
+        if (parent == ROMFS_ENTRY_EMPTY) {
+            return nullptr;
+        }
+        return MakeFile(index->FindFile(parent, components.back()));
+    }
+
+    VirtualDir GetDirectoryRelative(std::string_view path) const override {
+        const auto components = SplitPath(path);
+        if (components.empty()) {
+            return nullptr;
+        }
+        return MakeDirectory(Resolve(components));
+    }
+
+    VirtualFile GetFile(std::string_view file_name) const override {
+        return MakeFile(index->FindFile(entry_offset, file_name));
+    }
+
+    VirtualDir GetSubdirectory(std::string_view subdir_name) const override {
+        return MakeDirectory(index->FindDirectory(entry_offset, subdir_name));
+    }
+
+    std::vector<VirtualFile> GetFiles() const override {
+        std::vector<VirtualFile> out;
+        ForEachFile(
+            [&](const IndexedEntry<FileEntry>& file) { out.push_back(index->MakeFile(file)); });
+        return out;
+    }
+
+    std::vector<VirtualDir> GetSubdirectories() const override {
+        std::vector<VirtualDir> out;
+        ForEachDirectory([&](u32 offset, const IndexedEntry<DirectoryEntry>& dir) {
+            out.push_back(
+                std::make_shared<RomFSVfsDirectory>(index, offset, std::string(dir.name)));
+        });
+        return out;
+    }
+
+    std::map<std::string, VfsEntryType, std::less<>> GetEntries() const override {
+        std::map<std::string, VfsEntryType, std::less<>> out;
+        ForEachDirectory([&](u32, const IndexedEntry<DirectoryEntry>& dir) {
+            out.emplace(dir.name, VfsEntryType::Directory);
+        });
+        ForEachFile([&](const IndexedEntry<FileEntry>& file) {
+            out.emplace(file.name, VfsEntryType::File);
+        });
+        return out;
+    }
+
+    std::string GetName() const override {
+        return name;
+    }
+
+    VirtualDir GetParentDirectory() const override {
+        // Like the directories of other containers, the root has no parent
+        if (entry_offset == 0) {
+            return nullptr;
+        }
+        return MakeDirectory(index->GetDirectory(entry_offset)->entry.parent);
+    }
+
+private:
+    static std::vector<std::string_view> SplitPath(std::string_view path) {
+        std::vector<std::string_view> components;
+        while (!path.empty()) {
+            const std::size_t separator = path.find_first_of("/\\");
+            if (separator != 0) {
+                components.push_back(path.substr(0, separator));
+            }
+            if (separator == std::string_view::npos) {
+                break;
+            }
+            path.remove_prefix(separator + 1);
+        }
+        return components;
+    }
+
+    /// Returns the offset of the directory at the relative path, ROMFS_ENTRY_EMPTY if it is missing
+    u32 Resolve(std::span<const std::string_view> components) const {
+        u32 offset = entry_offset;
+        for (const std::string_view component : components) {
+            offset = index->FindDirectory(offset, component);
+            if (offset == ROMFS_ENTRY_EMPTY) {
+                break;
+            }
+        }
+        return offset;
+    }
+
+    VirtualFile MakeFile(u32 offset) const {
+        if (offset == ROMFS_ENTRY_EMPTY) {
+            return nullptr;
+        }
+        const auto file = index->GetFile(offset);
+        return file ? index->MakeFile(*file) : nullptr;
+    }
+
+    VirtualDir MakeDirectory(u32 offset) const {
+        if (offset == ROMFS_ENTRY_EMPTY) {
+            return nullptr;
+        }
+        const auto dir = index->GetDirectory(offset);
+        if (!dir) {
+            return nullptr;
+        }
+        return std::make_shared<RomFSVfsDirectory>(index, offset, std::string(dir->name));
+    }
+
+    template <typename Func>
+    void ForEachFile(Func&& func) const {
+        const auto dir = index->GetDirectory(entry_offset);
+        u32 offset = dir ? u32{dir->entry.child_file} : ROMFS_ENTRY_EMPTY;
+        while (offset != ROMFS_ENTRY_EMPTY) {
+            const auto file = index->GetFile(offset);
+            if (!file) {
+                break;
+            }
+            func(*file);
+            offset = file->entry.sibling;
+        }
+    }
+
+    template <typename Func>
+    void ForEachDirectory(Func&& func) const {
+        const auto dir = index->GetDirectory(entry_offset);
+        u32 offset = dir ? u32{dir->entry.child_dir} : ROMFS_ENTRY_EMPTY;
+        while (offset != ROMFS_ENTRY_EMPTY) {
+            const auto child = index->GetDirectory(offset);
+            if (!child) {
+                break;
+            }
+            func(offset, *child);
+            offset = child->entry.sibling;
+        }
+    }
+
+    std::shared_ptr<const RomFSIndex> index;
+    u32 entry_offset;
+    std::string name;
+};
 } // Anonymous namespace
 
 VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
@@ -112,19 +400,19 @@ VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
     if (header.header_size != sizeof(RomFSHeader))
         return nullptr;
 
-    const u64 file_offset = header.file_meta.offset;
-    const u64 dir_offset = header.directory_meta.offset + 4;
-
-    auto root =
-        std::make_shared<VectorVfsDirectory>(std::vector<VirtualFile>{}, std::vector<VirtualDir>{},
-                                             file->GetName(), file->GetContainingDirectory());
+    const auto index = RomFSIndex::Open(file, header);
+    if (index == nullptr)
+        return nullptr;
 
-    ProcessDirectory(file, dir_offset, file_offset, header.data_offset, 0, root);
+    // The game reads its files in no particular order
+    const std::size_t data_offset = std::min<std::size_t>(header.data_offset, file->GetSize());
+    file->AdviseAccess(Common::FS::AccessPattern::Random, data_offset,
+                       file->GetSize() - data_offset);
 
-    VirtualDir out = std::move(root);
+    VirtualDir out = std::make_shared<RomFSVfsDirectory>(index, 0, "");
 
     if (type == RomFSExtractionType::SingleDiscard)
-        return out->GetSubdirectories().front();
+        return out;
 
     while (out->GetSubdirectories().size() == 1 && out->GetFiles().empty()) {
         if (Common::ToLower(out->GetSubdirectories().front()->GetName()) == "data" &&
@@ -144,4 +432,14 @@ VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
     return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), dir->GetName());
 }
 
+VirtualFile CreateLayeredRomFS(std::vector<VirtualDir> layers, std::vector<VirtualDir> ext_layers,
+                               const std::filesystem::path& cache_path) {
+    if (layers.empty())
+        return nullptr;
+
+    auto name = layers.back()->GetName();
+    RomFSBuildContext ctx{std::move(layers), std::move(ext_layers), cache_path};
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), std::move(name));
+}
+
 } // namespace FileSys
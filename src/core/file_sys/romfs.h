@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <filesystem>
+#include <vector>
+
 #include "core/file_sys/vfs.h"
 
 namespace FileSys {
@@ -23,4 +26,11 @@ VirtualDir ExtractRomFS(VirtualFile file,
 // Returns nullptr on failure
 VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
 
+// Converts VFS directories stacked on top of each other into a RomFS binary, the first layer has
+// the highest priority. The layout is kept in cache_path and reused while the listings of the
+// layers don't change, an empty path disables the cache.
+// Returns nullptr on failure
+VirtualFile CreateLayeredRomFS(std::vector<VirtualDir> layers, std::vector<VirtualDir> ext_layers,
+                               const std::filesystem::path& cache_path = {});
+
 } // namespace FileSys
@@ -185,6 +185,13 @@ std::vector<u8> VfsFile::ReadAllBytes() const {
     return ReadBytes(GetSize());
 }
 
+std::span<const u8> VfsFile::GetMappedData() const {
+    return {};
+}
+
+void VfsFile::AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                           std::size_t length) const {}
+
 bool VfsFile::WriteByte(u8 data, std::size_t offset) {
     return Write(&data, 1, offset) == 1;
 }
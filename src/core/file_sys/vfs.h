@@ -8,12 +8,14 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/fs/fs_types.h"
 #include "core/file_sys/vfs_types.h"
 
 namespace FileSys {
@@ -113,6 +115,15 @@ public:
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
 
+    // Returns the contents of the file if they are mapped in host memory, or an empty span if they
+    // are not. The span stays valid while the file is alive and isn't written to or resized through
+    // any handle.
+    virtual std::span<const u8> GetMappedData() const;
+    // Hints the backing storage how length bytes starting at offset are about to be read. Files
+    // that can't make use of the hint ignore it.
+    virtual void AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                              std::size_t length) const;
+
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
     template <typename T>
@@ -0,0 +1,239 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "core/file_sys/vfs_cached.h"
+
+namespace FileSys {
+
+BlockCache::BlockCache(std::size_t capacity_) : capacity{capacity_} {}
+
+BlockCache::~BlockCache() = default;
+
+u64 BlockCache::NewFileId() {
+    return next_file_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool BlockCache::Read(u64 file_id, u64 block, std::size_t block_offset, std::span<u8> out) {
+    const Key key{file_id, block};
+    Shard& shard = GetShard(key);
+    {
+        std::scoped_lock lock{shard.mutex};
+        const auto it = shard.map.find(key);
+        if (it != shard.map.end() && it->second->data.size() >= block_offset + out.size()) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            std::memcpy(out.data(), it->second->data.data() + block_offset, out.size());
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void BlockCache::Insert(u64 file_id, u64 block, std::span<const u8> data) {
+    const std::size_t budget = capacity.load(std::memory_order_relaxed) / NUM_SHARDS;
+    if (data.size() > budget) {
+        return;
+    }
+    const Key key{file_id, block};
+    Shard& shard = GetShard(key);
+    std::scoped_lock lock{shard.mutex};
+    if (shard.map.contains(key)) {
+        // Another reader missed on the same block and cached it first
+        return;
+    }
+    std::vector<u8> storage = Evict(shard, budget - data.size());
+    storage.assign(data.begin(), data.end());
+    shard.lru.push_front(Entry{key, std::move(storage)});
+    shard.map.emplace(key, shard.lru.begin());
+    shard.size += data.size();
+    total_size.fetch_add(data.size(), std::memory_order_relaxed);
+}
+
+void BlockCache::SetCapacity(std::size_t capacity_) {
+    capacity.store(capacity_, std::memory_order_relaxed);
+    for (Shard& shard : shards) {
+        std::scoped_lock lock{shard.mutex};
+        Evict(shard, capacity_ / NUM_SHARDS);
+    }
+}
+
+void BlockCache::Clear() {
+    for (Shard& shard : shards) {
+        std::scoped_lock lock{shard.mutex};
+        shard.map.clear();
+        shard.lru.clear();
+        total_size.fetch_sub(shard.size, std::memory_order_relaxed);
+        shard.size = 0;
+    }
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+    evictions.store(0, std::memory_order_relaxed);
+}
+
+BlockCache::Stats BlockCache::GetStats() const {
+    return {
+        .hits = hits.load(std::memory_order_relaxed),
+        .misses = misses.load(std::memory_order_relaxed),
+        .evictions = evictions.load(std::memory_order_relaxed),
+        .size = total_size.load(std::memory_order_relaxed),
+    };
+}
+
+BlockCache::Shard& BlockCache::GetShard(const Key& key) {
+    // Consecutive blocks of a file land in different shards
+    return shards[(key.file_id + key.block) % NUM_SHARDS];
+}
+
+std::vector<u8> BlockCache::Evict(Shard& shard, std::size_t budget) {
+    std::vector<u8> storage;
+    while (shard.size > budget) {
+        Entry& entry = shard.lru.back();
+        shard.size -= entry.data.size();
+        total_size.fetch_sub(entry.data.size(), std::memory_order_relaxed);
+        shard.map.erase(entry.key);
+        storage = std::move(entry.data);
+        shard.lru.pop_back();
+        evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return storage;
+}
+
+CachedVfsFile::CachedVfsFile(VirtualFile file_, BlockCache& cache_)
+    : file(std::move(file_)), cache(cache_), file_id(cache.NewFileId()), size(file->GetSize()) {}
+
+CachedVfsFile::~CachedVfsFile() = default;
+
+std::string CachedVfsFile::GetName() const {
+    return file->GetName();
+}
+
+std::size_t CachedVfsFile::GetSize() const {
+    return size;
+}
+
+bool CachedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+VirtualDir CachedVfsFile::GetContainingDirectory() const {
+    return file->GetContainingDirectory();
+}
+
+bool CachedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool CachedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t CachedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (offset >= size) {
+        return 0;
+    }
+    length = std::min(length, size - offset);
+    if (!cache.IsEnabled()) {
+        return file->Read(data, length, offset);
+    }
+
+    constexpr std::size_t block_size = BlockCache::BLOCK_SIZE;
+    const std::size_t end = offset + length;
+    const u64 last_block = (end + block_size - 1) / block_size;
+
+    // Whole blocks that missed are read from the file in runs, straight into the output
+    u64 run_first = 0;
+    u64 run_last = 0;
+    const auto flush_run = [&] {
+        const bool success = run_first == run_last || ReadRun(data, offset, run_first, run_last);
+        run_first = run_last = 0;
+        return success;
+    };
+
+    for (u64 block = offset / block_size; block < last_block; ++block) {
+        const std::size_t block_begin = block * block_size;
+        const std::size_t block_end = std::min(block_begin + block_size, size);
+        const std::size_t copy_begin = std::max(block_begin, offset);
+        const std::size_t copy_end = std::min(block_end, end);
+        const std::span<u8> out{data + (copy_begin - offset), copy_end - copy_begin};
+        if (cache.Read(file_id, block, copy_begin - block_begin, out)) {
+            if (!flush_run()) {
+                return 0;
+            }
+            continue;
+        }
+        if (block_begin >= offset && block_end <= end) {
+            if (run_first == run_last) {
+                run_first = block;
+            }
+            run_last = block + 1;
+            continue;
+        }
+        if (!flush_run() || !ReadPartial(data, offset, end, block)) {
+            // Fall back to the wrapped file to report how much it can read
+            return file->Read(data, length, offset);
+        }
+    }
+    if (!flush_run()) {
+        return file->Read(data, length, offset);
+    }
+    return length;
+}
+
+std::size_t CachedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+std::span<const u8> CachedVfsFile::GetMappedData() const {
+    // Copying out of a mapping is as cheap as a hit, there is nothing to cache
+    return file->GetMappedData();
+}
+
+void CachedVfsFile::AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                                 std::size_t length) const {
+    file->AdviseAccess(pattern, offset, length);
+}
+
+bool CachedVfsFile::Rename(std::string_view name) {
+    return false;
+}
+
+bool CachedVfsFile::ReadRun(u8* data, std::size_t offset, u64 first, u64 last) const {
+    constexpr std::size_t block_size = BlockCache::BLOCK_SIZE;
+    const std::size_t run_begin = first * block_size;
+    const std::size_t run_size = std::min(last * block_size, size) - run_begin;
+    u8* const run_data = data + (run_begin - offset);
+    if (file->Read(run_data, run_size, run_begin) != run_size) {
+        return false;
+    }
+    for (u64 block = first; block < last; ++block) {
+        const std::size_t block_offset = (block - first) * block_size;
+        cache.Insert(file_id, block,
+                     {run_data + block_offset, std::min(block_size, run_size - block_offset)});
+    }
+    return true;
+}
+
+bool CachedVfsFile::ReadPartial(u8* data, std::size_t offset, std::size_t end, u64 block) const {
+    constexpr std::size_t block_size = BlockCache::BLOCK_SIZE;
+    const std::size_t block_begin = block * block_size;
+    const std::size_t block_length = std::min(block_size, size - block_begin);
+    std::array<u8, block_size> buffer;
+    if (file->Read(buffer.data(), block_length, block_begin) != block_length) {
+        return false;
+    }
+    cache.Insert(file_id, block, {buffer.data(), block_length});
+
+    const std::size_t copy_begin = std::max(block_begin, offset);
+    const std::size_t copy_end = std::min(block_begin + block_length, end);
+    std::memcpy(data + (copy_begin - offset), buffer.data() + (copy_begin - block_begin),
+                copy_end - copy_begin);
+    return true;
+}
+
+} // namespace FileSys
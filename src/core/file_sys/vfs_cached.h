@@ -0,0 +1,148 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// Bounded LRU cache of file blocks, shared by every CachedVfsFile. Blocks are spread over shards
+// that are locked separately, so readers of different blocks rarely contend.
+class BlockCache {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 0x4000;
+
+    struct Stats {
+        u64 hits;
+        u64 misses;
+        u64 evictions;
+        std::size_t size; ///< Bytes of block data held by the cache
+    };
+
+    explicit BlockCache(std::size_t capacity_ = 0);
+    ~BlockCache();
+
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    BlockCache(BlockCache&&) = delete;
+    BlockCache& operator=(BlockCache&&) = delete;
+
+    /// Cache used by the emulated file system, its budget is set from the settings on boot
+    static BlockCache& Instance() {
+        static BlockCache instance;
+        return instance;
+    }
+
+    /// Returns an identity for a new cached file, identities are never reused
+    u64 NewFileId();
+
+    /**
+     * Copies part of a cached block.
+     * @return False on a miss, or when the block is shorter than the requested range
+     */
+    bool Read(u64 file_id, u64 block, std::size_t block_offset, std::span<u8> out);
+
+    /// Caches a block, evicting the least recently used blocks of its shard to fit the budget
+    void Insert(u64 file_id, u64 block, std::span<const u8> data);
+
+    /// Changes the budget in bytes, zero disables the cache
+    void SetCapacity(std::size_t capacity_);
+
+    /// Drops every block and resets the counters
+    void Clear();
+
+    bool IsEnabled() const {
+        return capacity.load(std::memory_order_relaxed) != 0;
+    }
+
+    Stats GetStats() const;
+
+private:
+    static constexpr std::size_t NUM_SHARDS = 16;
+
+    struct Key {
+        u64 file_id;
+        u64 block;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const {
+            return static_cast<std::size_t>((key.file_id * 0x9E3779B97F4A7C15ULL) ^ key.block);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<u8> data;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru; ///< Most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> map;
+        std::size_t size = 0;
+    };
+
+    Shard& GetShard(const Key& key);
+
+    /// Evicts blocks from the back of a shard until it fits in the budget, keeping one for reuse
+    std::vector<u8> Evict(Shard& shard, std::size_t budget);
+
+    std::array<Shard, NUM_SHARDS> shards;
+    std::atomic<std::size_t> capacity;
+    std::atomic<u64> next_file_id{0};
+    std::atomic<u64> hits{0};
+    std::atomic<u64> misses{0};
+    std::atomic<u64> evictions{0};
+    std::atomic<std::size_t> total_size{0};
+};
+
+// A read-only VfsFile that keeps the blocks read from the wrapped file in a BlockCache. Wrapping a
+// decrypting layer caches decrypted data, so repeated reads skip both the disk and the cipher.
+class CachedVfsFile : public VfsFile {
+public:
+    explicit CachedVfsFile(VirtualFile file_, BlockCache& cache_ = BlockCache::Instance());
+    ~CachedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    VirtualDir GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetMappedData() const override;
+    void AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                      std::size_t length) const override;
+    bool Rename(std::string_view name) override;
+
+private:
+    /// Reads the whole blocks [first, last) from the wrapped file into place and caches them
+    bool ReadRun(u8* data, std::size_t offset, u64 first, u64 last) const;
+
+    /// Reads a block that the request covers only partially and caches it
+    bool ReadPartial(u8* data, std::size_t offset, std::size_t end, u64 block) const;
+
+    VirtualFile file;
+    BlockCache& cache;
+    u64 file_id;
+    std::size_t size;
+};
+
+} // namespace FileSys
@@ -73,6 +73,22 @@ std::vector<u8> OffsetVfsFile::ReadAllBytes() const {
     return file->ReadBytes(size, offset);
 }
 
+std::span<const u8> OffsetVfsFile::GetMappedData() const {
+    const std::span<const u8> mapped = file->GetMappedData();
+    if (mapped.size() < offset + size) {
+        return {};
+    }
+    return mapped.subspan(offset, size);
+}
+
+void OffsetVfsFile::AdviseAccess(Common::FS::AccessPattern pattern, std::size_t r_offset,
+                                 std::size_t length) const {
+    if (r_offset >= size) {
+        return;
+    }
+    file->AdviseAccess(pattern, offset + r_offset, TrimToFit(length, r_offset));
+}
+
 bool OffsetVfsFile::WriteByte(u8 data, std::size_t r_offset) {
     if (r_offset < size)
         return file->WriteByte(data, offset + r_offset);
@@ -5,10 +5,13 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <mutex>
+#include <shared_mutex>
 #include <utility>
 #include "common/assert.h"
 #include "common/fs/file.h"
 #include "common/fs/fs.h"
+#include "common/fs/mapped_file.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "core/file_sys/vfs_real.h"
@@ -35,8 +38,22 @@ constexpr FS::FileAccessMode ModeFlagsToFileAccessMode(Mode mode) {
     }
 }
 
+/// Reads of mapped files at least this large page in their whole range ahead of the copy, so they
+/// don't fault one page at a time in ranges advised as random
+constexpr std::size_t MAPPED_PREFETCH_THRESHOLD = 0x40000;
+
 } // Anonymous namespace
 
+struct RealVfsFilesystem::Mapping {
+    explicit Mapping(const std::string& path) : file{path} {}
+
+    FS::MappedFile file;
+    /// Held shared while the mapping is read, held exclusively to invalidate it
+    std::shared_mutex mutex;
+    /// Cleared before the file is written or resized, the mapping may no longer match the file
+    bool is_valid = true;
+};
+
 RealVfsFilesystem::RealVfsFilesystem() : VfsFilesystem(nullptr) {}
 RealVfsFilesystem::~RealVfsFilesystem() = default;
 
@@ -65,13 +82,18 @@ VfsEntryType RealVfsFilesystem::GetEntryType(std::string_view path_) const {
 }
 
 VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
+    std::scoped_lock lock{mutex};
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
 
     if (const auto weak_iter = cache.find(path); weak_iter != cache.cend()) {
         const auto& weak = weak_iter->second;
 
-        if (!weak.expired()) {
-            return std::shared_ptr<RealVfsFile>(new RealVfsFile(*this, weak.lock(), path, perms));
+        if (auto backing = weak.lock()) {
+            // Writes through the shared handle may still be buffered, a new mapping must see them
+            backing->Flush();
+            auto mapping = OpenMapping(path, perms);
+            return std::shared_ptr<RealVfsFile>(
+                new RealVfsFile(*this, std::move(backing), std::move(mapping), path, perms));
         }
     }
 
@@ -84,13 +106,15 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
     cache.insert_or_assign(path, std::move(backing));
 
     // Cannot use make_shared as RealVfsFile constructor is private
-    return std::shared_ptr<RealVfsFile>(new RealVfsFile(*this, backing, path, perms));
+    return std::shared_ptr<RealVfsFile>(
+        new RealVfsFile(*this, backing, OpenMapping(path, perms), path, perms));
 }
 
 VirtualFile RealVfsFilesystem::CreateFile(std::string_view path_, Mode perms) {
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
     // Current usages of CreateFile expect to delete the contents of an existing file.
     if (FS::IsFile(path)) {
+        InvalidateMapping(path);
         FS::IOFile temp{path, FS::FileAccessMode::Write, FS::FileType::BinaryFile};
 
         if (!temp.IsOpen()) {
@@ -115,6 +139,7 @@ VirtualFile RealVfsFilesystem::CopyFile(std::string_view old_path_, std::string_
 }
 
 VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_view new_path_) {
+    std::scoped_lock lock{mutex};
     const auto old_path = FS::SanitizePath(old_path_, FS::DirectorySeparator::PlatformDefault);
     const auto new_path = FS::SanitizePath(new_path_, FS::DirectorySeparator::PlatformDefault);
     const auto cached_file_iter = cache.find(old_path);
@@ -125,6 +150,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
         if (!cached_file_iter->second.expired()) {
             file->Close();
         }
+        DropMapping(old_path);
 
         if (!FS::RenameFile(old_path, new_path)) {
             return nullptr;
@@ -146,6 +172,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
 }
 
 bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
+    std::scoped_lock lock{mutex};
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
     const auto cached_iter = cache.find(path);
 
@@ -155,6 +182,7 @@ bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
         }
         cache.erase(path);
     }
+    DropMapping(path);
 
     return FS::RemoveFile(path);
 }
@@ -182,9 +210,12 @@ VirtualDir RealVfsFilesystem::CopyDirectory(std::string_view old_path_,
 
 VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
                                             std::string_view new_path_) {
+    std::scoped_lock lock{mutex};
     const auto old_path = FS::SanitizePath(old_path_, FS::DirectorySeparator::PlatformDefault);
     const auto new_path = FS::SanitizePath(new_path_, FS::DirectorySeparator::PlatformDefault);
 
+    DropMappings(old_path);
+
     if (!FS::RenameDir(old_path, new_path)) {
         return nullptr;
     }
@@ -219,6 +250,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
 }
 
 bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
+    std::scoped_lock lock{mutex};
     const auto path = FS::SanitizePath(path_, FS::DirectorySeparator::PlatformDefault);
 
     for (auto& kv : cache) {
@@ -234,14 +266,71 @@ bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
 
         cache.erase(kv.first);
     }
+    DropMappings(path);
 
     return FS::RemoveDirRecursively(path);
 }
 
+std::shared_ptr<RealVfsFilesystem::Mapping> RealVfsFilesystem::OpenMapping(const std::string& path,
+                                                                           Mode perms) {
+    // Files that may be written or resized can't be mapped safely
+    if (perms != Mode::Read) {
+        return nullptr;
+    }
+
+    if (const auto weak_iter = mappings.find(path); weak_iter != mappings.cend()) {
+        if (auto mapping = weak_iter->second.lock(); mapping && mapping->file.IsOpen()) {
+            return mapping;
+        }
+    }
+
+    auto mapping = std::make_shared<Mapping>(path);
+    if (!mapping->file.IsOpen()) {
+        // Empty files can't be mapped, they are read through the file handle instead
+        mappings.erase(path);
+        return nullptr;
+    }
+
+    mappings.insert_or_assign(path, mapping);
+    return mapping;
+}
+
+void RealVfsFilesystem::DropMapping(const std::string& path) {
+    std::scoped_lock lock{mutex};
+    mappings.erase(path);
+}
+
+void RealVfsFilesystem::DropMappings(const std::string& path) {
+    std::scoped_lock lock{mutex};
+    for (auto iter = mappings.begin(); iter != mappings.end();) {
+        if (iter->first.rfind(path, 0) == 0) {
+            iter = mappings.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void RealVfsFilesystem::InvalidateMapping(const std::string& path) {
+    std::scoped_lock lock{mutex};
+    const auto iter = mappings.find(path);
+    if (iter == mappings.end()) {
+        return;
+    }
+    if (const auto mapping = iter->second.lock()) {
+        std::unique_lock mapping_lock{mapping->mutex};
+        mapping->is_valid = false;
+    }
+    mappings.erase(iter);
+}
+
 RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<FS::IOFile> backing_,
-                         const std::string& path_, Mode perms_)
-    : base(base_), backing(std::move(backing_)), path(path_), parent_path(FS::GetParentPath(path_)),
-      path_components(FS::SplitPathComponents(path_)), perms(perms_) {}
+                         std::shared_ptr<RealVfsFilesystem::Mapping> mapping_,
+                         const std::string& path_,
+                         Mode perms_)
+    : base(base_), backing(std::move(backing_)), mapping(std::move(mapping_)), path(path_),
+      parent_path(FS::GetParentPath(path_)), path_components(FS::SplitPathComponents(path_)),
+      perms(perms_) {}
 
 RealVfsFile::~RealVfsFile() = default;
 
@@ -250,10 +339,17 @@ std::string RealVfsFile::GetName() const {
 }
 
 std::size_t RealVfsFile::GetSize() const {
+    if (mapping) {
+        std::shared_lock lock{mapping->mutex};
+        if (mapping->is_valid) {
+            return mapping->file.GetSize();
+        }
+    }
     return backing->GetSize();
 }
 
 bool RealVfsFile::Resize(std::size_t new_size) {
+    base.InvalidateMapping(path);
     return backing->SetSize(new_size);
 }
 
@@ -270,6 +366,16 @@ bool RealVfsFile::IsReadable() const {
 }
 
 std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    if (mapping) {
+        // The file can't be truncated while the mapping is being read
+        std::shared_lock lock{mapping->mutex};
+        if (mapping->is_valid) {
+            if (length >= MAPPED_PREFETCH_THRESHOLD) {
+                mapping->file.Advise(FS::AccessPattern::WillNeed, offset, length);
+            }
+            return mapping->file.Read(std::span{data, length}, offset);
+        }
+    }
     if (!backing->Seek(static_cast<s64>(offset))) {
         return 0;
     }
@@ -277,12 +383,33 @@ std::size_t RealVfsFile::Read(u8* data, std::size_t length, std::size_t offset)
 }
 
 std::size_t RealVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    // Mappings don't follow the file, files holding one read through the file handle from now on
+    base.InvalidateMapping(path);
     if (!backing->Seek(static_cast<s64>(offset))) {
         return 0;
     }
     return backing->WriteSpan(std::span{data, length});
 }
 
+std::span<const u8> RealVfsFile::GetMappedData() const {
+    if (!mapping) {
+        return {};
+    }
+    std::shared_lock lock{mapping->mutex};
+    return mapping->is_valid ? mapping->file.GetSpan() : std::span<const u8>{};
+}
+
+void RealVfsFile::AdviseAccess(FS::AccessPattern pattern, std::size_t offset,
+                               std::size_t length) const {
+    if (!mapping) {
+        return;
+    }
+    std::shared_lock lock{mapping->mutex};
+    if (mapping->is_valid) {
+        mapping->file.Advise(pattern, offset, length);
+    }
+}
+
 bool RealVfsFile::Rename(std::string_view name) {
     return base.MoveFile(path, parent_path + '/' + std::string(name)) != nullptr;
 }
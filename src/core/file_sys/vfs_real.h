@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string_view>
 #include <boost/container/flat_map.hpp>
 #include "core/file_sys/mode.h"
@@ -11,11 +13,14 @@
 
 namespace Common::FS {
 class IOFile;
-}
+class MappedFile;
+} // namespace Common::FS
 
 namespace FileSys {
 
 class RealVfsFilesystem : public VfsFilesystem {
+    friend class RealVfsFile;
+
 public:
     RealVfsFilesystem();
     ~RealVfsFilesystem() override;
@@ -36,10 +41,34 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
+    /// Mapping of a file shared by all the files opened for reading on its path
+    struct Mapping;
+
+    /// Returns the shared mapping of a file opened for reading only, nullptr if it can't be mapped
+    std::shared_ptr<Mapping> OpenMapping(const std::string& path, Mode perms);
+
+    /// Stops sharing the mapping of a file that is renamed or deleted. Files already holding the
+    /// mapping keep reading the old contents, files opened afterwards map the file again.
+    void DropMapping(const std::string& path);
+
+    /// Stops sharing the mappings of every file under a directory
+    void DropMappings(const std::string& path);
+
+    /// Invalidates the mapping of a file that is about to be written, resized or truncated.
+    /// Files holding the mapping wait for their reads in flight and then read through the file
+    /// handle, so they never touch pages past the new end of the file.
+    void InvalidateMapping(const std::string& path);
+
+    /// Guards the caches, files may be opened from several threads at once
+    std::recursive_mutex mutex;
     boost::container::flat_map<std::string, std::weak_ptr<Common::FS::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<Mapping>> mappings;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
+// Files opened for reading only are mapped into memory, reads of them are copies out of the
+// mapping instead of a seek and a read on the shared file handle. Once the file is written or
+// resized through any handle, reads go through the file handle again.
 class RealVfsFile : public VfsFile {
     friend class RealVfsDirectory;
     friend class RealVfsFilesystem;
@@ -55,16 +84,21 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetMappedData() const override;
+    void AdviseAccess(Common::FS::AccessPattern pattern, std::size_t offset,
+                      std::size_t length) const override;
     bool Rename(std::string_view name) override;
 
 private:
     RealVfsFile(RealVfsFilesystem& base, std::shared_ptr<Common::FS::IOFile> backing,
-                const std::string& path, Mode perms = Mode::Read);
+                std::shared_ptr<RealVfsFilesystem::Mapping> mapping, const std::string& path,
+                Mode perms = Mode::Read);
 
     void Close();
 
     RealVfsFilesystem& base;
     std::shared_ptr<Common::FS::IOFile> backing;
+    std::shared_ptr<RealVfsFilesystem::Mapping> mapping;
     std::string path;
     std::string parent_path;
     std::vector<std::string> path_components;
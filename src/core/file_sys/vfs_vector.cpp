@@ -51,6 +51,10 @@ std::size_t VectorVfsFile::Write(const u8* data_, std::size_t length, std::size_
     return write;
 }
 
+std::span<const u8> VectorVfsFile::GetMappedData() const {
+    return data;
+}
+
 bool VectorVfsFile::Rename(std::string_view name_) {
     name = name_;
     return true;
@@ -87,6 +87,7 @@ public:
     bool IsReadable() const override;
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
     std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    std::span<const u8> GetMappedData() const override;
     bool Rename(std::string_view name) override;
 
     virtual void Assign(std::vector<u8> new_data);
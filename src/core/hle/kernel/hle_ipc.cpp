@@ -263,6 +263,51 @@ std::vector<u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
     return buffer;
 }
 
+std::span<const u8> HLERequestContext::ReadBufferSpan(std::size_t buffer_index) {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    VAddr address;
+    std::size_t size;
+    if (is_buffer_a) {
+        address = BufferDescriptorA()[buffer_index].Address();
+        size = BufferDescriptorA()[buffer_index].Size();
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorX().size() > buffer_index, { return {}; },
+            "BufferDescriptorX invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorX()[buffer_index].Address();
+        size = BufferDescriptorX()[buffer_index].Size();
+    }
+    if (size == 0) {
+        return {};
+    }
+    if (const u8* const pointer = memory.GetReadPointer(address, size)) {
+        return {pointer, size};
+    }
+    std::vector<u8>& buffer = read_buffer_copies.emplace_back(size);
+    memory.ReadBlock(address, buffer.data(), size);
+    return buffer;
+}
+
+std::span<u8> HLERequestContext::WriteBufferSpan(std::size_t buffer_index) const {
+    const bool is_buffer_b{BufferDescriptorB().size() > buffer_index &&
+                           BufferDescriptorB()[buffer_index].Size()};
+    VAddr address;
+    std::size_t size;
+    if (is_buffer_b) {
+        address = BufferDescriptorB()[buffer_index].Address();
+        size = BufferDescriptorB()[buffer_index].Size();
+    } else {
+        ASSERT_OR_EXECUTE_MSG(
+            BufferDescriptorC().size() > buffer_index, { return {}; },
+            "BufferDescriptorC invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorC()[buffer_index].Address();
+        size = BufferDescriptorC()[buffer_index].Size();
+    }
+    u8* const pointer = memory.GetWritePointer(address, size);
+    return pointer ? std::span<u8>{pointer, size} : std::span<u8>{};
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
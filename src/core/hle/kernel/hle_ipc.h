@@ -8,10 +8,13 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/concepts.h"
@@ -241,20 +244,20 @@ public:
         return data_payload_offset;
     }
 
-    const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
-        return buffer_x_desciptors;
+    std::span<const IPC::BufferDescriptorX> BufferDescriptorX() const {
+        return {buffer_x_desciptors.data(), buffer_x_desciptors.size()};
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
-        return buffer_a_desciptors;
+    std::span<const IPC::BufferDescriptorABW> BufferDescriptorA() const {
+        return {buffer_a_desciptors.data(), buffer_a_desciptors.size()};
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
-        return buffer_b_desciptors;
+    std::span<const IPC::BufferDescriptorABW> BufferDescriptorB() const {
+        return {buffer_b_desciptors.data(), buffer_b_desciptors.size()};
     }
 
-    const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
-        return buffer_c_desciptors;
+    std::span<const IPC::BufferDescriptorC> BufferDescriptorC() const {
+        return {buffer_c_desciptors.data(), buffer_c_desciptors.size()};
     }
 
     const IPC::DomainMessageHeader& GetDomainMessageHeader() const {
@@ -268,6 +271,20 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(std::size_t buffer_index = 0) const;
 
+    /**
+     * Returns a view of a buffer using the appropriate buffer descriptor. The view points to guest
+     * memory when the buffer is contiguous in host memory, otherwise it is copied to memory owned
+     * by this context. It is valid until the context is destroyed.
+     */
+    std::span<const u8> ReadBufferSpan(std::size_t buffer_index = 0);
+
+    /**
+     * Returns a view of guest memory to write an output buffer in place, using the appropriate
+     * buffer descriptor. The view is empty when the buffer can't be written in place, WriteBuffer
+     * has to be used then.
+     */
+    std::span<u8> WriteBufferSpan(std::size_t buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
@@ -350,26 +367,33 @@ private:
 
     void ParseCommandBuffer(const KHandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
+    /// Requests rarely have more than a few handles or buffers, keep them inline to not allocate
+    template <typename T>
+    using InlineVector = boost::container::small_vector<T, 4>;
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     Kernel::KServerSession* server_session{};
     KThread* thread;
 
-    std::vector<Handle> incoming_move_handles;
-    std::vector<Handle> incoming_copy_handles;
+    InlineVector<Handle> incoming_move_handles;
+    InlineVector<Handle> incoming_copy_handles;
 
-    std::vector<KAutoObject*> outgoing_move_objects;
-    std::vector<KAutoObject*> outgoing_copy_objects;
-    std::vector<SessionRequestHandlerPtr> outgoing_domain_objects;
+    InlineVector<KAutoObject*> outgoing_move_objects;
+    InlineVector<KAutoObject*> outgoing_copy_objects;
+    InlineVector<SessionRequestHandlerPtr> outgoing_domain_objects;
 
     std::optional<IPC::CommandHeader> command_header;
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_desciptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_desciptors;
+    InlineVector<IPC::BufferDescriptorX> buffer_x_desciptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_a_desciptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_b_desciptors;
+    InlineVector<IPC::BufferDescriptorABW> buffer_w_desciptors;
+    InlineVector<IPC::BufferDescriptorC> buffer_c_desciptors;
+
+    /// Copies of the read buffers that are not contiguous in host memory
+    boost::container::small_vector<std::vector<u8>, 1> read_buffer_copies;
 
     u32_le command{};
     u64 pid{};
@@ -7,6 +7,7 @@
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/common_types.h"
+#include "common/intrusive_red_black_tree.h"
 #include "core/hle/kernel/memory_types.h"
 #include "core/hle/kernel/svc_types.h"
 
@@ -197,7 +198,7 @@ struct KMemoryInfo {
     }
 };
 
-class KMemoryBlock final {
+class KMemoryBlock final : public Common::IntrusiveRedBlackTreeBaseNode<KMemoryBlock> {
     friend class KMemoryBlockManager;
 
 private:
@@ -221,6 +222,19 @@ public:
         }
     }
 
+    /// Blocks are looked up by any address they contain
+    using LightCompareType = VAddr;
+
+    static constexpr int Compare(const LightCompareType& lhs, const KMemoryBlock& rhs) {
+        if (lhs < rhs.GetAddress()) {
+            return -1;
+        } else if (lhs <= rhs.GetLastAddress()) {
+            return 0;
+        } else {
+            return 1;
+        }
+    }
+
 public:
     constexpr KMemoryBlock() = default;
     constexpr KMemoryBlock(VAddr addr_, std::size_t num_pages_, KMemoryState state_,
@@ -310,25 +324,23 @@ private:
             (attribute & (KMemoryAttribute::IpcLocked | KMemoryAttribute::DeviceShared)));
     }
 
-    constexpr KMemoryBlock Split(VAddr split_addr) {
+    /// Moves the pages below split_addr into block, this block keeps the pages above it
+    constexpr void Split(KMemoryBlock* block, VAddr split_addr) {
         ASSERT(GetAddress() < split_addr);
         ASSERT(Contains(split_addr));
         ASSERT(Common::IsAligned(split_addr, PageSize));
 
-        KMemoryBlock block;
-        block.addr = addr;
-        block.num_pages = (split_addr - GetAddress()) / PageSize;
-        block.state = state;
-        block.ipc_lock_count = ipc_lock_count;
-        block.device_use_count = device_use_count;
-        block.perm = perm;
-        block.original_perm = original_perm;
-        block.attribute = attribute;
+        block->addr = addr;
+        block->num_pages = (split_addr - GetAddress()) / PageSize;
+        block->state = state;
+        block->ipc_lock_count = ipc_lock_count;
+        block->device_use_count = device_use_count;
+        block->perm = perm;
+        block->original_perm = original_perm;
+        block->attribute = attribute;
 
         addr = split_addr;
-        num_pages -= block.num_pages;
-
-        return block;
+        num_pages -= block->num_pages;
     }
 };
 static_assert(std::is_trivially_destructible<KMemoryBlock>::value);
@@ -10,20 +10,16 @@ namespace Kernel {
 KMemoryBlockManager::KMemoryBlockManager(VAddr start_addr_, VAddr end_addr_)
     : start_addr{start_addr_}, end_addr{end_addr_} {
     const u64 num_pages{(end_addr - start_addr) / PageSize};
-    memory_block_tree.emplace_back(start_addr, num_pages, KMemoryState::Free,
-                                   KMemoryPermission::None, KMemoryAttribute::None);
+    KMemoryBlock* const block{AllocateBlock()};
+    *block = KMemoryBlock(start_addr, num_pages, KMemoryState::Free, KMemoryPermission::None,
+                          KMemoryAttribute::None);
+    memory_block_tree.insert(*block);
 }
 
+KMemoryBlockManager::~KMemoryBlockManager() = default;
+
 KMemoryBlockManager::iterator KMemoryBlockManager::FindIterator(VAddr addr) {
-    auto node{memory_block_tree.begin()};
-    while (node != end()) {
-        const VAddr node_end_addr{node->GetNumPages() * PageSize + node->GetAddress()};
-        if (node->GetAddress() <= addr && node_end_addr - 1 >= addr) {
-            return node;
-        }
-        node = std::next(node);
-    }
-    return end();
+    return memory_block_tree.find_light(addr);
 }
 
 VAddr KMemoryBlockManager::FindFreeArea(VAddr region_start, std::size_t region_num_pages,
@@ -68,7 +64,7 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
                                  KMemoryState state, KMemoryPermission perm,
                                  KMemoryAttribute attribute) {
     const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     prev_attribute |= KMemoryAttribute::IpcAndDeviceMapped;
 
@@ -86,11 +82,11 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
 
             iterator new_node{node};
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                SplitBlock(node, addr);
             }
 
             if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
+                new_node = SplitBlock(node, update_end_addr);
             }
 
             new_node->Update(state, perm, attribute);
@@ -109,7 +105,7 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
 void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState state,
                                  KMemoryPermission perm, KMemoryAttribute attribute) {
     const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     while (node != memory_block_tree.end()) {
         KMemoryBlock* block{&(*node)};
@@ -121,11 +117,11 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
             iterator new_node{node};
 
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                SplitBlock(node, addr);
             }
 
             if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
+                new_node = SplitBlock(node, update_end_addr);
             }
 
             new_node->Update(state, perm, attribute);
@@ -141,49 +137,29 @@ void KMemoryBlockManager::Update(VAddr addr, std::size_t num_pages, KMemoryState
     }
 }
 
-void KMemoryBlockManager::UpdateLock(VAddr addr, std::size_t num_pages, LockFunc&& lock_func,
-                                     KMemoryPermission perm) {
-    const VAddr update_end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
-
-    while (node != memory_block_tree.end()) {
-        KMemoryBlock* block{&(*node)};
-        iterator next_node{std::next(node)};
-        const VAddr cur_addr{block->GetAddress()};
-        const VAddr cur_end_addr{block->GetNumPages() * PageSize + cur_addr};
-
-        if (addr < cur_end_addr && cur_addr < update_end_addr) {
-            iterator new_node{node};
-
-            if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
-            }
-
-            if (update_end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(update_end_addr));
-            }
-
-            lock_func(new_node, perm);
-
-            MergeAdjacent(new_node, next_node);
+KMemoryBlock* KMemoryBlockManager::AllocateBlock() {
+    if (free_blocks.empty()) {
+        auto& chunk{block_chunks.emplace_back(std::make_unique<KMemoryBlock[]>(BLOCKS_PER_CHUNK))};
+        for (std::size_t i = BLOCKS_PER_CHUNK; i > 0; --i) {
+            free_blocks.push_back(&chunk[i - 1]);
         }
-
-        if (cur_end_addr - 1 >= update_end_addr - 1) {
-            break;
-        }
-
-        node = next_node;
     }
+    KMemoryBlock* const block{free_blocks.back()};
+    free_blocks.pop_back();
+    ++num_blocks;
+    return block;
+}
+
+void KMemoryBlockManager::FreeBlock(KMemoryBlock* block) {
+    free_blocks.push_back(block);
+    --num_blocks;
 }
 
-void KMemoryBlockManager::IterateForRange(VAddr start, VAddr end, IterateFunc&& func) {
-    const_iterator it{FindIterator(start)};
-    KMemoryInfo info{};
-    do {
-        info = it->GetMemoryInfo();
-        func(info);
-        it = std::next(it);
-    } while (info.addr + info.size - 1 < end - 1 && it != cend());
+KMemoryBlockManager::iterator KMemoryBlockManager::SplitBlock(iterator node, VAddr split_addr) {
+    // The block at node keeps its place in the tree, the new block goes right before it
+    KMemoryBlock* const new_block{AllocateBlock()};
+    node->Split(new_block, split_addr);
+    return memory_block_tree.insert(*new_block);
 }
 
 void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
@@ -193,7 +169,9 @@ void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         if (next_it == it_to_erase) {
             next_it = std::next(next_it);
         }
+        KMemoryBlock* const erased_block{&(*it_to_erase)};
         memory_block_tree.erase(it_to_erase);
+        FreeBlock(erased_block);
     };
 
     if (it != memory_block_tree.begin()) {
@@ -210,12 +188,12 @@ void KMemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         }
     }
 
-    if (it != cend()) {
-        const KMemoryBlock* const next{&(*std::next(it))};
+    if (const iterator next_block{std::next(it)}; next_block != end()) {
+        const KMemoryBlock* const next{&(*next_block)};
 
         if (block->HasSameProperties(*next)) {
             block->Add(next->GetNumPages());
-            EraseIt(std::next(it));
+            EraseIt(next_block);
         }
     }
 }
@@ -4,22 +4,35 @@
 
 #pragma once
 
-#include <functional>
-#include <list>
+#include <iterator>
+#include <memory>
+#include <vector>
 
+#include "common/common_funcs.h"
 #include "common/common_types.h"
+#include "common/intrusive_red_black_tree.h"
 #include "core/hle/kernel/k_memory_block.h"
+#include "core/hle/kernel/memory_types.h"
 
 namespace Kernel {
 
+/**
+ * Tracks the state of an address space as a set of non-overlapping blocks.
+ * Blocks are kept in a red-black tree ordered by address, so finding the block of an address is
+ * logarithmic in the number of blocks instead of walking the whole address space.
+ */
 class KMemoryBlockManager final {
+    YUZU_NON_COPYABLE(KMemoryBlockManager);
+
 public:
-    using MemoryBlockTree = std::list<KMemoryBlock>;
+    using MemoryBlockTree =
+        Common::IntrusiveRedBlackTreeBaseTraits<KMemoryBlock>::TreeType<KMemoryBlock>;
     using iterator = MemoryBlockTree::iterator;
     using const_iterator = MemoryBlockTree::const_iterator;
 
 public:
     KMemoryBlockManager(VAddr start_addr_, VAddr end_addr_);
+    ~KMemoryBlockManager();
 
     iterator end() {
         return memory_block_tree.end();
@@ -33,6 +46,11 @@ public:
 
     iterator FindIterator(VAddr addr);
 
+    /// Returns the number of blocks the address space is split into
+    std::size_t GetNumBlocks() const {
+        return num_blocks;
+    }
+
     VAddr FindFreeArea(VAddr region_start, std::size_t region_num_pages, std::size_t num_pages,
                        std::size_t align, std::size_t offset, std::size_t guard_pages);
 
@@ -44,23 +62,78 @@ public:
                 KMemoryPermission perm = KMemoryPermission::None,
                 KMemoryAttribute attribute = KMemoryAttribute::None);
 
-    using LockFunc = std::function<void(iterator, KMemoryPermission)>;
+    /// Calls lock_func(iterator, perm) on the blocks of the range, split at its bounds
+    template <typename LockFunc>
     void UpdateLock(VAddr addr, std::size_t num_pages, LockFunc&& lock_func,
-                    KMemoryPermission perm);
+                    KMemoryPermission perm) {
+        const VAddr update_end_addr{addr + num_pages * PageSize};
+        iterator node{FindIterator(addr)};
+
+        while (node != memory_block_tree.end()) {
+            KMemoryBlock* block{&(*node)};
+            iterator next_node{std::next(node)};
+            const VAddr cur_addr{block->GetAddress()};
+            const VAddr cur_end_addr{block->GetNumPages() * PageSize + cur_addr};
+
+            if (addr < cur_end_addr && cur_addr < update_end_addr) {
+                iterator new_node{node};
+
+                if (addr > cur_addr) {
+                    SplitBlock(node, addr);
+                }
+
+                if (update_end_addr < cur_end_addr) {
+                    new_node = SplitBlock(node, update_end_addr);
+                }
+
+                lock_func(new_node, perm);
+
+                MergeAdjacent(new_node, next_node);
+            }
 
-    using IterateFunc = std::function<void(const KMemoryInfo&)>;
-    void IterateForRange(VAddr start, VAddr end, IterateFunc&& func);
+            if (cur_end_addr - 1 >= update_end_addr - 1) {
+                break;
+            }
+
+            node = next_node;
+        }
+    }
+
+    /// Calls func(const KMemoryInfo&) on every block overlapping the range
+    template <typename IterateFunc>
+    void IterateForRange(VAddr start, VAddr end, IterateFunc&& func) {
+        const_iterator it{FindIterator(start)};
+        KMemoryInfo info{};
+        do {
+            info = it->GetMemoryInfo();
+            func(info);
+            it = std::next(it);
+        } while (info.addr + info.size - 1 < end - 1 && it != cend());
+    }
 
     KMemoryBlock& FindBlock(VAddr addr) {
         return *FindIterator(addr);
     }
 
 private:
+    /// Blocks are allocated in chunks of this many and recycled through a free list
+    static constexpr std::size_t BLOCKS_PER_CHUNK = 256;
+
+    KMemoryBlock* AllocateBlock();
+    void FreeBlock(KMemoryBlock* block);
+
+    /// Splits the block at node so that a block starts at split_addr, returns the lower half
+    iterator SplitBlock(iterator node, VAddr split_addr);
+
     void MergeAdjacent(iterator it, iterator& next_it);
 
     [[maybe_unused]] const VAddr start_addr;
     [[maybe_unused]] const VAddr end_addr;
 
+    std::vector<std::unique_ptr<KMemoryBlock[]>> block_chunks;
+    std::vector<KMemoryBlock*> free_blocks;
+    std::size_t num_blocks{};
+
     MemoryBlockTree memory_block_tree;
 };
 
@@ -977,7 +977,9 @@ void KernelCore::ExitSVCProfile() {
 }
 
 std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
-    auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
+    // Handlers, their domains and the filesystem backends behind them aren't thread safe, so the
+    // sessions of a service share a single worker
+    auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, name);
     impl->service_threads.emplace(service_thread);
     return service_thread;
 }
@@ -3,11 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <condition_variable>
-#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
-#include <queue>
 
 #include "common/assert.h"
 #include "common/scope_exit.h"
@@ -23,50 +22,80 @@ namespace Kernel {
 
 class ServiceThread::Impl final {
 public:
-    explicit Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit Impl(KernelCore& kernel, const std::string& name);
     ~Impl();
 
     void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
 
 private:
-    std::vector<std::thread> threads;
-    std::queue<std::function<void()>> requests;
+    /// Pending request, linked into the queue of the service
+    struct Request {
+        Request* next;
+        KServerSession* server_session;
+        std::shared_ptr<HLERequestContext> context;
+    };
+
+    static constexpr std::size_t REQUESTS_PER_CHUNK = 64;
+
+    void WorkerLoop();
+
+    /// Takes a request from the free list, growing the pool when it's empty
+    Request* AllocateRequest();
+    void GrowRequestPool();
+    void FreeRequest(Request* request);
+
+    KernelCore& kernel;
+    std::thread thread;
+
+    Request* head{};
+    Request* tail{};
+
+    std::vector<std::unique_ptr<Request[]>> request_chunks;
+    Request* free_requests{};
+
     std::mutex queue_mutex;
     std::condition_variable condition;
     const std::string service_name;
     bool stop{};
 };
 
-ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : service_name{name} {
-    for (std::size_t i = 0; i < num_threads; ++i)
-        threads.emplace_back([this, &kernel] {
-            Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+ServiceThread::Impl::Impl(KernelCore& kernel_, const std::string& name)
+    : kernel{kernel_}, service_name{name} {
+    GrowRequestPool();
+}
 
-            // Wait for first request before trying to acquire a render context
-            {
-                std::unique_lock lock{queue_mutex};
-                condition.wait(lock, [this] { return stop || !requests.empty(); });
+void ServiceThread::Impl::WorkerLoop() {
+    Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+    kernel.RegisterHostThread();
+
+    while (true) {
+        Request* request;
+        {
+            std::unique_lock lock{queue_mutex};
+            condition.wait(lock, [this] { return stop || head != nullptr; });
+            if (stop) {
+                return;
+            }
+            request = head;
+            head = request->next;
+            if (!head) {
+                tail = nullptr;
             }
+        }
 
-            kernel.RegisterHostThread();
+        {
+            KServerSession* const server_session = request->server_session;
 
-            while (true) {
-                std::function<void()> task;
+            // Close the reference.
+            SCOPE_EXIT({ server_session->Close(); });
 
-                {
-                    std::unique_lock lock{queue_mutex};
-                    condition.wait(lock, [this] { return stop || !requests.empty(); });
-                    if (stop || requests.empty()) {
-                        return;
-                    }
-                    task = std::move(requests.front());
-                    requests.pop();
-                }
+            // Complete the service request.
+            server_session->CompleteSyncRequest(*request->context);
+        }
 
-                task();
-            }
-        });
+        std::scoped_lock lock{queue_mutex};
+        FreeRequest(request);
+    }
 }
 
 void ServiceThread::Impl::QueueSyncRequest(KSession& session,
@@ -80,30 +109,62 @@ void ServiceThread::Impl::QueueSyncRequest(KSession& session,
         // completes asynchronously.
         server_session->Open();
 
-        requests.emplace([server_session, context{std::move(context)}]() {
-            // Close the reference.
-            SCOPE_EXIT({ server_session->Close(); });
-
-            // Complete the service request.
-            server_session->CompleteSyncRequest(*context);
-        });
+        Request* const request = AllocateRequest();
+        request->next = nullptr;
+        request->server_session = server_session;
+        request->context = std::move(context);
+        if (tail) {
+            tail->next = request;
+        } else {
+            head = request;
+        }
+        tail = request;
+
+        if (!thread.joinable()) {
+            thread = std::thread([this] { WorkerLoop(); });
+        }
     }
     condition.notify_one();
 }
 
+ServiceThread::Impl::Request* ServiceThread::Impl::AllocateRequest() {
+    if (!free_requests) {
+        GrowRequestPool();
+    }
+    Request* const request = free_requests;
+    free_requests = request->next;
+    return request;
+}
+
+void ServiceThread::Impl::GrowRequestPool() {
+    auto chunk = std::make_unique<Request[]>(REQUESTS_PER_CHUNK);
+    for (std::size_t i = 0; i < REQUESTS_PER_CHUNK - 1; ++i) {
+        chunk[i].next = &chunk[i + 1];
+    }
+    chunk[REQUESTS_PER_CHUNK - 1].next = free_requests;
+    free_requests = chunk.get();
+    request_chunks.push_back(std::move(chunk));
+}
+
+void ServiceThread::Impl::FreeRequest(Request* request) {
+    request->context.reset();
+    request->next = free_requests;
+    free_requests = request;
+}
+
 ServiceThread::Impl::~Impl() {
     {
         std::unique_lock lock{queue_mutex};
         stop = true;
     }
     condition.notify_all();
-    for (std::thread& thread : threads) {
+    if (thread.joinable()) {
         thread.join();
     }
 }
 
-ServiceThread::ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name)
-    : impl{std::make_unique<Impl>(kernel, num_threads, name)} {}
+ServiceThread::ServiceThread(KernelCore& kernel, const std::string& name)
+    : impl{std::make_unique<Impl>(kernel, name)} {}
 
 ServiceThread::~ServiceThread() = default;
 
@@ -13,9 +13,13 @@ class HLERequestContext;
 class KernelCore;
 class KSession;
 
+/**
+ * Executes the requests of a service on a host thread, in the order they were queued.
+ * The thread is started with the first request, services that are never used don't take any.
+ */
 class ServiceThread final {
 public:
-    explicit ServiceThread(KernelCore& kernel, std::size_t num_threads, const std::string& name);
+    explicit ServiceThread(KernelCore& kernel, const std::string& name);
     ~ServiceThread();
 
     void QueueSyncRequest(KSession& session, std::shared_ptr<HLERequestContext>&& context);
@@ -5,6 +5,7 @@
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -45,6 +46,29 @@ struct SizeGetter {
     }
 };
 
+namespace {
+/**
+ * Reads from a file straight into the output buffer of a request when it is contiguous in host
+ * memory, and through a temporary buffer otherwise.
+ * @return Number of bytes read
+ */
+std::size_t ReadToBuffer(Kernel::HLERequestContext& ctx, const FileSys::VfsFile& file, u64 offset,
+                         u64 length) {
+    const std::span<u8> output = ctx.WriteBufferSpan();
+    if (output.empty()) {
+        // WriteBuffer clamps the data to the size of the buffer
+        const std::vector<u8> data = file.ReadBytes(length, offset);
+        return ctx.WriteBuffer(data);
+    }
+    if (length > output.size()) {
+        LOG_CRITICAL(Service_FS, "length ({:016X}) is greater than buffer_size ({:016X})", length,
+                     output.size());
+        length = output.size();
+    }
+    return file.Read(output.data(), length, offset);
+}
+} // Anonymous namespace
+
 enum class FileSystemType : u8 {
     Invalid0 = 0,
     Invalid1 = 1,
@@ -95,10 +119,8 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        ReadToBuffer(ctx, *backend, offset, length);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(ResultSuccess);
@@ -156,15 +178,12 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend into memory
+        const std::size_t read = ReadToBuffer(ctx, *backend, offset, length);
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(ResultSuccess);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -190,7 +209,7 @@ private:
             return;
         }
 
-        const std::vector<u8> data = ctx.ReadBuffer();
+        const std::span<const u8> data = ctx.ReadBufferSpan();
 
         ASSERT_MSG(
             static_cast<s64>(data.size()) <= length,
@@ -7,6 +7,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -33,11 +34,11 @@ public:
     explicit nvhost_as_gpu(Core::System& system_, std::shared_ptr<nvmap> nvmap_dev_);
     ~nvhost_as_gpu() override;
 
-    NvResult Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
+    NvResult Ioctl1(DeviceFD fd, Ioctl command, std::span<const u8> input,
                     std::vector<u8>& output) override;
-    NvResult Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                    const std::vector<u8>& inline_input, std::vector<u8>& output) override;
-    NvResult Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
+    NvResult Ioctl2(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                    std::span<const u8> inline_input, std::vector<u8>& output) override;
+    NvResult Ioctl3(DeviceFD fd, Ioctl command, std::span<const u8> input,
                     std::vector<u8>& output, std::vector<u8>& inline_output) override;
 
     void OnOpen(DeviceFD fd) override;
@@ -165,16 +166,16 @@ private:
     s32 channel{};
     u32 big_page_size{DEFAULT_BIG_PAGE_SIZE};
 
-    NvResult AllocAsEx(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult AllocateSpace(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult Remap(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult MapBufferEx(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult UnmapBuffer(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult FreeSpace(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult BindChannel(const std::vector<u8>& input, std::vector<u8>& output);
+    NvResult AllocAsEx(std::span<const u8> input, std::vector<u8>& output);
+    NvResult AllocateSpace(std::span<const u8> input, std::vector<u8>& output);
+    NvResult Remap(std::span<const u8> input, std::vector<u8>& output);
+    NvResult MapBufferEx(std::span<const u8> input, std::vector<u8>& output);
+    NvResult UnmapBuffer(std::span<const u8> input, std::vector<u8>& output);
+    NvResult FreeSpace(std::span<const u8> input, std::vector<u8>& output);
+    NvResult BindChannel(std::span<const u8> input, std::vector<u8>& output);
 
-    NvResult GetVARegions(const std::vector<u8>& input, std::vector<u8>& output);
-    NvResult GetVARegions(const std::vector<u8>& input, std::vector<u8>& output,
+    NvResult GetVARegions(std::span<const u8> input, std::vector<u8>& output);
+    NvResult GetVARegions(std::span<const u8> input, std::vector<u8>& output,
                           std::vector<u8>& inline_output);
 
     std::optional<BufferMap> FindBufferMap(GPUVAddr gpu_addr) const;
@@ -382,7 +382,7 @@ void BSD::Send(Kernel::HLERequestContext& ctx) {
     ExecuteWork(ctx, SendWork{
                          .fd = fd,
                          .flags = flags,
-                         .message = ctx.ReadBuffer(),
+                         .message = ctx.ReadBufferSpan(),
                      });
 }
 
@@ -397,8 +397,8 @@ void BSD::SendTo(Kernel::HLERequestContext& ctx) {
     ExecuteWork(ctx, SendToWork{
                          .fd = fd,
                          .flags = flags,
-                         .message = ctx.ReadBuffer(0),
-                         .addr = ctx.ReadBuffer(1),
+                         .message = ctx.ReadBufferSpan(0),
+                         .addr = ctx.ReadBufferSpan(1),
                      });
 }
 
@@ -411,7 +411,7 @@ void BSD::Write(Kernel::HLERequestContext& ctx) {
     ExecuteWork(ctx, SendWork{
                          .fd = fd,
                          .flags = 0,
-                         .message = ctx.ReadBuffer(),
+                         .message = ctx.ReadBufferSpan(),
                      });
 }
 
@@ -756,15 +756,15 @@ std::pair<s32, Errno> BSD::RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& mess
     return {ret, bsd_errno};
 }
 
-std::pair<s32, Errno> BSD::SendImpl(s32 fd, u32 flags, const std::vector<u8>& message) {
+std::pair<s32, Errno> BSD::SendImpl(s32 fd, u32 flags, std::span<const u8> message) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
     return Translate(file_descriptors[fd]->socket->Send(message, flags));
 }
 
-std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, const std::vector<u8>& message,
-                                      const std::vector<u8>& addr) {
+std::pair<s32, Errno> BSD::SendToImpl(s32 fd, u32 flags, std::span<const u8> message,
+                                      std::span<const u8> addr) {
     if (!IsFileDescriptorValid(fd)) {
         return {-1, Errno::BADF};
     }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -98,7 +99,7 @@ private:
 
         s32 fd;
         u32 flags;
-        std::vector<u8> message;
+        std::span<const u8> message;
         s32 ret{};
         Errno bsd_errno{};
     };
@@ -109,8 +110,8 @@ private:
 
         s32 fd;
         u32 flags;
-        std::vector<u8> message;
-        std::vector<u8> addr;
+        std::span<const u8> message;
+        std::span<const u8> addr;
         s32 ret{};
         Errno bsd_errno{};
     };
@@ -156,9 +157,9 @@ private:
     std::pair<s32, Errno> RecvImpl(s32 fd, u32 flags, std::vector<u8>& message);
     std::pair<s32, Errno> RecvFromImpl(s32 fd, u32 flags, std::vector<u8>& message,
                                        std::vector<u8>& addr);
-    std::pair<s32, Errno> SendImpl(s32 fd, u32 flags, const std::vector<u8>& message);
-    std::pair<s32, Errno> SendToImpl(s32 fd, u32 flags, const std::vector<u8>& message,
-                                     const std::vector<u8>& addr);
+    std::pair<s32, Errno> SendImpl(s32 fd, u32 flags, std::span<const u8> message);
+    std::pair<s32, Errno> SendToImpl(s32 fd, u32 flags, std::span<const u8> message,
+                                     std::span<const u8> addr);
     Errno CloseImpl(s32 fd);
 
     s32 FindFreeFileDescriptorHandle() noexcept;
@@ -2,8 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "common/common_funcs.h"
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -131,6 +135,9 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     const auto static_modules = {"rtld",    "main",    "subsdk0", "subsdk1", "subsdk2", "subsdk3",
                                  "subsdk4", "subsdk5", "subsdk6", "subsdk7", "sdk"};
 
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const auto layout_start = std::chrono::steady_clock::now();
+
     // Use the NSO module loader to figure out the code layout
     std::size_t code_size{};
     for (const auto& module : static_modules) {
@@ -153,31 +160,53 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     if (process.LoadFromMetadata(metadata, code_size).IsError()) {
         return {ResultStatus::ErrorUnableToParseKernelMetadata, {}};
     }
+    const auto layout_end = std::chrono::steady_clock::now();
 
-    // Load NSO modules
-    modules.clear();
-    const VAddr base_address{process.PageTable().GetCodeRegionStart()};
-    VAddr next_load_addr{base_address};
-    const FileSys::PatchManager pm{metadata.GetTitleID(), system.GetFileSystemController(),
-                                   system.GetContentProvider()};
+    // Build the program images, segments are decompressed while the next module is being read.
+    // The images are declared first so the builder waits for its workers before they are freed.
+    std::vector<std::pair<FileSys::VirtualFile, std::unique_ptr<NSOImage>>> images;
+    NSOImageBuilder image_builder;
     for (const auto& module : static_modules) {
-        const FileSys::VirtualFile module_file{dir->GetFile(module)};
+        FileSys::VirtualFile module_file{dir->GetFile(module)};
         if (!module_file) {
             continue;
         }
 
-        const VAddr load_addr{next_load_addr};
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
-        const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
-            process, system, *module_file, load_addr, should_pass_arguments, true, pm);
-        if (!tentative_next_load_addr) {
+        auto image = image_builder.Read(*module_file, should_pass_arguments);
+        if (!image) {
             return {ResultStatus::ErrorLoadingNSO, {}};
         }
+        images.emplace_back(std::move(module_file), std::move(image));
+    }
+    image_builder.Wait();
+    const auto build_end = std::chrono::steady_clock::now();
 
-        next_load_addr = *tentative_next_load_addr;
-        modules.insert_or_assign(load_addr, module);
-        LOG_DEBUG(Loader, "loaded module {} @ 0x{:X}", module, load_addr);
+    // Load NSO modules
+    modules.clear();
+    const VAddr base_address{process.PageTable().GetCodeRegionStart()};
+    VAddr next_load_addr{base_address};
+    const FileSys::PatchManager pm{metadata.GetTitleID(), system.GetFileSystemController(),
+                                   system.GetContentProvider()};
+    for (auto& [module_file, image] : images) {
+        const VAddr load_addr{next_load_addr};
+        next_load_addr = AppLoader_NSO::LoadImage(process, system, std::move(*image),
+                                                  module_file->GetName(), load_addr, pm);
+        modules.insert_or_assign(load_addr, module_file->GetName());
+        LOG_DEBUG(Loader, "loaded module {} @ 0x{:X}", module_file->GetName(), load_addr);
     }
+    const auto load_end = std::chrono::steady_clock::now();
+
+    const NSOImageBuilder::Statistics build_statistics = image_builder.GetStatistics();
+    LOG_INFO(Loader,
+             "Loaded {} modules in {:.1f} ms: layout {:.1f} ms, read {:.1f} ms, decompress "
+             "{:.1f} ms over all threads ({:.1f} ms waiting), patch and map {:.1f} ms",
+             images.size(), Milliseconds(load_end - layout_start).count(),
+             Milliseconds(layout_end - layout_start).count(),
+             Milliseconds(build_statistics.read_time).count(),
+             Milliseconds(build_statistics.decompress_time).count(),
+             Milliseconds(build_statistics.wait_time).count(),
+             Milliseconds(load_end - build_end).count());
 
     // Find the RomFS by searching for a ".romfs" file in this directory
     const auto& files = dir->GetFiles();
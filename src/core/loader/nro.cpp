@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -129,22 +130,24 @@ static constexpr u32 PageAlignSize(u32 size) {
     return static_cast<u32>((size + Core::Memory::PAGE_MASK) & ~Core::Memory::PAGE_MASK);
 }
 
-static bool LoadNroImpl(Kernel::KProcess& process, const std::vector<u8>& data) {
-    if (data.size() < sizeof(NroHeader)) {
+static bool LoadNroImpl(Kernel::KProcess& process, const FileSys::VfsFile& nro_file) {
+    if (nro_file.GetSize() < sizeof(NroHeader)) {
         return {};
     }
 
     // Read NSO header
     NroHeader nro_header{};
-    std::memcpy(&nro_header, data.data(), sizeof(NroHeader));
+    if (nro_file.ReadObject(&nro_header) != sizeof(NroHeader)) {
+        return {};
+    }
     if (nro_header.magic != Common::MakeMagic('N', 'R', 'O', '0')) {
         return {};
     }
 
-    // Build program image
+    // Build program image, reading the file straight into it
     Kernel::PhysicalMemory program_image(PageAlignSize(nro_header.file_size));
-    std::memcpy(program_image.data(), data.data(), program_image.size());
-    if (program_image.size() != PageAlignSize(nro_header.file_size)) {
+    const std::size_t read_size = std::min<std::size_t>(nro_header.file_size, nro_file.GetSize());
+    if (nro_file.Read(program_image.data(), read_size) != read_size) {
         return {};
     }
 
@@ -199,7 +202,7 @@ static bool LoadNroImpl(Kernel::KProcess& process, const std::vector<u8>& data)
 }
 
 bool AppLoader_NRO::LoadNro(Kernel::KProcess& process, const FileSys::VfsFile& nro_file) {
-    return LoadNroImpl(process, nro_file.ReadAllBytes());
+    return LoadNroImpl(process, nro_file);
 }
 
 AppLoader_NRO::LoadResult AppLoader_NRO::Load(Kernel::KProcess& process, Core::System& system) {
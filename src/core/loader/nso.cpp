@@ -2,8 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
+#include <mutex>
+#include <span>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -12,6 +15,8 @@
 #include "common/lz4_compression.h"
 #include "common/settings.h"
 #include "common/swap.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/hle/kernel/code_set.h"
@@ -34,22 +39,165 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+constexpr u32 PageAlignSize(u32 size) {
+    return static_cast<u32>((size + Core::Memory::PAGE_MASK) & ~Core::Memory::PAGE_MASK);
+}
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
+bool ReadHeader(const FileSys::VfsFile& nso_file, NSOHeader& nso_header) {
+    if (nso_file.GetSize() < sizeof(NSOHeader)) {
+        return false;
+    }
+    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
+        return false;
+    }
+    return nso_header.magic == Common::MakeMagic('N', 'S', 'O', '0');
+}
 
-    return uncompressed_data;
+bool ShouldPassArguments(bool should_pass_arguments) {
+    return should_pass_arguments && !Settings::values.program_args.empty();
 }
 
-constexpr u32 PageAlignSize(u32 size) {
-    return static_cast<u32>((size + Core::Memory::PAGE_MASK) & ~Core::Memory::PAGE_MASK);
+/// Returns the end of the last segment, arguments are placed right after it
+u32 GetSegmentsEnd(const NSOHeader& nso_header) {
+    u32 segments_end = 0;
+    for (const NSOSegmentHeader& segment : nso_header.segments) {
+        segments_end = std::max<u32>(segments_end, segment.location + segment.size);
+    }
+    return segments_end;
+}
+
+/// Returns the size of the program image, including arguments and .bss
+u32 GetImageSize(const NSOHeader& nso_header, bool should_pass_arguments) {
+    u32 size = GetSegmentsEnd(nso_header);
+    if (ShouldPassArguments(should_pass_arguments)) {
+        size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
+    }
+    return PageAlignSize(size + nso_header.segments[2].bss_size);
 }
 } // Anonymous namespace
 
+struct NSOImageBuilder::Impl {
+    std::mutex mutex;
+    Common::WaitGroup pending;
+    Statistics statistics{};
+};
+
+NSOImageBuilder::NSOImageBuilder() : impl{std::make_unique<Impl>()} {}
+
+NSOImageBuilder::~NSOImageBuilder() {
+    // Workers write into images owned by the caller, don't let them outlive the builder
+    Wait();
+}
+
+std::unique_ptr<NSOImage> NSOImageBuilder::Read(const FileSys::VfsFile& nso_file,
+                                                bool should_pass_arguments) {
+    const auto read_start = std::chrono::steady_clock::now();
+    auto image = std::make_unique<NSOImage>();
+    NSOHeader& nso_header = image->header;
+    if (!ReadHeader(nso_file, nso_header)) {
+        return nullptr;
+    }
+
+    // Allocate the whole image up front, segments are written in place by the workers
+    Kernel::CodeSet& codeset = image->codeset;
+    Kernel::PhysicalMemory& program_image = codeset.memory;
+    program_image.resize(GetImageSize(nso_header, should_pass_arguments));
+
+    // Compressed segments of a mapped file are used in place, the others are copied out first
+    const std::span<const u8> mapped = nso_file.GetMappedData();
+    nso_file.AdviseAccess(Common::FS::AccessPattern::WillNeed, 0, nso_file.GetSize());
+    const auto is_mapped = [&](std::size_t i) {
+        return mapped.size() >= std::size_t{nso_header.segments[i].offset} +
+                                    nso_header.segments_compressed_size[i];
+    };
+
+    std::size_t compressed_size = 0;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (nso_header.IsSegmentCompressed(i) && !is_mapped(i)) {
+            compressed_size += nso_header.segments_compressed_size[i];
+        }
+    }
+    image->compressed_data.resize(compressed_size);
+
+    std::array<std::span<const u8>, 3> compressed_segments{};
+    std::size_t compressed_offset = 0;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const NSOSegmentHeader& segment = nso_header.segments[i];
+        if (nso_header.IsSegmentCompressed(i) && is_mapped(i)) {
+            compressed_segments[i] =
+                mapped.subspan(segment.offset, nso_header.segments_compressed_size[i]);
+        } else if (nso_header.IsSegmentCompressed(i)) {
+            u8* const compressed = image->compressed_data.data() + compressed_offset;
+            const std::size_t read = nso_file.Read(
+                compressed, nso_header.segments_compressed_size[i], segment.offset);
+            compressed_segments[i] = std::span<const u8>(compressed, read);
+            compressed_offset += nso_header.segments_compressed_size[i];
+        } else {
+            const u32 size = std::min<u32>(segment.size, nso_header.segments_compressed_size[i]);
+            nso_file.Read(program_image.data() + segment.location, size, segment.offset);
+        }
+        codeset.segments[i].addr = segment.location;
+        codeset.segments[i].offset = segment.location;
+        codeset.segments[i].size = segment.size;
+    }
+
+    if (ShouldPassArguments(should_pass_arguments)) {
+        const auto arg_data{Settings::values.program_args};
+
+        codeset.DataSegment().size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
+        NSOArgumentHeader args_header{
+            NSO_ARGUMENT_DATA_ALLOCATION_SIZE, static_cast<u32_le>(arg_data.size()), {}};
+        const auto end_offset = GetSegmentsEnd(nso_header);
+        std::memcpy(program_image.data() + end_offset, &args_header, sizeof(NSOArgumentHeader));
+        std::memcpy(program_image.data() + end_offset + sizeof(NSOArgumentHeader), arg_data.data(),
+                    arg_data.size());
+    }
+
+    codeset.DataSegment().size += nso_header.segments[2].bss_size;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        codeset.segments[i].size = PageAlignSize(codeset.segments[i].size);
+    }
+
+    const auto read_end = std::chrono::steady_clock::now();
+    std::scoped_lock lock{impl->mutex};
+    impl->statistics.read_time += read_end - read_start;
+
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (!nso_header.IsSegmentCompressed(i)) {
+            continue;
+        }
+        const std::span<u8> uncompressed(program_image.data() + nso_header.segments[i].location,
+                                         nso_header.segments[i].size);
+        impl->pending.Add();
+        Common::SharedThreadWorker().QueueWork([this, compressed = compressed_segments[i],
+                                                uncompressed] {
+            const auto start = std::chrono::steady_clock::now();
+            const bool success = Common::Compression::DecompressDataLZ4(compressed, uncompressed);
+            ASSERT_MSG(success, "Failed to decompress segment of size 0x{:X}", uncompressed.size());
+            const auto end = std::chrono::steady_clock::now();
+            {
+                std::scoped_lock worker_lock{impl->mutex};
+                impl->statistics.decompress_time += end - start;
+            }
+            // The builder may be destroyed as soon as this returns
+            impl->pending.Done();
+        });
+    }
+    return image;
+}
+
+void NSOImageBuilder::Wait() {
+    const auto start = std::chrono::steady_clock::now();
+    impl->pending.Wait();
+    std::scoped_lock lock{impl->mutex};
+    impl->statistics.wait_time += std::chrono::steady_clock::now() - start;
+}
+
+NSOImageBuilder::Statistics NSOImageBuilder::GetStatistics() const {
+    std::scoped_lock lock{impl->mutex};
+    return impl->statistics;
+}
+
 bool NSOHeader::IsSegmentCompressed(size_t segment_num) const {
     ASSERT_MSG(segment_num < 3, "Invalid segment {}", segment_num);
     return ((flags >> segment_num) & 1) != 0;
@@ -74,77 +222,47 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
                                                const FileSys::VfsFile& nso_file, VAddr load_base,
                                                bool should_pass_arguments, bool load_into_process,
                                                std::optional<FileSys::PatchManager> pm) {
-    if (nso_file.GetSize() < sizeof(NSOHeader)) {
-        return std::nullopt;
-    }
-
-    NSOHeader nso_header{};
-    if (sizeof(NSOHeader) != nso_file.ReadObject(&nso_header)) {
-        return std::nullopt;
-    }
-
-    if (nso_header.magic != Common::MakeMagic('N', 'S', 'O', '0')) {
-        return std::nullopt;
-    }
-
-    // Build program image
-    Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
-    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+    // If we aren't actually loading (i.e. just computing the process code layout), the header is
+    // all we need
+    if (!load_into_process) {
+        NSOHeader nso_header{};
+        if (!ReadHeader(nso_file, nso_header)) {
+            return std::nullopt;
         }
-        program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
-        codeset.segments[i].addr = nso_header.segments[i].location;
-        codeset.segments[i].offset = nso_header.segments[i].location;
-        codeset.segments[i].size = nso_header.segments[i].size;
+        return load_base + GetImageSize(nso_header, should_pass_arguments);
     }
 
-    if (should_pass_arguments && !Settings::values.program_args.empty()) {
-        const auto arg_data{Settings::values.program_args};
-
-        codeset.DataSegment().size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
-        NSOArgumentHeader args_header{
-            NSO_ARGUMENT_DATA_ALLOCATION_SIZE, static_cast<u32_le>(arg_data.size()), {}};
-        const auto end_offset = program_image.size();
-        program_image.resize(static_cast<u32>(program_image.size()) +
-                             NSO_ARGUMENT_DATA_ALLOCATION_SIZE);
-        std::memcpy(program_image.data() + end_offset, &args_header, sizeof(NSOArgumentHeader));
-        std::memcpy(program_image.data() + end_offset + sizeof(NSOArgumentHeader), arg_data.data(),
-                    arg_data.size());
+    NSOImageBuilder image_builder;
+    const std::unique_ptr<NSOImage> image = image_builder.Read(nso_file, should_pass_arguments);
+    if (!image) {
+        return std::nullopt;
     }
+    image_builder.Wait();
 
-    codeset.DataSegment().size += nso_header.segments[2].bss_size;
-    const u32 image_size{
-        PageAlignSize(static_cast<u32>(program_image.size()) + nso_header.segments[2].bss_size)};
-    program_image.resize(image_size);
+    return LoadImage(process, system, std::move(*image), nso_file.GetName(), load_base,
+                     std::move(pm));
+}
 
-    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        codeset.segments[i].size = PageAlignSize(codeset.segments[i].size);
-    }
+VAddr AppLoader_NSO::LoadImage(Kernel::KProcess& process, Core::System& system, NSOImage&& image,
+                               const std::string& name, VAddr load_base,
+                               std::optional<FileSys::PatchManager> pm) {
+    const NSOHeader& nso_header = image.header;
+    Kernel::PhysicalMemory& program_image = image.codeset.memory;
+    const std::size_t image_size = program_image.size();
 
     // Apply patches if necessary
     if (pm && (pm->HasNSOPatch(nso_header.build_id) || Settings::values.dump_nso)) {
         std::vector<u8> pi_header;
-        pi_header.insert(pi_header.begin(), reinterpret_cast<u8*>(&nso_header),
-                         reinterpret_cast<u8*>(&nso_header) + sizeof(NSOHeader));
+        pi_header.insert(pi_header.begin(), reinterpret_cast<const u8*>(&nso_header),
+                         reinterpret_cast<const u8*>(&nso_header) + sizeof(NSOHeader));
         pi_header.insert(pi_header.begin() + sizeof(NSOHeader), program_image.data(),
                          program_image.data() + program_image.size());
 
-        pi_header = pm->PatchNSO(pi_header, nso_file.GetName());
+        pi_header = pm->PatchNSO(pi_header, name);
 
         std::copy(pi_header.begin() + sizeof(NSOHeader), pi_header.end(), program_image.data());
     }
 
-    // If we aren't actually loading (i.e. just computing the process code layout), we are done
-    if (!load_into_process) {
-        return load_base + image_size;
-    }
-
     // Apply cheats if they exist and the program has a valid title ID
     if (pm) {
         system.SetCurrentProcessBuildID(nso_header.build_id);
@@ -155,8 +273,7 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
     }
 
     // Load codeset for current process
-    codeset.memory = std::move(program_image);
-    process.LoadModule(std::move(codeset), load_base);
+    process.LoadModule(std::move(image.codeset), load_base);
 
     return load_base + image_size;
 }
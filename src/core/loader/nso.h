@@ -5,11 +5,15 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <memory>
 #include <optional>
+#include <string>
 #include <type_traits>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/file_sys/patch_manager.h"
+#include "core/hle/kernel/code_set.h"
 #include "core/loader/loader.h"
 
 namespace Core {
@@ -68,6 +72,55 @@ struct NSOArgumentHeader {
 };
 static_assert(sizeof(NSOArgumentHeader) == 0x20, "NSOArgumentHeader has incorrect size.");
 
+/// Program image of an NSO module, built before the module is loaded into a process
+struct NSOImage {
+    NSOHeader header{};
+    Kernel::CodeSet codeset;
+    /// Compressed segments waiting to be decompressed into the image
+    std::vector<u8> compressed_data;
+};
+
+/**
+ * Builds the program images of NSO modules.
+ * Segments are read and decrypted on the calling thread, as reads through the VFS layers are not
+ * thread safe, and decompressed on worker threads straight into the image while the caller moves on
+ * to the next module.
+ */
+class NSOImageBuilder final {
+public:
+    struct Statistics {
+        /// Time spent reading and decrypting segments on the calling thread
+        std::chrono::nanoseconds read_time;
+        /// Time spent decompressing segments, summed over all threads
+        std::chrono::nanoseconds decompress_time;
+        /// Time the calling thread spent waiting for decompression to finish
+        std::chrono::nanoseconds wait_time;
+    };
+
+    NSOImageBuilder();
+    ~NSOImageBuilder();
+
+    NSOImageBuilder(const NSOImageBuilder&) = delete;
+    NSOImageBuilder& operator=(const NSOImageBuilder&) = delete;
+
+    /**
+     * Reads an NSO and queues the decompression of its segments, the image is complete after Wait.
+     * Compressed segments of a file mapped in memory are decompressed straight out of the mapping,
+     * so the file must outlive Wait.
+     */
+    [[nodiscard]] std::unique_ptr<NSOImage> Read(const FileSys::VfsFile& nso_file,
+                                                 bool should_pass_arguments);
+
+    /// Blocks until every queued segment has been decompressed
+    void Wait();
+
+    [[nodiscard]] Statistics GetStatistics() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
 /// Loads an NSO file
 class AppLoader_NSO final : public AppLoader {
 public:
@@ -91,6 +144,11 @@ public:
                                            bool should_pass_arguments, bool load_into_process,
                                            std::optional<FileSys::PatchManager> pm = {});
 
+    /// Patches a program image built by NSOImageBuilder and loads it into the process
+    static VAddr LoadImage(Kernel::KProcess& process, Core::System& system, NSOImage&& image,
+                           const std::string& name, VAddr load_base,
+                           std::optional<FileSys::PatchManager> pm = {});
+
     LoadResult Load(Kernel::KProcess& process, Core::System& system) override;
 
     ResultStatus ReadNSOModules(Modules& out_modules) override;
@@ -94,6 +94,50 @@ struct Memory::Impl {
         return nullptr;
     }
 
+    template <bool is_write>
+    u8* GetContiguousPointer(const VAddr vaddr, const std::size_t size) {
+        if (size == 0) {
+            return nullptr;
+        }
+        const auto& page_table = system.CurrentProcess()->PageTable().PageTableImpl();
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + size - 1) >> PAGE_BITS;
+        if (last_page < first_page || last_page >= page_table.pointers.size()) {
+            return nullptr;
+        }
+        u8* base = nullptr;
+        bool is_cached = false;
+        for (std::size_t page = first_page; page <= last_page; ++page) {
+            const auto [pointer, type] = page_table.pointers[page].PointerType();
+            const auto page_vaddr = static_cast<VAddr>(page << PAGE_BITS);
+            u8* host_ptr = nullptr;
+            switch (type) {
+            case Common::PageType::Memory:
+                host_ptr = pointer + page_vaddr;
+                break;
+            case Common::PageType::RasterizerCachedMemory:
+                if constexpr (is_write) {
+                    return nullptr;
+                }
+                host_ptr = GetPointerFromRasterizerCachedMemory(page_vaddr);
+                is_cached = true;
+                break;
+            default:
+                return nullptr;
+            }
+            if (page == first_page) {
+                base = host_ptr;
+            }
+            if (!host_ptr || host_ptr != base + ((page - first_page) << PAGE_BITS)) {
+                return nullptr;
+            }
+        }
+        if (is_cached) {
+            system.GPU().FlushRegion(vaddr, size);
+        }
+        return base + (vaddr & PAGE_MASK);
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -805,6 +849,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+const u8* Memory::GetReadPointer(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer<false>(vaddr, size);
+}
+
+u8* Memory::GetWritePointer(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer<true>(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -141,6 +141,30 @@ public:
         return reinterpret_cast<T*>(GetPointer(vaddr));
     }
 
+    /**
+     * Gets a pointer to a range of the current process' address space that is contiguous in host
+     * memory, flushing the pages modified by the GPU.
+     *
+     * @param vaddr Virtual address of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The pointer to the range, or nullptr if the range is not mapped or it is split
+     *          across host allocations.
+     */
+    const u8* GetReadPointer(VAddr vaddr, std::size_t size);
+
+    /**
+     * Gets a pointer to a range of the current process' address space that can be written without
+     * going through WriteBlock, the range has to be contiguous in host memory and can't be cached
+     * by the GPU.
+     *
+     * @param vaddr Virtual address of the range.
+     * @param size  Size of the range in bytes.
+     *
+     * @returns The pointer to the range, or nullptr if it can't be written in place.
+     */
+    u8* GetWritePointer(VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -0,0 +1,244 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Headless benchmark of the NVDEC decode pipeline. Traces recorded with the dump_nvdec setting hold
+// the H.264 and VP9 bitstreams games submitted, exactly as they were sent to FFmpeg. Each trace is
+// replayed synchronously on a single decoding thread, like NVDEC used to decode on the GPU thread,
+// and through the asynchronous frame-threaded decode worker.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <getopt.h>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "video_core/command_classes/codecs/decode_worker.h"
+#include "video_core/command_classes/nvdec_common.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Tegra::DecodeWorker;
+using Tegra::NvdecCommon::VideoCodec;
+
+struct Trace {
+    std::string name;
+    VideoCodec codec;
+    std::vector<std::vector<u8>> packets;
+};
+
+struct Result {
+    /// Time the caller was blocked submitting each packet
+    std::vector<Clock::duration> submit_latencies;
+    std::size_t num_frames{};
+    double seconds{};
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <nvdec trace files or directories>\n"
+                 "-i, --iterations      Number of times each trace is decoded (default 1)\n"
+                 "-t, --threads         FFmpeg threads of the async decoder (default: automatic)\n"
+                 "-l, --log-filter      Log filter, errors are printed by default\n"
+                 "-h, --help            Display this help and exit\n";
+}
+
+void InitializeLogging(const std::string& filter_string) {
+    using namespace Common;
+
+    Log::Filter log_filter(Log::Level::Error);
+    log_filter.ParseFilterString(filter_string);
+    Log::SetGlobalFilter(log_filter);
+
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+void LoadTraceFile(const std::filesystem::path& path, std::vector<Trace>& traces) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    Tegra::NvdecTrace::Header header{};
+    if (!file.IsOpen() || !file.ReadObject(header) || header.magic != Tegra::NvdecTrace::MAGIC) {
+        LOG_ERROR(Frontend, "{} is not an NVDEC trace", path.string());
+        return;
+    }
+    Trace trace{
+        .name = path.filename().string(),
+        .codec = static_cast<VideoCodec>(header.codec),
+        .packets = {},
+    };
+    u32 packet_size{};
+    while (file.ReadObject(packet_size)) {
+        std::vector<u8> packet(packet_size);
+        if (file.Read(packet) != packet_size) {
+            LOG_ERROR(Frontend, "{} is truncated", path.string());
+            break;
+        }
+        trace.packets.push_back(std::move(packet));
+    }
+    if (trace.packets.empty()) {
+        LOG_ERROR(Frontend, "{} has no packets", path.string());
+        return;
+    }
+    traces.push_back(std::move(trace));
+}
+
+/// Consumes the decoded frames like VIC does, one per submitted packet
+std::size_t TakeFrames(DecodeWorker& worker, std::size_t max_frames) {
+    std::size_t num_frames = 0;
+    while (num_frames < max_frames && worker.GetFrame()) {
+        ++num_frames;
+    }
+    return num_frames;
+}
+
+/**
+ * Decodes a trace
+ * @param is_async When false, every packet is waited on before the next one is submitted
+ */
+Result RunTrace(const Trace& trace, int num_threads, bool is_async) {
+    DecodeWorker worker(trace.codec, num_threads);
+    if (!worker.IsInitialized()) {
+        return {};
+    }
+    Result result;
+    const Clock::time_point start = Clock::now();
+    for (const std::vector<u8>& packet : trace.packets) {
+        const Clock::time_point submit = Clock::now();
+        worker.QueuePacket(std::vector<u8>(packet));
+        if (!is_async) {
+            worker.WaitIdle();
+        }
+        result.submit_latencies.push_back(Clock::now() - submit);
+        result.num_frames += TakeFrames(worker, 1);
+    }
+    worker.WaitIdle();
+    result.num_frames += TakeFrames(worker, DecodeWorker::MAX_QUEUED_FRAMES);
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+/// Prints the latency percentiles of a mode in microseconds
+void PrintLatencies(std::string_view mode, std::vector<Clock::duration> latencies) {
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](std::size_t percent) {
+        const std::size_t index = (latencies.size() - 1) * percent / 100;
+        return std::chrono::duration<double, std::micro>(latencies[index]).count();
+    };
+    Clock::duration total{};
+    for (const Clock::duration latency : latencies) {
+        total += latency;
+    }
+    const double mean = std::chrono::duration<double, std::micro>(total).count() /
+                        static_cast<double>(latencies.size());
+    fmt::print("{:<10} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n", mode,
+               latencies.size(), mean, percentile(50), percentile(90), percentile(99),
+               percentile(100));
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::filesystem::path> paths;
+    std::size_t iterations = 1;
+    int num_threads = 0;
+    std::string log_filter = "*:Error";
+
+    static struct option long_options[] = {
+        {"iterations", required_argument, 0, 'i'},
+        {"threads", required_argument, 0, 't'},
+        {"log-filter", required_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    int option_index = 0;
+    while (optind < argc) {
+        const int arg = getopt_long(argc, argv, "i:t:l:h", long_options, &option_index);
+        if (arg == -1) {
+            paths.emplace_back(argv[optind]);
+            ++optind;
+            continue;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'i':
+            iterations = std::max<std::size_t>(std::stoul(optarg), 1);
+            break;
+        case 't':
+            num_threads = std::max(std::stoi(optarg), 0);
+            break;
+        case 'l':
+            log_filter = optarg;
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return 0;
+        default:
+            PrintHelp(argv[0]);
+            return 1;
+        }
+    }
+    if (paths.empty()) {
+        PrintHelp(argv[0]);
+        return 1;
+    }
+    InitializeLogging(log_filter);
+
+    std::vector<Trace> traces;
+    for (const std::filesystem::path& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            LoadTraceFile(path, traces);
+            continue;
+        }
+        for (const auto& dir_entry : std::filesystem::directory_iterator{path}) {
+            if (dir_entry.is_regular_file() && dir_entry.path().extension() == ".nvdt") {
+                LoadTraceFile(dir_entry.path(), traces);
+            }
+        }
+    }
+    if (traces.empty()) {
+        std::cerr << "No traces were loaded\n";
+        return 1;
+    }
+
+    for (const Trace& trace : traces) {
+        fmt::print("{}: {} packets\n", trace.name, trace.packets.size());
+        fmt::print("{:<10} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "submit (us)", "count",
+                   "mean", "p50", "p90", "p99", "max");
+        for (const bool is_async : {false, true}) {
+            Result total;
+            for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+                Result result = RunTrace(trace, is_async ? num_threads : 1, is_async);
+                total.submit_latencies.insert(total.submit_latencies.end(),
+                                              result.submit_latencies.begin(),
+                                              result.submit_latencies.end());
+                total.num_frames += result.num_frames;
+                total.seconds += result.seconds;
+            }
+            if (total.submit_latencies.empty()) {
+                std::cerr << "Failed to initialize the decoder\n";
+                return 1;
+            }
+            const std::string_view mode = is_async ? "async" : "sync";
+            PrintLatencies(mode, total.submit_latencies);
+            fmt::print("{:<10} {:.1f} packets/s, {} frames presented ({:.3f} s wall time)\n", mode,
+                       static_cast<double>(total.submit_latencies.size()) / total.seconds,
+                       total.num_frames, total.seconds);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,340 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+// Headless benchmark of the shader pipeline. Shaders are loaded from OpenGL transferable caches,
+// which hold the program code and the registry keys of every shader a game has used, then decoded
+// and decompiled to each backend's language without creating a GPU context.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <getopt.h>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/renderer_opengl/gl_arb_decompiler.h"
+#include "video_core/renderer_opengl/gl_device.h"
+#include "video_core/renderer_opengl/gl_shader_decompiler.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/renderer_vulkan/vk_shader_decompiler.h"
+#include "video_core/shader/compiler_settings.h"
+#include "video_core/shader/memory_util.h"
+#include "video_core/shader/registry.h"
+#include "video_core/shader/shader_ir.h"
+#include "video_core/vulkan_common/vulkan_device.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Maxwell = Tegra::Engines::Maxwell3D::Regs;
+using OpenGL::ShaderDiskCacheEntry;
+using Tegra::Engines::ShaderType;
+using VideoCommon::Shader::CompileDepth;
+using VideoCommon::Shader::CompilerSettings;
+using VideoCommon::Shader::ShaderIR;
+
+enum class Backend : u32 {
+    GLSL,
+    ARB,
+    SPIRV,
+};
+constexpr std::array BACKEND_NAMES{"glsl", "arb", "spirv"};
+constexpr std::size_t NUM_BACKENDS = BACKEND_NAMES.size();
+
+// Same settings the renderers compile their shaders with
+constexpr CompilerSettings OPENGL_COMPILER_SETTINGS{};
+constexpr CompilerSettings VULKAN_COMPILER_SETTINGS{
+    .depth = CompileDepth::FullDecompile,
+    .disable_else_derivation = true,
+};
+
+struct Job {
+    const ShaderDiskCacheEntry* entry;
+    Backend backend;
+};
+
+struct Sample {
+    Clock::duration decode;
+    Clock::duration decompile;
+};
+
+struct Devices {
+    const OpenGL::Device& gl;
+    const Vulkan::Device& vulkan;
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <transferable cache files or directories>\n"
+                 "-b, --backend         Backend to decompile to: glsl, arb, spirv or all\n"
+                 "-i, --iterations      Number of times each shader is compiled (default 1)\n"
+                 "-t, --threads         Number of worker threads (default: hardware threads)\n"
+                 "-l, --log-filter      Log filter, errors are printed by default\n"
+                 "-h, --help            Display this help and exit\n";
+}
+
+void InitializeLogging(const std::string& filter_string) {
+    using namespace Common;
+
+    Log::Filter log_filter(Log::Level::Error);
+    log_filter.ParseFilterString(filter_string);
+    Log::SetGlobalFilter(log_filter);
+
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+}
+
+void LoadCacheFile(const std::filesystem::path& path, std::vector<ShaderDiskCacheEntry>& entries) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    u32 version{};
+    if (!file.IsOpen() || !file.ReadObject(version)) {
+        LOG_ERROR(Frontend, "Failed to read {}", path.string());
+        return;
+    }
+    if (version != OpenGL::ShaderDiskCacheOpenGL::GetTransferableVersion()) {
+        LOG_ERROR(Frontend, "{} has version {}, expected {}", path.string(), version,
+                  OpenGL::ShaderDiskCacheOpenGL::GetTransferableVersion());
+        return;
+    }
+    auto file_entries = OpenGL::ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+    if (!file_entries) {
+        return;
+    }
+    entries.insert(entries.end(), std::make_move_iterator(file_entries->begin()),
+                   std::make_move_iterator(file_entries->end()));
+}
+
+Vulkan::Specialization MakeSpecialization(const ShaderDiskCacheEntry& entry) {
+    Vulkan::Specialization specialization;
+    if (entry.type == ShaderType::Compute) {
+        specialization.workgroup_size = entry.compute_info.workgroup_size;
+        specialization.shared_memory_size = entry.compute_info.shared_memory_size_in_words * 4;
+        return specialization;
+    }
+    // Attribute state is not part of the cache, assume every attribute is a float
+    specialization.enabled_attributes.set();
+    specialization.attribute_types.fill(Maxwell::VertexAttribute::Type::Float);
+    return specialization;
+}
+
+Sample RunJob(const Job& job, const Devices& devices) {
+    const ShaderDiskCacheEntry& entry = *job.entry;
+    const bool is_compute = entry.type == ShaderType::Compute;
+    const u32 main_offset = is_compute ? VideoCommon::Shader::KERNEL_MAIN_OFFSET
+                                       : VideoCommon::Shader::STAGE_MAIN_OFFSET;
+    const CompilerSettings& settings =
+        job.backend == Backend::SPIRV ? VULKAN_COMPILER_SETTINGS : OPENGL_COMPILER_SETTINGS;
+    const auto registry = entry.MakeRegistry();
+
+    const Clock::time_point start = Clock::now();
+    const ShaderIR ir(entry.code, main_offset, settings, *registry);
+    const Clock::time_point decoded = Clock::now();
+
+    const std::string identifier = fmt::format("{:016X}", entry.unique_identifier);
+    std::size_t output_size = 0;
+    switch (job.backend) {
+    case Backend::GLSL:
+        output_size =
+            OpenGL::DecompileShader(devices.gl, ir, *registry, entry.type, identifier).size();
+        break;
+    case Backend::ARB:
+        output_size =
+            OpenGL::DecompileAssemblyShader(devices.gl, ir, *registry, entry.type, identifier)
+                .size();
+        break;
+    case Backend::SPIRV:
+        output_size = Vulkan::Decompile(devices.vulkan, ir, entry.type, *registry,
+                                        MakeSpecialization(entry))
+                          .size();
+        break;
+    }
+    const Clock::time_point end = Clock::now();
+    if (output_size == 0) {
+        LOG_ERROR(Frontend, "Shader {} produced no {} code", identifier,
+                  BACKEND_NAMES[static_cast<std::size_t>(job.backend)]);
+    }
+    return Sample{
+        .decode = decoded - start,
+        .decompile = end - decoded,
+    };
+}
+
+/// Prints the latency percentiles of a stage in microseconds
+void PrintLatencies(std::string_view stage, std::vector<Clock::duration> latencies) {
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](std::size_t percent) {
+        const std::size_t index = (latencies.size() - 1) * percent / 100;
+        return std::chrono::duration<double, std::micro>(latencies[index]).count();
+    };
+    Clock::duration total{};
+    for (const Clock::duration latency : latencies) {
+        total += latency;
+    }
+    const double mean = std::chrono::duration<double, std::micro>(total).count() /
+                        static_cast<double>(latencies.size());
+    fmt::print("{:<10} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f}\n", stage,
+               latencies.size(), mean, percentile(50), percentile(90), percentile(99),
+               percentile(100));
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::filesystem::path> paths;
+    std::array<bool, NUM_BACKENDS> enabled_backends{};
+    std::size_t iterations = 1;
+    std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::string log_filter = "*:Error";
+
+    static struct option long_options[] = {
+        {"backend", required_argument, 0, 'b'},
+        {"iterations", required_argument, 0, 'i'},
+        {"threads", required_argument, 0, 't'},
+        {"log-filter", required_argument, 0, 'l'},
+        {"help", no_argument, 0, 'h'},
+        {0, 0, 0, 0},
+    };
+
+    int option_index = 0;
+    while (optind < argc) {
+        const int arg = getopt_long(argc, argv, "b:i:t:l:h", long_options, &option_index);
+        if (arg == -1) {
+            paths.emplace_back(argv[optind]);
+            ++optind;
+            continue;
+        }
+        switch (static_cast<char>(arg)) {
+        case 'b': {
+            const std::string_view backend = optarg;
+            bool found = backend == "all";
+            for (std::size_t i = 0; i < NUM_BACKENDS; ++i) {
+                if (backend == "all" || backend == BACKEND_NAMES[i]) {
+                    enabled_backends[i] = true;
+                    found = true;
+                }
+            }
+            if (!found) {
+                std::cerr << "Unknown backend: " << backend << '\n';
+                return 1;
+            }
+            break;
+        }
+        case 'i':
+            iterations = std::max<std::size_t>(std::stoul(optarg), 1);
+            break;
+        case 't':
+            num_threads = std::max<std::size_t>(std::stoul(optarg), 1);
+            break;
+        case 'l':
+            log_filter = optarg;
+            break;
+        case 'h':
+            PrintHelp(argv[0]);
+            return 0;
+        default:
+            PrintHelp(argv[0]);
+            return 1;
+        }
+    }
+    if (paths.empty()) {
+        PrintHelp(argv[0]);
+        return 1;
+    }
+    if (std::none_of(enabled_backends.begin(), enabled_backends.end(), [](bool x) { return x; })) {
+        enabled_backends.fill(true);
+    }
+    InitializeLogging(log_filter);
+
+    std::vector<ShaderDiskCacheEntry> entries;
+    for (const std::filesystem::path& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            LoadCacheFile(path, entries);
+            continue;
+        }
+        for (const auto& dir_entry : std::filesystem::directory_iterator{path}) {
+            if (dir_entry.is_regular_file() && dir_entry.path().extension() == ".bin") {
+                LoadCacheFile(dir_entry.path(), entries);
+            }
+        }
+    }
+    if (entries.empty()) {
+        std::cerr << "No shaders were loaded\n";
+        return 1;
+    }
+
+    std::vector<Job> jobs;
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration) {
+        for (std::size_t backend = 0; backend < NUM_BACKENDS; ++backend) {
+            if (!enabled_backends[backend]) {
+                continue;
+            }
+            for (const ShaderDiskCacheEntry& entry : entries) {
+                jobs.push_back(Job{&entry, static_cast<Backend>(backend)});
+            }
+        }
+    }
+    fmt::print("Compiling {} shaders {} times on {} threads\n", entries.size(),
+               jobs.size() / entries.size(), num_threads);
+
+    const OpenGL::Device gl_device(nullptr);
+    const Vulkan::Device vulkan_device(nullptr);
+    const Devices devices{gl_device, vulkan_device};
+
+    // Each job writes its own sample, workers only share the index of the next job
+    std::vector<Sample> samples(jobs.size());
+    std::atomic_size_t next_job{0};
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back([&] {
+                for (std::size_t job = next_job++; job < jobs.size(); job = next_job++) {
+                    samples[job] = RunJob(jobs[job], devices);
+                }
+            });
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("{:<10} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10}\n", "stage (us)", "count", "mean",
+               "p50", "p90", "p99", "max");
+    for (std::size_t backend = 0; backend < NUM_BACKENDS; ++backend) {
+        std::vector<Clock::duration> latencies;
+        for (std::size_t job = 0; job < jobs.size(); ++job) {
+            if (jobs[job].backend == static_cast<Backend>(backend)) {
+                latencies.push_back(samples[job].decompile);
+            }
+        }
+        PrintLatencies(BACKEND_NAMES[backend], std::move(latencies));
+    }
+    std::vector<Clock::duration> decode_latencies;
+    for (const Sample& sample : samples) {
+        decode_latencies.push_back(sample.decode);
+    }
+    PrintLatencies("decode", std::move(decode_latencies));
+
+    fmt::print("Throughput: {:.1f} shaders/s ({:.3f} s wall time)\n",
+               static_cast<double>(jobs.size()) / seconds, seconds);
+    return 0;
+}
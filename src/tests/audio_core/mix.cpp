@@ -0,0 +1,226 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "audio_core/algorithm/mix.h"
+#include "audio_core/codec.h"
+#include "audio_core/common.h"
+#include "common/common_types.h"
+
+namespace {
+using namespace AudioCore;
+
+/// Sample counts covering the vector steps and every tail length
+constexpr std::array<std::size_t, 6> SAMPLE_COUNTS{0, 1, 3, 4, 161, 240};
+
+std::vector<s32> RandomSamples(std::size_t count, s32 min, s32 max, u32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<s32> dist(min, max);
+    std::vector<s32> samples(count);
+    std::generate(samples.begin(), samples.end(), [&] { return dist(rng); });
+    return samples;
+}
+
+s32 Saturate(s64 value) {
+    return static_cast<s32>(std::clamp<s64>(value, std::numeric_limits<s32>::min(),
+                                            std::numeric_limits<s32>::max()));
+}
+
+s32 ScaleQ15(s32 sample, s32 gain) {
+    return static_cast<s32>((static_cast<s64>(sample) * gain + 0x4000) >> 15);
+}
+
+/// Random ADPCM frames with valid headers
+std::vector<u8> RandomAdpcmFrames(std::size_t frame_count, u32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<u32> dist(0, 255);
+    std::vector<u8> frames(frame_count * 8);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        const u32 value = dist(rng);
+        frames[i] = static_cast<u8>(i % 8 == 0 ? value & 0x7b : value);
+    }
+    return frames;
+}
+
+constexpr Codec::ADPCM_Coeff ADPCM_COEFFS{
+    2048, 0, 4096, -2048, 0, 0, 1024, 1024, 3072, -1024, 2500, -1400, 1800, -600, 3900, -1900,
+};
+} // Anonymous namespace
+
+TEST_CASE("Mix: MixInto matches the scalar reference and saturates", "[audio_core]") {
+    for (const std::size_t count : SAMPLE_COUNTS) {
+        const std::vector<s32> input = RandomSamples(count, -0x800000, 0x7fffff, 1);
+        std::vector<s32> output = RandomSamples(count, std::numeric_limits<s32>::min(),
+                                                std::numeric_limits<s32>::max(), 2);
+        for (const s32 gain : {32768, 12345, -20000, 0x7fffff}) {
+            std::vector<s32> expected = output;
+            for (std::size_t i = 0; i < count; ++i) {
+                expected[i] = Saturate(s64{expected[i]} + ScaleQ15(input[i], gain));
+            }
+            Mix::MixInto(output, input, gain);
+            REQUIRE(output == expected);
+        }
+    }
+}
+
+TEST_CASE("Mix: MixRamp matches the scalar reference", "[audio_core]") {
+    for (const std::size_t count : SAMPLE_COUNTS) {
+        const std::vector<s32> input = RandomSamples(count, -0x8000, 0x7fff, 3);
+        std::vector<s32> output = RandomSamples(count, -0x10000, 0x10000, 4);
+        const float gain = 0.75f;
+        const float delta = -0.5f / 240.0f;
+
+        std::vector<s32> expected = output;
+        s32 expected_last = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const float ramp = gain + delta * static_cast<float>(i);
+            expected_last = static_cast<s32>(static_cast<float>(input[i]) * ramp);
+            expected[i] = Saturate(s64{expected[i]} + expected_last);
+        }
+        REQUIRE(Mix::MixRamp(output, input, gain, delta) == expected_last);
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("Mix: ApplyGain matches the scalar reference in place", "[audio_core]") {
+    for (const std::size_t count : SAMPLE_COUNTS) {
+        std::vector<s32> samples = RandomSamples(count, -0x800000, 0x7fffff, 5);
+        const s32 gain = 20000;
+        const s32 delta = -37;
+
+        std::vector<s32> expected(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            expected[i] = ScaleQ15(samples[i], gain + delta * static_cast<s32>(i));
+        }
+        Mix::ApplyGain(samples, samples, gain, delta);
+        REQUIRE(samples == expected);
+    }
+}
+
+TEST_CASE("Codec: DecodeADPCMFrames matches DecodeADPCM", "[audio_core]") {
+    constexpr std::size_t frame_count = 37;
+    const std::vector<u8> frames = RandomAdpcmFrames(frame_count, 6);
+
+    Codec::ADPCMState reference_state{123, -456};
+    const std::vector<s16> reference =
+        Codec::DecodeADPCM(frames.data(), frames.size(), ADPCM_COEFFS, reference_state);
+
+    Codec::ADPCMState state{123, -456};
+    std::vector<s32> decoded(frame_count * 14);
+    Codec::DecodeADPCMFrames(frames, ADPCM_COEFFS, state, decoded);
+
+    REQUIRE(std::equal(decoded.begin(), decoded.end(), reference.begin()));
+    REQUIRE(state.yn1 == reference_state.yn1);
+    REQUIRE(state.yn2 == reference_state.yn2);
+}
+
+TEST_CASE("Mix: Render a frame of 96 voices", "[.][benchmark]") {
+    AudioCommon::AudioRendererParameter params{};
+    params.sample_rate = 48000;
+    params.sample_count = 240;
+    params.mix_buffer_count = 24;
+    params.submix_count = 4;
+    params.voice_count = 96;
+
+    const std::size_t sample_count = params.sample_count;
+    const std::size_t frames_per_voice = (sample_count + 13) / 14;
+    const std::size_t channels_per_submix = params.mix_buffer_count / (params.submix_count + 1);
+    std::vector<std::vector<u8>> voice_data;
+    for (u32 voice = 0; voice < params.voice_count; ++voice) {
+        voice_data.push_back(RandomAdpcmFrames(frames_per_voice, voice));
+    }
+    std::vector<s32> voice_samples(frames_per_voice * 14);
+    std::vector<s32> mix_buffers(params.mix_buffer_count * sample_count);
+    const auto mix_buffer = [&](std::size_t index) {
+        return std::span<s32>(mix_buffers).subspan(index * sample_count, sample_count);
+    };
+
+    // One render: decode each voice, ramp it into a submix, mix the submixes into the final mix
+    // and apply the final gain, like the command generator does for a simple voice setup.
+    const auto render = [&](auto&& decode, auto&& mix_ramp, auto&& mix, auto&& gain) {
+        std::fill(mix_buffers.begin(), mix_buffers.end(), 0);
+        for (u32 voice = 0; voice < params.voice_count; ++voice) {
+            Codec::ADPCMState state{};
+            decode(voice_data[voice], state, voice_samples);
+            const std::size_t submix = 1 + voice % params.submix_count;
+            for (std::size_t channel = 0; channel < channels_per_submix; ++channel) {
+                mix_ramp(mix_buffer(submix * channels_per_submix + channel),
+                         std::span<const s32>(voice_samples).first(sample_count), 0.5f,
+                         0.25f / static_cast<float>(sample_count));
+            }
+        }
+        for (std::size_t submix = 1; submix <= params.submix_count; ++submix) {
+            for (std::size_t channel = 0; channel < channels_per_submix; ++channel) {
+                mix(mix_buffer(channel), mix_buffer(submix * channels_per_submix + channel),
+                    24576);
+            }
+        }
+        for (std::size_t channel = 0; channel < channels_per_submix; ++channel) {
+            gain(mix_buffer(channel), mix_buffer(channel), 30000);
+        }
+    };
+
+    // Previous path: one sample at a time and a vector per decoded voice
+    const auto scalar_decode = [](std::span<const u8> frames, Codec::ADPCMState& state,
+                                  std::span<s32> output) {
+        const std::vector<s16> decoded =
+            Codec::DecodeADPCM(frames.data(), frames.size(), ADPCM_COEFFS, state);
+        std::copy(decoded.begin(), decoded.end(), output.begin());
+    };
+    const auto scalar_mix_ramp = [](std::span<s32> output, std::span<const s32> input,
+                                    float gain, float delta) {
+        for (std::size_t i = 0; i < output.size(); ++i) {
+            output[i] += static_cast<s32>(static_cast<float>(input[i]) * gain);
+            gain += delta;
+        }
+    };
+    const auto scalar_mix = [](std::span<s32> output, std::span<const s32> input, s32 gain) {
+        for (std::size_t i = 0; i < output.size(); ++i) {
+            output[i] += ScaleQ15(input[i], gain);
+        }
+    };
+    const auto scalar_gain = [](std::span<s32> output, std::span<const s32> input, s32 gain) {
+        for (std::size_t i = 0; i < output.size(); ++i) {
+            output[i] = ScaleQ15(input[i], gain);
+        }
+    };
+    const auto batched_decode = [](std::span<const u8> frames, Codec::ADPCMState& state,
+                                   std::span<s32> output) {
+        Codec::DecodeADPCMFrames(frames, ADPCM_COEFFS, state, output);
+    };
+    const auto kernel_gain = [](std::span<s32> output, std::span<const s32> input, s32 gain) {
+        Mix::ApplyGain(output, input, gain);
+    };
+
+    using Clock = std::chrono::steady_clock;
+    constexpr int iterations = 2000;
+    const auto microseconds = [](Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+    };
+
+    const Clock::time_point scalar_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        render(scalar_decode, scalar_mix_ramp, scalar_mix, scalar_gain);
+    }
+    const Clock::time_point scalar_end = Clock::now();
+
+    const Clock::time_point kernel_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        render(batched_decode, Mix::MixRamp, Mix::MixInto, kernel_gain);
+    }
+    const Clock::time_point kernel_end = Clock::now();
+
+    fmt::print("{} voices, {} samples per render: scalar {:.1f} us, kernels {:.1f} us\n",
+               params.voice_count, params.sample_count, microseconds(scalar_start, scalar_end),
+               microseconds(kernel_start, kernel_end));
+}
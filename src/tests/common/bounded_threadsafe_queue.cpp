@@ -0,0 +1,148 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "common/bounded_threadsafe_queue.h"
+#include "common/common_types.h"
+#include "common/threadsafe_queue.h"
+
+namespace Common {
+
+TEST_CASE("BoundedMPSCQueue: Basic Tests", "[common]") {
+    BoundedMPSCQueue<int, 4> queue;
+    REQUIRE(queue.Empty());
+
+    // Pushing into a queue with room should succeed and hand out increasing tickets.
+    for (int i = 0; i < 4; ++i) {
+        std::size_t ticket{};
+        REQUIRE(queue.TryPush(i, &ticket));
+        REQUIRE(ticket == static_cast<std::size_t>(i));
+    }
+    REQUIRE(queue.Size() == 4U);
+    REQUIRE(queue.NextTicket() == 4U);
+
+    // Pushing into a full queue should fail.
+    REQUIRE(!queue.TryPush(42));
+    REQUIRE(queue.Size() == 4U);
+    REQUIRE(queue.NextTicket() == 4U);
+
+    // Elements are popped in push order.
+    int value{};
+    REQUIRE(queue.TryPop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.TryPop(value));
+    REQUIRE(value == 1);
+
+    // Popping makes room for new elements, which wrap around the ring.
+    REQUIRE(queue.TryPush(4));
+    REQUIRE(queue.TryPush(5));
+    REQUIRE(!queue.TryPush(6));
+
+    for (int expected = 2; expected < 6; ++expected) {
+        REQUIRE(queue.PopWait() == expected);
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(!queue.TryPop(value));
+}
+
+TEST_CASE("BoundedMPSCQueue: Stop while full", "[common]") {
+    BoundedMPSCQueue<int, 2> queue;
+    REQUIRE(queue.Push(1).has_value());
+    REQUIRE(queue.Push(2).has_value());
+
+    std::stop_source stop_source;
+    std::optional<std::size_t> ticket{0};
+    std::thread producer([&] {
+        // The queue is never drained, this push can only return through the stop token.
+        ticket = queue.Push(3, stop_source.get_token());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stop_source.request_stop();
+    producer.join();
+
+    REQUIRE(!ticket.has_value());
+    REQUIRE(queue.Size() == 2U);
+}
+
+TEST_CASE("BoundedMPSCQueue: Multiple producers", "[common]") {
+    constexpr std::size_t num_producers = 4;
+    constexpr u32 count = 100000;
+
+    // A tiny queue forces producers through the full queue and sleeping consumer paths.
+    BoundedMPSCQueue<u64, 16> queue;
+    std::vector<std::thread> producers;
+    for (u64 producer = 0; producer < num_producers; ++producer) {
+        producers.emplace_back([&queue, producer] {
+            for (u32 i = 0; i < count; ++i) {
+                queue.Push((producer << 32) | i);
+            }
+        });
+    }
+
+    // Elements of each producer must arrive in the order they were pushed.
+    std::array<u32, num_producers> next{};
+    for (std::size_t i = 0; i < num_producers * count; ++i) {
+        const u64 value = queue.PopWait();
+        const auto producer = static_cast<std::size_t>(value >> 32);
+        REQUIRE(producer < num_producers);
+        REQUIRE(static_cast<u32>(value) == next[producer]);
+        ++next[producer];
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    REQUIRE(queue.Empty());
+}
+
+namespace {
+template <typename Queue>
+double MeasureProducers(Queue& queue, std::size_t num_producers, u32 count) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < num_producers; ++producer) {
+        producers.emplace_back([&queue, count] {
+            for (u32 i = 0; i < count; ++i) {
+                queue.Push(u64{i});
+            }
+        });
+    }
+    u64 value{};
+    for (std::size_t i = 0; i < num_producers * count; ++i) {
+        value = queue.PopWait();
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    static_cast<void>(value);
+    return std::chrono::duration<double>(end - start).count();
+}
+} // Anonymous namespace
+
+TEST_CASE("BoundedMPSCQueue: Benchmark against MPSCQueue", "[.][benchmark]") {
+    constexpr u32 count = 1000000;
+    for (std::size_t num_producers = 1; num_producers <= 4; ++num_producers) {
+        const u64 pushes = num_producers * count;
+
+        MPSCQueue<u64> mpsc_queue;
+        const double mpsc_time = MeasureProducers(mpsc_queue, num_producers, count);
+
+        auto bounded_queue = std::make_unique<BoundedMPSCQueue<u64, 1024>>();
+        const double bounded_time = MeasureProducers(*bounded_queue, num_producers, count);
+
+        fmt::print("{} producer(s): MPSCQueue {:.1f} Mops/s, BoundedMPSCQueue {:.1f} Mops/s\n",
+                   num_producers, pushes / mpsc_time / 1e6, pushes / bounded_time / 1e6);
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,148 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+
+namespace {
+/// Type that can't be copied into the log ring, it is formatted in the calling thread
+struct Point {
+    int x;
+    int y;
+};
+
+/// Backend that keeps the messages it receives
+class CaptureBackend : public Common::Log::Backend {
+public:
+    explicit CaptureBackend(std::shared_ptr<std::vector<std::string>> messages_,
+                            std::shared_ptr<std::mutex> mutex_)
+        : messages{std::move(messages_)}, mutex{std::move(mutex_)} {}
+
+    static const char* Name() {
+        return "capture";
+    }
+    const char* GetName() const override {
+        return Name();
+    }
+    void Write(const Common::Log::Entry& entry) override {
+        std::scoped_lock lock{*mutex};
+        messages->push_back(entry.message);
+    }
+
+private:
+    std::shared_ptr<std::vector<std::string>> messages;
+    std::shared_ptr<std::mutex> mutex;
+};
+
+/// Backend that discards everything it receives
+class NullBackend : public Common::Log::Backend {
+public:
+    static const char* Name() {
+        return "null";
+    }
+    const char* GetName() const override {
+        return Name();
+    }
+    void Write(const Common::Log::Entry&) override {}
+};
+} // Anonymous namespace
+
+template <>
+struct fmt::formatter<Point> {
+    constexpr auto parse(format_parse_context& ctx) {
+        return ctx.begin();
+    }
+    template <typename FormatContext>
+    auto format(const Point& point, FormatContext& ctx) {
+        return fmt::format_to(ctx.out(), "({}, {})", point.x, point.y);
+    }
+};
+
+TEST_CASE("Logging: Deferred arguments are formatted in the logging thread", "[common]") {
+    auto messages = std::make_shared<std::vector<std::string>>();
+    auto mutex = std::make_shared<std::mutex>();
+    Common::Log::SetGlobalFilter(Common::Log::Filter{Common::Log::Level::Info});
+    Common::Log::AddBackend(std::make_unique<CaptureBackend>(messages, mutex));
+
+    {
+        // The string is destroyed before the logging thread formats the message
+        std::string name = "deferred";
+        LOG_INFO(Common, "{} {} {:#x} {:.1f} {}", name, std::string_view{"view"}, u32{0xcafe},
+                 2.5, true);
+    }
+    {
+        // The format is overwritten before the logging thread formats the message
+        char format[] = "local {}";
+        LOG_INFO(Common, format, 3);
+        std::fill(std::begin(format), std::end(format) - 1, 'x');
+    }
+    const char* null_string = nullptr;
+    LOG_INFO(Common, "null {}", null_string);
+    LOG_INFO(Common, "no arguments {{}}");
+    LOG_INFO(Common, "point {}", Point{1, 2});
+    LOG_DEBUG(Common, "filtered {}", 1);
+
+    const std::vector<std::string> expected{
+        "deferred view 0xcafe 2.5 true",
+        "local 3",
+        "null (null)",
+        "no arguments {}",
+        "point (1, 2)",
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    std::vector<std::string> received;
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::scoped_lock lock{*mutex};
+            received = *messages;
+        }
+        if (received.size() >= expected.size()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    Common::Log::RemoveBackend(CaptureBackend::Name());
+    REQUIRE(received == expected);
+}
+
+TEST_CASE("Logging: Log from the emulated thread", "[.][benchmark]") {
+    Common::Log::SetGlobalFilter(Common::Log::Filter{Common::Log::Level::Trace});
+    Common::Log::AddBackend(std::make_unique<NullBackend>());
+
+    // Bursts shorter than a ring, like a traced subsystem logging every call
+    constexpr std::size_t num_bursts = 64;
+    constexpr std::size_t burst_size = 1024;
+    double seconds = 0.0;
+    for (std::size_t burst = 0; burst < num_bursts; ++burst) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < burst_size; ++i) {
+            LOG_DEBUG(Common, "Called, address=0x{:016X}, size={}, name={}", i * 0x1000, i,
+                      "service");
+        }
+        const auto end = std::chrono::steady_clock::now();
+        seconds += std::chrono::duration<double>(end - start).count();
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+    }
+    Common::Log::RemoveBackend(NullBackend::Name());
+    Common::Log::SetGlobalFilter(Common::Log::Filter{});
+
+    constexpr std::size_t num_messages = num_bursts * burst_size;
+    fmt::print("Logging: {:.1f} ns per message\n",
+               seconds * 1e9 / static_cast<double>(num_messages));
+}
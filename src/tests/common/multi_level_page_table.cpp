@@ -0,0 +1,57 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "common/multi_level_page_table.h"
+
+namespace Common {
+
+TEST_CASE("MultiLevelPageTable: Leaves are allocated on demand", "[common]") {
+    MultiLevelPageTable<u32, 16, 8> table;
+    REQUIRE(table.NumLeaves() == 0);
+    REQUIRE(table.Get(0x1234) == 0);
+
+    // Setting an empty entry does not allocate
+    table.Set(0x1234, 0);
+    REQUIRE(table.NumLeaves() == 0);
+
+    table.Set(0x1234, 7);
+    table.Set(0x12ff, 8);
+    REQUIRE(table.NumLeaves() == 1);
+    REQUIRE(table.Get(0x1234) == 7);
+    REQUIRE(table.Get(0x12ff) == 8);
+    REQUIRE(table.Get(0x1235) == 0);
+
+    table.Set(0xffff, 9);
+    REQUIRE(table.NumLeaves() == 2);
+    REQUIRE(table.Get(0xffff) == 9);
+}
+
+TEST_CASE("MultiLevelPageTable: Leaves are kept once allocated", "[common]") {
+    MultiLevelPageTable<u32, 16, 8> table;
+    const std::size_t empty_usage = table.MemoryUsage();
+
+    table.Set(0x100, 1);
+    table.Set(0x101, 2);
+    REQUIRE(table.MemoryUsage() > empty_usage);
+
+    table.Set(0x100, 3);
+    table.Set(0x101, 0);
+    REQUIRE(table.NumLeaves() == 1);
+    REQUIRE(table.Get(0x100) == 3);
+    REQUIRE(table.Get(0x101) == 0);
+
+    // Emptying a leaf doesn't free it, readers on other threads may still be looking at it
+    table.Set(0x100, 0);
+    REQUIRE(table.NumLeaves() == 1);
+    REQUIRE(table.Get(0x100) == 0);
+
+    table.Set(0x1ff, 4);
+    REQUIRE(table.NumLeaves() == 1);
+    REQUIRE(table.Get(0x1ff) == 4);
+}
+
+} // namespace Common
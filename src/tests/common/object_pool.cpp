@@ -0,0 +1,63 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/object_pool.h"
+
+namespace Common {
+
+namespace {
+struct Counted {
+    explicit Counted(int value_, int& live_) : value{value_}, live{live_} {
+        ++live;
+    }
+    ~Counted() {
+        --live;
+    }
+
+    int value;
+    int& live;
+};
+} // Anonymous namespace
+
+TEST_CASE("ObjectPool: Objects are stable across chunks", "[common]") {
+    int live = 0;
+    ObjectPool<Counted> pool{4};
+    std::vector<Counted*> objects;
+    for (int i = 0; i < 10; ++i) {
+        objects.push_back(pool.Create(i, live));
+    }
+    REQUIRE(live == 10);
+    REQUIRE(pool.Size() == 10U);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(objects[static_cast<std::size_t>(i)]->value == i);
+    }
+}
+
+TEST_CASE("ObjectPool: Release destroys every object", "[common]") {
+    int live = 0;
+    {
+        ObjectPool<Counted> pool{4};
+        for (int i = 0; i < 9; ++i) {
+            static_cast<void>(pool.Create(i, live));
+        }
+        const std::size_t memory_usage = pool.MemoryUsage();
+        pool.ReleaseContents();
+        REQUIRE(live == 0);
+        REQUIRE(pool.Size() == 0U);
+        REQUIRE(pool.MemoryUsage() < memory_usage);
+
+        // The pool can be reused after its contents are released
+        static_cast<void>(pool.Create(42, live));
+        REQUIRE(live == 1);
+        REQUIRE(pool.Size() == 1U);
+    }
+    REQUIRE(live == 0);
+}
+
+} // namespace Common
@@ -4,12 +4,16 @@
 
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -144,3 +148,89 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[UnscheduleEvent]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::mutex fired_mutex;
+    std::vector<std::uintptr_t> fired;
+    const auto callback = [&](std::uintptr_t user_data, std::chrono::nanoseconds) {
+        std::scoped_lock lock{fired_mutex};
+        fired.push_back(user_data);
+    };
+    const auto event_a = Core::Timing::CreateEvent("callbackA", callback);
+    const auto event_b = Core::Timing::CreateEvent("callbackB", callback);
+
+    core_timing.SyncPause(true);
+
+    // Schedule in reverse so the queue has to reorder them
+    for (std::uintptr_t i = 10; i-- > 0;) {
+        const auto future_ns = std::chrono::milliseconds{static_cast<s64>(i + 1)};
+        core_timing.ScheduleEvent(future_ns, event_a, i);
+        core_timing.ScheduleEvent(future_ns, event_b, i + 100);
+    }
+    for (std::uintptr_t i = 1; i < 10; i += 2) {
+        core_timing.UnscheduleEvent(event_a, i);
+    }
+    core_timing.RemoveEvent(event_b);
+
+    core_timing.Pause(false);
+
+    while (core_timing.HasPendingEvents())
+        ;
+
+    std::scoped_lock lock{fired_mutex};
+    REQUIRE(fired == std::vector<std::uintptr_t>{0, 2, 4, 6, 8});
+}
+
+TEST_CASE("CoreTiming[Stress]", "[.][benchmark]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    constexpr std::size_t num_events = 10000;
+    const auto empty_callback = [](std::uintptr_t, std::chrono::nanoseconds) {};
+    std::vector<std::shared_ptr<Core::Timing::EventType>> events;
+    for (std::size_t i = 0; i < num_events; i++) {
+        events.push_back(Core::Timing::CreateEvent("stress", empty_callback));
+    }
+    std::vector<std::size_t> order(num_events);
+    for (std::size_t i = 0; i < num_events; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937{1234});
+
+    core_timing.SyncPause(true);
+
+    // Events far enough in the future to never fire while measuring
+    const auto future = [](std::size_t i) { return std::chrono::seconds{60 + i % 60}; };
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::size_t i : order) {
+        core_timing.ScheduleEvent(future(i), events[i], i);
+    }
+    const auto scheduled = std::chrono::steady_clock::now();
+
+    // Pad updates, vsync and audio reschedule by unscheduling and scheduling again
+    for (std::size_t round = 0; round < 10; round++) {
+        for (const std::size_t i : order) {
+            core_timing.UnscheduleEvent(events[i], i);
+            core_timing.ScheduleEvent(future(i + round), events[i], i);
+        }
+    }
+    const auto rescheduled = std::chrono::steady_clock::now();
+
+    for (const std::size_t i : order) {
+        core_timing.RemoveEvent(events[i]);
+    }
+    const auto removed = std::chrono::steady_clock::now();
+
+    REQUIRE(!core_timing.Advance().has_value());
+
+    const auto to_ms = [](auto duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    printf("CoreTiming Stress: schedule %zu: %.3f ms\n", num_events, to_ms(scheduled - start));
+    printf("CoreTiming Stress: reschedule %zu: %.3f ms\n", num_events * 10,
+           to_ms(rescheduled - scheduled));
+    printf("CoreTiming Stress: remove %zu: %.3f ms\n", num_events, to_ms(removed - rescheduled));
+}
@@ -0,0 +1,169 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/key_manager.h"
+#include "core/crypto/xts_encryption_layer.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using Core::Crypto::AESCipher;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 rng{seed};
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+/// Encrypts data the way an NCA section is laid out, with the block index in the IV low half
+std::vector<u8> EncryptCTRSection(const std::vector<u8>& plain, const Key128& key,
+                                  const Core::Crypto::CTREncryptionLayer::IVData& nonce) {
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    cipher.SetIV(nonce);
+    std::vector<u8> encrypted(plain.size());
+    cipher.Transcode(plain.data(), plain.size(), encrypted.data(), Op::Encrypt);
+    return encrypted;
+}
+} // Anonymous namespace
+
+TEST_CASE("AESCipher[CTRKnownAnswer]", "[core]") {
+    // NIST SP 800-38A, F.5.1 CTR-AES128.Encrypt
+    const Key128 key{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                     0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    const std::array<u8, 16> counter{0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                     0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+    const std::array<u8, 32> plain{0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+                                   0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+                                   0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+                                   0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51};
+    const std::array<u8, 32> expected{0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+                                      0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+                                      0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+                                      0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff};
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    cipher.SetIV(counter);
+    std::array<u8, 32> encrypted{};
+    cipher.Transcode(plain.data(), plain.size(), encrypted.data(), Op::Encrypt);
+    REQUIRE(encrypted == expected);
+
+    // Decrypting in place gives the plaintext back
+    cipher.SetIV(counter);
+    cipher.Transcode(encrypted.data(), encrypted.size(), encrypted.data(), Op::Decrypt);
+    REQUIRE(encrypted == plain);
+}
+
+TEST_CASE("AESCipher[XTSKnownAnswer]", "[core]") {
+    // IEEE 1619-2007, XTS-AES-128 test vector 2
+    Key256 key{};
+    std::fill(key.begin(), key.begin() + 0x10, u8{0x11});
+    std::fill(key.begin() + 0x10, key.end(), u8{0x22});
+    const std::array<u8, 16> tweak{0x33, 0x33, 0x33, 0x33, 0x33};
+    const std::array<u8, 32> expected{0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e,
+                                      0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+                                      0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4,
+                                      0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0};
+    std::array<u8, 32> data{};
+    data.fill(0x44);
+
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    cipher.SetIV(tweak);
+    cipher.Transcode(data.data(), data.size(), data.data(), Op::Encrypt);
+    REQUIRE(data == expected);
+
+    cipher.SetIV(tweak);
+    cipher.Transcode(data.data(), data.size(), data.data(), Op::Decrypt);
+    REQUIRE(std::all_of(data.begin(), data.end(), [](u8 byte) { return byte == 0x44; }));
+}
+
+TEST_CASE("CTREncryptionLayer[UnalignedReads]", "[core]") {
+    const Key128 key{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const Core::Crypto::CTREncryptionLayer::IVData nonce{0xde, 0xad, 0xbe, 0xef};
+    const std::vector<u8> plain = RandomBytes(0x10000, 1);
+
+    auto encrypted = std::make_shared<FileSys::VectorVfsFile>(EncryptCTRSection(plain, key, nonce));
+    Core::Crypto::CTREncryptionLayer layer(encrypted, key, 0);
+    layer.SetIV(nonce);
+
+    std::mt19937 rng{2};
+    for (std::size_t i = 0; i < 256; ++i) {
+        const std::size_t offset = rng() % plain.size();
+        const std::size_t length = rng() % 0x400;
+        std::vector<u8> out(length);
+        const std::size_t read = layer.Read(out.data(), length, offset);
+        REQUIRE(read == std::min(length, plain.size() - offset));
+        REQUIRE(std::equal(out.begin(), out.begin() + read, plain.begin() + offset));
+    }
+}
+
+TEST_CASE("XTSEncryptionLayer[UnalignedReads]", "[core]") {
+    constexpr std::size_t sector_size = 0x4000;
+    Key256 key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i * 3);
+    }
+    const std::vector<u8> plain = RandomBytes(sector_size * 8, 3);
+    std::vector<u8> encrypted(plain.size());
+    AESCipher<Key256> cipher(key, Mode::XTS);
+    cipher.XTSTranscode(plain.data(), plain.size(), encrypted.data(), 0, sector_size, Op::Encrypt);
+
+    Core::Crypto::XTSEncryptionLayer layer(
+        std::make_shared<FileSys::VectorVfsFile>(std::move(encrypted)), key);
+
+    std::mt19937 rng{4};
+    for (std::size_t i = 0; i < 64; ++i) {
+        const std::size_t offset = rng() % plain.size();
+        const std::size_t length = rng() % (sector_size * 3);
+        std::vector<u8> out(length);
+        const std::size_t read = layer.Read(out.data(), length, offset);
+        REQUIRE(read == std::min(length, plain.size() - offset));
+        REQUIRE(std::equal(out.begin(), out.begin() + read, plain.begin() + offset));
+    }
+}
+
+TEST_CASE("CTREncryptionLayer[Throughput]", "[.][benchmark]") {
+    // Synthetic NCA section: 64 MiB of CTR encrypted data read in chunks like RomFS streaming
+    constexpr std::size_t section_size = 64ULL << 20;
+    const Key128 key{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const Core::Crypto::CTREncryptionLayer::IVData nonce{0xde, 0xad, 0xbe, 0xef};
+    const std::vector<u8> plain = RandomBytes(section_size, 5);
+
+    Core::Crypto::CTREncryptionLayer layer(
+        std::make_shared<FileSys::VectorVfsFile>(EncryptCTRSection(plain, key, nonce)), key, 0);
+    layer.SetIV(nonce);
+
+    std::vector<u8> out(section_size);
+    for (const std::size_t chunk_size : {std::size_t{0x200}, std::size_t{0x4000},
+                                         std::size_t{0x100000}}) {
+        const auto start = std::chrono::steady_clock::now();
+        // Offset by one byte so every chunk also goes through the unaligned path
+        for (std::size_t offset = 1; offset + chunk_size <= section_size; offset += chunk_size) {
+            layer.Read(out.data() + offset, chunk_size, offset);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        printf("CTREncryptionLayer chunk 0x%zx: %.1f MiB/s\n", chunk_size,
+               static_cast<double>(section_size) / seconds / (1 << 20));
+    }
+    REQUIRE(std::equal(out.begin() + 1, out.end() - 0x100000, plain.begin() + 1));
+}
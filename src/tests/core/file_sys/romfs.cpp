@@ -0,0 +1,383 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_layered.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+std::vector<u8> RandomData(std::size_t size, u32 seed) {
+    std::mt19937 rng(seed);
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+/// Directory of files with random contents, spread over a few subdirectories
+FileSys::VirtualDir MakeTree(std::size_t file_count, std::size_t file_size) {
+    constexpr std::size_t directory_count = 4;
+    std::vector<FileSys::VirtualDir> directories;
+    for (std::size_t dir = 0; dir < directory_count; ++dir) {
+        std::vector<FileSys::VirtualFile> files;
+        for (std::size_t file = dir; file < file_count; file += directory_count) {
+            files.push_back(std::make_shared<FileSys::VectorVfsFile>(
+                RandomData(file_size, static_cast<u32>(file)), fmt::format("file{}.bin", file)));
+        }
+        directories.push_back(std::make_shared<FileSys::VectorVfsDirectory>(
+            std::move(files), std::vector<FileSys::VirtualDir>{}, fmt::format("dir{}", dir)));
+    }
+    return std::make_shared<FileSys::VectorVfsDirectory>(std::vector<FileSys::VirtualFile>{},
+                                                         std::move(directories), "root");
+}
+
+/// Directory of empty files, named like game assets, spread over dir_count subdirectories
+FileSys::VirtualDir MakeWideTree(std::size_t dir_count, std::size_t files_per_dir) {
+    std::vector<FileSys::VirtualDir> directories;
+    for (std::size_t dir = 0; dir < dir_count; ++dir) {
+        std::vector<FileSys::VirtualFile> files;
+        for (std::size_t file = 0; file < files_per_dir; ++file) {
+            files.push_back(std::make_shared<FileSys::VectorVfsFile>(
+                std::vector<u8>{}, fmt::format("asset_{:04}.bfres", file)));
+        }
+        directories.push_back(std::make_shared<FileSys::VectorVfsDirectory>(
+            std::move(files), std::vector<FileSys::VirtualDir>{}, fmt::format("model{:03}", dir)));
+    }
+    return std::make_shared<FileSys::VectorVfsDirectory>(std::vector<FileSys::VirtualFile>{},
+                                                         std::move(directories), "root");
+}
+
+/// Copies a directory tree into vector directories, like ExtractRomFS used to build up front
+FileSys::VirtualDir Materialize(const FileSys::VirtualDir& dir) {
+    std::vector<FileSys::VirtualDir> subdirectories;
+    for (const auto& subdirectory : dir->GetSubdirectories()) {
+        subdirectories.push_back(Materialize(subdirectory));
+    }
+    return std::make_shared<FileSys::VectorVfsDirectory>(dir->GetFiles(), std::move(subdirectories),
+                                                         dir->GetName());
+}
+
+FileSys::VirtualDir MakeDir(std::string name, std::vector<FileSys::VirtualFile> files,
+                            std::vector<FileSys::VirtualDir> dirs = {}) {
+    return std::make_shared<FileSys::VectorVfsDirectory>(std::move(files), std::move(dirs),
+                                                         std::move(name));
+}
+
+FileSys::VirtualFile MakeFile(std::string name, std::vector<u8> data) {
+    return std::make_shared<FileSys::VectorVfsFile>(std::move(data), std::move(name));
+}
+
+/// Builds a RomFS image of the tree in a single file, like a decrypted RomFS section
+FileSys::VirtualFile MakeRomFS(const FileSys::VirtualDir& tree) {
+    const FileSys::VirtualFile romfs = FileSys::CreateRomFS(tree);
+    return std::make_shared<FileSys::VectorVfsFile>(romfs->ReadAllBytes(), "romfs.bin");
+}
+} // Anonymous namespace
+
+TEST_CASE("RomFS: Files read back from an extracted image", "[core]") {
+    const FileSys::VirtualDir tree = MakeTree(10, 0x1234);
+    const FileSys::VirtualDir romfs =
+        FileSys::ExtractRomFS(MakeRomFS(tree), FileSys::RomFSExtractionType::Full);
+    REQUIRE(romfs != nullptr);
+
+    for (const auto& dir : tree->GetSubdirectories()) {
+        const FileSys::VirtualDir extracted_dir = romfs->GetSubdirectory(dir->GetName());
+        REQUIRE(extracted_dir != nullptr);
+        for (const auto& file : dir->GetFiles()) {
+            const FileSys::VirtualFile extracted = extracted_dir->GetFile(file->GetName());
+            REQUIRE(extracted != nullptr);
+            REQUIRE(extracted->GetSize() == file->GetSize());
+
+            // Unaligned read straight into a caller buffer, like fsp-srv does
+            std::vector<u8> buffer(file->GetSize() - 3);
+            REQUIRE(extracted->Read(buffer.data(), buffer.size(), 3) == buffer.size());
+            REQUIRE(std::memcmp(buffer.data(), file->ReadAllBytes().data() + 3, buffer.size()) ==
+                    0);
+        }
+    }
+}
+
+TEST_CASE("RomFS: Paths resolve through the hash tables", "[core]") {
+    const auto make_file = [](std::string name, u32 seed) {
+        return std::make_shared<FileSys::VectorVfsFile>(RandomData(0x100, seed), std::move(name));
+    };
+    const auto deep = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<FileSys::VirtualFile>{make_file("c.bin", 3)},
+        std::vector<FileSys::VirtualDir>{}, "deep");
+    const auto sub = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<FileSys::VirtualFile>{make_file("b.bin", 2)},
+        std::vector<FileSys::VirtualDir>{deep}, "sub");
+    const auto empty = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<FileSys::VirtualFile>{}, std::vector<FileSys::VirtualDir>{}, "empty");
+    const auto tree = std::make_shared<FileSys::VectorVfsDirectory>(
+        std::vector<FileSys::VirtualFile>{make_file("a.txt", 1)},
+        std::vector<FileSys::VirtualDir>{sub, empty}, "root");
+
+    const FileSys::VirtualDir romfs =
+        FileSys::ExtractRomFS(MakeRomFS(tree), FileSys::RomFSExtractionType::Full);
+    REQUIRE(romfs != nullptr);
+
+    const FileSys::VirtualFile c = romfs->GetFileRelative("sub/deep/c.bin");
+    REQUIRE(c != nullptr);
+    REQUIRE(c->GetName() == "c.bin");
+    REQUIRE(c->ReadAllBytes() == RandomData(0x100, 3));
+    REQUIRE(romfs->GetFileRelative("/sub//deep\\c.bin") != nullptr);
+    REQUIRE(romfs->GetFile("a.txt")->ReadAllBytes() == RandomData(0x100, 1));
+
+    // Names only match entries of their own type and parent
+    REQUIRE(romfs->GetFileRelative("sub/c.bin") == nullptr);
+    REQUIRE(romfs->GetFileRelative("deep/c.bin") == nullptr);
+    REQUIRE(romfs->GetFileRelative("sub/deep") == nullptr);
+    REQUIRE(romfs->GetDirectoryRelative("a.txt") == nullptr);
+    REQUIRE(romfs->GetFileRelative("") == nullptr);
+
+    const FileSys::VirtualDir deep_dir = romfs->GetDirectoryRelative("sub/deep");
+    REQUIRE(deep_dir != nullptr);
+    REQUIRE(deep_dir->GetName() == "deep");
+    REQUIRE(deep_dir->GetParentDirectory()->GetName() == "sub");
+    REQUIRE(deep_dir->GetParentDirectory()->GetParentDirectory()->IsRoot());
+
+    const auto entries = romfs->GetSubdirectory("sub")->GetEntries();
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries.at("b.bin") == FileSys::VfsEntryType::File);
+    REQUIRE(entries.at("deep") == FileSys::VfsEntryType::Directory);
+
+    const FileSys::VirtualDir empty_dir = romfs->GetSubdirectory("empty");
+    REQUIRE(empty_dir != nullptr);
+    REQUIRE(empty_dir->GetFiles().empty());
+    REQUIRE(empty_dir->GetSubdirectories().empty());
+}
+
+TEST_CASE("RomFS: Open and lookup time of a large image", "[.][benchmark]") {
+    constexpr std::size_t dir_count = 256;
+    constexpr std::size_t files_per_dir = 400;
+    constexpr int lookups = 100000;
+    const FileSys::VirtualFile image = MakeRomFS(MakeWideTree(dir_count, files_per_dir));
+
+    std::vector<std::string> paths(lookups);
+    std::mt19937 rng(1);
+    for (std::string& path : paths) {
+        const std::size_t dir = rng() % dir_count;
+        path = fmt::format("model{:03}/asset_{:04}.bfres", dir, rng() % files_per_dir);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const auto milliseconds = [](Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    const Clock::time_point open_start = Clock::now();
+    const FileSys::VirtualDir romfs =
+        FileSys::ExtractRomFS(image, FileSys::RomFSExtractionType::Full);
+    const Clock::time_point open_end = Clock::now();
+    REQUIRE(romfs != nullptr);
+
+    const FileSys::VirtualDir materialized = Materialize(romfs);
+    const Clock::time_point materialize_end = Clock::now();
+
+    const auto time_lookups = [&](const FileSys::VirtualDir& dir) {
+        std::size_t found = 0;
+        const Clock::time_point start = Clock::now();
+        for (const std::string& path : paths) {
+            found += dir->GetFileRelative(path) != nullptr ? 1 : 0;
+        }
+        const Clock::time_point end = Clock::now();
+        REQUIRE(found == paths.size());
+        return milliseconds(start, end) * 1000.0 / lookups;
+    };
+
+    fmt::print("{} files: open {:.2f} ms, building the whole tree {:.2f} ms\n",
+               dir_count * files_per_dir, milliseconds(open_start, open_end),
+               milliseconds(open_end, materialize_end));
+    fmt::print("lookups: hash tables {:.2f} us, vector directories {:.2f} us\n",
+               time_lookups(romfs), time_lookups(materialized));
+}
+
+TEST_CASE("RomFS: LayeredFS merges layers and reuses the cached layout", "[core]") {
+    const std::filesystem::path cache_path =
+        std::filesystem::temp_directory_path() / "yuzu_layeredfs_test.bin";
+    Common::FS::RemoveFile(cache_path);
+
+    const FileSys::VirtualDir base = FileSys::ExtractRomFS(
+        MakeRomFS(MakeDir("root", {MakeFile("a.bin", RandomData(0x40, 1))},
+                          {MakeDir("dir", {MakeFile("b.bin", RandomData(0x20, 2)),
+                                           MakeFile("c.bin", RandomData(0x30, 3))}),
+                           MakeDir("gone", {MakeFile("d.bin", RandomData(0x10, 4))})})),
+        FileSys::RomFSExtractionType::Full);
+    REQUIRE(base != nullptr);
+
+    // Writes 4 bytes of 0xAA at 0x10
+    const std::vector<u8> ips{'P', 'A', 'T', 'C', 'H', 0x00, 0x00, 0x10, 0x00, 0x04,
+                              0xAA, 0xAA, 0xAA, 0xAA, 'E', 'O', 'F'};
+    const FileSys::VirtualDir ext = MakeDir(
+        "romfs_ext", {MakeFile("gone.stub", {}), MakeFile("a.bin.ips", ips)},
+        {MakeDir("dir", {MakeFile("c.bin.stub", {})})});
+
+    const auto build = [&](const FileSys::VirtualDir& mod) {
+        const FileSys::VirtualFile packed =
+            FileSys::CreateLayeredRomFS({mod, base}, {ext}, cache_path);
+        REQUIRE(packed != nullptr);
+        return packed;
+    };
+    const auto check = [&](const FileSys::VirtualFile& image) {
+        const FileSys::VirtualDir merged =
+            FileSys::ExtractRomFS(image, FileSys::RomFSExtractionType::Full);
+        REQUIRE(merged != nullptr);
+
+        std::vector<u8> patched = RandomData(0x40, 1);
+        std::fill_n(patched.begin() + 0x10, 4, u8{0xAA});
+        REQUIRE(merged->GetFile("a.bin")->ReadAllBytes() == patched);
+        REQUIRE(merged->GetFileRelative("dir/b.bin")->ReadAllBytes() == RandomData(0x50, 20));
+        REQUIRE(merged->GetFileRelative("dir/new.bin")->ReadAllBytes() == RandomData(0x18, 5));
+        REQUIRE(merged->GetFileRelative("dir/c.bin") == nullptr);
+        REQUIRE(merged->GetSubdirectory("gone") == nullptr);
+        return merged;
+    };
+
+    const FileSys::VirtualDir mod = MakeDir(
+        "romfs", {}, {MakeDir("dir", {MakeFile("b.bin", RandomData(0x50, 20)),
+                                      MakeFile("new.bin", RandomData(0x18, 5))})});
+    const FileSys::VirtualFile built = build(mod);
+    check(built);
+    REQUIRE(Common::FS::Exists(cache_path));
+
+    // Same inputs, the layout comes from the cache
+    const FileSys::VirtualFile cached = build(mod);
+    check(cached);
+    REQUIRE(cached->ReadAllBytes() == built->ReadAllBytes());
+
+    // A changed mod doesn't match the cache anymore
+    const FileSys::VirtualDir changed_mod = MakeDir(
+        "romfs", {MakeFile("more.bin", RandomData(0x8, 6))},
+        {MakeDir("dir", {MakeFile("b.bin", RandomData(0x50, 20)),
+                         MakeFile("new.bin", RandomData(0x18, 5))})});
+    const FileSys::VirtualDir changed = check(build(changed_mod));
+    REQUIRE(changed->GetFile("more.bin")->ReadAllBytes() == RandomData(0x8, 6));
+
+    // A broken cache is rebuilt
+    const std::vector<u8> garbage = RandomData(0x30, 7);
+    {
+        Common::FS::IOFile file{cache_path, Common::FS::FileAccessMode::Write,
+                                Common::FS::FileType::BinaryFile};
+        REQUIRE(file.WriteSpan(std::span{garbage}) == garbage.size());
+    }
+    check(build(mod));
+
+    REQUIRE(Common::FS::RemoveFile(cache_path));
+}
+
+TEST_CASE("RomFS: LayeredFS build time of a large image", "[.][benchmark]") {
+    const std::filesystem::path cache_path =
+        std::filesystem::temp_directory_path() / "yuzu_layeredfs_benchmark.bin";
+    Common::FS::RemoveFile(cache_path);
+
+    const FileSys::VirtualDir base = FileSys::ExtractRomFS(MakeRomFS(MakeWideTree(256, 400)),
+                                                           FileSys::RomFSExtractionType::Full);
+    REQUIRE(base != nullptr);
+    std::vector<FileSys::VirtualDir> mods;
+    for (int i = 0; i < 4; ++i) {
+        mods.push_back(MakeDir(
+            "romfs", {},
+            {MakeDir(fmt::format("model{:03}", i * 50),
+                     {MakeFile("asset_0000.bfres", RandomData(0x1000, static_cast<u32>(i)))})}));
+    }
+    const FileSys::VirtualDir ext = MakeDir("romfs_ext", {MakeFile("model255.stub", {})});
+
+    using Clock = std::chrono::steady_clock;
+    const auto time_build = [](auto&& build) {
+        const Clock::time_point start = Clock::now();
+        REQUIRE(build() != nullptr);
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    auto layers = mods;
+    layers.push_back(base);
+
+    const double single_layer = time_build([&] {
+        return FileSys::CreateRomFS(FileSys::LayeredVfsDirectory::MakeLayeredDirectory(layers),
+                                    ext);
+    });
+    const double uncached = time_build([&] { return FileSys::CreateLayeredRomFS(layers, {ext}); });
+    const double miss =
+        time_build([&] { return FileSys::CreateLayeredRomFS(layers, {ext}, cache_path); });
+    const double hit =
+        time_build([&] { return FileSys::CreateLayeredRomFS(layers, {ext}, cache_path); });
+
+    fmt::print("through a layered directory {:.2f} ms, layers {:.2f} ms, cache miss {:.2f} ms, "
+               "cache hit {:.2f} ms\n",
+               single_layer, uncached, miss, hit);
+
+    REQUIRE(Common::FS::RemoveFile(cache_path));
+}
+
+TEST_CASE("RomFS: fsp-srv read throughput", "[.][benchmark]") {
+    constexpr std::size_t file_count = 32;
+    constexpr std::size_t file_size = 4 << 20;
+    const FileSys::VirtualDir romfs =
+        FileSys::ExtractRomFS(MakeRomFS(MakeTree(file_count, file_size)),
+                              FileSys::RomFSExtractionType::Full);
+    REQUIRE(romfs != nullptr);
+
+    std::vector<FileSys::VirtualFile> files;
+    for (const auto& dir : romfs->GetSubdirectories()) {
+        for (const auto& file : dir->GetFiles()) {
+            files.push_back(file);
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    constexpr int iterations = 8;
+    const double total_mib =
+        static_cast<double>(file_count * file_size * iterations) / static_cast<double>(1 << 20);
+
+    for (const std::size_t chunk_size : {std::size_t{0x4000}, std::size_t{0x40000},
+                                         std::size_t{0x400000}}) {
+        // Stands in for the guest output buffer of the request
+        std::vector<u8> guest_buffer(chunk_size);
+
+        // Previous path: read into a new vector, then copy it into guest memory
+        const Clock::time_point copy_start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto& file : files) {
+                for (std::size_t offset = 0; offset < file_size; offset += chunk_size) {
+                    const std::vector<u8> data = file->ReadBytes(chunk_size, offset);
+                    std::memcpy(guest_buffer.data(), data.data(), data.size());
+                }
+            }
+        }
+        const Clock::time_point copy_end = Clock::now();
+
+        const Clock::time_point direct_start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (const auto& file : files) {
+                for (std::size_t offset = 0; offset < file_size; offset += chunk_size) {
+                    file->Read(guest_buffer.data(), chunk_size, offset);
+                }
+            }
+        }
+        const Clock::time_point direct_end = Clock::now();
+
+        const auto mib_per_second = [&](Clock::time_point start, Clock::time_point end) {
+            return total_mib / std::chrono::duration<double>(end - start).count();
+        };
+        fmt::print("{} KiB reads: ReadBytes and copy {:.0f} MiB/s, in place {:.0f} MiB/s\n",
+                   chunk_size >> 10, mib_per_second(copy_start, copy_end),
+                   mib_per_second(direct_start, direct_end));
+    }
+}
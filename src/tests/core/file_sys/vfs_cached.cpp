@@ -0,0 +1,150 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/path_util.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+using FileSys::BlockCache;
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 rng(seed);
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+/// Reads random ranges through the cached file and compares them with the source data
+void CheckRandomReads(const FileSys::VfsFile& file, const std::vector<u8>& source, u32 seed,
+                      int count) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::size_t> offset_dist(0, source.size() + 0x100);
+    std::uniform_int_distribution<std::size_t> length_dist(0, 5 * BlockCache::BLOCK_SIZE);
+    std::vector<u8> out;
+    for (int i = 0; i < count; ++i) {
+        const std::size_t offset = offset_dist(rng);
+        const std::size_t length = length_dist(rng);
+        out.assign(length, 0);
+        const std::size_t expected =
+            offset >= source.size() ? 0 : std::min(length, source.size() - offset);
+        REQUIRE(file.Read(out.data(), length, offset) == expected);
+        REQUIRE(std::equal(out.begin(), out.begin() + expected, source.begin() + offset));
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("CachedVfsFile: Random reads match the wrapped file", "[core]") {
+    // Odd size, so the last block is short
+    const std::vector<u8> source = RandomBytes(40 * BlockCache::BLOCK_SIZE + 123, 1);
+
+    SECTION("The whole file fits") {
+        BlockCache cache{64 * BlockCache::BLOCK_SIZE * 16};
+        const FileSys::CachedVfsFile file{std::make_shared<FileSys::VectorVfsFile>(source), cache};
+        CheckRandomReads(file, source, 2, 2000);
+
+        const BlockCache::Stats stats = cache.GetStats();
+        REQUIRE(stats.hits > 0);
+        REQUIRE(stats.misses <= 41);
+        REQUIRE(stats.evictions == 0);
+    }
+
+    SECTION("Blocks are evicted") {
+        BlockCache cache{2 * BlockCache::BLOCK_SIZE * 16};
+        const FileSys::CachedVfsFile file{std::make_shared<FileSys::VectorVfsFile>(source), cache};
+        CheckRandomReads(file, source, 3, 2000);
+
+        const BlockCache::Stats stats = cache.GetStats();
+        REQUIRE(stats.evictions > 0);
+        REQUIRE(stats.size <= 2 * BlockCache::BLOCK_SIZE * 16);
+    }
+
+    SECTION("The cache is disabled") {
+        BlockCache cache{0};
+        const FileSys::CachedVfsFile file{std::make_shared<FileSys::VectorVfsFile>(source), cache};
+        CheckRandomReads(file, source, 4, 200);
+        REQUIRE(cache.GetStats().size == 0);
+    }
+}
+
+TEST_CASE("CachedVfsFile: Concurrent readers", "[core]") {
+    const std::vector<u8> source = RandomBytes(64 * BlockCache::BLOCK_SIZE, 5);
+    BlockCache cache{16 * BlockCache::BLOCK_SIZE * 16};
+    const FileSys::CachedVfsFile file{std::make_shared<FileSys::VectorVfsFile>(source), cache};
+
+    std::vector<std::thread> threads;
+    for (u32 i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] { CheckRandomReads(file, source, 10 + i, 500); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(cache.GetStats().size <= 16 * BlockCache::BLOCK_SIZE * 16);
+}
+
+TEST_CASE("CachedVfsFile: Repeated reads of a file on disk", "[.][benchmark]") {
+    // Hot assets of a RomFS section: a 32 MiB working set read again and again in 64 KiB chunks
+    constexpr std::size_t file_size = 32 << 20;
+    constexpr std::size_t chunk_size = 0x10000;
+    constexpr int num_reads = 20000;
+
+    const auto path = std::filesystem::temp_directory_path() / "yuzu_vfs_cached_benchmark.bin";
+    FileSys::RealVfsFilesystem filesystem;
+    {
+        const FileSys::VirtualFile writer =
+            filesystem.CreateFile(Common::FS::PathToUTF8String(path), FileSys::Mode::ReadWrite);
+        REQUIRE(writer != nullptr);
+        writer->WriteBytes(RandomBytes(file_size, 6));
+    }
+    const FileSys::VirtualFile real =
+        filesystem.OpenFile(Common::FS::PathToUTF8String(path), FileSys::Mode::Read);
+    REQUIRE(real != nullptr);
+    const auto section = std::make_shared<FileSys::OffsetVfsFile>(real, file_size - 0x1000, 0x1000);
+
+    BlockCache cache{64 << 20};
+    const FileSys::CachedVfsFile cached{section, cache};
+
+    std::vector<std::size_t> offsets(num_reads);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> dist(0, section->GetSize() - chunk_size);
+    std::generate(offsets.begin(), offsets.end(), [&] { return dist(rng); });
+
+    std::vector<u8> out(chunk_size);
+    const auto time_reads = [&](const FileSys::VfsFile& file) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const std::size_t offset : offsets) {
+            file.Read(out.data(), chunk_size, offset);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / num_reads;
+    };
+
+    const double uncached = time_reads(*section);
+    const double cold = time_reads(cached);
+    const double warm = time_reads(cached);
+    const BlockCache::Stats stats = cache.GetStats();
+
+    fmt::print("64 KiB reads: uncached {:.2f} us, cold cache {:.2f} us, warm cache {:.2f} us, "
+               "{} hits, {} misses\n",
+               uncached, cold, warm, stats.hits, stats.misses);
+
+    filesystem.DeleteFile(Common::FS::PathToUTF8String(path));
+}
@@ -0,0 +1,164 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/path_util.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_real.h"
+
+namespace {
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 rng(seed);
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+std::string TempPath(std::string_view name) {
+    return Common::FS::PathToUTF8String(std::filesystem::temp_directory_path() / name);
+}
+
+/// Creates a file on disk with the given contents
+void WriteFile(FileSys::RealVfsFilesystem& filesystem, const std::string& path,
+               const std::vector<u8>& data) {
+    const FileSys::VirtualFile writer = filesystem.CreateFile(path, FileSys::Mode::ReadWrite);
+    REQUIRE(writer != nullptr);
+    REQUIRE(writer->WriteBytes(data) == data.size());
+}
+} // Anonymous namespace
+
+TEST_CASE("RealVfsFile: Files opened for reading are mapped", "[core]") {
+    const std::string path = TempPath("yuzu_vfs_real_mapped.bin");
+    const std::vector<u8> data = RandomBytes(0x12345, 1);
+    FileSys::RealVfsFilesystem filesystem;
+    WriteFile(filesystem, path, data);
+
+    const FileSys::VirtualFile file = filesystem.OpenFile(path, FileSys::Mode::Read);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->GetSize() == data.size());
+
+    const std::span<const u8> mapped = file->GetMappedData();
+    REQUIRE(mapped.size() == data.size());
+    REQUIRE(std::equal(mapped.begin(), mapped.end(), data.begin()));
+
+    // Reads past the end are clamped like reads through the file handle
+    std::vector<u8> out(0x100);
+    REQUIRE(file->Read(out.data(), out.size(), data.size() - 0x10) == 0x10);
+    REQUIRE(std::equal(out.begin(), out.begin() + 0x10, data.end() - 0x10));
+    REQUIRE(file->Read(out.data(), out.size(), data.size() + 1) == 0);
+
+    // Offset files hand out a view into the same mapping
+    const FileSys::OffsetVfsFile section{file, 0x1000, 0x2345};
+    const std::span<const u8> section_mapped = section.GetMappedData();
+    REQUIRE(section_mapped.data() == mapped.data() + 0x2345);
+    REQUIRE(section_mapped.size() == 0x1000);
+    section.AdviseAccess(Common::FS::AccessPattern::Random, 0, section.GetSize());
+
+    // Files opened for writing are never mapped
+    const FileSys::VirtualFile writable = filesystem.OpenFile(path, FileSys::Mode::ReadWrite);
+    REQUIRE(writable != nullptr);
+    REQUIRE(writable->GetMappedData().empty());
+
+    REQUIRE(filesystem.DeleteFile(path));
+}
+
+TEST_CASE("RealVfsFile: Writes invalidate the mappings of files that are being read", "[core]") {
+    const std::string path = TempPath("yuzu_vfs_real_written.bin");
+    const std::vector<u8> data = RandomBytes(0x4000, 2);
+    FileSys::RealVfsFilesystem filesystem;
+    WriteFile(filesystem, path, data);
+
+    // Both share the handle of the writer, the file is opened for writing first
+    const FileSys::VirtualFile writer = filesystem.OpenFile(path, FileSys::Mode::ReadWrite);
+    REQUIRE(writer != nullptr);
+    const FileSys::VirtualFile reader = filesystem.OpenFile(path, FileSys::Mode::Read);
+    REQUIRE(reader != nullptr);
+    REQUIRE(reader->GetMappedData().size() == data.size());
+
+    // The reader falls back to the file handle and sees the file grow
+    const std::vector<u8> tail = RandomBytes(0x100, 3);
+    REQUIRE(writer->WriteBytes(tail, data.size()) == tail.size());
+    REQUIRE(reader->GetMappedData().empty());
+    REQUIRE(reader->GetSize() == data.size() + tail.size());
+    REQUIRE(reader->ReadBytes(tail.size(), data.size()) == tail);
+
+    // Truncating the file must not leave the reader copying from pages past its end
+    REQUIRE(writer->Resize(0x100));
+    REQUIRE(reader->GetSize() == 0x100);
+    REQUIRE(reader->ReadAllBytes() == std::vector<u8>(data.begin(), data.begin() + 0x100));
+
+    // Files opened afterwards map the new contents
+    const FileSys::VirtualFile new_reader = filesystem.OpenFile(path, FileSys::Mode::Read);
+    REQUIRE(new_reader != nullptr);
+    REQUIRE(new_reader->GetMappedData().size() == 0x100);
+
+    REQUIRE(filesystem.DeleteFile(path));
+}
+
+TEST_CASE("RealVfsFile: Empty files are read through the file handle", "[core]") {
+    const std::string path = TempPath("yuzu_vfs_real_empty.bin");
+    FileSys::RealVfsFilesystem filesystem;
+    WriteFile(filesystem, path, {});
+
+    const FileSys::VirtualFile file = filesystem.OpenFile(path, FileSys::Mode::Read);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->GetSize() == 0);
+    REQUIRE(file->GetMappedData().empty());
+    REQUIRE(file->ReadAllBytes().empty());
+
+    REQUIRE(filesystem.DeleteFile(path));
+}
+
+TEST_CASE("RealVfsFile: Random reads of a game dump", "[.][benchmark]") {
+    constexpr std::size_t file_size = 64 << 20;
+    constexpr int num_reads = 20000;
+    const std::string path = TempPath("yuzu_vfs_real_benchmark.bin");
+    FileSys::RealVfsFilesystem filesystem;
+    WriteFile(filesystem, path, RandomBytes(file_size, 4));
+
+    // Opened for writing first, the shared file handle is only used when there is no mapping
+    const FileSys::VirtualFile handle = filesystem.OpenFile(path, FileSys::Mode::ReadWrite);
+    const FileSys::VirtualFile mapped = filesystem.OpenFile(path, FileSys::Mode::Read);
+    REQUIRE(handle->GetMappedData().empty());
+    REQUIRE(!mapped->GetMappedData().empty());
+
+    for (const std::size_t chunk_size : {std::size_t{0x200}, std::size_t{0x4000},
+                                         std::size_t{0x10000}}) {
+        std::vector<std::size_t> offsets(num_reads);
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<std::size_t> dist(0, file_size - chunk_size);
+        std::generate(offsets.begin(), offsets.end(), [&] { return dist(rng); });
+
+        std::vector<u8> out(chunk_size);
+        const auto time_reads = [&](const FileSys::VfsFile& file) {
+            const auto start = std::chrono::steady_clock::now();
+            for (const std::size_t offset : offsets) {
+                file.Read(out.data(), chunk_size, offset);
+            }
+            const auto end = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::micro>(end - start).count() / num_reads;
+        };
+
+        const double handle_time = time_reads(*handle);
+        const double mapped_time = time_reads(*mapped);
+        fmt::print("{} byte reads: file handle {:.2f} us, mapping {:.2f} us\n", chunk_size,
+                   handle_time, mapped_time);
+    }
+
+    REQUIRE(filesystem.DeleteFile(path));
+}
@@ -0,0 +1,215 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/k_handle_table.h"
+#include "core/hle/kernel/k_page_table.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/memory.h"
+
+namespace {
+/// Number of allocations done through the global operator new by the test binary
+std::atomic<u64> num_allocations{0};
+
+/// TIPC request with a copied handle, one X, one A and one B buffer and a word of data
+std::array<u32, IPC::COMMAND_BUFFER_LENGTH> MakeRequest() {
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+    cmd_buf[0] = (static_cast<u32>(IPC::CommandType::TIPC_CommandRegion) + 5) | (1U << 16) |
+                 (1U << 20) | (1U << 24);
+    cmd_buf[1] = 1U | (1U << 31); // One word of data, handle descriptor enabled
+    cmd_buf[2] = 1U << 1;         // One copied handle
+    cmd_buf[3] = 0x1234;
+    cmd_buf[4] = 0x40U << 16; // X buffer of 0x40 bytes at 0x1000
+    cmd_buf[5] = 0x1000;
+    cmd_buf[6] = 0x100; // A buffer of 0x100 bytes at 0x2000
+    cmd_buf[7] = 0x2000;
+    cmd_buf[9] = 0x200; // B buffer of 0x200 bytes at 0x3000
+    cmd_buf[10] = 0x3000;
+    cmd_buf[12] = 0xcafe;
+    return cmd_buf;
+}
+
+/// System::System is private. Parsing a request only reads the kernel and memory of the global
+/// instance, it doesn't need a running process.
+Core::System& GetSystem() {
+    return Core::System::GetInstance();
+}
+
+constexpr u64 PAGE_SIZE = Core::Memory::PAGE_SIZE;
+
+/// Host pages backing the guest pages of the buffers
+struct alignas(PAGE_SIZE) HostPages {
+    std::array<std::array<u8, PAGE_SIZE>, 3> pages{};
+};
+
+/// Makes the process current with a small page table, so buffers are read from its memory
+void SetupProcess(Core::System& system, Kernel::KProcess& process) {
+    process.PageTable().PageTableImpl().Resize(16, Core::Memory::PAGE_BITS);
+    system.Kernel().MakeCurrentProcess(&process);
+}
+
+/// Backs the guest page at the given address with a page of host memory
+void MapPage(Kernel::KProcess& process, VAddr vaddr, u8* host_page) {
+    Common::PageTable& page_table = process.PageTable().PageTableImpl();
+    page_table.pointers[vaddr >> Core::Memory::PAGE_BITS].Store(host_page - vaddr,
+                                                                Common::PageType::Memory);
+}
+} // Anonymous namespace
+
+void* operator new(std::size_t size) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* const pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+TEST_CASE("HLERequestContext: Parse descriptors and handles", "[core]") {
+    Core::System& system = GetSystem();
+    Kernel::KHandleTable handle_table{system.Kernel()};
+    auto cmd_buf = MakeRequest();
+
+    Kernel::HLERequestContext context{system.Kernel(), system.Memory(), nullptr, nullptr};
+    REQUIRE(context.PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data()).IsSuccess());
+
+    REQUIRE(context.IsTipc());
+    REQUIRE(context.GetCommand() == 5);
+    REQUIRE(context.GetCopyHandle(0) == 0x1234);
+    REQUIRE(context.BufferDescriptorX().size() == 1);
+    REQUIRE(context.BufferDescriptorX()[0].Address() == 0x1000);
+    REQUIRE(context.BufferDescriptorX()[0].Size() == 0x40);
+    REQUIRE(context.BufferDescriptorA().size() == 1);
+    REQUIRE(context.BufferDescriptorA()[0].Address() == 0x2000);
+    REQUIRE(context.GetReadBufferSize() == 0x100);
+    REQUIRE(context.BufferDescriptorB().size() == 1);
+    REQUIRE(context.GetWriteBufferSize() == 0x200);
+    REQUIRE(context.BufferDescriptorC().empty());
+}
+
+TEST_CASE("HLERequestContext: Buffer spans in place", "[core]") {
+    Core::System& system = GetSystem();
+    Kernel::KHandleTable handle_table{system.Kernel()};
+    Kernel::KProcess process{system.Kernel()};
+    SetupProcess(system, process);
+    auto cmd_buf = MakeRequest();
+
+    // Guest pages 0x1000-0x3FFF are contiguous in host memory
+    HostPages host;
+    for (std::size_t i = 0; i < host.pages.size(); ++i) {
+        MapPage(process, (i + 1) * PAGE_SIZE, host.pages[i].data());
+    }
+    host.pages[1][0] = 0x12;
+    host.pages[1][0xFF] = 0x34;
+
+    Kernel::HLERequestContext context{system.Kernel(), system.Memory(), nullptr, nullptr};
+    REQUIRE(context.PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data()).IsSuccess());
+
+    // The A buffer at 0x2000 is read from guest memory without a copy
+    const std::span<const u8> input = context.ReadBufferSpan();
+    REQUIRE(input.data() == host.pages[1].data());
+    REQUIRE(input.size() == 0x100);
+    REQUIRE(input.front() == 0x12);
+    REQUIRE(input.back() == 0x34);
+
+    // The B buffer at 0x3000 is written in place
+    const std::span<u8> output = context.WriteBufferSpan();
+    REQUIRE(output.data() == host.pages[2].data());
+    REQUIRE(output.size() == 0x200);
+    output[0x1FF] = 0x56;
+    REQUIRE(host.pages[2][0x1FF] == 0x56);
+
+    system.Kernel().MakeCurrentProcess(nullptr);
+}
+
+TEST_CASE("HLERequestContext: Buffer spans across non-contiguous pages", "[core]") {
+    Core::System& system = GetSystem();
+    Kernel::KHandleTable handle_table{system.Kernel()};
+    Kernel::KProcess process{system.Kernel()};
+    SetupProcess(system, process);
+    auto cmd_buf = MakeRequest();
+    cmd_buf[7] = 0x2F80;  // A buffer of 0x100 bytes crossing into page 0x3000
+    cmd_buf[10] = 0x2F00; // B buffer of 0x200 bytes crossing into page 0x3000
+
+    // Guest pages 0x2000 and 0x3000 are swapped in host memory
+    HostPages host;
+    MapPage(process, 0x1000, host.pages[0].data());
+    MapPage(process, 0x2000, host.pages[2].data());
+    MapPage(process, 0x3000, host.pages[1].data());
+    host.pages[2][0xF80] = 0x12;
+    host.pages[1][0x7F] = 0x34;
+
+    Kernel::HLERequestContext context{system.Kernel(), system.Memory(), nullptr, nullptr};
+    REQUIRE(context.PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data()).IsSuccess());
+
+    // The A buffer is copied into memory owned by the context
+    const std::span<const u8> input = context.ReadBufferSpan();
+    REQUIRE(input.size() == 0x100);
+    REQUIRE(input.data() != host.pages[2].data() + 0xF80);
+    REQUIRE(input.front() == 0x12);
+    REQUIRE(input.back() == 0x34);
+
+    // The copy stays valid while other buffers are read
+    const std::span<const u8> other_input = context.ReadBufferSpan();
+    REQUIRE(other_input.data() != input.data());
+    REQUIRE(input.front() == 0x12);
+
+    // The B buffer can't be written in place, WriteBuffer has to split the write
+    REQUIRE(context.WriteBufferSpan().empty());
+    std::vector<u8> data(0x200);
+    data.front() = 0x56;
+    data.back() = 0x78;
+    REQUIRE(context.WriteBuffer(data) == data.size());
+    REQUIRE(host.pages[2][0xF00] == 0x56);
+    REQUIRE(host.pages[1][0xFF] == 0x78);
+
+    system.Kernel().MakeCurrentProcess(nullptr);
+}
+
+TEST_CASE("HLERequestContext: Allocations per request", "[.][benchmark]") {
+    Core::System& system = GetSystem();
+    Kernel::KHandleTable handle_table{system.Kernel()};
+    auto cmd_buf = MakeRequest();
+
+    constexpr std::size_t num_requests = 1 << 20;
+    const u64 allocations_before = num_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_requests; ++i) {
+        // Contexts are shared with the service thread, like KServerSession does
+        auto context = std::make_shared<Kernel::HLERequestContext>(
+            system.Kernel(), system.Memory(), nullptr, nullptr);
+        void(context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data()));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const u64 allocations = num_allocations.load(std::memory_order_relaxed) - allocations_before;
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    fmt::print("HLERequestContext: {:.1f} allocations per request, {:.0f} ns per request\n",
+               static_cast<double>(allocations) / static_cast<double>(num_requests),
+               seconds * 1e9 / static_cast<double>(num_requests));
+}
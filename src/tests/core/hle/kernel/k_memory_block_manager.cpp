@@ -0,0 +1,123 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/hle/kernel/k_memory_block.h"
+#include "core/hle/kernel/k_memory_block_manager.h"
+#include "core/hle/kernel/memory_types.h"
+
+namespace {
+using Kernel::KMemoryAttribute;
+using Kernel::KMemoryBlockManager;
+using Kernel::KMemoryInfo;
+using Kernel::KMemoryPermission;
+using Kernel::KMemoryState;
+using Kernel::PageSize;
+
+constexpr VAddr START_ADDR = 0x8000000;
+constexpr VAddr END_ADDR = 0x8000000000;
+
+/// Returns the blocks of the whole address space in order
+std::vector<KMemoryInfo> GetBlocks(KMemoryBlockManager& manager) {
+    std::vector<KMemoryInfo> blocks;
+    manager.IterateForRange(START_ADDR, END_ADDR,
+                            [&](const KMemoryInfo& info) { blocks.push_back(info); });
+    return blocks;
+}
+} // Anonymous namespace
+
+TEST_CASE("KMemoryBlockManager: Split and merge blocks", "[core]") {
+    KMemoryBlockManager manager{START_ADDR, END_ADDR};
+    REQUIRE(manager.GetNumBlocks() == 1);
+
+    const VAddr addr = START_ADDR + 0x10 * PageSize;
+    manager.Update(addr, 4, KMemoryState::Normal, KMemoryPermission::ReadAndWrite);
+    REQUIRE(manager.GetNumBlocks() == 3);
+    REQUIRE(manager.FindBlock(addr + 3 * PageSize).GetAddress() == addr);
+    REQUIRE(manager.FindBlock(addr + 3 * PageSize).GetNumPages() == 4);
+    REQUIRE(manager.FindBlock(addr + 4 * PageSize).GetMemoryInfo().state == KMemoryState::Free);
+    REQUIRE(manager.FindIterator(END_ADDR) == manager.end());
+
+    // Reprotect the middle of the block, only when the previous state matches
+    manager.Update(addr + PageSize, 2, KMemoryState::Code, KMemoryPermission::ReadAndWrite,
+                   KMemoryAttribute::None, KMemoryState::Normal, KMemoryPermission::Read,
+                   KMemoryAttribute::None);
+    REQUIRE(manager.GetNumBlocks() == 3);
+    manager.Update(addr + PageSize, 2, KMemoryState::Normal, KMemoryPermission::ReadAndWrite,
+                   KMemoryAttribute::None, KMemoryState::Normal, KMemoryPermission::Read,
+                   KMemoryAttribute::None);
+    REQUIRE(manager.GetNumBlocks() == 5);
+    REQUIRE(manager.FindBlock(addr + PageSize).GetMemoryInfo().perm == KMemoryPermission::Read);
+
+    manager.UpdateLock(
+        addr, 4,
+        [](KMemoryBlockManager::iterator block, KMemoryPermission permission) {
+            block->ShareToDevice(permission);
+        },
+        KMemoryPermission::None);
+    REQUIRE(manager.FindBlock(addr).GetMemoryInfo().device_use_count == 1);
+    manager.UpdateLock(
+        addr, 4,
+        [](KMemoryBlockManager::iterator block, KMemoryPermission permission) {
+            block->UnshareToDevice(permission);
+        },
+        KMemoryPermission::None);
+
+    // Unmapping everything merges the address space back into a single block
+    manager.Update(addr, 4, KMemoryState::Free);
+    REQUIRE(manager.GetNumBlocks() == 1);
+    const std::vector<KMemoryInfo> blocks = GetBlocks(manager);
+    REQUIRE(blocks.size() == 1);
+    REQUIRE(blocks[0].GetAddress() == START_ADDR);
+    REQUIRE(blocks[0].GetSize() == END_ADDR - START_ADDR);
+}
+
+TEST_CASE("KMemoryBlockManager: Find free area", "[core]") {
+    KMemoryBlockManager manager{START_ADDR, END_ADDR};
+    const std::size_t region_num_pages = (END_ADDR - START_ADDR) / PageSize;
+    const VAddr first = manager.FindFreeArea(START_ADDR, region_num_pages, 8, PageSize, 0, 1);
+    REQUIRE(first == START_ADDR + PageSize);
+
+    manager.Update(first, 8, KMemoryState::Normal, KMemoryPermission::ReadAndWrite);
+    const VAddr second = manager.FindFreeArea(START_ADDR, region_num_pages, 8, PageSize, 0, 1);
+    REQUIRE(second == first + 9 * PageSize);
+}
+
+TEST_CASE("KMemoryBlockManager: Map and unmap in a fragmented address space", "[.][benchmark]") {
+    constexpr std::size_t num_mappings = 1 << 14;
+    constexpr std::size_t num_operations = 1 << 16;
+    KMemoryBlockManager manager{START_ADDR, END_ADDR};
+
+    // Alternate permissions so neighbouring mappings don't merge, like a heavily mapped process
+    std::vector<VAddr> mappings(num_mappings);
+    for (std::size_t i = 0; i < num_mappings; ++i) {
+        mappings[i] = START_ADDR + i * 4 * PageSize;
+        manager.Update(mappings[i], 2, KMemoryState::Normal,
+                       i % 2 == 0 ? KMemoryPermission::Read : KMemoryPermission::ReadAndWrite);
+    }
+    const std::size_t num_blocks = manager.GetNumBlocks();
+
+    std::mt19937_64 rng{5};
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_operations; ++i) {
+        const VAddr addr = mappings[rng() % num_mappings];
+        const KMemoryInfo info = manager.FindBlock(addr).GetMemoryInfo();
+        manager.Update(addr, 2, KMemoryState::Free);
+        manager.Update(addr, 2, KMemoryState::Normal, info.perm);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    REQUIRE(manager.GetNumBlocks() == num_blocks);
+
+    fmt::print("KMemoryBlockManager: {} blocks, {:.0f} ns per map and unmap\n", num_blocks,
+               seconds * 1e9 / static_cast<double>(num_operations));
+}
@@ -0,0 +1,152 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/lz4_compression.h"
+#include "core/file_sys/vfs_vector.h"
+#include "core/loader/nso.h"
+
+namespace {
+using Loader::NSOHeader;
+using Loader::NSOImage;
+using Loader::NSOImageBuilder;
+
+constexpr u32 BSS_SIZE = 0x3000;
+
+struct TestModule {
+    std::vector<u8> file;
+    std::array<std::vector<u8>, 3> segments;
+};
+
+/// Code-like data, compressible but not trivially
+std::vector<u8> MakeSegmentData(std::mt19937& rng, std::size_t size) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; i += 4) {
+        const u32 word = rng() % 4 == 0 ? static_cast<u32>(rng()) : 0xd503201fU + (rng() % 8);
+        std::memcpy(data.data() + i, &word, std::min<std::size_t>(4, size - i));
+    }
+    return data;
+}
+
+/// Builds an NSO with compressed text and data segments and an uncompressed rodata segment
+TestModule MakeModule(u32 seed, std::size_t text_size) {
+    std::mt19937 rng{seed};
+    TestModule module;
+    module.segments[0] = MakeSegmentData(rng, text_size);
+    module.segments[1] = MakeSegmentData(rng, 0x1800);
+    module.segments[2] = MakeSegmentData(rng, 0x2400);
+
+    NSOHeader header{};
+    header.magic = Common::MakeMagic('N', 'S', 'O', '0');
+    header.flags = 0b101;
+    module.file.resize(sizeof(NSOHeader));
+    u32 location = 0;
+    for (std::size_t i = 0; i < 3; ++i) {
+        const std::vector<u8>& segment = module.segments[i];
+        const std::vector<u8> stored =
+            header.IsSegmentCompressed(i)
+                ? Common::Compression::CompressDataLZ4(segment.data(), segment.size())
+                : segment;
+        header.segments[i].offset = static_cast<u32>(module.file.size());
+        header.segments[i].location = location;
+        header.segments[i].size = static_cast<u32>(segment.size());
+        header.segments_compressed_size[i] = static_cast<u32>(stored.size());
+        module.file.insert(module.file.end(), stored.begin(), stored.end());
+        location += (static_cast<u32>(segment.size()) + 0xfff) & ~0xfffU;
+    }
+    header.segments[2].bss_size = BSS_SIZE;
+    std::memcpy(module.file.data(), &header, sizeof(NSOHeader));
+    return module;
+}
+} // Anonymous namespace
+
+TEST_CASE("NSOImageBuilder: Decompress segments into the image", "[core]") {
+    std::vector<TestModule> modules;
+    for (u32 seed = 0; seed < 4; ++seed) {
+        modules.push_back(MakeModule(seed, 0x10000 + seed * 0x1234));
+    }
+
+    std::vector<std::unique_ptr<NSOImage>> images;
+    NSOImageBuilder image_builder;
+    for (const TestModule& module : modules) {
+        const FileSys::VectorVfsFile file{module.file, "module"};
+        images.push_back(image_builder.Read(file, false));
+        REQUIRE(images.back() != nullptr);
+    }
+    image_builder.Wait();
+
+    for (std::size_t i = 0; i < modules.size(); ++i) {
+        const NSOImage& image = *images[i];
+        for (std::size_t segment = 0; segment < 3; ++segment) {
+            const std::vector<u8>& expected = modules[i].segments[segment];
+            const u32 location = image.header.segments[segment].location;
+            REQUIRE(std::equal(expected.begin(), expected.end(),
+                               image.codeset.memory.begin() + location));
+            REQUIRE(image.codeset.segments[segment].addr == location);
+        }
+        const u32 data_end = image.header.segments[2].location + image.header.segments[2].size;
+        REQUIRE(image.codeset.memory.size() == ((data_end + BSS_SIZE + 0xfff) & ~0xfffU));
+        REQUIRE(std::all_of(image.codeset.memory.begin() + data_end, image.codeset.memory.end(),
+                            [](u8 value) { return value == 0; }));
+    }
+
+    const FileSys::VectorVfsFile truncated{std::vector<u8>(0x80), "truncated"};
+    REQUIRE(image_builder.Read(truncated, false) == nullptr);
+}
+
+TEST_CASE("NSOImageBuilder: Build the images of a title", "[.][benchmark]") {
+    // A large main module and a handful of subsdk modules
+    std::vector<TestModule> modules;
+    modules.push_back(MakeModule(0, 48 << 20));
+    for (u32 seed = 1; seed < 8; ++seed) {
+        modules.push_back(MakeModule(seed, 6 << 20));
+    }
+    std::vector<FileSys::VirtualFile> files;
+    for (const TestModule& module : modules) {
+        files.push_back(std::make_shared<FileSys::VectorVfsFile>(module.file, "module"));
+    }
+
+    // Serial reference, reading each segment into a vector and copying it into the image
+    const auto serial_start = std::chrono::steady_clock::now();
+    for (const FileSys::VirtualFile& file : files) {
+        NSOHeader header{};
+        file->ReadObject(&header);
+        std::vector<u8> program_image;
+        for (std::size_t i = 0; i < 3; ++i) {
+            std::vector<u8> data =
+                file->ReadBytes(header.segments_compressed_size[i], header.segments[i].offset);
+            if (header.IsSegmentCompressed(i)) {
+                data = Common::Compression::DecompressDataLZ4(data, header.segments[i].size);
+            }
+            program_image.resize(header.segments[i].location + data.size());
+            std::memcpy(program_image.data() + header.segments[i].location, data.data(),
+                        data.size());
+        }
+    }
+    const auto serial_end = std::chrono::steady_clock::now();
+
+    std::vector<std::unique_ptr<NSOImage>> images;
+    NSOImageBuilder image_builder;
+    for (const FileSys::VirtualFile& file : files) {
+        images.push_back(image_builder.Read(*file, false));
+    }
+    image_builder.Wait();
+    const auto builder_end = std::chrono::steady_clock::now();
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    fmt::print("NSOImageBuilder: serial {:.1f} ms, builder {:.1f} ms\n",
+               Milliseconds(serial_end - serial_start).count(),
+               Milliseconds(builder_end - serial_end).count());
+}
@@ -0,0 +1,216 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/command_classes/vic_convert.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::VicConvert;
+
+struct TestFrame {
+    std::vector<u8> luma;
+    std::vector<u8> chroma_u;
+    std::vector<u8> chroma_v;
+    Yuv420Frame frame;
+};
+
+/// Random frame with padded strides, like FFmpeg allocates them
+TestFrame MakeFrame(u32 width, u32 height, u32 seed) {
+    std::mt19937 rng{seed};
+    const auto random_plane = [&rng](std::size_t size) {
+        std::vector<u8> plane(size);
+        for (u8& value : plane) {
+            value = static_cast<u8>(rng());
+        }
+        return plane;
+    };
+    const std::size_t luma_stride = width + 32;
+    const std::size_t chroma_stride = (width + 1) / 2 + 16;
+    const std::size_t chroma_height = (height + 1) / 2;
+    TestFrame test{
+        .luma = random_plane(luma_stride * height),
+        .chroma_u = random_plane(chroma_stride * chroma_height),
+        .chroma_v = random_plane(chroma_stride * chroma_height),
+        .frame = {},
+    };
+    test.frame = Yuv420Frame{
+        .luma = test.luma.data(),
+        .chroma_u = test.chroma_u.data(),
+        .chroma_v = test.chroma_v.data(),
+        .luma_stride = luma_stride,
+        .chroma_stride = chroma_stride,
+        .width = width,
+        .height = height,
+    };
+    return test;
+}
+
+/// BT.601 limited range conversion in floating point, one pixel at a time
+std::vector<u8> ReferenceConvert(const Yuv420Frame& frame) {
+    std::vector<u8> output(std::size_t{frame.width} * frame.height * 4);
+    for (u32 y = 0; y < frame.height; ++y) {
+        for (u32 x = 0; x < frame.width; ++x) {
+            const std::size_t chroma = (y / 2) * frame.chroma_stride + x / 2;
+            const float luma = 1.164f * (frame.luma[y * frame.luma_stride + x] - 16.0f);
+            const float u = frame.chroma_u[chroma] - 128.0f;
+            const float v = frame.chroma_v[chroma] - 128.0f;
+            const auto clamp = [](float value) {
+                return static_cast<u8>(std::clamp(std::round(value), 0.0f, 255.0f));
+            };
+            u8* const pixel = &output[(std::size_t{y} * frame.width + x) * 4];
+            pixel[0] = clamp(luma + 1.596f * v);
+            pixel[1] = clamp(luma - 0.391f * u - 0.813f * v);
+            pixel[2] = clamp(luma + 2.018f * u);
+            pixel[3] = 0xff;
+        }
+    }
+    return output;
+}
+} // Anonymous namespace
+
+TEST_CASE("VicConvert[Rgba]", "[video_core]") {
+    for (const auto& [width, height] : {std::pair<u32, u32>{64, 8}, std::pair<u32, u32>{70, 33},
+                                        std::pair<u32, u32>{5, 3}}) {
+        const TestFrame test = MakeFrame(width, height, width);
+        const std::vector<u8> expected = ReferenceConvert(test.frame);
+
+        std::vector<u8> rgba(expected.size());
+        ConvertToRgba(test.frame, RgbaOrder::RGBA, rgba.data());
+        for (std::size_t i = 0; i < rgba.size(); ++i) {
+            REQUIRE(std::abs(rgba[i] - expected[i]) <= 1);
+        }
+
+        std::vector<u8> bgra(expected.size());
+        ConvertToRgba(test.frame, RgbaOrder::BGRA, bgra.data());
+        for (std::size_t i = 0; i < bgra.size(); i += 4) {
+            REQUIRE(bgra[i] == rgba[i + 2]);
+            REQUIRE(bgra[i + 1] == rgba[i + 1]);
+            REQUIRE(bgra[i + 2] == rgba[i]);
+            REQUIRE(bgra[i + 3] == 0xff);
+        }
+    }
+}
+
+TEST_CASE("VicConvert[BlockLinear]", "[video_core]") {
+    for (const auto& [width, height] : {std::pair<u32, u32>{128, 64}, std::pair<u32, u32>{70, 33},
+                                        std::pair<u32, u32>{1, 1}}) {
+        const TestFrame test = MakeFrame(width, height, width + 1);
+        std::vector<u8> linear(std::size_t{width} * height * 4);
+        ConvertToRgba(test.frame, RgbaOrder::BGRA, linear.data());
+        for (u32 block_height = 0; block_height <= 4; ++block_height) {
+            // Converting in place must match swizzling the pitch linear conversion
+            const std::size_t size =
+                Tegra::Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+            std::vector<u8> expected(size);
+            Tegra::Texture::SwizzleSubrect(width, height, width * 4, width, 4, expected.data(),
+                                           linear.data(), block_height, 0, 0);
+            std::vector<u8> swizzled(size);
+            ConvertToRgbaBlockLinear(test.frame, RgbaOrder::BGRA, block_height, swizzled.data());
+            REQUIRE(swizzled == expected);
+        }
+    }
+}
+
+TEST_CASE("VicConvert[Yuv420]", "[video_core]") {
+    constexpr std::size_t pitch = 256;
+    const TestFrame test = MakeFrame(90, 20, 7);
+    const std::size_t half_width = test.frame.width / 2;
+    const std::size_t half_height = test.frame.height / 2;
+
+    std::vector<u8> luma(pitch * test.frame.height, 0xcc);
+    CopyPlane(test.frame.luma, test.frame.luma_stride, test.frame.width, test.frame.height, pitch,
+              luma.data());
+    std::vector<u8> chroma(pitch * half_height, 0xcc);
+    InterleaveChroma(test.frame.chroma_u, test.frame.chroma_v, test.frame.chroma_stride,
+                     half_width, half_height, pitch, chroma.data());
+    for (std::size_t y = 0; y < test.frame.height; ++y) {
+        for (std::size_t x = 0; x < pitch; ++x) {
+            const u8 value = x < test.frame.width ? test.luma[y * test.frame.luma_stride + x] : 0;
+            REQUIRE(luma[y * pitch + x] == value);
+        }
+    }
+    for (std::size_t y = 0; y < half_height; ++y) {
+        for (std::size_t x = 0; x < pitch; ++x) {
+            const std::size_t source = y * test.frame.chroma_stride + x / 2;
+            const std::vector<u8>& plane = x % 2 == 0 ? test.chroma_u : test.chroma_v;
+            const u8 value = x < half_width * 2 ? plane[source] : 0;
+            REQUIRE(chroma[y * pitch + x] == value);
+        }
+    }
+}
+
+TEST_CASE("VicConvert[Throughput]", "[.][benchmark]") {
+    constexpr u32 width = 1920;
+    constexpr u32 height = 1080;
+    constexpr u32 block_height = 4;
+    constexpr int iterations = 32;
+    const TestFrame test = MakeFrame(width, height, 1);
+    const std::size_t size =
+        Tegra::Texture::CalculateSize(true, 4, width, height, 1, block_height, 0);
+    std::vector<u8> linear(std::size_t{width} * height * 4);
+    std::vector<u8> swizzled(size);
+
+    using Clock = std::chrono::steady_clock;
+    const auto milliseconds = [](Clock::time_point start, Clock::time_point end, int count) {
+        return std::chrono::duration<double, std::milli>(end - start).count() / count;
+    };
+
+    // Previous path: convert one pixel at a time, then swizzle the pitch linear frame
+    const Clock::time_point reference_start = Clock::now();
+    const std::vector<u8> reference = ReferenceConvert(test.frame);
+    Tegra::Texture::SwizzleSubrect(width, height, width * 4, width, 4, swizzled.data(),
+                                   reference.data(), block_height, 0, 0);
+    const Clock::time_point reference_end = Clock::now();
+
+    const Clock::time_point two_pass_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ConvertToRgba(test.frame, RgbaOrder::RGBA, linear.data());
+        Tegra::Texture::SwizzleSubrect(width, height, width * 4, width, 4, swizzled.data(),
+                                       linear.data(), block_height, 0, 0);
+    }
+    const Clock::time_point two_pass_end = Clock::now();
+
+    const Clock::time_point fused_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ConvertToRgbaBlockLinear(test.frame, RgbaOrder::RGBA, block_height, swizzled.data());
+    }
+    const Clock::time_point fused_end = Clock::now();
+
+    const Clock::time_point linear_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ConvertToRgba(test.frame, RgbaOrder::RGBA, linear.data());
+    }
+    const Clock::time_point linear_end = Clock::now();
+
+    constexpr std::size_t pitch = (width + 0xff) & ~0xff;
+    std::vector<u8> luma(pitch * height);
+    std::vector<u8> chroma(pitch * height / 2);
+    const Clock::time_point yuv_start = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        CopyPlane(test.frame.luma, test.frame.luma_stride, width, height, pitch, luma.data());
+        InterleaveChroma(test.frame.chroma_u, test.frame.chroma_v, test.frame.chroma_stride,
+                         width / 2, height / 2, pitch, chroma.data());
+    }
+    const Clock::time_point yuv_end = Clock::now();
+
+    fmt::print("1080p frame: per pixel convert and swizzle {:.2f} ms, convert and swizzle "
+               "{:.2f} ms, fused block linear {:.2f} ms, pitch linear {:.2f} ms, YUV420 {:.2f} "
+               "ms\n",
+               milliseconds(reference_start, reference_end, 1),
+               milliseconds(two_pass_start, two_pass_end, iterations),
+               milliseconds(fused_start, fused_end, iterations),
+               milliseconds(linear_start, linear_end, iterations),
+               milliseconds(yuv_start, yuv_end, iterations));
+}
@@ -0,0 +1,106 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "video_core/memory_manager.h"
+
+namespace {
+constexpr u64 PAGE = 0x10000;
+constexpr GPUVAddr ADDRESS_SPACE_START = 1ULL << 32;
+constexpr VAddr CPU_ADDR = 0x80000000;
+
+/// System::System is private. The memory manager only touches the system to lock pages of the
+/// current process, which these tests never do, so the global instance is left untouched.
+Core::System& GetSystem() {
+    return Core::System::GetInstance();
+}
+} // Anonymous namespace
+
+TEST_CASE("MemoryManager: Translate mapped ranges", "[video_core]") {
+    Tegra::MemoryManager memory_manager{GetSystem()};
+
+    const GPUVAddr gpu_addr = memory_manager.Map(CPU_ADDR, ADDRESS_SPACE_START, PAGE * 3);
+    REQUIRE(gpu_addr == ADDRESS_SPACE_START);
+    REQUIRE(memory_manager.GpuToCpuAddress(gpu_addr + 0x12345) == CPU_ADDR + 0x12345);
+    REQUIRE(memory_manager.GpuToCpuAddress(gpu_addr + PAGE * 2 + 4) == CPU_ADDR + PAGE * 2 + 4);
+    REQUIRE(!memory_manager.GpuToCpuAddress(gpu_addr + PAGE * 3));
+    REQUIRE(memory_manager.IsContinousRange(gpu_addr, PAGE * 3));
+    REQUIRE(memory_manager.BytesToMapEnd(gpu_addr + PAGE) == PAGE * 2);
+
+    memory_manager.Unmap(gpu_addr, PAGE * 3);
+    REQUIRE(!memory_manager.GpuToCpuAddress(gpu_addr));
+}
+
+TEST_CASE("MemoryManager: Allocations reuse the lowest free range", "[video_core]") {
+    Tegra::MemoryManager memory_manager{GetSystem()};
+
+    const GPUVAddr a = memory_manager.MapAllocate(CPU_ADDR, PAGE * 2, 0);
+    const GPUVAddr b = memory_manager.MapAllocate(CPU_ADDR, PAGE, 0);
+    const GPUVAddr c = memory_manager.MapAllocate(CPU_ADDR, PAGE * 4, 0);
+    REQUIRE(a == ADDRESS_SPACE_START);
+    REQUIRE(b == a + PAGE * 2);
+    REQUIRE(c == b + PAGE);
+
+    // The hole left by the first mapping is reused by anything that fits in it
+    memory_manager.Unmap(a, PAGE * 2);
+    REQUIRE(memory_manager.MapAllocate(CPU_ADDR, PAGE, 0) == a);
+    REQUIRE(memory_manager.MapAllocate(CPU_ADDR, PAGE * 2, 0) == c + PAGE * 4);
+    REQUIRE(memory_manager.MapAllocate(CPU_ADDR, PAGE, 0) == a + PAGE);
+
+    // Aligned allocations skip the unaligned part of a free range
+    memory_manager.Unmap(b, PAGE);
+    const GPUVAddr aligned = memory_manager.MapAllocate(CPU_ADDR, PAGE, PAGE * 8);
+    REQUIRE(aligned % (PAGE * 8) == 0);
+    REQUIRE(aligned > b);
+
+    // Reserved ranges are not free, and fixed allocations can't overlap them
+    const GPUVAddr reserved = memory_manager.Allocate(PAGE * 2, 0);
+    REQUIRE(!memory_manager.GpuToCpuAddress(reserved));
+    REQUIRE(!memory_manager.AllocateFixed(reserved + PAGE, PAGE));
+    REQUIRE(memory_manager.AllocateFixed(b, PAGE) == b);
+    REQUIRE(memory_manager.MapAllocate(CPU_ADDR, PAGE, 0) != b);
+}
+
+TEST_CASE("MemoryManager: Map churn", "[.][benchmark]") {
+    Tegra::MemoryManager memory_manager{GetSystem()};
+
+    // Keep a working set of live mappings like a game streaming resources in and out
+    constexpr std::size_t num_live = 4096;
+    constexpr std::size_t num_iterations = 1 << 18;
+    std::mt19937 rng{1};
+    std::vector<std::pair<GPUVAddr, std::size_t>> live;
+    live.reserve(num_live);
+
+    u64 checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_iterations; ++i) {
+        if (live.size() == num_live) {
+            const std::size_t index = rng() % live.size();
+            memory_manager.Unmap(live[index].first, live[index].second);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        const std::size_t size = PAGE * (1 + rng() % 32);
+        const GPUVAddr gpu_addr = memory_manager.MapAllocate(CPU_ADDR, size, 0);
+        live.emplace_back(gpu_addr, size);
+        checksum += *memory_manager.GpuToCpuAddress(gpu_addr + size - 1);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    fmt::print("MemoryManager churn: {:.0f} map/unmap/translate per second, page table {} KiB "
+               "(checksum {:x})\n",
+               static_cast<double>(num_iterations) / seconds,
+               memory_manager.PageTableMemoryUsage() / 1024, checksum);
+}
@@ -0,0 +1,147 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/engines/shader_bytecode.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/shader/compiler_settings.h"
+#include "video_core/shader/memory_util.h"
+#include "video_core/shader/node.h"
+#include "video_core/shader/registry.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace {
+using namespace VideoCommon::Shader;
+using Tegra::Engines::ShaderType;
+
+constexpr u64 SCHED_INSTRUCTION = 0x001f8000fc0007e0ULL;
+constexpr u64 EXIT_INSTRUCTION = 0xe30000000007000fULL;
+
+/// Encodes "MOV32I reg, value" predicated on PT
+constexpr u64 Mov32Immediate(u32 reg, u32 value) {
+    return 0x0100000000070000ULL | (u64{value} << 20) | reg;
+}
+
+/// Builds a graphics program that moves an immediate into each of the given registers
+ProgramCode MakeProgram(u32 num_registers) {
+    ProgramCode code(STAGE_MAIN_OFFSET);
+    u32 reg = 0;
+    while (reg < num_registers) {
+        code.push_back(SCHED_INSTRUCTION);
+        for (int i = 0; i < 3 && reg < num_registers; ++i, ++reg) {
+            code.push_back(Mov32Immediate(reg, reg * 0x100));
+        }
+    }
+    while ((code.size() - STAGE_MAIN_OFFSET) % 4 != 0) {
+        code.push_back(Mov32Immediate(0, 0));
+    }
+    code.push_back(SCHED_INSTRUCTION);
+    code.push_back(EXIT_INSTRUCTION);
+    code.push_back(EXIT_INSTRUCTION);
+    code.push_back(EXIT_INSTRUCTION);
+    return code;
+}
+
+/// Creates a registry without any keys, like the one of a shader loaded from disk
+Registry MakeRegistry(ShaderType stage) {
+    const SerializedRegistryInfo info;
+    return Registry(stage, info);
+}
+
+#ifndef _WIN32
+/// Returns the peak resident set size of the process in KiB
+long PeakMemoryUsage() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+#else
+long PeakMemoryUsage() {
+    return 0;
+}
+#endif
+} // Anonymous namespace
+
+TEST_CASE("ShaderIR: Decode synthetic program", "[video_core]") {
+    const ProgramCode code = MakeProgram(32);
+    Registry registry = MakeRegistry(ShaderType::Vertex);
+    const ShaderIR ir(code, STAGE_MAIN_OFFSET, CompilerSettings{}, registry);
+
+    REQUIRE(!ir.GetBasicBlocks().empty());
+    REQUIRE(ir.GetRegisters().size() == 32U);
+
+    // Decompilers query condition codes after decoding, from threads without a node pool
+    Node condition;
+    std::thread decompiler(
+        [&] { condition = ir.GetConditionCode(Tegra::Shader::ConditionCode::NEU); });
+    decompiler.join();
+    REQUIRE(condition != nullptr);
+    const auto* const operation = std::get_if<OperationNode>(condition);
+    REQUIRE(operation != nullptr);
+    REQUIRE(operation->GetCode() == OperationCode::LogicalNegate);
+}
+
+TEST_CASE("ShaderIR: Decode corpus", "[.][benchmark]") {
+    // Directory of dumped program binaries, files ending in ".kernel.bin" are compute programs
+    const char* const corpus_path = std::getenv("YUZU_SHADER_CORPUS");
+    std::vector<std::pair<ProgramCode, bool>> programs;
+    if (corpus_path != nullptr) {
+        for (const auto& entry : std::filesystem::directory_iterator{corpus_path}) {
+            const std::string name = entry.path().filename().string();
+            if (!entry.is_regular_file() || !name.ends_with(".bin")) {
+                continue;
+            }
+            Common::FS::IOFile file{entry.path(), Common::FS::FileAccessMode::Read,
+                                    Common::FS::FileType::BinaryFile};
+            ProgramCode code(file.GetSize() / sizeof(u64));
+            if (code.empty() || file.Read(code) != code.size()) {
+                continue;
+            }
+            programs.emplace_back(std::move(code), name.ends_with(".kernel.bin"));
+        }
+    }
+    if (programs.empty()) {
+        // Without a corpus, decode large synthetic programs instead
+        for (u32 i = 0; i < 64; ++i) {
+            programs.emplace_back(MakeProgram(255), false);
+        }
+    }
+
+    constexpr std::size_t iterations = 8;
+    const long memory_before = PeakMemoryUsage();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (const auto& [code, is_compute] : programs) {
+            const ShaderType stage = is_compute ? ShaderType::Compute : ShaderType::Vertex;
+            Registry registry = MakeRegistry(stage);
+            const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+            const ShaderIR ir(code, main_offset, CompilerSettings{}, registry);
+            REQUIRE(ir.GetLength() > 0);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const auto num_decodes = static_cast<double>(iterations * programs.size());
+
+    fmt::print("Decoded {} programs: {:.3f} ms per program, peak memory {} KiB (+{} KiB)\n",
+               programs.size(), seconds * 1000.0 / num_decodes, PeakMemoryUsage(),
+               PeakMemoryUsage() - memory_before);
+}
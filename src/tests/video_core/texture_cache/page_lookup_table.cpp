@@ -0,0 +1,162 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/page_lookup_table.h"
+
+namespace {
+using VideoCommon::PageLookupTable;
+
+constexpr u64 PAGE_BITS = 20;
+constexpr u64 ADDRESS_BITS = 40;
+
+using Table = PageLookupTable<u32, ADDRESS_BITS - PAGE_BITS>;
+
+struct TraceImage {
+    u64 addr;
+    u64 size;
+};
+
+/// Calls func for every page overlapped by the given range, like the texture cache does
+template <typename Func>
+void ForEachPage(u64 addr, u64 size, Func&& func) {
+    const u64 page_end = (addr + size - 1) >> PAGE_BITS;
+    for (u64 page = addr >> PAGE_BITS; page <= page_end; ++page) {
+        func(page);
+    }
+}
+
+/// Synthetic trace of images in a few heaps, most of them are small render targets and textures
+std::vector<TraceImage> MakeTrace(std::size_t num_images) {
+    std::mt19937_64 rng{7};
+    std::vector<TraceImage> images(num_images);
+    for (TraceImage& image : images) {
+        const u64 heap = (rng() % 4 + 1) << 32;
+        image.addr = heap + ((rng() % (1ULL << 30)) & ~0xffULL);
+        image.size = (rng() % 8 == 0) ? (rng() % (32ULL << 20)) + 1 : (rng() % (1ULL << 20)) + 1;
+    }
+    return images;
+}
+
+struct IdentityHash {
+    [[nodiscard]] size_t operator()(u64 value) const noexcept {
+        return static_cast<size_t>(value);
+    }
+};
+
+/// Node based map the texture cache used before, kept to compare against
+class HashTable {
+public:
+    [[nodiscard]] std::vector<u32>* Find(u64 page) {
+        const auto it = map.find(page);
+        return it != map.end() ? &it->second : nullptr;
+    }
+
+    [[nodiscard]] std::vector<u32>& operator[](u64 page) {
+        return map[page];
+    }
+
+private:
+    std::unordered_map<u64, std::vector<u32>, IdentityHash> map;
+};
+
+/// Registers, looks up and unregisters the images of a trace, returns the number of hits
+template <typename T>
+u64 ReplayTrace(T& table, const std::vector<TraceImage>& trace, std::size_t num_lookups) {
+    for (u32 id = 0; id < static_cast<u32>(trace.size()); ++id) {
+        ForEachPage(trace[id].addr, trace[id].size, [&](u64 page) { table[page].push_back(id); });
+    }
+    std::mt19937_64 rng{11};
+    std::vector<bool> picked(trace.size());
+    std::vector<u32> found;
+    u64 hits = 0;
+    for (std::size_t i = 0; i < num_lookups; ++i) {
+        const TraceImage& query = trace[rng() % trace.size()];
+        ForEachPage(query.addr, query.size, [&](u64 page) {
+            const auto* const ids = table.Find(page);
+            if (!ids) {
+                return;
+            }
+            for (const u32 id : *ids) {
+                const TraceImage& image = trace[id];
+                if (picked[id] || image.addr >= query.addr + query.size ||
+                    query.addr >= image.addr + image.size) {
+                    continue;
+                }
+                picked[id] = true;
+                found.push_back(id);
+            }
+        });
+        hits += found.size();
+        for (const u32 id : found) {
+            picked[id] = false;
+        }
+        found.clear();
+    }
+    for (u32 id = 0; id < static_cast<u32>(trace.size()); ++id) {
+        ForEachPage(trace[id].addr, trace[id].size, [&](u64 page) {
+            auto* const ids = table.Find(page);
+            ids->erase(std::ranges::find(*ids, id));
+        });
+    }
+    return hits;
+}
+} // Anonymous namespace
+
+TEST_CASE("PageLookupTable: Find and register pages", "[video_core]") {
+    Table table;
+    REQUIRE(table.Find(5) == nullptr);
+
+    table[5].push_back(1);
+    table[5].push_back(2);
+    REQUIRE(table.Find(5) != nullptr);
+    REQUIRE(table.Find(5)->size() == 2);
+
+    // Pages in the same block exist once the block is allocated, but they are empty
+    REQUIRE(table.Find(6) != nullptr);
+    REQUIRE(table.Find(6)->empty());
+    REQUIRE(table.Find(1ULL << 19) == nullptr);
+
+    auto* const ids = table.Find(5);
+    ids->erase(std::ranges::find(*ids, 1U));
+    REQUIRE(table.Find(5)->size() == 1);
+    REQUIRE(table.Find(5)->front() == 2);
+}
+
+TEST_CASE("PageLookupTable: Replay matches a hash table", "[video_core]") {
+    const std::vector<TraceImage> trace = MakeTrace(256);
+    Table table;
+    HashTable hash_table;
+    REQUIRE(ReplayTrace(table, trace, 1024) == ReplayTrace(hash_table, trace, 1024));
+}
+
+TEST_CASE("PageLookupTable: Replay image trace", "[.][benchmark]") {
+    const std::vector<TraceImage> trace = MakeTrace(8192);
+    constexpr std::size_t num_lookups = 1 << 18;
+
+    const auto run = [&](auto& table, const char* name) {
+        const auto start = std::chrono::steady_clock::now();
+        const u64 hits = ReplayTrace(table, trace, num_lookups);
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        fmt::print("{}: {:.1f} ms, {:.0f} lookups/s ({} hits)\n", name, seconds * 1000.0,
+                   static_cast<double>(num_lookups) / seconds, hits);
+        return hits;
+    };
+    Table table;
+    HashTable hash_table;
+    const u64 table_hits = run(table, "PageLookupTable");
+    const u64 hash_hits = run(hash_table, "unordered_map");
+    REQUIRE(table_hits == hash_hits);
+}
@@ -0,0 +1,174 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+
+namespace {
+struct BlockSize {
+    u32 width;
+    u32 height;
+};
+
+constexpr std::array<BlockSize, 6> BLOCK_SIZES{{
+    {4, 4},
+    {5, 4},
+    {6, 6},
+    {8, 8},
+    {10, 10},
+    {12, 12},
+}};
+
+/// Block modes with weight grids that fit in a 4x4 block and leave room for any endpoint data
+constexpr std::array<u32, 5> BLOCK_MODES{0x013, 0x10d, 0x1bf, 0x35e, 0x50d};
+/// LDR luminance+alpha, RGB and RGBA direct color endpoint modes
+constexpr std::array<u32, 3> ENDPOINT_MODES{4, 8, 12};
+
+void SetBits(std::array<u8, 16>& block, u32 offset, u32 count, u32 value) {
+    for (u32 bit = 0; bit < count; ++bit) {
+        const u32 position = offset + bit;
+        block[position / 8] = static_cast<u8>((block[position / 8] & ~(1U << (position % 8))) |
+                                              (((value >> bit) & 1) << (position % 8)));
+    }
+}
+
+std::array<u8, 16> MakeVoidExtentBlock(u16 r, u16 g, u16 b, u16 a) {
+    std::array<u8, 16> block{};
+    SetBits(block, 0, 12, 0xDFC);
+    for (u32 extent = 0; extent < 4; ++extent) {
+        SetBits(block, 12 + extent * 13, 13, 0x1FFF);
+    }
+    SetBits(block, 64, 16, r);
+    SetBits(block, 80, 16, g);
+    SetBits(block, 96, 16, b);
+    SetBits(block, 112, 16, a);
+    return block;
+}
+
+/// Generates valid LDR blocks with random endpoints, weights and partitions
+std::vector<u8> MakeBlocks(std::size_t num_blocks, u32 seed) {
+    std::mt19937 rng{seed};
+    std::vector<u8> data(num_blocks * 16);
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        std::array<u8, 16> block;
+        for (u8& byte : block) {
+            byte = static_cast<u8>(rng());
+        }
+        if (rng() % 16 == 0) {
+            block = MakeVoidExtentBlock(static_cast<u16>(rng()), static_cast<u16>(rng()),
+                                        static_cast<u16>(rng()), static_cast<u16>(rng()));
+        } else {
+            const u32 partitions = rng() % 3 + 1;
+            const u32 endpoint_mode = ENDPOINT_MODES[rng() % ENDPOINT_MODES.size()];
+            SetBits(block, 0, 11, BLOCK_MODES[rng() % BLOCK_MODES.size()]);
+            SetBits(block, 11, 2, partitions - 1);
+            if (partitions == 1) {
+                SetBits(block, 13, 4, endpoint_mode);
+            } else {
+                // Partition index followed by a shared endpoint mode
+                SetBits(block, 13, 10, rng());
+                SetBits(block, 23, 6, endpoint_mode << 2);
+            }
+        }
+        std::memcpy(&data[i * 16], block.data(), block.size());
+    }
+    return data;
+}
+
+u32 NumBlocks(u32 size, u32 block_size) {
+    return (size + block_size - 1) / block_size;
+}
+} // Anonymous namespace
+
+TEST_CASE("ASTC[VoidExtent]", "[video_core]") {
+    const std::array<u8, 16> block = MakeVoidExtentBlock(0x1234, 0x5678, 0x9abc, 0xdef0);
+    std::vector<u8> output(6 * 6 * 4);
+    Tegra::Texture::ASTC::Decompress(block, 6, 6, 1, 6, 6, output);
+    for (std::size_t texel = 0; texel < 6 * 6; ++texel) {
+        REQUIRE(output[texel * 4 + 0] == 0x12);
+        REQUIRE(output[texel * 4 + 1] == 0x56);
+        REQUIRE(output[texel * 4 + 2] == 0x9a);
+        REQUIRE(output[texel * 4 + 3] == 0xde);
+    }
+}
+
+TEST_CASE("ASTC[Conformance]", "[video_core]") {
+    // Hashes of the images decoded one block at a time by the original serial decoder
+    constexpr std::array<u64, BLOCK_SIZES.size()> expected_hashes{
+        0xadc8227cfbaec719, 0xb6a22e6d8b17dc5e, 0x4929240535a8e683,
+        0xb2fa7ee1f20b4e30, 0xa68cba93c49437a1, 0x83961202a88c4f58,
+    };
+    constexpr u32 width = 301;
+    constexpr u32 height = 203;
+    constexpr u32 depth = 2;
+    for (std::size_t size_index = 0; size_index < BLOCK_SIZES.size(); ++size_index) {
+        const auto [block_width, block_height] = BLOCK_SIZES[size_index];
+        const u32 blocks_x = NumBlocks(width, block_width);
+        const u32 blocks_y = NumBlocks(height, block_height);
+        const std::vector<u8> data =
+            MakeBlocks(static_cast<std::size_t>(blocks_x) * blocks_y * depth, block_width);
+
+        std::vector<u8> output(width * height * depth * 4);
+        Tegra::Texture::ASTC::Decompress(data, width, height, depth, block_width, block_height,
+                                         output);
+        REQUIRE(Common::CityHash64(reinterpret_cast<const char*>(output.data()),
+                                   output.size()) == expected_hashes[size_index]);
+
+        // The parallel decode must match decoding every block on its own
+        std::vector<u8> block_output(block_width * block_height * 4);
+        for (u32 z = 0; z < depth; ++z) {
+            for (u32 block_y = 0; block_y < blocks_y; ++block_y) {
+                for (u32 block_x = 0; block_x < blocks_x; ++block_x) {
+                    const std::size_t block = (z * blocks_y + block_y) * blocks_x + block_x;
+                    Tegra::Texture::ASTC::Decompress(std::span(data).subspan(block * 16, 16),
+                                                     block_width, block_height, 1, block_width,
+                                                     block_height, block_output);
+                    for (u32 y = 0; y < block_height; ++y) {
+                        const u32 image_y = block_y * block_height + y;
+                        const u32 image_x = block_x * block_width;
+                        if (image_y >= height) {
+                            break;
+                        }
+                        const u32 row_size = std::min(block_width, width - image_x) * 4;
+                        const std::size_t offset =
+                            ((static_cast<std::size_t>(z) * height + image_y) * width + image_x) *
+                            4;
+                        REQUIRE(std::memcmp(&output[offset], &block_output[y * block_width * 4],
+                                            row_size) == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("ASTC[Throughput]", "[.][benchmark]") {
+    constexpr u32 width = 2048;
+    constexpr u32 height = 2048;
+    for (const auto [block_width, block_height] : BLOCK_SIZES) {
+        const std::vector<u8> data = MakeBlocks(
+            static_cast<std::size_t>(NumBlocks(width, block_width)) * NumBlocks(height, block_height),
+            1);
+        std::vector<u8> output(static_cast<std::size_t>(width) * height * 4);
+
+        const auto start = std::chrono::steady_clock::now();
+        Tegra::Texture::ASTC::Decompress(data, width, height, 1, block_width, block_height, output);
+        const auto end = std::chrono::steady_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        fmt::print("ASTC {}x{}: {:.1f} Mtexels/s\n", block_width, block_height,
+                   static_cast<double>(width) * height / seconds / 1e6);
+    }
+}
@@ -0,0 +1,238 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+
+#include "common/alignment.h"
+#include "common/common_types.h"
+#include "common/div_ceil.h"
+#include "video_core/textures/decoders.h"
+
+namespace {
+using namespace Tegra::Texture;
+
+constexpr std::array<u32, 5> BYTES_PER_PIXEL{1, 2, 4, 8, 16};
+
+std::vector<u8> RandomBytes(std::size_t size, u32 seed) {
+    std::mt19937 rng{seed};
+    std::vector<u8> data(size);
+    for (u8& byte : data) {
+        byte = static_cast<u8>(rng());
+    }
+    return data;
+}
+
+/// Byte offset of a pixel in a block linear texture, computed one pixel at a time
+std::size_t ReferenceOffset(u32 x, u32 y, u32 z, u32 stride, u32 height, u32 block_height,
+                            u32 block_depth) {
+    const u32 gobs_in_x = Common::DivCeilLog2(stride, GOB_SIZE_X_SHIFT);
+    const u32 block_size = gobs_in_x << (GOB_SIZE_SHIFT + block_height + block_depth);
+    const u32 slice_size =
+        Common::DivCeilLog2(height, block_height + GOB_SIZE_Y_SHIFT) * block_size;
+    const u32 block_y = y >> GOB_SIZE_Y_SHIFT;
+    return (z >> block_depth) * slice_size +
+           ((z & ((1U << block_depth) - 1)) << (GOB_SIZE_SHIFT + block_height)) +
+           (block_y >> block_height) * block_size +
+           ((block_y & ((1U << block_height) - 1)) << GOB_SIZE_SHIFT) +
+           ((x >> GOB_SIZE_X_SHIFT) << (GOB_SIZE_SHIFT + block_height + block_depth)) +
+           SWIZZLE_TABLE[y % GOB_SIZE_Y][x % GOB_SIZE_X];
+}
+
+std::vector<u8> ReferenceUnswizzle(std::span<const u8> input, u32 bytes_per_pixel, u32 width,
+                                   u32 height, u32 depth, u32 block_height, u32 block_depth) {
+    const u32 pitch = width * bytes_per_pixel;
+    std::vector<u8> output(static_cast<std::size_t>(pitch) * height * depth);
+    for (u32 z = 0; z < depth; ++z) {
+        for (u32 y = 0; y < height; ++y) {
+            for (u32 x = 0; x < width; ++x) {
+                const std::size_t swizzled = ReferenceOffset(x * bytes_per_pixel, y, z, pitch,
+                                                             height, block_height, block_depth);
+                const std::size_t linear = (z * height + y) * pitch + x * bytes_per_pixel;
+                std::memcpy(&output[linear], &input[swizzled], bytes_per_pixel);
+            }
+        }
+    }
+    return output;
+}
+} // Anonymous namespace
+
+TEST_CASE("Swizzle[Conformance]", "[video_core]") {
+    constexpr std::array<std::array<u32, 3>, 6> extents{{
+        {1, 1, 1},
+        {3, 5, 1},
+        {17, 9, 2},
+        {64, 64, 1},
+        {100, 37, 3},
+        {257, 130, 1},
+    }};
+    u32 seed = 0;
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        for (const auto& [width, height, depth] : extents) {
+            for (u32 block_height = 0; block_height <= 5; block_height += 2) {
+                for (u32 block_depth = 0; block_depth <= 1; ++block_depth) {
+                    const std::size_t size = CalculateSize(true, bytes_per_pixel, width, height,
+                                                           depth, block_height, block_depth);
+                    const std::vector<u8> swizzled = RandomBytes(size, ++seed);
+                    const std::vector<u8> expected = ReferenceUnswizzle(
+                        swizzled, bytes_per_pixel, width, height, depth, block_height, block_depth);
+
+                    std::vector<u8> linear(expected.size());
+                    UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, depth,
+                                     block_height, block_depth);
+                    REQUIRE(linear == expected);
+
+                    // Swizzling back must restore every byte covered by the image
+                    std::vector<u8> reswizzled(size);
+                    SwizzleTexture(reswizzled, linear, bytes_per_pixel, width, height, depth,
+                                   block_height, block_depth);
+                    std::vector<u8> relinear(expected.size());
+                    UnswizzleTexture(relinear, reswizzled, bytes_per_pixel, width, height, depth,
+                                     block_height, block_depth);
+                    REQUIRE(relinear == expected);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Swizzle[Subrect]", "[video_core]") {
+    constexpr u32 width = 200;
+    constexpr u32 height = 70;
+    constexpr u32 block_height = 2;
+    u32 seed = 100;
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        const u32 pitch = width * bytes_per_pixel;
+        const std::size_t size =
+            CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+        for (const auto [origin_x, origin_y, rect_width, rect_height] :
+             {std::array<u32, 4>{0, 0, width, height}, std::array<u32, 4>{3, 1, 61, 20},
+              std::array<u32, 4>{17, 9, 150, 50}}) {
+            const std::vector<u8> source = RandomBytes(size, ++seed);
+            const u32 rect_pitch = rect_width * bytes_per_pixel + 5;
+
+            // Unswizzling a subrect must match the full image at the same position
+            const std::vector<u8> full =
+                ReferenceUnswizzle(source, bytes_per_pixel, width, height, 1, block_height, 0);
+            std::vector<u8> rect(static_cast<std::size_t>(rect_pitch) * rect_height);
+            UnswizzleSubrect(rect_width, rect_height, rect_pitch, width, bytes_per_pixel,
+                             block_height, origin_x, origin_y, rect.data(), source.data());
+            for (u32 y = 0; y < rect_height; ++y) {
+                const u8* const expected =
+                    &full[(origin_y + y) * pitch + origin_x * bytes_per_pixel];
+                REQUIRE(std::memcmp(&rect[y * rect_pitch], expected,
+                                    rect_width * bytes_per_pixel) == 0);
+            }
+
+            // Swizzling it back must only touch the bytes of the subrect
+            std::vector<u8> swizzled(size);
+            SwizzleSubrect(rect_width, rect_height, rect_pitch, width, bytes_per_pixel,
+                           swizzled.data(), rect.data(), block_height, origin_x, origin_y);
+            const std::vector<u8> linear =
+                ReferenceUnswizzle(swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+            for (u32 y = 0; y < height; ++y) {
+                for (u32 x = 0; x < width; ++x) {
+                    const bool inside = x >= origin_x && x < origin_x + rect_width &&
+                                        y >= origin_y && y < origin_y + rect_height;
+                    const std::size_t offset = y * pitch + x * bytes_per_pixel;
+                    for (u32 byte = 0; byte < bytes_per_pixel; ++byte) {
+                        REQUIRE(linear[offset + byte] == (inside ? full[offset + byte] : 0));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Swizzle[OddBytesPerPixel]", "[video_core]") {
+    // Pixel sizes that do not divide a GOB row take the pixel by pixel path
+    constexpr u32 width = 45;
+    constexpr u32 height = 19;
+    for (const u32 bytes_per_pixel : {3U, 6U, 12U}) {
+        const std::size_t size = CalculateSize(true, bytes_per_pixel, width, height, 1, 1, 0);
+        const std::vector<u8> swizzled = RandomBytes(size, bytes_per_pixel);
+        std::vector<u8> linear(width * height * bytes_per_pixel);
+        UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, 1, 1, 0);
+        REQUIRE(linear == ReferenceUnswizzle(swizzled, bytes_per_pixel, width, height, 1, 1, 0));
+    }
+}
+
+TEST_CASE("Swizzle[Parallel]", "[video_core]") {
+    // Textures of a few MiB are split in batches of rows across threads, including 3D textures
+    // whose batches cross slice boundaries
+    constexpr std::array<std::array<u32, 4>, 3> textures{{
+        {4, 1024, 1021, 1},
+        {4, 256, 130, 17},
+        {16, 333, 100, 5},
+    }};
+    u32 seed = 200;
+    for (const auto& [bytes_per_pixel, width, height, depth] : textures) {
+        const u32 block_depth = depth > 1 ? 1 : 0;
+        const std::size_t size =
+            CalculateSize(true, bytes_per_pixel, width, height, depth, 3, block_depth);
+        const std::vector<u8> swizzled = RandomBytes(size, ++seed);
+        const std::vector<u8> expected =
+            ReferenceUnswizzle(swizzled, bytes_per_pixel, width, height, depth, 3, block_depth);
+
+        std::vector<u8> linear(expected.size());
+        UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, depth, 3, block_depth);
+        REQUIRE(linear == expected);
+
+        std::vector<u8> reswizzled(size);
+        SwizzleTexture(reswizzled, linear, bytes_per_pixel, width, height, depth, 3, block_depth);
+        std::vector<u8> relinear(expected.size());
+        UnswizzleTexture(relinear, reswizzled, bytes_per_pixel, width, height, depth, 3,
+                         block_depth);
+        REQUIRE(relinear == expected);
+    }
+}
+
+TEST_CASE("Swizzle[Throughput]", "[.][benchmark]") {
+    constexpr u32 width = 2048;
+    constexpr u32 height = 2048;
+    constexpr u32 block_height = 4;
+    constexpr int iterations = 8;
+    for (const u32 bytes_per_pixel : BYTES_PER_PIXEL) {
+        const std::size_t size =
+            CalculateSize(true, bytes_per_pixel, width, height, 1, block_height, 0);
+        const std::vector<u8> swizzled = RandomBytes(size, 1);
+        std::vector<u8> linear(static_cast<std::size_t>(width) * height * bytes_per_pixel);
+
+        const auto unswizzle_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            UnswizzleTexture(linear, swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+        }
+        const auto unswizzle_end = std::chrono::steady_clock::now();
+
+        const auto reference_start = std::chrono::steady_clock::now();
+        const std::vector<u8> expected =
+            ReferenceUnswizzle(swizzled, bytes_per_pixel, width, height, 1, block_height, 0);
+        const auto reference_end = std::chrono::steady_clock::now();
+        REQUIRE(linear == expected);
+
+        std::vector<u8> reswizzled(size);
+        const auto swizzle_start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            SwizzleTexture(reswizzled, linear, bytes_per_pixel, width, height, 1, block_height, 0);
+        }
+        const auto swizzle_end = std::chrono::steady_clock::now();
+
+        const auto bytes = static_cast<double>(linear.size());
+        const auto rate = [bytes](auto start, auto end, int count) {
+            return bytes * count / std::chrono::duration<double>(end - start).count() / (1 << 20);
+        };
+        fmt::print("{:2} bytes per pixel: unswizzle {:.0f} MiB/s, swizzle {:.0f} MiB/s, "
+                   "per pixel reference {:.0f} MiB/s\n",
+                   bytes_per_pixel, rate(unswizzle_start, unswizzle_end, iterations),
+                   rate(swizzle_start, swizzle_end, iterations),
+                   rate(reference_start, reference_end, 1));
+    }
+}
@@ -35,7 +35,10 @@ CDmaPusher::CDmaPusher(GPU& gpu_)
       host1x_processor(std::make_unique<Host1x>(gpu)),
       sync_manager(std::make_unique<SyncptIncrManager>(gpu)) {}
 
-CDmaPusher::~CDmaPusher() = default;
+CDmaPusher::~CDmaPusher() {
+    // Pending decodes signal syncpoints through the sync manager, let them finish first
+    nvdec_processor->WaitIdle();
+}
 
 void CDmaPusher::ProcessEntries(ChCommandHeaderList&& entries) {
     for (const auto& value : entries) {
@@ -95,8 +98,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Frames are decoded asynchronously, the guest waits on the syncpoint for them
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->SignalWhenDone(
+                    [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
@@ -2,73 +2,65 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <cstring>
-#include <fstream>
+#include <chrono>
 #include <vector>
+#include <fmt/format.h>
 #include "common/assert.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
 #include "video_core/command_classes/codecs/codec.h"
 #include "video_core/command_classes/codecs/h264.h"
 #include "video_core/command_classes/codecs/vp9.h"
 #include "video_core/gpu.h"
 #include "video_core/memory_manager.h"
 
-extern "C" {
-#include <libavutil/opt.h>
-}
-
 namespace Tegra {
 
-void AVFrameDeleter(AVFrame* ptr) {
-    av_frame_unref(ptr);
-    av_free(ptr);
-}
-
 Codec::Codec(GPU& gpu_, const NvdecCommon::NvdecRegisters& regs)
     : gpu(gpu_), state{regs}, h264_decoder(std::make_unique<Decoder::H264>(gpu)),
       vp9_decoder(std::make_unique<Decoder::VP9>(gpu)) {}
 
-Codec::~Codec() {
-    if (!initialized) {
+Codec::~Codec() = default;
+
+void Codec::Initialize() {
+    if (current_codec != NvdecCommon::VideoCodec::H264 &&
+        current_codec != NvdecCommon::VideoCodec::Vp9) {
         return;
     }
-    // Free libav memory
-    AVFrame* av_frame{nullptr};
-    avcodec_send_packet(av_codec_ctx, nullptr);
-    av_frame = av_frame_alloc();
-    avcodec_receive_frame(av_codec_ctx, av_frame);
-    avcodec_flush_buffers(av_codec_ctx);
-
-    av_frame_unref(av_frame);
-    av_free(av_frame);
-    avcodec_close(av_codec_ctx);
+    decode_worker = std::make_unique<DecodeWorker>(current_codec);
+    if (!decode_worker->IsInitialized()) {
+        decode_worker.reset();
+        return;
+    }
+    if (Settings::values.dump_nvdec) {
+        OpenTraceFile();
+    }
+    initialized = true;
 }
 
-void Codec::Initialize() {
-    AVCodecID codec{AV_CODEC_ID_NONE};
-    switch (current_codec) {
-    case NvdecCommon::VideoCodec::H264:
-        codec = AV_CODEC_ID_H264;
-        break;
-    case NvdecCommon::VideoCodec::Vp9:
-        codec = AV_CODEC_ID_VP9;
-        break;
-    default:
+void Codec::OpenTraceFile() {
+    const auto dump_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::DumpDir) / "nvdec";
+    if (!Common::FS::CreateDirs(dump_dir)) {
+        LOG_ERROR(Service_NVDRV, "Failed to create NVDEC dump directory");
         return;
     }
-    av_codec = avcodec_find_decoder(codec);
-    av_codec_ctx = avcodec_alloc_context3(av_codec);
-    av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
-
-    // TODO(ameerj): libavcodec gpu hw acceleration
-
-    const auto av_error = avcodec_open2(av_codec_ctx, av_codec, nullptr);
-    if (av_error < 0) {
-        LOG_ERROR(Service_NVDRV, "avcodec_open2() Failed.");
-        avcodec_close(av_codec_ctx);
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    const auto path =
+        dump_dir / fmt::format("{}_{}.nvdt", GetCurrentCodecName(), timestamp.count());
+    trace_file.emplace(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::BinaryFile);
+    const NvdecTrace::Header header{
+        .magic = NvdecTrace::MAGIC,
+        .codec = static_cast<u32>(current_codec),
+    };
+    if (!trace_file->IsOpen() || !trace_file->WriteObject(header)) {
+        LOG_ERROR(Service_NVDRV, "Failed to create NVDEC trace {}", path.string());
+        trace_file.reset();
         return;
     }
-    initialized = true;
-    return;
+    LOG_INFO(Service_NVDRV, "Recording NVDEC trace to {}", path.string());
 }
 
 void Codec::SetTargetCodec(NvdecCommon::VideoCodec codec) {
@@ -82,47 +74,51 @@ void Codec::Decode() {
     const bool is_first_frame = !initialized;
     if (!initialized) {
         Initialize();
+        if (!initialized) {
+            return;
+        }
     }
 
-    bool vp9_hidden_frame = false;
-    AVPacket packet{};
-    av_init_packet(&packet);
+    // The composed frame is copied, decoders reuse their buffer for the next frame
     std::vector<u8> frame_data;
-
     if (current_codec == NvdecCommon::VideoCodec::H264) {
         frame_data = h264_decoder->ComposeFrameHeader(state, is_first_frame);
     } else if (current_codec == NvdecCommon::VideoCodec::Vp9) {
         frame_data = vp9_decoder->ComposeFrameHeader(state);
-        vp9_hidden_frame = vp9_decoder->WasFrameHidden();
     }
 
-    packet.data = frame_data.data();
-    packet.size = static_cast<s32>(frame_data.size());
+    if (trace_file) {
+        const u32 size = static_cast<u32>(frame_data.size());
+        if (!trace_file->WriteObject(size) || trace_file->Write(frame_data) != size) {
+            LOG_ERROR(Service_NVDRV, "Failed to write NVDEC trace, recording stopped");
+            trace_file.reset();
+        }
+    }
 
-    avcodec_send_packet(av_codec_ctx, &packet);
+    decode_worker->QueuePacket(std::move(frame_data));
+}
 
-    if (!vp9_hidden_frame) {
-        // Only receive/store visible frames
-        AVFramePtr frame = AVFramePtr{av_frame_alloc(), AVFrameDeleter};
-        avcodec_receive_frame(av_codec_ctx, frame.get());
-        av_frames.push(std::move(frame));
-        // Limit queue to 10 frames. Workaround for ZLA decode and queue spam
-        if (av_frames.size() > 10) {
-            av_frames.pop();
-        }
+void Codec::SignalWhenDone(std::function<void()>&& func) {
+    if (!decode_worker) {
+        func();
+        return;
+    }
+    decode_worker->QueueCallback(std::move(func));
+}
+
+void Codec::WaitIdle() {
+    if (decode_worker) {
+        decode_worker->WaitIdle();
     }
 }
 
 AVFramePtr Codec::GetCurrentFrame() {
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a nullptr and don't overwrite previous frame data
-    if (av_frames.empty()) {
+    if (!decode_worker) {
         return AVFramePtr{nullptr, AVFrameDeleter};
     }
-
-    AVFramePtr frame = std::move(av_frames.front());
-    av_frames.pop();
-    return frame;
+    return decode_worker->GetFrame();
 }
 
 NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
@@ -4,29 +4,18 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
-#include <queue>
+#include <optional>
 #include "common/common_types.h"
+#include "common/fs/file.h"
+#include "video_core/command_classes/codecs/decode_worker.h"
 #include "video_core/command_classes/nvdec_common.h"
 
-extern "C" {
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-#include <libavcodec/avcodec.h>
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-}
-
 namespace Tegra {
 class GPU;
 struct VicRegisters;
 
-void AVFrameDeleter(AVFrame* ptr);
-using AVFramePtr = std::unique_ptr<AVFrame, decltype(&AVFrameDeleter)>;
-
 namespace Decoder {
 class H264;
 class VP9;
@@ -43,9 +32,15 @@ public:
     /// Sets NVDEC video stream codec
     void SetTargetCodec(NvdecCommon::VideoCodec codec);
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers, queue the frame to be decoded with ffmpeg
     void Decode();
 
+    /// Calls func once every frame queued so far has been decoded, it may run on another thread
+    void SignalWhenDone(std::function<void()>&& func);
+
+    /// Blocks until every queued frame has been decoded
+    void WaitIdle();
+
     /// Returns next decoded frame
     [[nodiscard]] AVFramePtr GetCurrentFrame();
 
@@ -55,18 +50,19 @@ public:
     [[nodiscard]] std::string_view GetCurrentCodecName() const;
 
 private:
+    /// Opens a trace file in the dump directory to record the decoded bitstream
+    void OpenTraceFile();
+
     bool initialized{};
     NvdecCommon::VideoCodec current_codec{NvdecCommon::VideoCodec::None};
 
-    AVCodec* av_codec{nullptr};
-    AVCodecContext* av_codec_ctx{nullptr};
-
     GPU& gpu;
     const NvdecCommon::NvdecRegisters& state;
     std::unique_ptr<Decoder::H264> h264_decoder;
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
-    std::queue<AVFramePtr> av_frames{};
+    std::unique_ptr<DecodeWorker> decode_worker;
+    std::optional<Common::FS::IOFile> trace_file;
 };
 
 } // namespace Tegra
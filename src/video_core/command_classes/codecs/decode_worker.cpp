@@ -0,0 +1,166 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "video_core/command_classes/codecs/decode_worker.h"
+
+extern "C" {
+#include <libavutil/opt.h>
+}
+
+namespace Tegra {
+
+void AVFrameDeleter(AVFrame* ptr) {
+    av_frame_unref(ptr);
+    av_free(ptr);
+}
+
+DecodeWorker::DecodeWorker(NvdecCommon::VideoCodec codec, int num_threads) {
+    AVCodecID codec_id{AV_CODEC_ID_NONE};
+    switch (codec) {
+    case NvdecCommon::VideoCodec::H264:
+        codec_id = AV_CODEC_ID_H264;
+        break;
+    case NvdecCommon::VideoCodec::Vp9:
+        codec_id = AV_CODEC_ID_VP9;
+        break;
+    default:
+        return;
+    }
+    av_codec = avcodec_find_decoder(codec_id);
+    av_codec_ctx = avcodec_alloc_context3(av_codec);
+    av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
+    av_codec_ctx->thread_count = num_threads;
+    // Frame threading holds back the output by a frame per thread, VIC expects the frame of a
+    // packet once the syncpoint behind it has been signalled
+    av_codec_ctx->thread_type = FF_THREAD_SLICE;
+
+    // TODO(ameerj): libavcodec gpu hw acceleration
+
+    const auto av_error = avcodec_open2(av_codec_ctx, av_codec, nullptr);
+    if (av_error < 0) {
+        LOG_ERROR(Service_NVDRV, "avcodec_open2() Failed.");
+        avcodec_free_context(&av_codec_ctx);
+        return;
+    }
+    worker_thread = std::thread([this] { WorkerThread(); });
+}
+
+DecodeWorker::~DecodeWorker() {
+    if (!IsInitialized()) {
+        return;
+    }
+    {
+        std::scoped_lock lock{queue_mutex};
+        stop = true;
+    }
+    request_cv.notify_all();
+    worker_thread.join();
+
+    // Free libav memory
+    AVFrame* av_frame{nullptr};
+    avcodec_send_packet(av_codec_ctx, nullptr);
+    av_frame = av_frame_alloc();
+    avcodec_receive_frame(av_codec_ctx, av_frame);
+    avcodec_flush_buffers(av_codec_ctx);
+
+    av_frame_unref(av_frame);
+    av_free(av_frame);
+    avcodec_free_context(&av_codec_ctx);
+}
+
+void DecodeWorker::QueuePacket(std::vector<u8>&& packet) {
+    {
+        std::unique_lock lock{queue_mutex};
+        space_cv.wait(lock, [this] { return num_pending_packets < MAX_PENDING_PACKETS; });
+        requests.push_back(Request{.packet = std::move(packet), .callback = {}});
+        ++num_pending_packets;
+    }
+    request_cv.notify_one();
+}
+
+void DecodeWorker::QueueCallback(std::function<void()>&& func) {
+    {
+        std::scoped_lock lock{queue_mutex};
+        requests.push_back(Request{.packet = {}, .callback = std::move(func)});
+    }
+    request_cv.notify_one();
+}
+
+void DecodeWorker::WaitIdle() {
+    std::unique_lock lock{queue_mutex};
+    idle_cv.wait(lock, [this] { return requests.empty() && !is_busy; });
+}
+
+AVFramePtr DecodeWorker::GetFrame() {
+    std::scoped_lock lock{frame_mutex};
+    if (frames.empty()) {
+        return AVFramePtr{nullptr, AVFrameDeleter};
+    }
+    AVFramePtr frame = std::move(frames.front());
+    frames.pop();
+    return frame;
+}
+
+void DecodeWorker::WorkerThread() {
+    Common::SetCurrentThreadName("yuzu:NVDEC");
+    while (true) {
+        Request request;
+        {
+            std::unique_lock lock{queue_mutex};
+            request_cv.wait(lock, [this] { return stop || !requests.empty(); });
+            if (stop) {
+                return;
+            }
+            request = std::move(requests.front());
+            requests.pop_front();
+            is_busy = true;
+        }
+        if (request.callback) {
+            request.callback();
+        } else {
+            DecodePacket(request.packet);
+        }
+        {
+            std::scoped_lock lock{queue_mutex};
+            if (!request.callback) {
+                --num_pending_packets;
+            }
+            is_busy = false;
+        }
+        space_cv.notify_one();
+        idle_cv.notify_all();
+    }
+}
+
+void DecodeWorker::DecodePacket(std::vector<u8>& packet) {
+    AVPacket av_packet{};
+    av_init_packet(&av_packet);
+    av_packet.data = packet.data();
+    av_packet.size = static_cast<s32>(packet.size());
+    if (avcodec_send_packet(av_codec_ctx, &av_packet) < 0) {
+        LOG_ERROR(Service_NVDRV, "avcodec_send_packet() Failed.");
+        return;
+    }
+
+    // Take every frame the decoder has ready, hidden VP9 frames leave none
+    while (true) {
+        AVFramePtr frame{av_frame_alloc(), AVFrameDeleter};
+        if (avcodec_receive_frame(av_codec_ctx, frame.get()) < 0) {
+            break;
+        }
+        std::scoped_lock lock{frame_mutex};
+        frames.push(std::move(frame));
+        // Drop the oldest frame when the consumer falls behind, some games decode frames they never
+        // present
+        if (frames.size() > MAX_QUEUED_FRAMES) {
+            frames.pop();
+        }
+    }
+}
+
+} // namespace Tegra
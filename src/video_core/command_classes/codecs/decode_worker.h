@@ -0,0 +1,118 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "video_core/command_classes/nvdec_common.h"
+
+extern "C" {
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+#include <libavcodec/avcodec.h>
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+}
+
+namespace Tegra {
+
+void AVFrameDeleter(AVFrame* ptr);
+using AVFramePtr = std::unique_ptr<AVFrame, decltype(&AVFrameDeleter)>;
+
+/// Recorded NVDEC bitstreams, as they are sent to FFmpeg. Written when dump_nvdec is enabled.
+namespace NvdecTrace {
+constexpr u32 MAGIC = Common::MakeMagic('N', 'V', 'D', 'T');
+
+/// The header is followed by the packets, each one is a u32 size and the packet data
+struct Header {
+    u32 magic;
+    u32 codec; ///< NvdecCommon::VideoCodec
+};
+static_assert(sizeof(Header) == 0x8, "Header has incorrect size.");
+} // namespace NvdecTrace
+
+/**
+ * Decodes video packets with FFmpeg on a dedicated thread.
+ * FFmpeg only uses slice threading, so the frame of a packet is available as soon as the packet
+ * has been decoded and callbacks queued after it can signal its completion. Packets are decoded in
+ * the order they were queued, queueing blocks while MAX_PENDING_PACKETS packets are waiting.
+ * Decoded frames are double buffered, the oldest one is dropped when the consumer falls behind.
+ */
+class DecodeWorker final {
+public:
+    /// Number of packets that can be waiting for the decoder before the caller blocks
+    static constexpr std::size_t MAX_PENDING_PACKETS = 2;
+    /// Number of decoded frames kept for the consumer, older frames are dropped
+    static constexpr std::size_t MAX_QUEUED_FRAMES = 2;
+
+    /**
+     * @param codec        Codec of the packets
+     * @param num_threads  Number of FFmpeg decoding threads, zero picks one per host thread
+     */
+    explicit DecodeWorker(NvdecCommon::VideoCodec codec, int num_threads = 0);
+    ~DecodeWorker();
+
+    YUZU_NON_COPYABLE(DecodeWorker);
+    YUZU_NON_MOVEABLE(DecodeWorker);
+
+    /// Returns true when FFmpeg was successfully initialized for the codec
+    [[nodiscard]] bool IsInitialized() const {
+        return av_codec_ctx != nullptr;
+    }
+
+    /// Queues a packet to be decoded
+    void QueuePacket(std::vector<u8>&& packet);
+
+    /// Calls func on the worker thread once every packet queued before it has been decoded
+    void QueueCallback(std::function<void()>&& func);
+
+    /// Blocks until every queued packet and callback has been processed
+    void WaitIdle();
+
+    /// Returns the oldest decoded frame, or nullptr if there are none
+    [[nodiscard]] AVFramePtr GetFrame();
+
+private:
+    struct Request {
+        std::vector<u8> packet;
+        std::function<void()> callback;
+    };
+
+    void WorkerThread();
+
+    void DecodePacket(std::vector<u8>& packet);
+
+    AVCodec* av_codec{};
+    AVCodecContext* av_codec_ctx{};
+
+    std::mutex queue_mutex;
+    std::condition_variable request_cv;
+    std::condition_variable space_cv;
+    std::condition_variable idle_cv;
+    std::deque<Request> requests;
+    std::size_t num_pending_packets{};
+    bool is_busy{};
+    bool stop{};
+
+    std::mutex frame_mutex;
+    std::queue<AVFramePtr> frames;
+
+    std::thread worker_thread;
+};
+
+} // namespace Tegra
@@ -32,6 +32,14 @@ AVFramePtr Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
 
+void Nvdec::SignalWhenDone(std::function<void()>&& func) {
+    codec->SignalWhenDone(std::move(func));
+}
+
+void Nvdec::WaitIdle() {
+    codec->WaitIdle();
+}
+
 void Nvdec::Execute() {
     switch (codec->GetCurrentCodec()) {
     case NvdecCommon::VideoCodec::H264:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include "common/common_types.h"
@@ -23,6 +24,12 @@ public:
     /// Return most recently decoded frame
     [[nodiscard]] AVFramePtr GetFrame();
 
+    /// Calls func once every frame executed so far has been decoded, it may run on another thread
+    void SignalWhenDone(std::function<void()>&& func);
+
+    /// Blocks until every frame executed so far has been decoded
+    void WaitIdle();
+
 private:
     /// Invoke codec to decode a frame
     void Execute();
@@ -54,6 +54,9 @@ public:
     void IncrementAllDone();
 
 private:
+    /// Increments the done syncpoints, increment_lock must be held
+    void IncrementAllDoneLocked();
+
     std::vector<SyncptIncr> increments;
     std::mutex increment_lock;
     u32 current_id{};
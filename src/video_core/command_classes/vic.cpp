@@ -2,24 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <array>
-
-extern "C" {
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-#include <libswscale/swscale.h>
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-}
+#include <cstring>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
 
 #include "video_core/command_classes/nvdec.h"
 #include "video_core/command_classes/vic.h"
+#include "video_core/command_classes/vic_convert.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
 #include "video_core/memory_manager.h"
@@ -28,11 +18,22 @@ extern "C" {
 namespace Tegra {
 
 Vic::Vic(GPU& gpu_, std::shared_ptr<Nvdec> nvdec_processor_)
-    : gpu(gpu_),
-      nvdec_processor(std::move(nvdec_processor_)), converted_frame_buffer{nullptr, av_free} {}
+    : gpu(gpu_), nvdec_processor(std::move(nvdec_processor_)) {}
 
 Vic::~Vic() = default;
 
+template <typename Func>
+void Vic::WriteSurface(GPUVAddr address, std::size_t size, std::vector<u8>& staging,
+                       Func&& write) {
+    if (u8* const pointer = gpu.MemoryManager().GetContinuousWritePointer(address, size)) {
+        write(pointer);
+        return;
+    }
+    staging.resize(size);
+    write(staging.data());
+    gpu.MemoryManager().WriteBlock(address, staging.data(), size);
+}
+
 void Vic::ProcessMethod(Method method, u32 argument) {
     LOG_DEBUG(HW_GPU, "Vic method 0x{:X}", static_cast<u32>(method));
     const u64 arg = static_cast<u64>(argument) << 8;
@@ -75,52 +76,34 @@ void Vic::Execute() {
     case VideoPixelFormat::RGBA8: {
         LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
 
-        if (scaler_ctx == nullptr || frame->width != scaler_width ||
-            frame->height != scaler_height) {
-            const AVPixelFormat target_format =
-                (pixel_format == VideoPixelFormat::RGBA8) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_BGRA;
-
-            sws_freeContext(scaler_ctx);
-            scaler_ctx = nullptr;
-
-            // FFmpeg returns all frames in YUV420, convert it into expected format
-            scaler_ctx =
-                sws_getContext(frame->width, frame->height, AV_PIX_FMT_YUV420P, frame->width,
-                               frame->height, target_format, 0, nullptr, nullptr, nullptr);
-
-            scaler_width = frame->width;
-            scaler_height = frame->height;
-        }
-        // Get Converted frame
-        const std::size_t linear_size = frame->width * frame->height * 4;
-
-        // Only allocate frame_buffer once per stream, as the size is not expected to change
-        if (!converted_frame_buffer) {
-            converted_frame_buffer = AVMallocPtr{static_cast<u8*>(av_malloc(linear_size)), av_free};
-        }
-
-        const int converted_stride{frame->width * 4};
-        u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
-
-        sws_scale(scaler_ctx, frame->data, frame->linesize, 0, frame->height,
-                  &converted_frame_buf_addr, &converted_stride);
+        // FFmpeg returns all frames in YUV420, convert it into the expected format
+        const VicConvert::Yuv420Frame yuv_frame{
+            .luma = frame->data[0],
+            .chroma_u = frame->data[1],
+            .chroma_v = frame->data[2],
+            .luma_stride = static_cast<std::size_t>(frame->linesize[0]),
+            .chroma_stride = static_cast<std::size_t>(frame->linesize[1]),
+            .width = static_cast<u32>(frame->width),
+            .height = static_cast<u32>(frame->height),
+        };
+        const VicConvert::RgbaOrder order = pixel_format == VideoPixelFormat::RGBA8
+                                                ? VicConvert::RgbaOrder::RGBA
+                                                : VicConvert::RgbaOrder::BGRA;
 
         const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
         if (blk_kind != 0) {
-            // swizzle pitch linear to block linear
+            // Convert and swizzle pitch linear to block linear in a single pass
             const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
-            const auto size = Tegra::Texture::CalculateSize(true, 4, frame->width, frame->height, 1,
-                                                            block_height, 0);
-            luma_buffer.resize(size);
-            Tegra::Texture::SwizzleSubrect(frame->width, frame->height, frame->width * 4,
-                                           frame->width, 4, luma_buffer.data(),
-                                           converted_frame_buffer.get(), block_height, 0, 0);
-
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(), size);
+            const auto size = Tegra::Texture::CalculateSize(true, 4, yuv_frame.width,
+                                                            yuv_frame.height, 1, block_height, 0);
+            WriteSurface(output_surface_luma_address, size, luma_buffer, [&](u8* output) {
+                VicConvert::ConvertToRgbaBlockLinear(yuv_frame, order, block_height, output);
+            });
         } else {
             // send pitch linear frame
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, converted_frame_buf_addr,
-                                           linear_size);
+            const std::size_t linear_size = std::size_t{yuv_frame.width} * yuv_frame.height * 4;
+            WriteSurface(output_surface_luma_address, linear_size, luma_buffer,
+                         [&](u8* output) { VicConvert::ConvertToRgba(yuv_frame, order, output); });
         }
         break;
     }
@@ -133,41 +116,25 @@ void Vic::Execute() {
         const std::size_t half_height = config.surface_height_minus1 / 2;
         const std::size_t aligned_width = (surface_width + 0xff) & ~0xff;
 
-        const auto* luma_ptr = frame->data[0];
-        const auto* chroma_b_ptr = frame->data[1];
-        const auto* chroma_r_ptr = frame->data[2];
-        const auto stride = frame->linesize[0];
-        const auto half_stride = frame->linesize[1];
-
-        luma_buffer.resize(aligned_width * surface_height);
-        chroma_buffer.resize(aligned_width * half_height);
+        const auto stride = static_cast<std::size_t>(frame->linesize[0]);
+        const auto half_stride = static_cast<std::size_t>(frame->linesize[1]);
 
-        // Populate luma buffer
-        for (std::size_t y = 0; y < surface_height - 1; ++y) {
-            const std::size_t src = y * stride;
-            const std::size_t dst = y * aligned_width;
-
-            const std::size_t size = surface_width;
-
-            for (std::size_t offset = 0; offset < size; ++offset) {
-                luma_buffer[dst + offset] = luma_ptr[src + offset];
-            }
-        }
-        gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(),
-                                       luma_buffer.size());
+        // Populate luma buffer, the last row is left cleared
+        WriteSurface(output_surface_luma_address, aligned_width * surface_height, luma_buffer,
+                     [&](u8* output) {
+                         VicConvert::CopyPlane(frame->data[0], stride, surface_width,
+                                               surface_height - 1, aligned_width, output);
+                         std::memset(output + (surface_height - 1) * aligned_width, 0,
+                                     aligned_width);
+                     });
 
         // Populate chroma buffer from both channels with interleaving.
-        for (std::size_t y = 0; y < half_height; ++y) {
-            const std::size_t src = y * half_stride;
-            const std::size_t dst = y * aligned_width;
-
-            for (std::size_t x = 0; x < half_width; ++x) {
-                chroma_buffer[dst + x * 2] = chroma_b_ptr[src + x];
-                chroma_buffer[dst + x * 2 + 1] = chroma_r_ptr[src + x];
-            }
-        }
-        gpu.MemoryManager().WriteBlock(output_surface_chroma_u_address, chroma_buffer.data(),
-                                       chroma_buffer.size());
+        WriteSurface(output_surface_chroma_u_address, aligned_width * half_height, chroma_buffer,
+                     [&](u8* output) {
+                         VicConvert::InterleaveChroma(frame->data[1], frame->data[2], half_stride,
+                                                      half_width, half_height, aligned_width,
+                                                      output);
+                     });
         break;
     }
     default:
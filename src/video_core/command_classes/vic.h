@@ -4,13 +4,12 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
 
-struct SwsContext;
-
 namespace Tegra {
 class GPU;
 class Nvdec;
@@ -35,6 +34,14 @@ public:
 private:
     void Execute();
 
+    /**
+     * Writes a surface to guest memory. The surface is written in place when the region is
+     * continuous in host memory, otherwise through the staging buffer.
+     * @param write  Called with the destination of the surface
+     */
+    template <typename Func>
+    void WriteSurface(GPUVAddr address, std::size_t size, std::vector<u8>& staging, Func&& write);
+
     enum class VideoPixelFormat : u64_le {
         RGBA8 = 0x1f,
         BGRA8 = 0x20,
@@ -55,10 +62,8 @@ private:
     GPU& gpu;
     std::shared_ptr<Tegra::Nvdec> nvdec_processor;
 
-    /// Avoid reallocation of the following buffers every frame, as their
-    /// size does not change during a stream
-    using AVMallocPtr = std::unique_ptr<u8, decltype(&av_free)>;
-    AVMallocPtr converted_frame_buffer;
+    /// Staging buffers for surfaces that are not continuous in host memory. Avoid reallocation of
+    /// them every frame, as their size does not change during a stream
     std::vector<u8> luma_buffer;
     std::vector<u8> chroma_buffer;
 
@@ -66,10 +71,6 @@ private:
     GPUVAddr output_surface_luma_address{};
     GPUVAddr output_surface_chroma_u_address{};
     GPUVAddr output_surface_chroma_v_address{};
-
-    SwsContext* scaler_ctx{};
-    s32 scaler_width{};
-    s32 scaler_height{};
 };
 
 } // namespace Tegra
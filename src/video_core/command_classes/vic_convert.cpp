@@ -0,0 +1,231 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
+#include "common/div_ceil.h"
+#include "video_core/command_classes/vic_convert.h"
+#include "video_core/textures/decoders.h"
+
+namespace Tegra::VicConvert {
+namespace {
+using Texture::GOB_SIZE_SHIFT;
+using Texture::GOB_SIZE_X;
+using Texture::GOB_SIZE_Y;
+using Texture::GOB_SIZE_Y_SHIFT;
+using Texture::SWIZZLE_TABLE;
+
+constexpr u32 BYTES_PER_PIXEL = 4;
+
+/// Number of pixels converted at once, their 64 bytes are exactly one GOB row
+constexpr u32 PIXELS_PER_STEP = 16;
+static_assert(PIXELS_PER_STEP * BYTES_PER_PIXEL == GOB_SIZE_X);
+
+// BT.601 limited range coefficients with 6 fractional bits. Luma is scaled by multiplying it,
+// replicated to 16 bits, by Y_SCALE and keeping the high half, to fit the products in 16 bits.
+constexpr int FRACTION_BITS = 6;
+constexpr u16 Y_SCALE = 18997;    // 1.164 * 64 * 65536 / 257
+constexpr s16 Y_BIAS = 32 - 1192; // Rounding minus 16 * 1.164 * 64
+constexpr s16 RED_V = 102;        // 1.596 * 64
+constexpr s16 GREEN_U = 25;       // 0.391 * 64
+constexpr s16 GREEN_V = 52;       // 0.813 * 64
+constexpr s16 BLUE_U = 129;       // 2.018 * 64
+
+u8 ClampChannel(int value) {
+    return static_cast<u8>(std::clamp(value >> FRACTION_BITS, 0, 255));
+}
+
+/// Converts a single pixel, gives the same results as the vectorized path
+template <RgbaOrder order>
+void ConvertPixel(u8 luma, u8 chroma_u, u8 chroma_v, u8* output) {
+    const int y = static_cast<int>((u32{luma} * 257 * Y_SCALE) >> 16) + Y_BIAS;
+    const int u = chroma_u - 128;
+    const int v = chroma_v - 128;
+    const u8 red = ClampChannel(y + RED_V * v);
+    const u8 green = ClampChannel(y - GREEN_U * u - GREEN_V * v);
+    const u8 blue = ClampChannel(y + BLUE_U * u);
+    output[0] = order == RgbaOrder::RGBA ? red : blue;
+    output[1] = green;
+    output[2] = order == RgbaOrder::RGBA ? blue : red;
+    output[3] = 0xff;
+}
+
+#ifdef ARCHITECTURE_x86_64
+/// Adds the chroma terms to the luma of 16 pixels and packs the channel to bytes
+__m128i MakeChannel(__m128i y_low, __m128i y_high, __m128i chroma) {
+    // Each chroma sample covers two horizontally adjacent pixels
+    const __m128i low = _mm_adds_epi16(y_low, _mm_unpacklo_epi16(chroma, chroma));
+    const __m128i high = _mm_adds_epi16(y_high, _mm_unpackhi_epi16(chroma, chroma));
+    return _mm_packus_epi16(_mm_srai_epi16(low, FRACTION_BITS),
+                            _mm_srai_epi16(high, FRACTION_BITS));
+}
+
+/**
+ * Converts 16 pixels and stores them as four 16 byte runs
+ * @param dest  Returns the destination of the run holding the given byte of the 64 byte output
+ */
+template <RgbaOrder order, typename Dest>
+void ConvertStep(const u8* luma, const u8* chroma_u, const u8* chroma_v, Dest&& dest) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma));
+    const __m128i u = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_u)), zero),
+        bias);
+    const __m128i v = _mm_sub_epi16(
+        _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(chroma_v)), zero),
+        bias);
+
+    const __m128i y_scale = _mm_set1_epi16(static_cast<s16>(Y_SCALE));
+    const __m128i y_bias = _mm_set1_epi16(Y_BIAS);
+    const __m128i y_low = _mm_add_epi16(_mm_mulhi_epu16(_mm_unpacklo_epi8(y, y), y_scale), y_bias);
+    const __m128i y_high =
+        _mm_add_epi16(_mm_mulhi_epu16(_mm_unpackhi_epi8(y, y), y_scale), y_bias);
+
+    const __m128i red_uv = _mm_mullo_epi16(v, _mm_set1_epi16(RED_V));
+    const __m128i green_uv =
+        _mm_sub_epi16(zero, _mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(GREEN_U)),
+                                          _mm_mullo_epi16(v, _mm_set1_epi16(GREEN_V))));
+    const __m128i blue_uv = _mm_mullo_epi16(u, _mm_set1_epi16(BLUE_U));
+
+    const __m128i red = MakeChannel(y_low, y_high, red_uv);
+    const __m128i green = MakeChannel(y_low, y_high, green_uv);
+    const __m128i blue = MakeChannel(y_low, y_high, blue_uv);
+    const __m128i alpha = _mm_set1_epi8(-1);
+
+    const __m128i first = order == RgbaOrder::RGBA ? red : blue;
+    const __m128i third = order == RgbaOrder::RGBA ? blue : red;
+    const __m128i first_green_low = _mm_unpacklo_epi8(first, green);
+    const __m128i first_green_high = _mm_unpackhi_epi8(first, green);
+    const __m128i third_alpha_low = _mm_unpacklo_epi8(third, alpha);
+    const __m128i third_alpha_high = _mm_unpackhi_epi8(third, alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest(0)),
+                     _mm_unpacklo_epi16(first_green_low, third_alpha_low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest(16)),
+                     _mm_unpackhi_epi16(first_green_low, third_alpha_low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest(32)),
+                     _mm_unpacklo_epi16(first_green_high, third_alpha_high));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest(48)),
+                     _mm_unpackhi_epi16(first_green_high, third_alpha_high));
+}
+#endif
+
+/**
+ * Converts the pixels of a row from x_begin to x_end
+ * @param dest  Returns the destination of the given byte of the row, 16 byte aligned runs must be
+ *              contiguous
+ */
+template <RgbaOrder order, typename Dest>
+void ConvertRow(const Yuv420Frame& frame, u32 row, u32 x_begin, u32 x_end, Dest&& dest) {
+    const u8* const luma = frame.luma + row * frame.luma_stride;
+    const u8* const chroma_u = frame.chroma_u + (row / 2) * frame.chroma_stride;
+    const u8* const chroma_v = frame.chroma_v + (row / 2) * frame.chroma_stride;
+    u32 x = x_begin;
+#ifdef ARCHITECTURE_x86_64
+    for (; x + PIXELS_PER_STEP <= x_end; x += PIXELS_PER_STEP) {
+        const u32 x_bytes = x * BYTES_PER_PIXEL;
+        ConvertStep<order>(luma + x, chroma_u + x / 2, chroma_v + x / 2,
+                           [&](u32 offset) { return dest(x_bytes + offset); });
+    }
+#endif
+    for (; x < x_end; ++x) {
+        ConvertPixel<order>(luma[x], chroma_u[x / 2], chroma_v[x / 2],
+                            dest(x * BYTES_PER_PIXEL));
+    }
+}
+
+template <RgbaOrder order>
+void ConvertLinear(const Yuv420Frame& frame, u8* output) {
+    const std::size_t pitch = std::size_t{frame.width} * BYTES_PER_PIXEL;
+    for (u32 row = 0; row < frame.height; ++row) {
+        u8* const output_row = output + row * pitch;
+        ConvertRow<order>(frame, row, 0, frame.width,
+                          [output_row](u32 x_bytes) { return output_row + x_bytes; });
+    }
+}
+
+template <RgbaOrder order>
+void ConvertBlockLinear(const Yuv420Frame& frame, u32 block_height, u8* output) {
+    const u32 gobs_in_x = Common::DivCeil(frame.width * BYTES_PER_PIXEL, GOB_SIZE_X);
+    const u32 x_shift = GOB_SIZE_SHIFT + block_height;
+    const std::size_t block_size = std::size_t{gobs_in_x} << x_shift;
+    const u32 block_height_mask = (1U << block_height) - 1;
+    for (u32 gob_y = 0; gob_y < frame.height; gob_y += GOB_SIZE_Y) {
+        const u32 block_y = gob_y >> GOB_SIZE_Y_SHIFT;
+        u8* const output_gobs = output + (block_y >> block_height) * block_size +
+                                ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+        const u32 row_end = std::min(gob_y + GOB_SIZE_Y, frame.height);
+        // Fill one GOB at a time, the rows of a GOB are 512 contiguous bytes while the GOBs of a
+        // row are a block apart
+        for (u32 x = 0; x < frame.width; x += PIXELS_PER_STEP) {
+            const u32 x_end = std::min(x + PIXELS_PER_STEP, frame.width);
+            u8* const output_gob = output_gobs + (std::size_t{x / PIXELS_PER_STEP} << x_shift);
+            for (u32 row = gob_y; row < row_end; ++row) {
+                const auto& table = SWIZZLE_TABLE[row % GOB_SIZE_Y];
+                ConvertRow<order>(frame, row, x, x_end, [output_gob, &table](u32 x_bytes) {
+                    return output_gob + table[x_bytes % GOB_SIZE_X];
+                });
+            }
+        }
+    }
+}
+} // Anonymous namespace
+
+void ConvertToRgba(const Yuv420Frame& frame, RgbaOrder order, u8* output) {
+    if (order == RgbaOrder::RGBA) {
+        ConvertLinear<RgbaOrder::RGBA>(frame, output);
+    } else {
+        ConvertLinear<RgbaOrder::BGRA>(frame, output);
+    }
+}
+
+void ConvertToRgbaBlockLinear(const Yuv420Frame& frame, RgbaOrder order, u32 block_height,
+                              u8* output) {
+    if (order == RgbaOrder::RGBA) {
+        ConvertBlockLinear<RgbaOrder::RGBA>(frame, block_height, output);
+    } else {
+        ConvertBlockLinear<RgbaOrder::BGRA>(frame, block_height, output);
+    }
+}
+
+void CopyPlane(const u8* plane, std::size_t stride, std::size_t width, std::size_t height,
+               std::size_t pitch, u8* output) {
+    for (std::size_t row = 0; row < height; ++row) {
+        u8* const output_row = output + row * pitch;
+        std::memcpy(output_row, plane + row * stride, width);
+        std::memset(output_row + width, 0, pitch - width);
+    }
+}
+
+void InterleaveChroma(const u8* chroma_u, const u8* chroma_v, std::size_t stride,
+                      std::size_t width, std::size_t height, std::size_t pitch, u8* output) {
+    for (std::size_t row = 0; row < height; ++row) {
+        const u8* const u = chroma_u + row * stride;
+        const u8* const v = chroma_v + row * stride;
+        u8* const output_row = output + row * pitch;
+        std::size_t x = 0;
+#ifdef ARCHITECTURE_x86_64
+        for (; x + 16 <= width; x += 16) {
+            const __m128i u_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x));
+            const __m128i v_data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output_row + x * 2),
+                             _mm_unpacklo_epi8(u_data, v_data));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output_row + x * 2 + 16),
+                             _mm_unpackhi_epi8(u_data, v_data));
+        }
+#endif
+        for (; x < width; ++x) {
+            output_row[x * 2] = u[x];
+            output_row[x * 2 + 1] = v[x];
+        }
+        std::memset(output_row + width * 2, 0, pitch - width * 2);
+    }
+}
+
+} // namespace Tegra::VicConvert
@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+
+#include "common/common_types.h"
+
+// Colour conversion and surface writing kernels of VIC. Frames come from FFmpeg as planar YUV420
+// and are converted with the BT.601 limited range matrix, like swscale does by default.
+namespace Tegra::VicConvert {
+
+/// Planes of a decoded YUV420 frame, chroma is subsampled by two in both directions
+struct Yuv420Frame {
+    const u8* luma;
+    const u8* chroma_u;
+    const u8* chroma_v;
+    std::size_t luma_stride;
+    std::size_t chroma_stride;
+    u32 width;
+    u32 height;
+};
+
+enum class RgbaOrder {
+    RGBA,
+    BGRA,
+};
+
+/// Converts a frame to 32-bit RGBA or BGRA pixels in pitch linear memory, with a pitch of width * 4
+void ConvertToRgba(const Yuv420Frame& frame, RgbaOrder order, u8* output);
+
+/**
+ * Converts a frame to 32-bit RGBA or BGRA pixels and swizzles them into a block linear surface in
+ * the same pass.
+ * @param block_height  Log2 of the block height in GOBs
+ * @param output        Surface of Texture::CalculateSize(true, 4, width, height, 1, block_height,
+ *                      0) bytes
+ */
+void ConvertToRgbaBlockLinear(const Yuv420Frame& frame, RgbaOrder order, u32 block_height,
+                              u8* output);
+
+/// Copies the rows of a plane into a surface with a larger pitch, the padding is cleared
+void CopyPlane(const u8* plane, std::size_t stride, std::size_t width, std::size_t height,
+               std::size_t pitch, u8* output);
+
+/// Interleaves the U and V planes into a UV plane with the given pitch, the padding is cleared
+void InterleaveChroma(const u8* chroma_u, const u8* chroma_v, std::size_t stride,
+                      std::size_t width, std::size_t height, std::size_t pitch, u8* output);
+
+} // namespace Tegra::VicConvert
@@ -2,6 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <span>
+
+#ifdef _MSC_VER
+#include <xmmintrin.h>
+#endif
+
 #include "common/cityhash.h"
 #include "common/microprofile.h"
 #include "core/core.h"
@@ -12,6 +19,20 @@
 #include "video_core/memory_manager.h"
 
 namespace Tegra {
+namespace {
+/// Bytes of the next command list loaded ahead of time, the rest is left to the hardware
+/// prefetcher once dispatching starts reading it
+constexpr std::size_t PREFETCH_SIZE = 512;
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+void Prefetch(const void* pointer) {
+#ifdef _MSC_VER
+    _mm_prefetch(static_cast<const char*>(pointer), _MM_HINT_T0);
+#else
+    __builtin_prefetch(pointer);
+#endif
+}
+} // Anonymous namespace
 
 DmaPusher::DmaPusher(Core::System& system_, GPU& gpu_) : gpu{gpu_}, system{system_} {}
 
@@ -55,9 +76,11 @@ bool DmaPusher::Step() {
             return true;
         });
 
+    std::span<const CommandHeader> commands;
     if (command_list.prefetch_command_list.size()) {
         // Prefetched command list from nvdrv, used for things like synchronization
         command_headers = std::move(command_list.prefetch_command_list);
+        commands = command_headers;
         dma_pushbuffer.pop();
     } else {
         const CommandListHeader command_list_header{
@@ -68,26 +91,36 @@ bool DmaPusher::Step() {
             // We've gone through the current list, remove it from the queue
             dma_pushbuffer.pop();
             dma_pushbuffer_subindex = 0;
+        } else {
+            // Start loading the next list while this one is being dispatched
+            PrefetchCommandList(command_list.command_lists[dma_pushbuffer_subindex]);
         }
 
         if (command_list_header.size == 0) {
             return true;
         }
 
-        // Push buffer non-empty, read a word
-        command_headers.resize(command_list_header.size);
-        gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
-                                            command_list_header.size * sizeof(u32));
+        // Push buffer non-empty, read it in place when it is continous in host memory
+        const std::size_t size = command_list_header.size;
+        const u8* const pointer =
+            gpu.MemoryManager().GetContinuousPointer(dma_get, size * sizeof(u32));
+        if (pointer) {
+            commands = std::span(reinterpret_cast<const CommandHeader*>(pointer), size);
+        } else {
+            command_headers.resize(size);
+            gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
+                                                size * sizeof(u32));
+            commands = command_headers;
+        }
     }
-    for (std::size_t index = 0; index < command_headers.size();) {
-        const CommandHeader& command_header = command_headers[index];
+    for (std::size_t index = 0; index < commands.size();) {
+        const CommandHeader& command_header = commands[index];
 
         if (dma_state.method_count) {
             // Data word of methods command
             if (dma_state.non_incrementing) {
                 const u32 max_write = static_cast<u32>(
-                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
-                    index);
+                    std::min<std::size_t>(index + dma_state.method_count, commands.size()) - index);
                 CallMultiMethod(&command_header.argument, max_write);
                 dma_state.method_count -= max_write;
                 dma_state.is_last_call = true;
@@ -142,6 +175,21 @@ bool DmaPusher::Step() {
     return true;
 }
 
+void DmaPusher::PrefetchCommandList(const CommandListHeader& command_list_header) const {
+    const u8* const pointer = gpu.MemoryManager().GetPointer(command_list_header.addr);
+    if (!pointer) {
+        return;
+    }
+    // Stay within the cpu page, the next one may not be continous in host memory
+    const std::size_t bytes_to_page_end =
+        Core::Memory::PAGE_SIZE - (command_list_header.addr & Core::Memory::PAGE_MASK);
+    const std::size_t size = std::min<std::size_t>(
+        {command_list_header.size * sizeof(u32), PREFETCH_SIZE, bytes_to_page_end});
+    for (std::size_t offset = 0; offset < size; offset += CACHE_LINE_SIZE) {
+        Prefetch(pointer + offset);
+    }
+}
+
 void DmaPusher::SetState(const CommandHeader& command_header) {
     dma_state.method = command_header.method;
     dma_state.subchannel = command_header.subchannel;
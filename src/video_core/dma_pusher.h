@@ -121,12 +121,16 @@ private:
     static constexpr u32 max_subchannels = 8;
     bool Step();
 
+    /// Hints the host to load the start of a command list that is about to be dispatched
+    void PrefetchCommandList(const CommandListHeader& command_list_header) const;
+
     void SetState(const CommandHeader& command_header);
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
-    std::vector<CommandHeader> command_headers; ///< Buffer for list of commands fetched at once
+    /// Buffer for lists of commands that can't be read in place from guest memory
+    std::vector<CommandHeader> command_headers;
 
     std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
     std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
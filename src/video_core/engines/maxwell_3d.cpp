@@ -232,6 +232,10 @@ void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argume
     }
 }
 
+void Maxwell3D::LoadDiskResources(u64 title_id) {
+    macro_engine->LoadDiskCache(title_id);
+}
+
 void Maxwell3D::CallMacroMethod(u32 method, const std::vector<u32>& parameters) {
     // Reset the current macro.
     executing_macro = 0;
@@ -1445,6 +1445,9 @@ public:
         return execute_on;
     }
 
+    /// Precompiles the macros cached on disk for the given title
+    void LoadDiskResources(u64 title_id);
+
     VideoCore::RasterizerInterface& Rasterizer() {
         return *rasterizer;
     }
@@ -16,6 +16,14 @@
 
 namespace VideoCommon::GPUThread {
 
+/// Discards commands until the one ending processing, so ShutDown() never waits on a full queue
+static void DiscardCommands(SynchState& state) {
+    CommandDataContainer next;
+    do {
+        state.queue.PopWait(next);
+    } while (!std::holds_alternative<EndProcessingCommand>(next.data));
+}
+
 /// Runs the GPU thread
 static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
                       Core::Frontend::GraphicsContext& context, Tegra::DmaPusher& dma_pusher,
@@ -33,6 +41,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
 
     // If emulation was stopped during disk shader loading, abort before trying to acquire context
     if (!state.is_running) {
+        DiscardCommands(state);
         return;
     }
 
@@ -40,8 +49,9 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
     VideoCore::RasterizerInterface* const rasterizer = renderer.ReadRasterizer();
 
     CommandDataContainer next;
+    u64 executed_fence{};
     while (state.is_running) {
-        next = state.queue.PopWait();
+        state.queue.PopWait(next);
         if (auto* submit_list = std::get_if<SubmitListCommand>(&next.data)) {
             dma_pusher.Push(std::move(submit_list->entries));
             dma_pusher.DispatchCalls();
@@ -57,17 +67,24 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             rasterizer->OnCPUWrite(invalidate->addr, invalidate->size);
         } else if (std::holds_alternative<EndProcessingCommand>(next.data)) {
             ASSERT(state.is_running == false);
+            return;
         } else {
             UNREACHABLE();
         }
-        state.signaled_fence.store(next.fence);
+        state.signaled_fence.store(++executed_fence);
         if (next.block) {
             // We have to lock the write_lock to ensure that the condition_variable wait not get a
             // race between the check and the lock itself.
             std::lock_guard lk(state.write_lock);
             state.cv.notify_all();
         }
+        while (!state.command_list_ends.empty() &&
+               state.command_list_ends.front() <= executed_fence) {
+            state.command_list_ends.pop();
+            rasterizer->ReleaseFences();
+        }
     }
+    DiscardCommands(state);
 }
 
 ThreadManager::ThreadManager(Core::System& system_, bool is_async_)
@@ -119,6 +136,7 @@ void ThreadManager::FlushAndInvalidateRegion(VAddr addr, u64 size) {
 
 void ThreadManager::ShutDown() {
     if (!state.is_running) {
+        DiscardCommands(state);
         return;
     }
 
@@ -129,15 +147,26 @@ void ThreadManager::ShutDown() {
     }
 
     if (!thread.joinable()) {
+        state.stop_source.request_stop();
         return;
     }
 
-    // Notify GPU thread that a shutdown is pending
+    // Notify GPU thread that a shutdown is pending. It keeps popping commands until this one, so
+    // pushing it cannot wait forever on a full queue.
     PushCommand(EndProcessingCommand());
+    // Release producers still waiting for room, the GPU thread stops draining the queue now
+    state.stop_source.request_stop();
     thread.join();
 }
 
 void ThreadManager::OnCommandListEnd() {
+    if (std::this_thread::get_id() == thread.get_id()) {
+        // Command lists end on the GPU thread itself, pushing into the queue from its only
+        // consumer could deadlock when the queue is full. Record where the command would have
+        // been queued instead, so fences are still released in queue order.
+        state.command_list_ends.push(state.queue.NextTicket());
+        return;
+    }
     PushCommand(OnCommandListEndCommand());
 }
 
@@ -147,11 +176,16 @@ u64 ThreadManager::PushCommand(CommandData&& command_data, bool block) {
         block = true;
     }
 
-    std::unique_lock lk(state.write_lock);
-    const u64 fence{++state.last_fence};
-    state.queue.Push(CommandDataContainer(std::move(command_data), fence, block));
+    const std::optional<std::size_t> ticket{state.queue.Push(
+        CommandDataContainer(std::move(command_data), block), state.stop_source.get_token())};
+    if (!ticket) {
+        // The GPU thread is shutting down and will not execute this command
+        return 0;
+    }
+    const u64 fence{*ticket + 1};
 
     if (block) {
+        std::unique_lock lk(state.write_lock);
         state.cv.wait(lk, [this, fence] {
             return fence <= state.signaled_fence.load(std::memory_order_relaxed) ||
                    !state.is_running;
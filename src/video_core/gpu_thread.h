@@ -8,10 +8,12 @@
 #include <condition_variable>
 #include <mutex>
 #include <optional>
+#include <queue>
+#include <stop_token>
 #include <thread>
 #include <variant>
 
-#include "common/threadsafe_queue.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "video_core/framebuffer_config.h"
 
 namespace Tegra {
@@ -90,24 +92,32 @@ using CommandData =
 struct CommandDataContainer {
     CommandDataContainer() = default;
 
-    explicit CommandDataContainer(CommandData&& data_, u64 next_fence_, bool block_)
-        : data{std::move(data_)}, fence{next_fence_}, block(block_) {}
+    explicit CommandDataContainer(CommandData&& data_, bool block_)
+        : data{std::move(data_)}, block(block_) {}
 
     CommandData data;
-    u64 fence{};
     bool block{};
 };
 
 /// Struct used to synchronize the GPU thread
 struct SynchState final {
     std::atomic_bool is_running{true};
+    /// Requested on shutdown, so producers stop waiting for room in a queue nobody drains
+    std::stop_source stop_source;
 
-    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
-    std::mutex write_lock;
+    /// Commands are fenced by their position in the queue, fence N is signaled once the N-th
+    /// pushed command has been executed
+    using CommandQueue = Common::BoundedMPSCQueue<CommandDataContainer, 1024>;
     CommandQueue queue;
-    u64 last_fence{};
     std::atomic<u64> signaled_fence{};
+
+    /// Only taken by threads blocking on a fence and by the GPU thread to wake them up
+    std::mutex write_lock;
     std::condition_variable cv;
+
+    /// Queue positions at which command lists ended on the GPU thread itself. Their fences are
+    /// released once every command pushed before that position has executed. GPU thread only.
+    std::queue<u64> command_list_ends;
 };
 
 /// Class used to manage the GPU thread
@@ -2,9 +2,15 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include <optional>
 #include <boost/container_hash/hash.hpp>
+#include <fmt/format.h>
 #include "common/assert.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -15,10 +21,35 @@
 
 namespace Tegra {
 
+namespace {
+/// Bump this when the layout of the macro cache changes
+constexpr u32 MACRO_CACHE_VERSION = 1;
+
+/// Largest macro accepted from the cache, macro memory is only 0x800 words long
+constexpr u32 MAX_CACHED_MACRO_SIZE = 0x800;
+
+const char* GetBackendName(MacroBackend backend) {
+    switch (backend) {
+    case MacroBackend::Interpreter:
+        return "Interpreter";
+    case MacroBackend::JIT:
+        return "JIT";
+    case MacroBackend::HLE:
+        return "HLE";
+    }
+    return "Unknown";
+}
+} // Anonymous namespace
+
 MacroEngine::MacroEngine(Engines::Maxwell3D& maxwell3d)
-    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d)} {}
+    : hle_macros{std::make_unique<Tegra::HLEMacro>(maxwell3d)},
+      collect_statistics{Settings::values.dump_macro_statistics} {}
 
-MacroEngine::~MacroEngine() = default;
+MacroEngine::~MacroEngine() {
+    if (collect_statistics) {
+        LogStatistics();
+    }
+}
 
 void MacroEngine::AddCode(u32 method, u32 data) {
     uploaded_macro_code[method].push_back(data);
@@ -28,12 +59,17 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
                           const std::vector<u32>& parameters) {
     auto compiled_macro = macro_cache.find(method);
     if (compiled_macro != macro_cache.end()) {
-        const auto& cache_info = compiled_macro->second;
-        if (cache_info.has_hle_program) {
-            cache_info.hle_program->Execute(parameters, method);
-        } else {
-            cache_info.lle_program->Execute(parameters, method);
+        auto& cache_info = compiled_macro->second;
+        ++cache_info.calls;
+        CachedMacro& program =
+            cache_info.has_hle_program ? *cache_info.hle_program : *cache_info.lle_program;
+        if (!collect_statistics) {
+            program.Execute(parameters, method);
+            return;
         }
+        const auto start = std::chrono::steady_clock::now();
+        program.Execute(parameters, method);
+        cache_info.time += std::chrono::steady_clock::now() - start;
     } else {
         // Macro not compiled, check if it's uploaded and if so, compile it
         std::optional<u32> mid_method;
@@ -53,8 +89,8 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
         auto& cache_info = macro_cache[method];
 
         if (!mid_method.has_value()) {
-            cache_info.lle_program = Compile(macro_code->second);
             cache_info.hash = boost::hash_value(macro_code->second);
+            cache_info.lle_program = GetProgram(macro_code->second, cache_info.hash);
         } else {
             const auto& macro_cached = uploaded_macro_code[mid_method.value()];
             const auto rebased_method = method - mid_method.value();
@@ -63,9 +99,10 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
             std::memcpy(code.data(), macro_cached.data() + rebased_method,
                         code.size() * sizeof(u32));
             cache_info.hash = boost::hash_value(code);
-            cache_info.lle_program = Compile(code);
+            cache_info.lle_program = GetProgram(code, cache_info.hash);
         }
 
+        ++cache_info.calls;
         auto hle_program = hle_macros->GetHLEProgram(cache_info.hash);
         if (hle_program.has_value()) {
             cache_info.has_hle_program = true;
@@ -77,6 +114,128 @@ void MacroEngine::Execute(Engines::Maxwell3D& maxwell3d, u32 method,
     }
 }
 
+void MacroEngine::LoadDiskCache(u64 title_id) {
+    // Skip games without title id
+    if (!Settings::values.use_disk_shader_cache.GetValue() || title_id == 0) {
+        return;
+    }
+    const auto macro_dir = Common::FS::GetYuzuPath(Common::FS::YuzuPath::ShaderDir) / "macro";
+    if (!Common::FS::CreateDirs(macro_dir)) {
+        LOG_ERROR(HW_GPU, "Failed to create directory={}", Common::FS::PathToUTF8String(macro_dir));
+        return;
+    }
+    disk_cache_path = macro_dir / fmt::format("{:016X}.bin", title_id);
+
+    Common::FS::IOFile file{disk_cache_path, Common::FS::FileAccessMode::Read,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_INFO(HW_GPU, "No macro cache found");
+        return;
+    }
+    u32 version{};
+    if (!file.ReadObject(version) || version != MACRO_CACHE_VERSION) {
+        LOG_INFO(HW_GPU, "Macro cache is invalid or from another version, removing");
+        file.Close();
+        if (!Common::FS::RemoveFile(disk_cache_path)) {
+            LOG_ERROR(HW_GPU, "Failed to remove macro cache in path={}",
+                      Common::FS::PathToUTF8String(disk_cache_path));
+        }
+        return;
+    }
+
+    while (static_cast<u64>(file.Tell()) < file.GetSize()) {
+        u64 hash{};
+        u32 size{};
+        if (!file.ReadObject(hash) || !file.ReadObject(size) || size == 0 ||
+            size > MAX_CACHED_MACRO_SIZE) {
+            LOG_ERROR(HW_GPU, "Failed to read macro cache entry, skipping the rest");
+            break;
+        }
+        std::vector<u32> code(size);
+        if (file.Read(code) != code.size() || boost::hash_value(code) != hash) {
+            LOG_ERROR(HW_GPU, "Macro cache entry is corrupted, skipping the rest");
+            break;
+        }
+        if (precompiled_macros.contains(hash)) {
+            continue;
+        }
+        // The interpreter keeps a reference to the code, compile it from its final location
+        auto& precompiled = precompiled_macros[hash];
+        precompiled.code = std::move(code);
+        precompiled.program = Compile(precompiled.code);
+    }
+    LOG_INFO(HW_GPU, "Precompiled {} macros from the disk cache", precompiled_macros.size());
+}
+
+std::vector<MacroStatistics> MacroEngine::GetStatistics() const {
+    std::unordered_map<u64, MacroStatistics> statistics;
+    for (const auto& [method, cache_info] : macro_cache) {
+        MacroStatistics& entry = statistics[cache_info.hash];
+        entry.hash = cache_info.hash;
+        entry.backend = cache_info.has_hle_program ? MacroBackend::HLE : GetBackend();
+        entry.calls += cache_info.calls;
+        entry.time += cache_info.time;
+        entry.has_hle_program = cache_info.has_hle_program;
+    }
+    std::vector<MacroStatistics> result;
+    result.reserve(statistics.size());
+    for (const auto& [hash, entry] : statistics) {
+        result.push_back(entry);
+    }
+    std::ranges::sort(result, [](const MacroStatistics& lhs, const MacroStatistics& rhs) {
+        return lhs.calls > rhs.calls;
+    });
+    return result;
+}
+
+std::unique_ptr<CachedMacro> MacroEngine::GetProgram(const std::vector<u32>& code, u64 hash) {
+    const auto it = precompiled_macros.find(hash);
+    if (it != precompiled_macros.end() && it->second.program && it->second.code == code) {
+        // Keep the code around, interpreted programs reference it
+        return std::move(it->second.program);
+    }
+    if (it == precompiled_macros.end()) {
+        SaveToDiskCache(code, hash);
+    }
+    return Compile(code);
+}
+
+void MacroEngine::SaveToDiskCache(const std::vector<u32>& code, u64 hash) const {
+    if (disk_cache_path.empty()) {
+        return;
+    }
+    const bool existed = Common::FS::Exists(disk_cache_path);
+    Common::FS::IOFile file{disk_cache_path, Common::FS::FileAccessMode::Append,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open macro cache in path={}",
+                  Common::FS::PathToUTF8String(disk_cache_path));
+        return;
+    }
+    if (!existed || file.GetSize() == 0) {
+        if (!file.WriteObject(MACRO_CACHE_VERSION)) {
+            LOG_ERROR(HW_GPU, "Failed to write macro cache version in path={}",
+                      Common::FS::PathToUTF8String(disk_cache_path));
+            return;
+        }
+    }
+    const u32 size = static_cast<u32>(code.size());
+    if (!file.WriteObject(hash) || !file.WriteObject(size) || file.Write(code) != code.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write macro {:016X} to the cache", hash);
+    }
+}
+
+void MacroEngine::LogStatistics() const {
+    const std::vector<MacroStatistics> statistics = GetStatistics();
+    LOG_INFO(HW_GPU, "Statistics of {} macros:", statistics.size());
+    for (const MacroStatistics& entry : statistics) {
+        const double milliseconds =
+            std::chrono::duration<double, std::milli>(entry.time).count();
+        LOG_INFO(HW_GPU, "Macro {:016X}: {} calls, {:.3f} ms in {}", entry.hash, entry.calls,
+                 milliseconds, GetBackendName(entry.backend));
+    }
+}
+
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d) {
     if (Settings::values.disable_macro_jit) {
         return std::make_unique<MacroInterpreter>(maxwell3d);
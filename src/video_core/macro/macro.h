@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <filesystem>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -110,6 +112,21 @@ public:
     virtual void Execute(const std::vector<u32>& parameters, u32 method) = 0;
 };
 
+enum class MacroBackend {
+    Interpreter,
+    JIT,
+    HLE,
+};
+
+/// Execution counters of all the macros with the same code
+struct MacroStatistics {
+    u64 hash{};
+    MacroBackend backend{};
+    u64 calls{};
+    std::chrono::nanoseconds time{};
+    bool has_hle_program{};
+};
+
 class MacroEngine {
 public:
     explicit MacroEngine(Engines::Maxwell3D& maxwell3d);
@@ -121,20 +138,48 @@ public:
     // Compiles the macro if its not in the cache, and executes the compiled macro
     void Execute(Engines::Maxwell3D& maxwell3d, u32 method, const std::vector<u32>& parameters);
 
+    /// Precompiles the macros seen in previous runs of the title, new macros are added to its cache
+    void LoadDiskCache(u64 title_id);
+
+    /// Returns the execution counters of every compiled macro, most called first.
+    /// Time is only measured when macro statistics are enabled in the settings.
+    [[nodiscard]] std::vector<MacroStatistics> GetStatistics() const;
+
 protected:
     virtual std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) = 0;
 
+    /// Returns the backend used to execute macros without an HLE implementation
+    [[nodiscard]] virtual MacroBackend GetBackend() const = 0;
+
 private:
     struct CacheInfo {
         std::unique_ptr<CachedMacro> lle_program{};
         std::unique_ptr<CachedMacro> hle_program{};
         u64 hash{};
         bool has_hle_program{};
+        u64 calls{};
+        std::chrono::nanoseconds time{};
+    };
+
+    /// Macro compiled ahead of time from the disk cache, waiting for a method to use it
+    struct PrecompiledMacro {
+        std::vector<u32> code;
+        std::unique_ptr<CachedMacro> program;
     };
 
+    /// Returns the program for the given code, either precompiled or compiled on the spot
+    std::unique_ptr<CachedMacro> GetProgram(const std::vector<u32>& code, u64 hash);
+
+    void SaveToDiskCache(const std::vector<u32>& code, u64 hash) const;
+
+    void LogStatistics() const;
+
     std::unordered_map<u32, CacheInfo> macro_cache;
     std::unordered_map<u32, std::vector<u32>> uploaded_macro_code;
+    std::unordered_map<u64, PrecompiledMacro> precompiled_macros;
     std::unique_ptr<HLEMacro> hle_macros;
+    std::filesystem::path disk_cache_path;
+    bool collect_statistics{};
 };
 
 std::unique_ptr<MacroEngine> GetMacroEngine(Engines::Maxwell3D& maxwell3d);
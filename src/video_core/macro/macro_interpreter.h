@@ -22,6 +22,10 @@ public:
 protected:
     std::unique_ptr<CachedMacro> Compile(const std::vector<u32>& code) override;
 
+    MacroBackend GetBackend() const override {
+        return MacroBackend::Interpreter;
+    }
+
 private:
     Engines::Maxwell3D& maxwell3d;
 };
@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <iterator>
+
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -17,7 +20,7 @@
 namespace Tegra {
 
 MemoryManager::MemoryManager(Core::System& system_)
-    : system{system_}, page_table(page_table_size) {}
+    : system{system_}, free_ranges{{0, address_space_size}} {}
 
 MemoryManager::~MemoryManager() = default;
 
@@ -26,6 +29,14 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface* rasterizer_)
 }
 
 GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
+    const GPUVAddr range_begin{Common::AlignDown(gpu_addr, page_size)};
+    const GPUVAddr range_end{range_begin + Common::AlignUp(size, page_size)};
+    if (page_entry.IsUnmapped()) {
+        AddFreeRange(range_begin, range_end);
+    } else {
+        RemoveFreeRange(range_begin, range_end);
+    }
+
     u64 remaining_size{size};
     for (u64 offset{}; offset < size; offset += page_size) {
         if (remaining_size < page_size) {
@@ -39,12 +50,7 @@ GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std
 }
 
 GPUVAddr MemoryManager::Map(VAddr cpu_addr, GPUVAddr gpu_addr, std::size_t size) {
-    const auto it = std::ranges::lower_bound(map_ranges, gpu_addr, {}, &MapRange::first);
-    if (it != map_ranges.end() && it->first == gpu_addr) {
-        it->second = size;
-    } else {
-        map_ranges.insert(it, MapRange{gpu_addr, size});
-    }
+    map_ranges.insert_or_assign(gpu_addr, size);
     return UpdateRange(gpu_addr, cpu_addr, size);
 }
 
@@ -62,7 +68,7 @@ void MemoryManager::Unmap(GPUVAddr gpu_addr, std::size_t size) {
     if (size == 0) {
         return;
     }
-    const auto it = std::ranges::lower_bound(map_ranges, gpu_addr, {}, &MapRange::first);
+    const auto it = map_ranges.lower_bound(gpu_addr);
     if (it != map_ranges.end()) {
         ASSERT(it->first == gpu_addr);
         map_ranges.erase(it);
@@ -77,17 +83,18 @@ void MemoryManager::Unmap(GPUVAddr gpu_addr, std::size_t size) {
         const std::optional<VAddr> cpu_addr = GpuToCpuAddress(map.first);
         ASSERT(cpu_addr);
 
-        rasterizer->UnmapMemory(*cpu_addr, map.second);
+        if (rasterizer) {
+            rasterizer->UnmapMemory(*cpu_addr, map.second);
+        }
     }
 
     UpdateRange(gpu_addr, PageEntry::State::Unmapped, size);
 }
 
 std::optional<GPUVAddr> MemoryManager::AllocateFixed(GPUVAddr gpu_addr, std::size_t size) {
-    for (u64 offset{}; offset < size; offset += page_size) {
-        if (!GetPageEntry(gpu_addr + offset).IsUnmapped()) {
-            return std::nullopt;
-        }
+    const GPUVAddr range_begin{Common::AlignDown(gpu_addr, page_size)};
+    if (!IsFreeRange(range_begin, range_begin + Common::AlignUp(size, page_size))) {
+        return std::nullopt;
     }
 
     return UpdateRange(gpu_addr, PageEntry::State::Allocated, size);
@@ -120,7 +127,7 @@ void MemoryManager::TryUnlockPage(PageEntry page_entry, std::size_t size) {
 }
 
 PageEntry MemoryManager::GetPageEntry(GPUVAddr gpu_addr) const {
-    return page_table[PageEntryIndex(gpu_addr)];
+    return page_table.Get(PageEntryIndex(gpu_addr));
 }
 
 void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
@@ -132,14 +139,15 @@ void MemoryManager::SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::s
 
     //// Lock the new page
     // TryLockPage(page_entry, size);
-    auto& current_page = page_table[PageEntryIndex(gpu_addr)];
+    const std::size_t index{PageEntryIndex(gpu_addr)};
+    const PageEntry current_page{page_table.Get(index)};
 
-    if ((!current_page.IsValid() && page_entry.IsValid()) ||
-        current_page.ToAddress() != page_entry.ToAddress()) {
+    if (rasterizer && ((!current_page.IsValid() && page_entry.IsValid()) ||
+                       current_page.ToAddress() != page_entry.ToAddress())) {
         rasterizer->ModifyGPUMemory(gpu_addr, size);
     }
 
-    current_page = page_entry;
+    page_table.Set(index, page_entry);
 }
 
 std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size_t align,
@@ -150,27 +158,84 @@ std::optional<GPUVAddr> MemoryManager::FindFreeRange(std::size_t size, std::size
         align = Common::AlignUp(align, page_size);
     }
 
-    u64 available_size{};
-    GPUVAddr gpu_addr{start_32bit_address ? address_space_start_low : address_space_start};
-    while (gpu_addr + available_size < address_space_size) {
-        if (GetPageEntry(gpu_addr + available_size).IsUnmapped()) {
-            available_size += page_size;
+    // Searching from the lowest free range returns the same address a scan of the page table would
+    const u64 aligned_size{std::max(Common::AlignUp(size, page_size), page_size)};
+    const GPUVAddr start{start_32bit_address ? address_space_start_low : address_space_start};
+    auto it = free_ranges.upper_bound(start);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    for (; it != free_ranges.end(); ++it) {
+        const auto [range_begin, range_end] = *it;
+        if (range_end <= start) {
+            continue;
+        }
+        const GPUVAddr gpu_addr{range_begin <= start ? start
+                                                     : Common::AlignUp(range_begin, align)};
+        if (gpu_addr + aligned_size <= range_end) {
+            return gpu_addr;
+        }
+    }
 
-            if (available_size >= size) {
-                return gpu_addr;
-            }
-        } else {
-            gpu_addr += available_size + page_size;
-            available_size = 0;
+    return std::nullopt;
+}
 
-            const auto remainder{gpu_addr % align};
-            if (remainder) {
-                gpu_addr = (gpu_addr - remainder) + align;
-            }
+void MemoryManager::AddFreeRange(GPUVAddr begin, GPUVAddr end) {
+    if (begin >= end) {
+        return;
+    }
+    auto next = free_ranges.lower_bound(begin);
+    if (next != free_ranges.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->second >= begin) {
+            begin = prev->first;
+            end = std::max(end, prev->second);
+            free_ranges.erase(prev);
         }
     }
+    while (next != free_ranges.end() && next->first <= end) {
+        end = std::max(end, next->second);
+        next = free_ranges.erase(next);
+    }
+    free_ranges.emplace_hint(next, begin, end);
+}
 
-    return std::nullopt;
+void MemoryManager::RemoveFreeRange(GPUVAddr begin, GPUVAddr end) {
+    auto it = free_ranges.upper_bound(begin);
+    if (it != free_ranges.begin()) {
+        --it;
+    }
+    while (it != free_ranges.end() && it->first < end) {
+        const auto [range_begin, range_end] = *it;
+        if (range_end <= begin) {
+            ++it;
+            continue;
+        }
+        it = free_ranges.erase(it);
+        if (range_begin < begin) {
+            free_ranges.emplace_hint(it, range_begin, begin);
+        }
+        if (range_end > end) {
+            free_ranges.emplace_hint(it, end, range_end);
+            break;
+        }
+    }
+}
+
+bool MemoryManager::IsFreeRange(GPUVAddr begin, GPUVAddr end) const {
+    if (begin >= end) {
+        return true;
+    }
+    auto it = free_ranges.upper_bound(begin);
+    if (it == free_ranges.begin()) {
+        return false;
+    }
+    --it;
+    return it->second >= end;
+}
+
+std::size_t MemoryManager::PageTableMemoryUsage() const {
+    return page_table.MemoryUsage();
 }
 
 std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr gpu_addr) const {
@@ -259,7 +324,7 @@ const u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) const {
 }
 
 size_t MemoryManager::BytesToMapEnd(GPUVAddr gpu_addr) const noexcept {
-    auto it = std::ranges::upper_bound(map_ranges, gpu_addr, {}, &MapRange::first);
+    auto it = map_ranges.upper_bound(gpu_addr);
     --it;
     return it->second - (gpu_addr - it->first);
 }
@@ -414,11 +479,45 @@ bool MemoryManager::IsContinousRange(GPUVAddr gpu_addr, std::size_t size) const
     return true;
 }
 
+const u8* MemoryManager::GetContinuousPointer(GPUVAddr gpu_addr, std::size_t size) const {
+    if (!IsContinousRange(gpu_addr, size)) {
+        return nullptr;
+    }
+    const VAddr cpu_addr{*GpuToCpuAddress(gpu_addr)};
+    const auto& memory{system.Memory()};
+    const u8* const pointer{memory.GetPointer(cpu_addr)};
+    if (!pointer) {
+        return nullptr;
+    }
+    // Continous cpu pages can still be backed by scattered host memory
+    const VAddr cpu_end{cpu_addr + size};
+    VAddr cpu_page{Common::AlignDown(cpu_addr, Core::Memory::PAGE_SIZE) + Core::Memory::PAGE_SIZE};
+    for (; cpu_page < cpu_end; cpu_page += Core::Memory::PAGE_SIZE) {
+        if (memory.GetPointer(cpu_page) != pointer + (cpu_page - cpu_addr)) {
+            return nullptr;
+        }
+    }
+    return pointer;
+}
+
+u8* MemoryManager::GetContinuousWritePointer(GPUVAddr gpu_addr, std::size_t size) {
+    // Guest memory is writable, the const lookup only checks how the region is mapped
+    u8* const pointer{const_cast<u8*>(GetContinuousPointer(gpu_addr, size))};
+    if (!pointer) {
+        return nullptr;
+    }
+    if (rasterizer) {
+        rasterizer->InvalidateRegion(*GpuToCpuAddress(gpu_addr), size);
+    }
+    return pointer;
+}
+
 bool MemoryManager::IsFullyMappedRange(GPUVAddr gpu_addr, std::size_t size) const {
     size_t page_index{gpu_addr >> page_bits};
     const size_t page_last{(gpu_addr + size + page_size - 1) >> page_bits};
     while (page_index < page_last) {
-        if (!page_table[page_index].IsValid() || page_table[page_index].ToAddress() == 0) {
+        const PageEntry page_entry{page_table.Get(page_index)};
+        if (!page_entry.IsValid() || page_entry.ToAddress() == 0) {
             return false;
         }
         ++page_index;
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/multi_level_page_table.h"
 
 namespace VideoCore {
 class RasterizerInterface;
@@ -51,6 +52,8 @@ public:
         return static_cast<VAddr>(state) << ShiftBits;
     }
 
+    [[nodiscard]] constexpr bool operator==(const PageEntry&) const = default;
+
     [[nodiscard]] constexpr PageEntry operator+(u64 offset) const {
         // If this is a reserved value, offsets do not apply
         if (!IsValid()) {
@@ -123,6 +126,19 @@ public:
      */
     [[nodiscard]] bool IsContinousRange(GPUVAddr gpu_addr, std::size_t size) const;
 
+    /**
+     * Returns a host pointer to a gpu region that can be read in place, or nullptr when the region
+     * is not continous in both cpu and host memory.
+     */
+    [[nodiscard]] const u8* GetContinuousPointer(GPUVAddr gpu_addr, std::size_t size) const;
+
+    /**
+     * Returns a host pointer to a gpu region that can be written in place, or nullptr when the
+     * region is not continous in both cpu and host memory. The region is invalidated like
+     * WriteBlock does, it must be written before the rasterizer reads it again.
+     */
+    [[nodiscard]] u8* GetContinuousWritePointer(GPUVAddr gpu_addr, std::size_t size);
+
     /**
      * Checks if a gpu region is mapped entirely.
      */
@@ -143,6 +159,9 @@ public:
     [[nodiscard]] GPUVAddr Allocate(std::size_t size, std::size_t align);
     void Unmap(GPUVAddr gpu_addr, std::size_t size);
 
+    /// Returns the number of bytes used by the page table
+    [[nodiscard]] std::size_t PageTableMemoryUsage() const;
+
 private:
     [[nodiscard]] PageEntry GetPageEntry(GPUVAddr gpu_addr) const;
     void SetPageEntry(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size = page_size);
@@ -150,6 +169,15 @@ private:
     [[nodiscard]] std::optional<GPUVAddr> FindFreeRange(std::size_t size, std::size_t align,
                                                         bool start_32bit_address = false) const;
 
+    /// Marks [begin, end) as free, merging it with the free ranges around it
+    void AddFreeRange(GPUVAddr begin, GPUVAddr end);
+
+    /// Removes [begin, end) from the free ranges, splitting the ones that partially overlap it
+    void RemoveFreeRange(GPUVAddr begin, GPUVAddr end);
+
+    /// Returns true when all the pages in [begin, end) are unmapped
+    [[nodiscard]] bool IsFreeRange(GPUVAddr begin, GPUVAddr end) const;
+
     void TryLockPage(PageEntry page_entry, std::size_t size);
     void TryUnlockPage(PageEntry page_entry, std::size_t size);
 
@@ -168,15 +196,19 @@ private:
     static constexpr u64 page_table_bits{24};
     static constexpr u64 page_table_size{1 << page_table_bits};
     static constexpr u64 page_table_mask{page_table_size - 1};
+    static constexpr u64 page_table_leaf_bits{10};
 
     Core::System& system;
 
     VideoCore::RasterizerInterface* rasterizer = nullptr;
 
-    std::vector<PageEntry> page_table;
+    Common::MultiLevelPageTable<PageEntry, page_table_bits, page_table_leaf_bits> page_table;
+
+    /// Size of each mapping, indexed by its base address
+    std::map<GPUVAddr, std::size_t> map_ranges;
 
-    using MapRange = std::pair<GPUVAddr, size_t>;
-    std::vector<MapRange> map_ranges;
+    /// Ranges of unmapped pages, the end of each range indexed by its start
+    std::map<GPUVAddr, GPUVAddr> free_ranges;
 
     std::vector<std::pair<VAddr, std::size_t>> cache_invalidate_queue;
 };
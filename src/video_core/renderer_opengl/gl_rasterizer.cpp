@@ -353,6 +353,7 @@ void RasterizerOpenGL::SetupShaders(bool is_indexed) {
 
 void RasterizerOpenGL::LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                                          const VideoCore::DiskResourceLoadCallback& callback) {
+    maxwell3d.LoadDiskResources(title_id);
     shader_cache.LoadDiskCache(title_id, stop_loading, callback);
 }
 
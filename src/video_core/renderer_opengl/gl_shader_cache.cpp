@@ -122,25 +122,6 @@ std::string MakeShaderID(u64 unique_identifier, ShaderType shader_type) {
     return fmt::format("{}{:016X}", GetShaderTypeName(shader_type), unique_identifier);
 }
 
-std::shared_ptr<Registry> MakeRegistry(const ShaderDiskCacheEntry& entry) {
-    const VideoCore::GuestDriverProfile guest_profile{entry.texture_handler_size};
-    const VideoCommon::Shader::SerializedRegistryInfo info{guest_profile, entry.bound_buffer,
-                                                           entry.graphics_info, entry.compute_info};
-    auto registry = std::make_shared<Registry>(entry.type, info);
-    for (const auto& [address, value] : entry.keys) {
-        const auto [buffer, offset] = address;
-        registry->InsertKey(buffer, offset, value);
-    }
-    for (const auto& [offset, sampler] : entry.bound_samplers) {
-        registry->InsertBoundSampler(offset, sampler);
-    }
-    for (const auto& [key, sampler] : entry.bindless_samplers) {
-        const auto [buffer, offset] = key;
-        registry->InsertBindlessSampler(buffer, offset, sampler);
-    }
-    return registry;
-}
-
 std::unordered_set<GLenum> GetSupportedFormats() {
     GLint num_formats;
     glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
@@ -277,9 +258,11 @@ std::unique_ptr<Shader> Shader::CreateStageFromMemory(
         const ShaderIR ir(code, STAGE_MAIN_OFFSET, COMPILER_SETTINGS, *registry);
         auto entries = MakeEntries(params.device, ir, shader_type);
 
+        // The stage is left unbound until it is built, so the draw is waiting for it
         async_shaders.QueueOpenGLShader(params.device, shader_type, params.unique_identifier,
                                         std::move(code), std::move(code_b), STAGE_MAIN_OFFSET,
-                                        COMPILER_SETTINGS, *registry, cpu_addr);
+                                        COMPILER_SETTINGS, *registry, cpu_addr,
+                                        VideoCommon::Shader::AsyncShaders::Priority::Draw);
 
         auto program = std::make_shared<ProgramHandle>();
         return std::unique_ptr<Shader>(
@@ -382,7 +365,7 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, std::stop_token stop_loading
 
             const bool is_compute = entry.type == ShaderType::Compute;
             const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
-            auto registry = MakeRegistry(entry);
+            auto registry = entry.MakeRegistry();
             const ShaderIR ir(entry.code, main_offset, COMPILER_SETTINGS, *registry);
 
             ProgramSharedPtr program;
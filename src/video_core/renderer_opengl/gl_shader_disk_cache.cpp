@@ -27,6 +27,7 @@ using Tegra::Engines::ShaderType;
 using VideoCommon::Shader::BindlessSamplerMap;
 using VideoCommon::Shader::BoundSamplerMap;
 using VideoCommon::Shader::KeyMap;
+using VideoCommon::Shader::Registry;
 using VideoCommon::Shader::SeparateSamplerKey;
 using ShaderCacheVersionHash = std::array<u8, 64>;
 
@@ -195,6 +196,25 @@ bool ShaderDiskCacheEntry::Save(Common::FS::IOFile& file) const {
            file.Write(flat_bindless_samplers) == flat_bindless_samplers.size();
 }
 
+std::shared_ptr<Registry> ShaderDiskCacheEntry::MakeRegistry() const {
+    const VideoCore::GuestDriverProfile guest_profile{texture_handler_size};
+    const VideoCommon::Shader::SerializedRegistryInfo info{guest_profile, bound_buffer,
+                                                           graphics_info, compute_info};
+    auto registry = std::make_shared<Registry>(type, info);
+    for (const auto& [address, value] : keys) {
+        const auto [buffer, offset] = address;
+        registry->InsertKey(buffer, offset, value);
+    }
+    for (const auto& [offset, sampler] : bound_samplers) {
+        registry->InsertBoundSampler(offset, sampler);
+    }
+    for (const auto& [key, sampler] : bindless_samplers) {
+        const auto [buffer, offset] = key;
+        registry->InsertBindlessSampler(buffer, offset, sampler);
+    }
+    return registry;
+}
+
 ShaderDiskCacheOpenGL::ShaderDiskCacheOpenGL() = default;
 
 ShaderDiskCacheOpenGL::~ShaderDiskCacheOpenGL() = default;
@@ -238,6 +258,21 @@ std::optional<std::vector<ShaderDiskCacheEntry>> ShaderDiskCacheOpenGL::LoadTran
     }
 
     // Version is valid, load the shaders
+    auto entries = LoadTransferableEntries(file);
+    if (!entries) {
+        return std::nullopt;
+    }
+
+    is_usable = true;
+    return entries;
+}
+
+u32 ShaderDiskCacheOpenGL::GetTransferableVersion() {
+    return NativeVersion;
+}
+
+std::optional<std::vector<ShaderDiskCacheEntry>> ShaderDiskCacheOpenGL::LoadTransferableEntries(
+    Common::FS::IOFile& file) {
     std::vector<ShaderDiskCacheEntry> entries;
     while (static_cast<u64>(file.Tell()) < file.GetSize()) {
         ShaderDiskCacheEntry& entry = entries.emplace_back();
@@ -246,8 +281,6 @@ std::optional<std::vector<ShaderDiskCacheEntry>> ShaderDiskCacheOpenGL::LoadTran
             return std::nullopt;
         }
     }
-
-    is_usable = true;
     return {std::move(entries)};
 }
 
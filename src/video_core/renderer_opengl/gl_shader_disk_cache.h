@@ -5,6 +5,7 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -39,6 +40,9 @@ struct ShaderDiskCacheEntry {
 
     bool Save(Common::FS::IOFile& file) const;
 
+    /// Creates a registry holding the keys and samplers stored in the entry
+    std::shared_ptr<VideoCommon::Shader::Registry> MakeRegistry() const;
+
     bool HasProgramA() const {
         return !code.empty() && !code_b.empty();
     }
@@ -76,6 +80,13 @@ public:
     /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
     std::optional<std::vector<ShaderDiskCacheEntry>> LoadTransferable();
 
+    /// Returns the version of the transferable cache format written by this build
+    static u32 GetTransferableVersion();
+
+    /// Loads the entries following the version header of a transferable cache file
+    static std::optional<std::vector<ShaderDiskCacheEntry>> LoadTransferableEntries(
+        Common::FS::IOFile& file);
+
     /// Loads current game's precompiled cache. Invalidates on failure.
     std::vector<ShaderDiskCachePrecompiled> LoadPrecompiled();
 
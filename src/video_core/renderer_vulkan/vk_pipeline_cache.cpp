@@ -216,9 +216,11 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
             gpu.ShaderNotify().MarkSharderBuilding();
             LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
             const auto [program, bindings] = DecompileShaders(key.fixed_state);
+            // Draws are skipped until their pipeline is built
             async_shaders.QueueVulkanShader(this, device, scheduler, descriptor_pool,
                                             update_descriptor_queue, bindings, program, key,
-                                            num_color_buffers);
+                                            num_color_buffers,
+                                            VideoCommon::Shader::AsyncShaders::Priority::Draw);
         }
         last_graphics_pipeline = pair->second.get();
         return last_graphics_pipeline;
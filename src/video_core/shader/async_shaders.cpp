@@ -2,10 +2,15 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <bit>
 #include <condition_variable>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
+#include "common/assert.h"
+#include "common/logging/log.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
@@ -17,6 +22,7 @@ AsyncShaders::AsyncShaders(Core::Frontend::EmuWindow& emu_window_) : emu_window(
 
 AsyncShaders::~AsyncShaders() {
     KillWorkers();
+    FreeCompletedWork();
 }
 
 void AsyncShaders::AllocateWorkers() {
@@ -35,56 +41,85 @@ void AsyncShaders::AllocateWorkers() {
         return;
     }
 
-    // If workers already exist, clear them
+    // If workers already exist, clear them, they are joined before their queues are replaced
     if (!worker_threads.empty()) {
         FreeWorkers();
     }
 
-    // Create workers
+    // Create workers, queues have to exist before any thread can steal from them
+    is_thread_exiting.store(false);
+    is_draining.store(false);
+    for (std::size_t i = 0; i < num_workers; i++) {
+        worker_queues.push_back(std::make_unique<WorkerQueue>());
+    }
     for (std::size_t i = 0; i < num_workers; i++) {
         context_list.push_back(emu_window.CreateSharedContext());
         worker_threads.emplace_back(&AsyncShaders::ShaderCompilerThread, this,
-                                    context_list[i].get());
+                                    context_list[i].get(), i);
     }
 }
 
 void AsyncShaders::FreeWorkers() {
-    // Mark all threads to quit
-    is_thread_exiting.store(true);
-    cv.notify_all();
-    for (auto& thread : worker_threads) {
-        thread.join();
+    // Mark all threads to quit once the queued shaders are built, draws are waiting for them
+    {
+        std::scoped_lock lock{sleep_mutex};
+        is_draining.store(true);
     }
-    // Clear our shared contexts
-    context_list.clear();
+    cv.notify_all();
+    JoinWorkers();
 
-    // Clear our worker threads
-    worker_threads.clear();
+    const Statistics stats = GetStatistics();
+    for (std::size_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        std::string buckets;
+        for (const u64 count : stats.latency_histogram[priority]) {
+            buckets += fmt::format(" {}", count);
+        }
+        LOG_DEBUG(Render, "Shader latency histogram of priority {}:{}", priority, buckets);
+    }
 }
 
 void AsyncShaders::KillWorkers() {
-    is_thread_exiting.store(true);
+    // Mark all threads to quit as soon as they finish the shader they are building
+    {
+        std::scoped_lock lock{sleep_mutex};
+        is_thread_exiting.store(true);
+    }
     cv.notify_all();
+    JoinWorkers();
+}
+
+void AsyncShaders::JoinWorkers() {
+    // Workers index the queues of each other, nothing is released until all of them have exited
     for (auto& thread : worker_threads) {
-        thread.detach();
+        thread.join();
     }
     // Clear our shared contexts
     context_list.clear();
 
-    // Clear our worker threads
+    // Clear our worker threads, along with any work they did not get to
     worker_threads.clear();
+    worker_queues.clear();
+    for (auto& depth : queue_depth) {
+        depth.store(0, std::memory_order_relaxed);
+    }
 }
 
 bool AsyncShaders::HasWorkQueued() const {
-    return !pending_queue.empty();
+    return std::ranges::any_of(queue_depth, [](const std::atomic<u64>& depth) {
+        return depth.load(std::memory_order_relaxed) != 0;
+    });
 }
 
 bool AsyncShaders::HasCompletedWork() const {
-    std::shared_lock lock{completed_mutex};
-    return !finished_work.empty();
+    return completed_head.load(std::memory_order_relaxed) != nullptr;
 }
 
 bool AsyncShaders::IsShaderAsync(const Tegra::GPU& gpu) const {
+    // Nothing would ever build the shader
+    if (worker_threads.empty()) {
+        return false;
+    }
+
     const auto& regs = gpu.Maxwell3D().regs;
 
     // If something is using depth, we can assume that games are not rendering anything which will
@@ -104,23 +139,50 @@ bool AsyncShaders::IsShaderAsync(const Tegra::GPU& gpu) const {
 }
 
 std::vector<AsyncShaders::Result> AsyncShaders::GetCompletedWork() {
+    // Take the whole stack at once, the nodes are owned by this thread from now on
+    CompletedNode* node = completed_head.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack holds the most recently completed shader first, reverse it
+    CompletedNode* reversed = nullptr;
+    std::size_t count = 0;
+    while (node != nullptr) {
+        CompletedNode* const next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+        ++count;
+    }
     std::vector<Result> results;
-    {
-        std::unique_lock lock{completed_mutex};
-        results = std::move(finished_work);
-        finished_work.clear();
+    results.reserve(count);
+    while (reversed != nullptr) {
+        const std::unique_ptr<CompletedNode> owned{reversed};
+        reversed = reversed->next;
+        results.push_back(std::move(owned->result));
     }
     return results;
 }
 
+AsyncShaders::Statistics AsyncShaders::GetStatistics() const {
+    Statistics stats{};
+    for (std::size_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        stats.queue_depth[priority] = queue_depth[priority].load(std::memory_order_relaxed);
+        for (std::size_t bucket = 0; bucket < NUM_LATENCY_BUCKETS; ++bucket) {
+            stats.latency_histogram[priority][bucket] =
+                latency_histogram[priority][bucket].load(std::memory_order_relaxed);
+        }
+    }
+    return stats;
+}
+
 void AsyncShaders::QueueOpenGLShader(const OpenGL::Device& device,
                                      Tegra::Engines::ShaderType shader_type, u64 uid,
                                      std::vector<u64> code, std::vector<u64> code_b,
                                      u32 main_offset, CompilerSettings compiler_settings,
-                                     const Registry& registry, VAddr cpu_addr) {
-    std::unique_lock lock(queue_mutex);
-    pending_queue.push({
+                                     const Registry& registry, VAddr cpu_addr, Priority priority) {
+    PushWork({
         .backend = device.UseAssemblyShaders() ? Backend::GLASM : Backend::OpenGL,
+        .priority = priority,
+        .queue_time = std::chrono::steady_clock::now(),
         .device = &device,
         .shader_type = shader_type,
         .uid = uid,
@@ -140,7 +202,6 @@ void AsyncShaders::QueueOpenGLShader(const OpenGL::Device& device,
         .key{},
         .num_color_buffers = 0,
     });
-    cv.notify_one();
 }
 
 void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
@@ -149,10 +210,12 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
                                      Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                                      std::vector<VkDescriptorSetLayoutBinding> bindings,
                                      Vulkan::SPIRVProgram program,
-                                     Vulkan::GraphicsPipelineCacheKey key, u32 num_color_buffers) {
-    std::unique_lock lock(queue_mutex);
-    pending_queue.push({
+                                     Vulkan::GraphicsPipelineCacheKey key, u32 num_color_buffers,
+                                     Priority priority) {
+    PushWork({
         .backend = Backend::Vulkan,
+        .priority = priority,
+        .queue_time = std::chrono::steady_clock::now(),
         .device = nullptr,
         .shader_type{},
         .uid = 0,
@@ -172,30 +235,102 @@ void AsyncShaders::QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache,
         .key = key,
         .num_color_buffers = num_color_buffers,
     });
-    cv.notify_one();
 }
 
-void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context) {
-    while (!is_thread_exiting.load(std::memory_order_relaxed)) {
-        std::unique_lock lock{queue_mutex};
-        cv.wait(lock, [this] { return HasWorkQueued() || is_thread_exiting; });
-        if (is_thread_exiting) {
-            return;
-        }
+void AsyncShaders::PushWork(WorkerParams&& work) {
+    if (worker_queues.empty()) {
+        UNREACHABLE_MSG("Shader queued without async shader workers");
+        return;
+    }
 
-        // Partial lock to allow all threads to read at the same time
-        if (!HasWorkQueued()) {
+    // Spread the work across workers, idle workers steal whatever is left behind
+    const auto priority = static_cast<std::size_t>(work.priority);
+    const std::size_t worker =
+        next_worker.fetch_add(1, std::memory_order_relaxed) % worker_queues.size();
+    WorkerQueue& queue = *worker_queues[worker];
+    {
+        // Only count the work once it can be taken, workers never look for work that isn't there
+        std::scoped_lock lock{queue.mutex};
+        queue.queues[priority].push_back(std::move(work));
+        queue_depth[priority].fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        // Synchronize with workers that are about to sleep, they will see the new depth
+        std::scoped_lock lock{sleep_mutex};
+    }
+    cv.notify_one();
+}
+
+std::optional<AsyncShaders::WorkerParams> AsyncShaders::PopWork(std::size_t worker_index) {
+    // The own queue is taken from the front in queue order, stolen work is taken from the back to
+    // stay away from the owner
+    const std::size_t num_workers = worker_queues.size();
+    for (std::size_t priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        if (queue_depth[priority].load(std::memory_order_relaxed) == 0) {
             continue;
         }
-        // Another thread beat us, just unlock and wait for the next load
-        if (pending_queue.empty()) {
-            continue;
+        for (std::size_t offset = 0; offset < num_workers; ++offset) {
+            const bool is_own = offset == 0;
+            WorkerQueue& queue = *worker_queues[(worker_index + offset) % num_workers];
+            std::scoped_lock lock{queue.mutex};
+            auto& deque = queue.queues[priority];
+            if (deque.empty()) {
+                continue;
+            }
+            WorkerParams work = std::move(is_own ? deque.front() : deque.back());
+            if (is_own) {
+                deque.pop_front();
+            } else {
+                deque.pop_back();
+            }
+            queue_depth[priority].fetch_sub(1, std::memory_order_relaxed);
+            return work;
         }
+    }
+    return std::nullopt;
+}
+
+void AsyncShaders::PushCompletedWork(Result&& result) {
+    auto* const node = new CompletedNode{
+        .result = std::move(result),
+        .next = completed_head.load(std::memory_order_relaxed),
+    };
+    while (!completed_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+    }
+}
 
-        // Pull work from queue
-        WorkerParams work = std::move(pending_queue.front());
-        pending_queue.pop();
-        lock.unlock();
+void AsyncShaders::RecordLatency(const WorkerParams& work) {
+    const auto latency = std::chrono::steady_clock::now() - work.queue_time;
+    const auto milliseconds = static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(latency).count());
+    const std::size_t bucket =
+        std::min<std::size_t>(std::bit_width(milliseconds), NUM_LATENCY_BUCKETS - 1);
+    const auto priority = static_cast<std::size_t>(work.priority);
+    latency_histogram[priority][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncShaders::FreeCompletedWork() {
+    CompletedNode* node = completed_head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+        const std::unique_ptr<CompletedNode> owned{node};
+        node = node->next;
+    }
+}
+
+void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context,
+                                        std::size_t worker_index) {
+    while (!is_thread_exiting.load(std::memory_order_relaxed)) {
+        std::optional<WorkerParams> next_work = PopWork(worker_index);
+        if (!next_work) {
+            std::unique_lock lock{sleep_mutex};
+            if (is_draining && !HasWorkQueued()) {
+                return;
+            }
+            cv.wait(lock, [this] { return HasWorkQueued() || is_thread_exiting || is_draining; });
+            continue;
+        }
+        WorkerParams& work = *next_work;
 
         if (work.backend == Backend::OpenGL || work.backend == Backend::GLASM) {
             const ShaderIR ir(work.code, work.main_offset, work.compiler_settings, *work.registry);
@@ -216,10 +351,8 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
                 result.program.glasm = std::move(program->assembly_program);
             }
 
-            {
-                std::unique_lock complete_lock(completed_mutex);
-                finished_work.push_back(std::move(result));
-            }
+            RecordLatency(work);
+            PushCompletedWork(std::move(result));
         } else if (work.backend == Backend::Vulkan) {
             auto pipeline = std::make_unique<Vulkan::VKGraphicsPipeline>(
                 *work.vk_device, *work.scheduler, *work.descriptor_pool,
@@ -227,6 +360,7 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
                 work.num_color_buffers);
 
             work.pp_cache->EmplacePipeline(std::move(pipeline));
+            RecordLatency(work);
         }
     }
 }
@@ -4,10 +4,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <vector>
 
 #include <glad/glad.h>
 
@@ -42,6 +48,24 @@ public:
         Vulkan,
     };
 
+    /// Work of a higher priority is always built before any work of a lower priority
+    enum class Priority : u32 {
+        Draw,        ///< A draw is skipped until this shader is built
+        Speculative, ///< Built ahead of time, no draw is waiting for it yet
+    };
+    static constexpr std::size_t NUM_PRIORITIES = 2;
+
+    /// Bucket N of the latency histogram counts shaders built in less than 2^N milliseconds, the
+    /// last bucket counts everything slower
+    static constexpr std::size_t NUM_LATENCY_BUCKETS = 12;
+
+    struct Statistics {
+        /// Number of shaders waiting for a worker
+        std::array<u64, NUM_PRIORITIES> queue_depth;
+        /// Time from queueing a shader until it has been built
+        std::array<std::array<u64, NUM_LATENCY_BUCKETS>, NUM_PRIORITIES> latency_histogram;
+    };
+
     struct ResultPrograms {
         OpenGL::OGLProgram opengl;
         OpenGL::OGLAssemblyProgram glasm;
@@ -63,10 +87,10 @@ public:
     /// Start up shader worker threads
     void AllocateWorkers();
 
-    /// Clear the shader queue and kill all worker threads
+    /// Build the queued shaders and stop all worker threads
     void FreeWorkers();
 
-    // Force end all threads
+    /// Drop the queued shaders and stop all worker threads
     void KillWorkers();
 
     /// Check to see if any shaders have actually been compiled
@@ -74,16 +98,19 @@ public:
 
     /// Deduce if a shader can be build on another thread of MUST be built in sync. We cannot build
     /// every shader async as some shaders are only built and executed once. We try to "guess" which
-    /// shader would be used only once
+    /// shader would be used only once. Shaders are always built in sync when there are no workers.
     [[nodiscard]] bool IsShaderAsync(const Tegra::GPU& gpu) const;
 
-    /// Pulls completed compiled shaders
+    /// Pulls completed compiled shaders, in the order they were completed
     [[nodiscard]] std::vector<Result> GetCompletedWork();
 
+    /// Returns the queue depth and compile latency counters of the workers
+    [[nodiscard]] Statistics GetStatistics() const;
+
     void QueueOpenGLShader(const OpenGL::Device& device, Tegra::Engines::ShaderType shader_type,
                            u64 uid, std::vector<u64> code, std::vector<u64> code_b, u32 main_offset,
                            CompilerSettings compiler_settings, const Registry& registry,
-                           VAddr cpu_addr);
+                           VAddr cpu_addr, Priority priority);
 
     void QueueVulkanShader(Vulkan::VKPipelineCache* pp_cache, const Vulkan::Device& device,
                            Vulkan::VKScheduler& scheduler,
@@ -91,16 +118,13 @@ public:
                            Vulkan::VKUpdateDescriptorQueue& update_descriptor_queue,
                            std::vector<VkDescriptorSetLayoutBinding> bindings,
                            Vulkan::SPIRVProgram program, Vulkan::GraphicsPipelineCacheKey key,
-                           u32 num_color_buffers);
+                           u32 num_color_buffers, Priority priority);
 
 private:
-    void ShaderCompilerThread(Core::Frontend::GraphicsContext* context);
-
-    /// Check our worker queue to see if we have any work queued already
-    [[nodiscard]] bool HasWorkQueued() const;
-
     struct WorkerParams {
         Backend backend;
+        Priority priority;
+        std::chrono::steady_clock::time_point queue_time;
         // For OGL
         const OpenGL::Device* device;
         Tegra::Engines::ShaderType shader_type;
@@ -124,14 +148,50 @@ private:
         u32 num_color_buffers;
     };
 
+    /// Work queued to a single worker, other workers steal from it when they run out of work
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<WorkerParams>, NUM_PRIORITIES> queues;
+    };
+
+    /// Completed results are pushed to a lock-free stack and taken all at once by the consumer
+    struct CompletedNode {
+        Result result;
+        CompletedNode* next;
+    };
+
+    void ShaderCompilerThread(Core::Frontend::GraphicsContext* context, std::size_t worker_index);
+
+    void PushWork(WorkerParams&& work);
+
+    /// Takes the highest priority work available, from the own queue before stealing
+    [[nodiscard]] std::optional<WorkerParams> PopWork(std::size_t worker_index);
+
+    /// Check our worker queues to see if we have any work queued already
+    [[nodiscard]] bool HasWorkQueued() const;
+
+    void PushCompletedWork(Result&& result);
+
+    void RecordLatency(const WorkerParams& work);
+
+    void FreeCompletedWork();
+
+    /// Joins the workers once they have been told to exit and releases their state
+    void JoinWorkers();
+
     std::condition_variable cv;
-    mutable std::mutex queue_mutex;
-    mutable std::shared_mutex completed_mutex;
+    std::mutex sleep_mutex;
     std::atomic<bool> is_thread_exiting{};
+    /// Set when the workers should exit once every queued shader has been built
+    std::atomic<bool> is_draining{};
     std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> context_list;
     std::vector<std::thread> worker_threads;
-    std::queue<WorkerParams> pending_queue;
-    std::vector<Result> finished_work;
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
+    std::atomic<std::size_t> next_worker{};
+    std::atomic<CompletedNode*> completed_head{};
+    std::array<std::atomic<u64>, NUM_PRIORITIES> queue_depth{};
+    std::array<std::array<std::atomic<u64>, NUM_LATENCY_BUCKETS>, NUM_PRIORITIES>
+        latency_histogram{};
     Core::Frontend::EmuWindow& emu_window;
 };
 
@@ -40,15 +40,15 @@ struct BlockStack {
 };
 
 template <typename T, typename... Args>
-BlockBranchInfo MakeBranchInfo(Args&&... args) {
+BlockBranchInfo MakeBranchInfo(Common::ObjectPool<BranchData>& pool, Args&&... args) {
     static_assert(std::is_convertible_v<T, BranchData>);
-    return std::make_shared<BranchData>(T(std::forward<Args>(args)...));
+    return pool.Create(T(std::forward<Args>(args)...));
 }
 
 bool BlockBranchIsIgnored(BlockBranchInfo first) {
     bool ignore = false;
     if (std::holds_alternative<SingleBranch>(*first)) {
-        const auto branch = std::get_if<SingleBranch>(first.get());
+        const auto branch = std::get_if<SingleBranch>(first);
         ignore = branch->ignore;
     }
     return ignore;
@@ -66,11 +66,14 @@ struct BlockInfo {
 };
 
 struct CFGRebuildState {
-    explicit CFGRebuildState(const ProgramCode& program_code_, u32 start_, Registry& registry_)
-        : program_code{program_code_}, registry{registry_}, start{start_} {}
+    explicit CFGRebuildState(const ProgramCode& program_code_, u32 start_, Registry& registry_,
+                             Common::ObjectPool<BranchData>& branch_pool_)
+        : program_code{program_code_}, registry{registry_}, branch_pool{branch_pool_},
+          start{start_} {}
 
     const ProgramCode& program_code;
     Registry& registry;
+    Common::ObjectPool<BranchData>& branch_pool;
     u32 start{};
     std::vector<BlockInfo> block_info;
     std::list<u32> inspect_queries;
@@ -294,8 +297,9 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             single_branch.ignore = false;
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-                single_branch.condition, single_branch.address, single_branch.kill,
-                single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
+                state.branch_pool, single_branch.condition, single_branch.address,
+                single_branch.kill, single_branch.is_sync, single_branch.is_brk,
+                single_branch.ignore);
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -328,8 +332,9 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             single_branch.ignore = false;
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-                single_branch.condition, single_branch.address, single_branch.kill,
-                single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
+                state.branch_pool, single_branch.condition, single_branch.address,
+                single_branch.kill, single_branch.is_sync, single_branch.is_brk,
+                single_branch.ignore);
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -353,8 +358,9 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             single_branch.ignore = false;
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-                single_branch.condition, single_branch.address, single_branch.kill,
-                single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
+                state.branch_pool, single_branch.condition, single_branch.address,
+                single_branch.kill, single_branch.is_sync, single_branch.is_brk,
+                single_branch.ignore);
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -378,8 +384,9 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             single_branch.ignore = false;
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-                single_branch.condition, single_branch.address, single_branch.kill,
-                single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
+                state.branch_pool, single_branch.condition, single_branch.address,
+                single_branch.kill, single_branch.is_sync, single_branch.is_brk,
+                single_branch.ignore);
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -403,8 +410,9 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             single_branch.ignore = false;
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-                single_branch.condition, single_branch.address, single_branch.kill,
-                single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
+                state.branch_pool, single_branch.condition, single_branch.address,
+                single_branch.kill, single_branch.is_sync, single_branch.is_brk,
+                single_branch.ignore);
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -442,7 +450,7 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
             }
             parse_info.end_address = offset;
             parse_info.branch_info = MakeBranchInfo<MultiBranch>(
-                static_cast<u32>(instr.gpr8.Value()), std::move(branches));
+                state.branch_pool, static_cast<u32>(instr.gpr8.Value()), std::move(branches));
 
             return {ParseResult::ControlCaught, parse_info};
         }
@@ -457,8 +465,8 @@ std::pair<ParseResult, ParseInfo> ParseCode(CFGRebuildState& state, u32 address)
     single_branch.is_brk = false;
     parse_info.end_address = offset - 1;
     parse_info.branch_info = MakeBranchInfo<SingleBranch>(
-        single_branch.condition, single_branch.address, single_branch.kill, single_branch.is_sync,
-        single_branch.is_brk, single_branch.ignore);
+        state.branch_pool, single_branch.condition, single_branch.address, single_branch.kill,
+        single_branch.is_sync, single_branch.is_brk, single_branch.ignore);
     return {ParseResult::BlockEnd, parse_info};
 }
 
@@ -482,8 +490,8 @@ bool TryInspectAddress(CFGRebuildState& state) {
         BlockInfo& current_block = state.block_info[block_index];
         current_block.end = address - 1;
         new_block.branch = std::move(current_block.branch);
-        BlockBranchInfo forward_branch = MakeBranchInfo<SingleBranch>();
-        const auto branch = std::get_if<SingleBranch>(forward_branch.get());
+        BlockBranchInfo forward_branch = MakeBranchInfo<SingleBranch>(state.branch_pool);
+        const auto branch = std::get_if<SingleBranch>(forward_branch);
         branch->address = address;
         branch->ignore = true;
         current_block.branch = std::move(forward_branch);
@@ -501,7 +509,7 @@ bool TryInspectAddress(CFGRebuildState& state) {
     BlockInfo& block_info = CreateBlockInfo(state, address, parse_info.end_address);
     block_info.branch = parse_info.branch_info;
     if (std::holds_alternative<SingleBranch>(*block_info.branch)) {
-        const auto branch = std::get_if<SingleBranch>(block_info.branch.get());
+        const auto branch = std::get_if<SingleBranch>(block_info.branch);
         if (branch->condition.IsUnconditional()) {
             return true;
         }
@@ -547,7 +555,7 @@ bool TryQuery(CFGRebuildState& state) {
     gather_labels(q2.ssy_stack, state.ssy_labels, block);
     gather_labels(q2.pbk_stack, state.pbk_labels, block);
     if (std::holds_alternative<SingleBranch>(*block.branch)) {
-        auto* branch = std::get_if<SingleBranch>(block.branch.get());
+        auto* branch = std::get_if<SingleBranch>(block.branch);
         if (!branch->condition.IsUnconditional()) {
             q2.address = block.end + 1;
             state.queries.push_back(q2);
@@ -570,7 +578,7 @@ bool TryQuery(CFGRebuildState& state) {
         return true;
     }
 
-    const auto* multi_branch = std::get_if<MultiBranch>(block.branch.get());
+    const auto* multi_branch = std::get_if<MultiBranch>(block.branch);
     for (const auto& branch_case : multi_branch->branches) {
         auto& conditional_query = state.queries.emplace_back(q2);
         conditional_query.address = branch_case.address;
@@ -608,7 +616,7 @@ void InsertBranch(ASTManager& mm, const BlockBranchInfo& branch_info) {
     };
 
     if (std::holds_alternative<SingleBranch>(*branch_info)) {
-        const auto* branch = std::get_if<SingleBranch>(branch_info.get());
+        const auto* branch = std::get_if<SingleBranch>(branch_info);
         if (branch->address < 0) {
             if (branch->kill) {
                 mm.InsertReturn(get_expr(branch->condition), true);
@@ -620,7 +628,7 @@ void InsertBranch(ASTManager& mm, const BlockBranchInfo& branch_info) {
         mm.InsertGoto(get_expr(branch->condition), branch->address);
         return;
     }
-    const auto* multi_branch = std::get_if<MultiBranch>(branch_info.get());
+    const auto* multi_branch = std::get_if<MultiBranch>(branch_info);
     for (const auto& branch_case : multi_branch->branches) {
         mm.InsertGoto(MakeExpr<ExprGprEqual>(multi_branch->gpr, branch_case.cmp_value),
                       branch_case.address);
@@ -657,7 +665,7 @@ std::unique_ptr<ShaderCharacteristics> ScanFlow(const ProgramCode& program_code,
         return result_out;
     }
 
-    CFGRebuildState state{program_code, start_address, registry};
+    CFGRebuildState state{program_code, start_address, registry, result_out->branch_pool};
     // Inspect Code and generate blocks
     state.labels.clear();
     state.labels.emplace(start_address);
@@ -9,6 +9,7 @@
 #include <set>
 #include <variant>
 
+#include "common/object_pool.h"
 #include "video_core/engines/shader_bytecode.h"
 #include "video_core/shader/ast.h"
 #include "video_core/shader/compiler_settings.h"
@@ -80,7 +81,8 @@ public:
 };
 
 using BranchData = std::variant<SingleBranch, MultiBranch>;
-using BlockBranchInfo = std::shared_ptr<BranchData>;
+/// Branch information is owned by the ShaderCharacteristics it was scanned for
+using BlockBranchInfo = BranchData*;
 
 bool BlockBranchInfoAreEqual(BlockBranchInfo first, BlockBranchInfo second);
 
@@ -102,6 +104,7 @@ struct ShaderBlock {
 };
 
 struct ShaderCharacteristics {
+    Common::ObjectPool<BranchData> branch_pool{64};
     std::list<ShaderBlock> blocks{};
     std::set<u32> labels{};
     u32 start{};
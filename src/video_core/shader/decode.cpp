@@ -215,7 +215,7 @@ void ShaderIR::InsertControlFlow(NodeBlock& bb, const ShaderBlock& block) {
     const auto apply_conditions = [&](const Condition& cond, Node n) -> Node {
         Node result = n;
         if (cond.cc != ConditionCode::T) {
-            result = Conditional(GetConditionCode(cond.cc), {result});
+            result = Conditional(node_pool, GetConditionCode(cond.cc), {result});
         }
         if (cond.predicate != Pred::UnusedIndex) {
             u32 pred = static_cast<u32>(cond.predicate);
@@ -223,40 +223,41 @@ void ShaderIR::InsertControlFlow(NodeBlock& bb, const ShaderBlock& block) {
             if (is_neg) {
                 pred -= 8;
             }
-            result = Conditional(GetPredicate(pred, is_neg), {result});
+            result = Conditional(node_pool, GetPredicate(pred, is_neg), {result});
         }
         return result;
     };
     if (std::holds_alternative<SingleBranch>(*block.branch)) {
-        auto branch = std::get_if<SingleBranch>(block.branch.get());
+        auto branch = std::get_if<SingleBranch>(block.branch);
         if (branch->address < 0) {
             if (branch->kill) {
-                Node n = Operation(OperationCode::Discard);
+                Node n = Operation(node_pool, OperationCode::Discard);
                 n = apply_conditions(branch->condition, n);
                 bb.push_back(n);
                 global_code.push_back(n);
                 return;
             }
-            Node n = Operation(OperationCode::Exit);
+            Node n = Operation(node_pool, OperationCode::Exit);
             n = apply_conditions(branch->condition, n);
             bb.push_back(n);
             global_code.push_back(n);
             return;
         }
-        Node n = Operation(OperationCode::Branch, Immediate(branch->address));
+        Node n = Operation(node_pool, OperationCode::Branch, Immediate(node_pool, branch->address));
         n = apply_conditions(branch->condition, n);
         bb.push_back(n);
         global_code.push_back(n);
         return;
     }
-    auto multi_branch = std::get_if<MultiBranch>(block.branch.get());
+    auto multi_branch = std::get_if<MultiBranch>(block.branch);
     Node op_a = GetRegister(multi_branch->gpr);
     for (auto& branch_case : multi_branch->branches) {
-        Node n = Operation(OperationCode::Branch, Immediate(branch_case.address));
-        Node op_b = Immediate(branch_case.cmp_value);
+        Node n =
+            Operation(node_pool, OperationCode::Branch, Immediate(node_pool, branch_case.address));
+        Node op_b = Immediate(node_pool, branch_case.cmp_value);
         Node condition =
             GetPredicateComparisonInteger(Tegra::Shader::PredCondition::EQ, false, op_a, op_b);
-        auto result = Conditional(condition, {n});
+        auto result = Conditional(node_pool, condition, {n});
         bb.push_back(result);
         global_code.push_back(result);
     }
@@ -275,13 +276,14 @@ u32 ShaderIR::DecodeInstr(NodeBlock& bb, u32 pc) {
     // Decoding failure
     if (!opcode) {
         UNIMPLEMENTED_MSG("Unhandled instruction: {0:x}", instr.value);
-        bb.push_back(Comment(fmt::format("{:05x} Unimplemented Shader instruction (0x{:016x})",
+        bb.push_back(Comment(node_pool,
+                             fmt::format("{:05x} Unimplemented Shader instruction (0x{:016x})",
                                          nv_address, instr.value)));
         return pc + 1;
     }
 
-    bb.push_back(Comment(
-        fmt::format("{:05x} {} (0x{:016x})", nv_address, opcode->get().GetName(), instr.value)));
+    bb.push_back(Comment(node_pool, fmt::format("{:05x} {} (0x{:016x})", nv_address,
+                                                opcode->get().GetName(), instr.value)));
 
     using Tegra::Shader::Pred;
     UNIMPLEMENTED_IF_MSG(instr.pred.full_pred == Pred::NeverExecute,
@@ -330,8 +332,8 @@ u32 ShaderIR::DecodeInstr(NodeBlock& bb, u32 pc) {
     const auto pred_index = static_cast<u32>(instr.pred.pred_index);
 
     if (can_be_predicated && pred_index != static_cast<u32>(Pred::UnusedIndex)) {
-        const Node conditional =
-            Conditional(GetPredicate(pred_index, instr.negate_pred != 0), std::move(tmp_block));
+        const Node conditional = Conditional(
+            node_pool, GetPredicate(pred_index, instr.negate_pred != 0), std::move(tmp_block));
         global_code.push_back(conditional);
         bb.push_back(conditional);
     } else {
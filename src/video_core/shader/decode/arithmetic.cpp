@@ -64,12 +64,12 @@ u32 ShaderIR::DecodeArithmetic(NodeBlock& bb, u32 pc) {
         };
 
         if (instr.fmul.postfactor != 0) {
-            op_a = Operation(OperationCode::FMul, NO_PRECISE, op_a,
-                             Immediate(FmulPostFactor[instr.fmul.postfactor]));
+            op_a = Operation(node_pool, OperationCode::FMul, NO_PRECISE, op_a,
+                             Immediate(node_pool, FmulPostFactor[instr.fmul.postfactor]));
         }
 
         // TODO(Rodrigo): Should precise be used when there's a postfactor?
-        Node value = Operation(OperationCode::FMul, PRECISE, op_a, op_b);
+        Node value = Operation(node_pool, OperationCode::FMul, PRECISE, op_a, op_b);
 
         value = GetSaturatedFloat(value, instr.alu.saturate_d);
 
@@ -83,7 +83,7 @@ u32 ShaderIR::DecodeArithmetic(NodeBlock& bb, u32 pc) {
         op_a = GetOperandAbsNegFloat(op_a, instr.alu.abs_a, instr.alu.negate_a);
         op_b = GetOperandAbsNegFloat(op_b, instr.alu.abs_b, instr.alu.negate_b);
 
-        Node value = Operation(OperationCode::FAdd, PRECISE, op_a, op_b);
+        Node value = Operation(node_pool, OperationCode::FAdd, PRECISE, op_a, op_b);
         value = GetSaturatedFloat(value, instr.alu.saturate_d);
 
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
@@ -96,22 +96,23 @@ u32 ShaderIR::DecodeArithmetic(NodeBlock& bb, u32 pc) {
         Node value = [&]() {
             switch (instr.sub_op) {
             case SubOp::Cos:
-                return Operation(OperationCode::FCos, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FCos, PRECISE, op_a);
             case SubOp::Sin:
-                return Operation(OperationCode::FSin, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FSin, PRECISE, op_a);
             case SubOp::Ex2:
-                return Operation(OperationCode::FExp2, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FExp2, PRECISE, op_a);
             case SubOp::Lg2:
-                return Operation(OperationCode::FLog2, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FLog2, PRECISE, op_a);
             case SubOp::Rcp:
-                return Operation(OperationCode::FDiv, PRECISE, Immediate(1.0f), op_a);
+                return Operation(node_pool, OperationCode::FDiv, PRECISE,
+                                 Immediate(node_pool, 1.0f), op_a);
             case SubOp::Rsq:
-                return Operation(OperationCode::FInverseSqrt, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FInverseSqrt, PRECISE, op_a);
             case SubOp::Sqrt:
-                return Operation(OperationCode::FSqrt, PRECISE, op_a);
+                return Operation(node_pool, OperationCode::FSqrt, PRECISE, op_a);
             default:
                 UNIMPLEMENTED_MSG("Unhandled MUFU sub op={0:x}", instr.sub_op.Value());
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
         value = GetSaturatedFloat(value, instr.alu.saturate_d);
@@ -127,9 +128,10 @@ u32 ShaderIR::DecodeArithmetic(NodeBlock& bb, u32 pc) {
 
         const Node condition = GetPredicate(instr.alu.fmnmx.pred, instr.alu.fmnmx.negate_pred != 0);
 
-        const Node min = Operation(OperationCode::FMin, NO_PRECISE, op_a, op_b);
-        const Node max = Operation(OperationCode::FMax, NO_PRECISE, op_a, op_b);
-        const Node value = Operation(OperationCode::Select, NO_PRECISE, condition, min, max);
+        const Node min = Operation(node_pool, OperationCode::FMin, NO_PRECISE, op_a, op_b);
+        const Node max = Operation(node_pool, OperationCode::FMax, NO_PRECISE, op_a, op_b);
+        const Node value =
+            Operation(node_pool, OperationCode::Select, NO_PRECISE, condition, min, max);
 
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
         SetRegister(bb, instr.gpr0, value);
@@ -140,10 +142,10 @@ u32 ShaderIR::DecodeArithmetic(NodeBlock& bb, u32 pc) {
     case OpCode::Id::FCMP_IMMR: {
         UNIMPLEMENTED_IF(instr.fcmp.ftz == 0);
         Node op_c = GetRegister(instr.gpr39);
-        Node comp = GetPredicateComparisonFloat(instr.fcmp.cond, std::move(op_c), Immediate(0.0f));
-        SetRegister(
-            bb, instr.gpr0,
-            Operation(OperationCode::Select, std::move(comp), std::move(op_a), std::move(op_b)));
+        Node comp = GetPredicateComparisonFloat(instr.fcmp.cond, std::move(op_c),
+                                                Immediate(node_pool, 0.0f));
+        SetRegister(bb, instr.gpr0, Operation(node_pool, OperationCode::Select, std::move(comp),
+                                              std::move(op_a), std::move(op_b)));
         break;
     }
     case OpCode::Id::RRO_C:
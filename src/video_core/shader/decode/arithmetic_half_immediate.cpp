@@ -36,12 +36,12 @@ u32 ShaderIR::DecodeArithmeticHalfImmediate(NodeBlock& bb, u32 pc) {
     Node value = [&]() {
         switch (opcode->get().GetId()) {
         case OpCode::Id::HADD2_IMM:
-            return Operation(OperationCode::HAdd, PRECISE, op_a, op_b);
+            return Operation(node_pool, OperationCode::HAdd, PRECISE, op_a, op_b);
         case OpCode::Id::HMUL2_IMM:
-            return Operation(OperationCode::HMul, PRECISE, op_a, op_b);
+            return Operation(node_pool, OperationCode::HMul, PRECISE, op_a, op_b);
         default:
             UNREACHABLE();
-            return Immediate(0);
+            return Immediate(node_pool, 0);
         }
     }();
 
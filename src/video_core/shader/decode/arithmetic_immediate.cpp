@@ -23,8 +23,8 @@ u32 ShaderIR::DecodeArithmeticImmediate(NodeBlock& bb, u32 pc) {
         break;
     }
     case OpCode::Id::FMUL32_IMM: {
-        Node value =
-            Operation(OperationCode::FMul, PRECISE, GetRegister(instr.gpr8), GetImmediate32(instr));
+        Node value = Operation(node_pool, OperationCode::FMul, PRECISE, GetRegister(instr.gpr8),
+                               GetImmediate32(instr));
         value = GetSaturatedFloat(value, instr.fmul32.saturate);
 
         SetInternalFlagsFromFloat(bb, value, instr.op_32.generates_cc);
@@ -37,7 +37,7 @@ u32 ShaderIR::DecodeArithmeticImmediate(NodeBlock& bb, u32 pc) {
         const Node op_b = GetOperandAbsNegFloat(GetImmediate32(instr), instr.fadd32i.abs_b,
                                                 instr.fadd32i.negate_b);
 
-        const Node value = Operation(OperationCode::FAdd, PRECISE, op_a, op_b);
+        const Node value = Operation(node_pool, OperationCode::FAdd, PRECISE, op_a, op_b);
         SetInternalFlagsFromFloat(bb, value, instr.op_32.generates_cc);
         SetRegister(bb, instr.gpr0, value);
         break;
@@ -23,7 +23,7 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
     Node op_a = GetRegister(instr.gpr8);
     Node op_b = [&]() {
         if (instr.is_b_imm) {
-            return Immediate(instr.alu.GetSignedImm20_20());
+            return Immediate(node_pool, instr.alu.GetSignedImm20_20());
         } else if (instr.is_b_gpr) {
             return GetRegister(instr.gpr20);
         } else {
@@ -41,25 +41,27 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         op_a = GetOperandAbsNegInteger(op_a, false, instr.alu_integer.negate_a, true);
         op_b = GetOperandAbsNegInteger(op_b, false, instr.alu_integer.negate_b, true);
 
-        Node value = Operation(OperationCode::UAdd, op_a, op_b);
+        Node value = Operation(node_pool, OperationCode::UAdd, op_a, op_b);
 
         if (instr.iadd.x) {
             Node carry = GetInternalFlag(InternalFlag::Carry);
-            Node x = Operation(OperationCode::Select, std::move(carry), Immediate(1), Immediate(0));
-            value = Operation(OperationCode::UAdd, std::move(value), std::move(x));
+            Node x = Operation(node_pool, OperationCode::Select, std::move(carry),
+                               Immediate(node_pool, 1), Immediate(node_pool, 0));
+            value = Operation(node_pool, OperationCode::UAdd, std::move(value), std::move(x));
         }
 
         if (instr.generates_cc) {
-            const Node i0 = Immediate(0);
+            const Node i0 = Immediate(node_pool, 0);
 
-            Node zero = Operation(OperationCode::LogicalIEqual, value, i0);
-            Node sign = Operation(OperationCode::LogicalILessThan, value, i0);
-            Node carry = Operation(OperationCode::LogicalAddCarry, op_a, op_b);
+            Node zero = Operation(node_pool, OperationCode::LogicalIEqual, value, i0);
+            Node sign = Operation(node_pool, OperationCode::LogicalILessThan, value, i0);
+            Node carry = Operation(node_pool, OperationCode::LogicalAddCarry, op_a, op_b);
 
-            Node pos_a = Operation(OperationCode::LogicalIGreaterThan, op_a, i0);
-            Node pos_b = Operation(OperationCode::LogicalIGreaterThan, op_b, i0);
-            Node pos = Operation(OperationCode::LogicalAnd, std::move(pos_a), std::move(pos_b));
-            Node overflow = Operation(OperationCode::LogicalAnd, pos, sign);
+            Node pos_a = Operation(node_pool, OperationCode::LogicalIGreaterThan, op_a, i0);
+            Node pos_b = Operation(node_pool, OperationCode::LogicalIGreaterThan, op_b, i0);
+            Node pos =
+                Operation(node_pool, OperationCode::LogicalAnd, std::move(pos_a), std::move(pos_b));
+            Node overflow = Operation(node_pool, OperationCode::LogicalAnd, pos, sign);
 
             SetInternalFlag(bb, InternalFlag::Zero, std::move(zero));
             SetInternalFlag(bb, InternalFlag::Sign, std::move(sign));
@@ -84,7 +86,7 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
                 return BitfieldExtract(value, 16, 16);
             default:
                 UNIMPLEMENTED_MSG("Unhandled IADD3 height: {}", height);
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         };
 
@@ -99,9 +101,9 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         op_c = GetOperandAbsNegInteger(op_c, false, instr.iadd3.neg_c, true);
 
         const Node value = [&] {
-            Node add_ab = Operation(OperationCode::IAdd, NO_PRECISE, op_a, op_b);
+            Node add_ab = Operation(node_pool, OperationCode::IAdd, NO_PRECISE, op_a, op_b);
             if (opcode->get().GetId() != OpCode::Id::IADD3_R) {
-                return Operation(OperationCode::IAdd, NO_PRECISE, add_ab, op_c);
+                return Operation(node_pool, OperationCode::IAdd, NO_PRECISE, add_ab, op_c);
             }
             const Node shifted = [&] {
                 switch (instr.iadd3.mode) {
@@ -110,16 +112,16 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
                     // https://envytools.readthedocs.io/en/latest/hw/graph/maxwell/cuda/int.html?highlight=iadd3
                     // The addition between op_a and op_b should be done in uint33, more
                     // investigation required
-                    return Operation(OperationCode::ILogicalShiftRight, NO_PRECISE, add_ab,
-                                     Immediate(16));
+                    return Operation(node_pool, OperationCode::ILogicalShiftRight, NO_PRECISE,
+                                     add_ab, Immediate(node_pool, 16));
                 case Tegra::Shader::IAdd3Mode::LeftShift:
-                    return Operation(OperationCode::ILogicalShiftLeft, NO_PRECISE, add_ab,
-                                     Immediate(16));
+                    return Operation(node_pool, OperationCode::ILogicalShiftLeft, NO_PRECISE,
+                                     add_ab, Immediate(node_pool, 16));
                 default:
                     return add_ab;
                 }
             }();
-            return Operation(OperationCode::IAdd, NO_PRECISE, shifted, op_c);
+            return Operation(node_pool, OperationCode::IAdd, NO_PRECISE, shifted, op_c);
         }();
 
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
@@ -135,9 +137,10 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         op_a = GetOperandAbsNegInteger(op_a, false, instr.alu_integer.negate_a, true);
         op_b = GetOperandAbsNegInteger(op_b, false, instr.alu_integer.negate_b, true);
 
-        const Node shift = Immediate(static_cast<u32>(instr.alu_integer.shift_amount));
-        const Node shifted_a = Operation(OperationCode::ILogicalShiftLeft, NO_PRECISE, op_a, shift);
-        const Node value = Operation(OperationCode::IAdd, NO_PRECISE, shifted_a, op_b);
+        const Node shift = Immediate(node_pool, static_cast<u32>(instr.alu_integer.shift_amount));
+        const Node shifted_a =
+            Operation(node_pool, OperationCode::ILogicalShiftLeft, NO_PRECISE, op_a, shift);
+        const Node value = Operation(node_pool, OperationCode::IAdd, NO_PRECISE, shifted_a, op_b);
 
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
         SetRegister(bb, instr.gpr0, value);
@@ -147,9 +150,9 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
     case OpCode::Id::POPC_R:
     case OpCode::Id::POPC_IMM: {
         if (instr.popc.invert) {
-            op_b = Operation(OperationCode::IBitwiseNot, NO_PRECISE, op_b);
+            op_b = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, op_b);
         }
-        const Node value = Operation(OperationCode::IBitCount, PRECISE, op_b);
+        const Node value = Operation(node_pool, OperationCode::IBitCount, PRECISE, op_b);
         SetRegister(bb, instr.gpr0, value);
         break;
     }
@@ -158,16 +161,16 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
     case OpCode::Id::FLO_IMM: {
         Node value;
         if (instr.flo.invert) {
-            op_b = Operation(OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_b));
+            op_b = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_b));
         }
         if (instr.flo.is_signed) {
-            value = Operation(OperationCode::IBitMSB, NO_PRECISE, std::move(op_b));
+            value = Operation(node_pool, OperationCode::IBitMSB, NO_PRECISE, std::move(op_b));
         } else {
-            value = Operation(OperationCode::UBitMSB, NO_PRECISE, std::move(op_b));
+            value = Operation(node_pool, OperationCode::UBitMSB, NO_PRECISE, std::move(op_b));
         }
         if (instr.flo.sh) {
-            value =
-                Operation(OperationCode::UBitwiseXor, NO_PRECISE, std::move(value), Immediate(31));
+            value = Operation(node_pool, OperationCode::UBitwiseXor, NO_PRECISE, std::move(value),
+                              Immediate(node_pool, 31));
         }
         SetRegister(bb, instr.gpr0, std::move(value));
         break;
@@ -176,7 +179,8 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
     case OpCode::Id::SEL_R:
     case OpCode::Id::SEL_IMM: {
         const Node condition = GetPredicate(instr.sel.pred, instr.sel.neg_pred != 0);
-        const Node value = Operation(OperationCode::Select, PRECISE, condition, op_a, op_b);
+        const Node value =
+            Operation(node_pool, OperationCode::Select, PRECISE, condition, op_a, op_b);
         SetRegister(bb, instr.gpr0, value);
         break;
     }
@@ -184,7 +188,7 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
     case OpCode::Id::ICMP_R:
     case OpCode::Id::ICMP_RC:
     case OpCode::Id::ICMP_IMM: {
-        const Node zero = Immediate(0);
+        const Node zero = Immediate(node_pool, 0);
 
         const auto [op_rhs, test] = [&]() -> std::pair<Node, Node> {
             switch (opcode->get().GetId()) {
@@ -197,7 +201,8 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
                 return {GetRegister(instr.gpr39),
                         GetConstBuffer(instr.cbuf34.index, instr.cbuf34.GetOffset())};
             case OpCode::Id::ICMP_IMM:
-                return {Immediate(instr.alu.GetSignedImm20_20()), GetRegister(instr.gpr39)};
+                return {Immediate(node_pool, instr.alu.GetSignedImm20_20()),
+                        GetRegister(instr.gpr39)};
             default:
                 UNREACHABLE();
                 return {zero, zero};
@@ -206,16 +211,17 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         const Node op_lhs = GetRegister(instr.gpr8);
         const Node comparison =
             GetPredicateComparisonInteger(instr.icmp.cond, instr.icmp.is_signed != 0, test, zero);
-        SetRegister(bb, instr.gpr0, Operation(OperationCode::Select, comparison, op_lhs, op_rhs));
+        SetRegister(bb, instr.gpr0,
+                    Operation(node_pool, OperationCode::Select, comparison, op_lhs, op_rhs));
         break;
     }
     case OpCode::Id::LOP_C:
     case OpCode::Id::LOP_R:
     case OpCode::Id::LOP_IMM: {
         if (instr.alu.lop.invert_a)
-            op_a = Operation(OperationCode::IBitwiseNot, NO_PRECISE, op_a);
+            op_a = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, op_a);
         if (instr.alu.lop.invert_b)
-            op_b = Operation(OperationCode::IBitwiseNot, NO_PRECISE, op_b);
+            op_b = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, op_b);
 
         WriteLogicOperation(bb, instr.gpr0, instr.alu.lop.operation, op_a, op_b,
                             instr.alu.lop.pred_result_mode, instr.alu.lop.pred48,
@@ -228,9 +234,9 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         const Node op_c = GetRegister(instr.gpr39);
         const Node lut = [&]() {
             if (opcode->get().GetId() == OpCode::Id::LOP3_R) {
-                return Immediate(instr.alu.lop3.GetImmLut28());
+                return Immediate(node_pool, instr.alu.lop3.GetImmLut28());
             } else {
-                return Immediate(instr.alu.lop3.GetImmLut48());
+                return Immediate(node_pool, instr.alu.lop3.GetImmLut48());
             }
         }();
 
@@ -245,9 +251,12 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
         const bool is_signed = instr.imnmx.is_signed;
 
         const Node condition = GetPredicate(instr.imnmx.pred, instr.imnmx.negate_pred != 0);
-        const Node min = SignedOperation(OperationCode::IMin, is_signed, NO_PRECISE, op_a, op_b);
-        const Node max = SignedOperation(OperationCode::IMax, is_signed, NO_PRECISE, op_a, op_b);
-        const Node value = Operation(OperationCode::Select, NO_PRECISE, condition, min, max);
+        const Node min =
+            SignedOperation(node_pool, OperationCode::IMin, is_signed, NO_PRECISE, op_a, op_b);
+        const Node max =
+            SignedOperation(node_pool, OperationCode::IMax, is_signed, NO_PRECISE, op_a, op_b);
+        const Node value =
+            Operation(node_pool, OperationCode::Select, NO_PRECISE, condition, min, max);
 
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
         SetRegister(bb, instr.gpr0, value);
@@ -262,41 +271,42 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
             switch (opcode->get().GetId()) {
             case OpCode::Id::LEA_R2: {
                 return {GetRegister(instr.gpr20), GetRegister(instr.gpr39),
-                        Immediate(static_cast<u32>(instr.lea.r2.entry_a))};
+                        Immediate(node_pool, static_cast<u32>(instr.lea.r2.entry_a))};
             }
             case OpCode::Id::LEA_R1: {
                 const bool neg = instr.lea.r1.neg != 0;
                 return {GetOperandAbsNegInteger(GetRegister(instr.gpr8), false, neg, true),
                         GetRegister(instr.gpr20),
-                        Immediate(static_cast<u32>(instr.lea.r1.entry_a))};
+                        Immediate(node_pool, static_cast<u32>(instr.lea.r1.entry_a))};
             }
             case OpCode::Id::LEA_IMM: {
                 const bool neg = instr.lea.imm.neg != 0;
                 return {GetOperandAbsNegInteger(GetRegister(instr.gpr8), false, neg, true),
-                        Immediate(static_cast<u32>(instr.lea.imm.entry_a)),
-                        Immediate(static_cast<u32>(instr.lea.imm.entry_b))};
+                        Immediate(node_pool, static_cast<u32>(instr.lea.imm.entry_a)),
+                        Immediate(node_pool, static_cast<u32>(instr.lea.imm.entry_b))};
             }
             case OpCode::Id::LEA_RZ: {
                 const bool neg = instr.lea.rz.neg != 0;
                 return {GetConstBuffer(instr.lea.rz.cb_index, instr.lea.rz.cb_offset),
                         GetOperandAbsNegInteger(GetRegister(instr.gpr8), false, neg, true),
-                        Immediate(static_cast<u32>(instr.lea.rz.entry_a))};
+                        Immediate(node_pool, static_cast<u32>(instr.lea.rz.entry_a))};
             }
             case OpCode::Id::LEA_HI:
             default:
                 UNIMPLEMENTED_MSG("Unhandled LEA subinstruction: {}", opcode->get().GetName());
 
-                return {Immediate(static_cast<u32>(instr.lea.imm.entry_a)), GetRegister(instr.gpr8),
-                        Immediate(static_cast<u32>(instr.lea.imm.entry_b))};
+                return {Immediate(node_pool, static_cast<u32>(instr.lea.imm.entry_a)),
+                        GetRegister(instr.gpr8),
+                        Immediate(node_pool, static_cast<u32>(instr.lea.imm.entry_b))};
             }
         }();
 
         UNIMPLEMENTED_IF_MSG(instr.lea.pred48 != static_cast<u64>(Pred::UnusedIndex),
                              "Unhandled LEA Predicate");
 
-        Node value =
-            Operation(OperationCode::ILogicalShiftLeft, std::move(op_a_), std::move(op_c_));
-        value = Operation(OperationCode::IAdd, std::move(op_b_), std::move(value));
+        Node value = Operation(node_pool, OperationCode::ILogicalShiftLeft, std::move(op_a_),
+                               std::move(op_c_));
+        value = Operation(node_pool, OperationCode::IAdd, std::move(op_b_), std::move(value));
         SetRegister(bb, instr.gpr0, std::move(value));
 
         break;
@@ -311,59 +321,59 @@ u32 ShaderIR::DecodeArithmeticInteger(NodeBlock& bb, u32 pc) {
 void ShaderIR::WriteLop3Instruction(NodeBlock& bb, Register dest, Node op_a, Node op_b, Node op_c,
                                     Node imm_lut, bool sets_cc) {
     const Node lop3_fast = [&](const Node na, const Node nb, const Node nc, const Node ttbl) {
-        Node value = Immediate(0);
+        Node value = Immediate(node_pool, 0);
         const ImmediateNode imm = std::get<ImmediateNode>(*ttbl);
         if (imm.GetValue() & 0x01) {
-            const Node a = Operation(OperationCode::IBitwiseNot, na);
-            const Node b = Operation(OperationCode::IBitwiseNot, nb);
-            const Node c = Operation(OperationCode::IBitwiseNot, nc);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, a, b);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node a = Operation(node_pool, OperationCode::IBitwiseNot, na);
+            const Node b = Operation(node_pool, OperationCode::IBitwiseNot, nb);
+            const Node c = Operation(node_pool, OperationCode::IBitwiseNot, nc);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, a, b);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x02) {
-            const Node a = Operation(OperationCode::IBitwiseNot, na);
-            const Node b = Operation(OperationCode::IBitwiseNot, nb);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, a, b);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node a = Operation(node_pool, OperationCode::IBitwiseNot, na);
+            const Node b = Operation(node_pool, OperationCode::IBitwiseNot, nb);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, a, b);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x04) {
-            const Node a = Operation(OperationCode::IBitwiseNot, na);
-            const Node c = Operation(OperationCode::IBitwiseNot, nc);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, a, nb);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node a = Operation(node_pool, OperationCode::IBitwiseNot, na);
+            const Node c = Operation(node_pool, OperationCode::IBitwiseNot, nc);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, a, nb);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x08) {
-            const Node a = Operation(OperationCode::IBitwiseNot, na);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, a, nb);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node a = Operation(node_pool, OperationCode::IBitwiseNot, na);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, a, nb);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x10) {
-            const Node b = Operation(OperationCode::IBitwiseNot, nb);
-            const Node c = Operation(OperationCode::IBitwiseNot, nc);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, na, b);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node b = Operation(node_pool, OperationCode::IBitwiseNot, nb);
+            const Node c = Operation(node_pool, OperationCode::IBitwiseNot, nc);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, na, b);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x20) {
-            const Node b = Operation(OperationCode::IBitwiseNot, nb);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, na, b);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node b = Operation(node_pool, OperationCode::IBitwiseNot, nb);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, na, b);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x40) {
-            const Node c = Operation(OperationCode::IBitwiseNot, nc);
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, na, nb);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            const Node c = Operation(node_pool, OperationCode::IBitwiseNot, nc);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, na, nb);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, c);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         if (imm.GetValue() & 0x80) {
-            Node r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, na, nb);
-            r = Operation(OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
-            value = Operation(OperationCode::IBitwiseOr, value, r);
+            Node r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, na, nb);
+            r = Operation(node_pool, OperationCode::IBitwiseAnd, NO_PRECISE, r, nc);
+            value = Operation(node_pool, OperationCode::IBitwiseOr, value, r);
         }
         return value;
     }(op_a, op_b, op_c, imm_lut);
@@ -22,7 +22,7 @@ u32 ShaderIR::DecodeArithmeticIntegerImmediate(NodeBlock& bb, u32 pc) {
     const auto opcode = OpCode::Decode(instr);
 
     Node op_a = GetRegister(instr.gpr8);
-    Node op_b = Immediate(static_cast<s32>(instr.alu.imm20_32));
+    Node op_b = Immediate(node_pool, static_cast<s32>(instr.alu.imm20_32));
 
     switch (opcode->get().GetId()) {
     case OpCode::Id::IADD32I: {
@@ -30,7 +30,8 @@ u32 ShaderIR::DecodeArithmeticIntegerImmediate(NodeBlock& bb, u32 pc) {
 
         op_a = GetOperandAbsNegInteger(std::move(op_a), false, instr.iadd32i.negate_a != 0, true);
 
-        Node value = Operation(OperationCode::IAdd, PRECISE, std::move(op_a), std::move(op_b));
+        Node value =
+            Operation(node_pool, OperationCode::IAdd, PRECISE, std::move(op_a), std::move(op_b));
 
         SetInternalFlagsFromInteger(bb, value, instr.op_32.generates_cc != 0);
         SetRegister(bb, instr.gpr0, std::move(value));
@@ -38,11 +39,11 @@ u32 ShaderIR::DecodeArithmeticIntegerImmediate(NodeBlock& bb, u32 pc) {
     }
     case OpCode::Id::LOP32I: {
         if (instr.alu.lop32i.invert_a) {
-            op_a = Operation(OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_a));
+            op_a = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_a));
         }
 
         if (instr.alu.lop32i.invert_b) {
-            op_b = Operation(OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_b));
+            op_b = Operation(node_pool, OperationCode::IBitwiseNot, NO_PRECISE, std::move(op_b));
         }
 
         WriteLogicOperation(bb, instr.gpr0, instr.alu.lop32i.operation, std::move(op_a),
@@ -64,16 +65,19 @@ void ShaderIR::WriteLogicOperation(NodeBlock& bb, Register dest, LogicOperation
     Node result = [&] {
         switch (logic_op) {
         case LogicOperation::And:
-            return Operation(OperationCode::IBitwiseAnd, PRECISE, std::move(op_a), std::move(op_b));
+            return Operation(node_pool, OperationCode::IBitwiseAnd, PRECISE, std::move(op_a),
+                             std::move(op_b));
         case LogicOperation::Or:
-            return Operation(OperationCode::IBitwiseOr, PRECISE, std::move(op_a), std::move(op_b));
+            return Operation(node_pool, OperationCode::IBitwiseOr, PRECISE, std::move(op_a),
+                             std::move(op_b));
         case LogicOperation::Xor:
-            return Operation(OperationCode::IBitwiseXor, PRECISE, std::move(op_a), std::move(op_b));
+            return Operation(node_pool, OperationCode::IBitwiseXor, PRECISE, std::move(op_a),
+                             std::move(op_b));
         case LogicOperation::PassB:
             return op_b;
         default:
             UNIMPLEMENTED_MSG("Unimplemented logic operation={}", logic_op);
-            return Immediate(0);
+            return Immediate(node_pool, 0);
         }
     }();
 
@@ -87,7 +91,8 @@ void ShaderIR::WriteLogicOperation(NodeBlock& bb, Register dest, LogicOperation
         return;
     case PredicateResultMode::NotZero: {
         // Set the predicate to true if the result is not zero.
-        Node compare = Operation(OperationCode::LogicalINotEqual, std::move(result), Immediate(0));
+        Node compare = Operation(node_pool, OperationCode::LogicalINotEqual, std::move(result),
+                                 Immediate(node_pool, 0));
         SetPredicate(bb, static_cast<u64>(predicate), std::move(compare));
         break;
     }
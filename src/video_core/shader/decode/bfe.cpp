@@ -25,10 +25,10 @@ u32 ShaderIR::DecodeBfe(NodeBlock& bb, u32 pc) {
         case OpCode::Id::BFE_C:
             return GetConstBuffer(instr.cbuf34.index, instr.cbuf34.GetOffset());
         case OpCode::Id::BFE_IMM:
-            return Immediate(instr.alu.GetSignedImm20_20());
+            return Immediate(node_pool, instr.alu.GetSignedImm20_20());
         default:
             UNREACHABLE();
-            return Immediate(0);
+            return Immediate(node_pool, 0);
         }
     }();
 
@@ -41,20 +41,20 @@ u32 ShaderIR::DecodeBfe(NodeBlock& bb, u32 pc) {
     // note for later if possible to implement faster method.
     if (instr.bfe.brev) {
         const auto swap = [&](u32 s, u32 mask) {
-            Node v1 =
-                SignedOperation(OperationCode::ILogicalShiftRight, is_signed, op_a, Immediate(s));
+            Node v1 = SignedOperation(node_pool, OperationCode::ILogicalShiftRight, is_signed, op_a,
+                                      Immediate(node_pool, s));
             if (mask != 0) {
-                v1 = SignedOperation(OperationCode::IBitwiseAnd, is_signed, std::move(v1),
-                                     Immediate(mask));
+                v1 = SignedOperation(node_pool, OperationCode::IBitwiseAnd, is_signed,
+                                     std::move(v1), Immediate(node_pool, mask));
             }
             Node v2 = op_a;
             if (mask != 0) {
-                v2 = SignedOperation(OperationCode::IBitwiseAnd, is_signed, std::move(v2),
-                                     Immediate(mask));
+                v2 = SignedOperation(node_pool, OperationCode::IBitwiseAnd, is_signed,
+                                     std::move(v2), Immediate(node_pool, mask));
             }
-            v2 = SignedOperation(OperationCode::ILogicalShiftLeft, is_signed, std::move(v2),
-                                 Immediate(s));
-            return SignedOperation(OperationCode::IBitwiseOr, is_signed, std::move(v1),
+            v2 = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft, is_signed,
+                                 std::move(v2), Immediate(node_pool, s));
+            return SignedOperation(node_pool, OperationCode::IBitwiseOr, is_signed, std::move(v1),
                                    std::move(v2));
         };
         op_a = swap(1, 0x55555555U);
@@ -64,11 +64,12 @@ u32 ShaderIR::DecodeBfe(NodeBlock& bb, u32 pc) {
         op_a = swap(16, 0);
     }
 
-    const auto offset = SignedOperation(OperationCode::IBitfieldExtract, is_signed, op_b,
-                                        Immediate(0), Immediate(8));
-    const auto bits = SignedOperation(OperationCode::IBitfieldExtract, is_signed, op_b,
-                                      Immediate(8), Immediate(8));
-    auto result = SignedOperation(OperationCode::IBitfieldExtract, is_signed, op_a, offset, bits);
+    const auto offset = SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed, op_b,
+                                        Immediate(node_pool, 0), Immediate(node_pool, 8));
+    const auto bits = SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed, op_b,
+                                      Immediate(node_pool, 8), Immediate(node_pool, 8));
+    auto result =
+        SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed, op_a, offset, bits);
     SetRegister(bb, instr.gpr0, std::move(result));
 
     return pc;
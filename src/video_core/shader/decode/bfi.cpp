@@ -23,10 +23,10 @@ u32 ShaderIR::DecodeBfi(NodeBlock& bb, u32 pc) {
             return {GetRegister(instr.gpr39),
                     GetConstBuffer(instr.cbuf34.index, instr.cbuf34.GetOffset())};
         case OpCode::Id::BFI_IMM_R:
-            return {Immediate(instr.alu.GetSignedImm20_20()), GetRegister(instr.gpr39)};
+            return {Immediate(node_pool, instr.alu.GetSignedImm20_20()), GetRegister(instr.gpr39)};
         default:
             UNREACHABLE();
-            return {Immediate(0), Immediate(0)};
+            return {Immediate(node_pool, 0), Immediate(node_pool, 0)};
         }
     }();
     const Node insert = GetRegister(instr.gpr8);
@@ -34,7 +34,7 @@ u32 ShaderIR::DecodeBfi(NodeBlock& bb, u32 pc) {
     const Node bits = BitfieldExtract(packed_shift, 8, 8);
 
     const Node value =
-        Operation(OperationCode::UBitfieldInsert, PRECISE, base, insert, offset, bits);
+        Operation(node_pool, OperationCode::UBitfieldInsert, PRECISE, base, insert, offset, bits);
 
     SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
     SetRegister(bb, instr.gpr0, value);
@@ -85,10 +85,10 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
             case OpCode::Id::I2I_C:
                 return GetConstBuffer(instr.cbuf34.index, instr.cbuf34.GetOffset());
             case OpCode::Id::I2I_IMM:
-                return Immediate(instr.alu.GetSignedImm20_20());
+                return Immediate(node_pool, instr.alu.GetSignedImm20_20());
             default:
                 UNREACHABLE();
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
 
@@ -105,8 +105,9 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
         }
 
         if (src_size != Register::Size::Word || selector != 0) {
-            value = SignedOperation(OperationCode::IBitfieldExtract, src_signed, std::move(value),
-                                    Immediate(selector * 8), Immediate(SizeInBits(src_size)));
+            value = SignedOperation(node_pool, OperationCode::IBitfieldExtract, src_signed,
+                                    std::move(value), Immediate(node_pool, selector * 8),
+                                    Immediate(node_pool, SizeInBits(src_size)));
         }
 
         value = GetOperandAbsNegInteger(std::move(value), instr.conversion.abs_a,
@@ -114,33 +115,34 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
 
         if (instr.alu.saturate_d) {
             if (src_signed && !dst_signed) {
-                Node is_negative = Operation(OperationCode::LogicalUGreaterEqual, value,
-                                             Immediate(1 << (SizeInBits(src_size) - 1)));
-                value = Operation(OperationCode::Select, std::move(is_negative), Immediate(0),
-                                  std::move(value));
+                Node is_negative = Operation(node_pool, OperationCode::LogicalUGreaterEqual, value,
+                                             Immediate(node_pool, 1 << (SizeInBits(src_size) - 1)));
+                value = Operation(node_pool, OperationCode::Select, std::move(is_negative),
+                                  Immediate(node_pool, 0), std::move(value));
 
                 // Simplify generated expressions, this can be removed without semantic impact
                 SetTemporary(bb, 0, std::move(value));
                 value = GetTemporary(0);
 
                 if (dst_size != Register::Size::Word) {
-                    const Node limit = Immediate((1 << SizeInBits(dst_size)) - 1);
-                    Node is_large =
-                        Operation(OperationCode::LogicalUGreaterThan, std::move(value), limit);
-                    value = Operation(OperationCode::Select, std::move(is_large), limit,
+                    const Node limit = Immediate(node_pool, (1 << SizeInBits(dst_size)) - 1);
+                    Node is_large = Operation(node_pool, OperationCode::LogicalUGreaterThan,
+                                              std::move(value), limit);
+                    value = Operation(node_pool, OperationCode::Select, std::move(is_large), limit,
                                       std::move(value));
                 }
             } else if (const std::optional bounds =
                            IntegerSaturateBounds(src_size, dst_size, src_signed, dst_signed)) {
-                value = SignedOperation(OperationCode::IMax, src_signed, std::move(value),
-                                        Immediate(bounds->first));
-                value = SignedOperation(OperationCode::IMin, src_signed, std::move(value),
-                                        Immediate(bounds->second));
+                value = SignedOperation(node_pool, OperationCode::IMax, src_signed,
+                                        std::move(value), Immediate(node_pool, bounds->first));
+                value = SignedOperation(node_pool, OperationCode::IMin, src_signed,
+                                        std::move(value), Immediate(node_pool, bounds->second));
             }
         } else if (dst_size != Register::Size::Word) {
             // No saturation, we only have to mask the result
-            Node mask = Immediate((1 << SizeInBits(dst_size)) - 1);
-            value = Operation(OperationCode::UBitwiseAnd, std::move(value), std::move(mask));
+            Node mask = Immediate(node_pool, (1 << SizeInBits(dst_size)) - 1);
+            value =
+                Operation(node_pool, OperationCode::UBitwiseAnd, std::move(value), std::move(mask));
         }
 
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
@@ -161,10 +163,10 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
             case OpCode::Id::I2F_C:
                 return GetConstBuffer(instr.cbuf34.index, instr.cbuf34.GetOffset());
             case OpCode::Id::I2F_IMM:
-                return Immediate(instr.alu.GetSignedImm20_20());
+                return Immediate(node_pool, instr.alu.GetSignedImm20_20());
             default:
                 UNREACHABLE();
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
 
@@ -176,19 +178,20 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
             if (instr.conversion.src_size == Register::Size::Short) {
                 ASSERT(offset == 0 || offset == 2);
             }
-            value = SignedOperation(OperationCode::ILogicalShiftRight, input_signed,
-                                    std::move(value), Immediate(offset * 8));
+            value = SignedOperation(node_pool, OperationCode::ILogicalShiftRight, input_signed,
+                                    std::move(value), Immediate(node_pool, offset * 8));
         }
 
         value = ConvertIntegerSize(value, instr.conversion.src_size, input_signed);
         value = GetOperandAbsNegInteger(value, instr.conversion.abs_a, false, input_signed);
-        value = SignedOperation(OperationCode::FCastInteger, input_signed, PRECISE, value);
+        value =
+            SignedOperation(node_pool, OperationCode::FCastInteger, input_signed, PRECISE, value);
         value = GetOperandAbsNegFloat(value, false, instr.conversion.negate_a);
 
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
 
         if (instr.conversion.dst_size == Register::Size::Short) {
-            value = Operation(OperationCode::HCastFloat, PRECISE, value);
+            value = Operation(node_pool, OperationCode::HCastFloat, PRECISE, value);
         }
 
         SetRegister(bb, instr.gpr0, value);
@@ -212,13 +215,13 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
                 return GetImmediate19(instr);
             default:
                 UNREACHABLE();
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
 
         if (instr.conversion.src_size == Register::Size::Short) {
-            value = Operation(GetFloatSelector(instr.conversion.float_src.selector), NO_PRECISE,
-                              std::move(value));
+            value = Operation(node_pool, GetFloatSelector(instr.conversion.float_src.selector),
+                              NO_PRECISE, std::move(value));
         } else {
             ASSERT(instr.conversion.float_src.selector == 0);
         }
@@ -235,13 +238,13 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
             case Tegra::Shader::F2fRoundingOp::None:
                 return value;
             case Tegra::Shader::F2fRoundingOp::Round:
-                return Operation(OperationCode::FRoundEven, value);
+                return Operation(node_pool, OperationCode::FRoundEven, value);
             case Tegra::Shader::F2fRoundingOp::Floor:
-                return Operation(OperationCode::FFloor, value);
+                return Operation(node_pool, OperationCode::FFloor, value);
             case Tegra::Shader::F2fRoundingOp::Ceil:
-                return Operation(OperationCode::FCeil, value);
+                return Operation(node_pool, OperationCode::FCeil, value);
             case Tegra::Shader::F2fRoundingOp::Trunc:
-                return Operation(OperationCode::FTrunc, value);
+                return Operation(node_pool, OperationCode::FTrunc, value);
             default:
                 UNIMPLEMENTED_MSG("Unimplemented F2F rounding mode {}",
                                   instr.conversion.f2f.rounding.Value());
@@ -253,7 +256,7 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
 
         if (instr.conversion.dst_size == Register::Size::Short) {
-            value = Operation(OperationCode::HCastFloat, PRECISE, value);
+            value = Operation(node_pool, OperationCode::HCastFloat, PRECISE, value);
         }
 
         SetRegister(bb, instr.gpr0, value);
@@ -275,13 +278,13 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
                 return GetImmediate19(instr);
             default:
                 UNREACHABLE();
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
 
         if (instr.conversion.src_size == Register::Size::Short) {
-            value = Operation(GetFloatSelector(instr.conversion.float_src.selector), NO_PRECISE,
-                              std::move(value));
+            value = Operation(node_pool, GetFloatSelector(instr.conversion.float_src.selector),
+                              NO_PRECISE, std::move(value));
         } else {
             ASSERT(instr.conversion.float_src.selector == 0);
         }
@@ -291,21 +294,21 @@ u32 ShaderIR::DecodeConversion(NodeBlock& bb, u32 pc) {
         value = [&]() {
             switch (instr.conversion.f2i.rounding) {
             case Tegra::Shader::F2iRoundingOp::RoundEven:
-                return Operation(OperationCode::FRoundEven, PRECISE, value);
+                return Operation(node_pool, OperationCode::FRoundEven, PRECISE, value);
             case Tegra::Shader::F2iRoundingOp::Floor:
-                return Operation(OperationCode::FFloor, PRECISE, value);
+                return Operation(node_pool, OperationCode::FFloor, PRECISE, value);
             case Tegra::Shader::F2iRoundingOp::Ceil:
-                return Operation(OperationCode::FCeil, PRECISE, value);
+                return Operation(node_pool, OperationCode::FCeil, PRECISE, value);
             case Tegra::Shader::F2iRoundingOp::Trunc:
-                return Operation(OperationCode::FTrunc, PRECISE, value);
+                return Operation(node_pool, OperationCode::FTrunc, PRECISE, value);
             default:
                 UNIMPLEMENTED_MSG("Unimplemented F2I rounding mode {}",
                                   instr.conversion.f2i.rounding.Value());
-                return Immediate(0);
+                return Immediate(node_pool, 0);
             }
         }();
         const bool is_signed = instr.conversion.is_output_signed;
-        value = SignedOperation(OperationCode::ICastFloat, is_signed, PRECISE, value);
+        value = SignedOperation(node_pool, OperationCode::ICastFloat, is_signed, PRECISE, value);
         value = ConvertIntegerSize(value, instr.conversion.dst_size, is_signed);
 
         SetRegister(bb, instr.gpr0, value);
@@ -43,14 +43,14 @@ u32 ShaderIR::DecodeFfma(NodeBlock& bb, u32 pc) {
             return {GetImmediate19(instr), GetRegister(instr.gpr39)};
         default:
             UNIMPLEMENTED_MSG("Unhandled FFMA instruction: {}", opcode->get().GetName());
-            return {Immediate(0), Immediate(0)};
+            return {Immediate(node_pool, 0), Immediate(node_pool, 0)};
         }
     }();
 
     op_b = GetOperandAbsNegFloat(op_b, false, instr.ffma.negate_b);
     op_c = GetOperandAbsNegFloat(op_c, false, instr.ffma.negate_c);
 
-    Node value = Operation(OperationCode::FFma, PRECISE, op_a, op_b, op_c);
+    Node value = Operation(node_pool, OperationCode::FFma, PRECISE, op_a, op_b, op_c);
     value = GetSaturatedFloat(value, instr.alu.saturate_d);
 
     SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
@@ -38,12 +38,12 @@ u32 ShaderIR::DecodeFloatSet(NodeBlock& bb, u32 pc) {
     const OperationCode combiner = GetPredicateCombiner(instr.fset.op);
     const Node first_pred = GetPredicateComparisonFloat(instr.fset.cond, op_a, op_b);
 
-    const Node predicate = Operation(combiner, first_pred, second_pred);
+    const Node predicate = Operation(node_pool, combiner, first_pred, second_pred);
 
-    const Node true_value = instr.fset.bf ? Immediate(1.0f) : Immediate(-1);
-    const Node false_value = instr.fset.bf ? Immediate(0.0f) : Immediate(0);
+    const Node true_value = instr.fset.bf ? Immediate(node_pool, 1.0f) : Immediate(node_pool, -1);
+    const Node false_value = instr.fset.bf ? Immediate(node_pool, 0.0f) : Immediate(node_pool, 0);
     const Node value =
-        Operation(OperationCode::Select, PRECISE, predicate, true_value, false_value);
+        Operation(node_pool, OperationCode::Select, PRECISE, predicate, true_value, false_value);
 
     if (instr.fset.bf) {
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
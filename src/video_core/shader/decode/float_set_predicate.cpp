@@ -38,7 +38,7 @@ u32 ShaderIR::DecodeFloatSetPredicate(NodeBlock& bb, u32 pc) {
     const Node second_pred = GetPredicate(instr.fsetp.pred39, instr.fsetp.neg_pred != 0);
 
     const OperationCode combiner = GetPredicateCombiner(instr.fsetp.op);
-    const Node value = Operation(combiner, predicate, second_pred);
+    const Node value = Operation(node_pool, combiner, predicate, second_pred);
 
     // Set the primary predicate to the result of Predicate OP SecondPredicate
     SetPredicate(bb, instr.fsetp.pred3, value);
@@ -46,8 +46,8 @@ u32 ShaderIR::DecodeFloatSetPredicate(NodeBlock& bb, u32 pc) {
     if (instr.fsetp.pred0 != static_cast<u64>(Pred::UnusedIndex)) {
         // Set the secondary predicate to the result of !Predicate OP SecondPredicate,
         // if enabled
-        const Node negated_pred = Operation(OperationCode::LogicalNegate, predicate);
-        const Node second_value = Operation(combiner, negated_pred, second_pred);
+        const Node negated_pred = Operation(node_pool, OperationCode::LogicalNegate, predicate);
+        const Node second_value = Operation(node_pool, combiner, negated_pred, second_pred);
         SetPredicate(bb, instr.fsetp.pred0, second_value);
     }
 
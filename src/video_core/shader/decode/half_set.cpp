@@ -97,16 +97,17 @@ u32 ShaderIR::DecodeHalfSet(NodeBlock& bb, u32 pc) {
     std::array<Node, 2> values;
     for (u32 i = 0; i < 2; ++i) {
         const u32 raw_value = bf ? 0x3c00 : 0xffff;
-        Node true_value = Immediate(raw_value << (i * 16));
-        Node false_value = Immediate(0);
-
-        Node comparison = Operation(OperationCode::LogicalPick2, comparison_pair, Immediate(i));
-        Node predicate = Operation(combiner, comparison, second_pred);
-        values[i] =
-            Operation(OperationCode::Select, predicate, move(true_value), move(false_value));
+        Node true_value = Immediate(node_pool, raw_value << (i * 16));
+        Node false_value = Immediate(node_pool, 0);
+
+        Node comparison = Operation(node_pool, OperationCode::LogicalPick2, comparison_pair,
+                                    Immediate(node_pool, i));
+        Node predicate = Operation(node_pool, combiner, comparison, second_pred);
+        values[i] = Operation(node_pool, OperationCode::Select, predicate, move(true_value),
+                              move(false_value));
     }
 
-    Node value = Operation(OperationCode::UBitwiseOr, values[0], values[1]);
+    Node value = Operation(node_pool, OperationCode::UBitwiseOr, values[0], values[1]);
     SetRegister(bb, instr.gpr0, move(value));
 
     return pc;
@@ -52,26 +52,28 @@ u32 ShaderIR::DecodeHalfSetPredicate(NodeBlock& bb, u32 pc) {
         break;
     default:
         UNREACHABLE();
-        op_b = Immediate(0);
+        op_b = Immediate(node_pool, 0);
     }
 
     const OperationCode combiner = GetPredicateCombiner(instr.hsetp2.op);
     const Node combined_pred = GetPredicate(instr.hsetp2.pred39, instr.hsetp2.neg_pred);
 
     const auto Write = [&](u64 dest, Node src) {
-        SetPredicate(bb, dest, Operation(combiner, std::move(src), combined_pred));
+        SetPredicate(bb, dest, Operation(node_pool, combiner, std::move(src), combined_pred));
     };
 
     const Node comparison = GetPredicateComparisonHalf(cond, op_a, op_b);
     const u64 first = instr.hsetp2.pred3;
     const u64 second = instr.hsetp2.pred0;
     if (h_and) {
-        Node joined = Operation(OperationCode::LogicalAnd2, comparison);
+        Node joined = Operation(node_pool, OperationCode::LogicalAnd2, comparison);
         Write(first, joined);
-        Write(second, Operation(OperationCode::LogicalNegate, std::move(joined)));
+        Write(second, Operation(node_pool, OperationCode::LogicalNegate, std::move(joined)));
     } else {
-        Write(first, Operation(OperationCode::LogicalPick2, comparison, Immediate(0U)));
-        Write(second, Operation(OperationCode::LogicalPick2, comparison, Immediate(1U)));
+        Write(first, Operation(node_pool, OperationCode::LogicalPick2, comparison,
+                               Immediate(node_pool, 0U)));
+        Write(second, Operation(node_pool, OperationCode::LogicalPick2, comparison,
+                                Immediate(node_pool, 1U)));
     }
 
     return pc;
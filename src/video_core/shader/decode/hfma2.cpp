@@ -53,7 +53,7 @@ u32 ShaderIR::DecodeHfma2(NodeBlock& bb, u32 pc) {
             return {instr.hfma2.saturate, identity, UnpackHalfImmediate(instr, true),
                     instr.hfma2.type_reg39, GetRegister(instr.gpr39)};
         default:
-            return {false, identity, Immediate(0), identity, Immediate(0)};
+            return {false, identity, Immediate(node_pool, 0), identity, Immediate(node_pool, 0)};
         }
     }();
 
@@ -61,7 +61,7 @@ u32 ShaderIR::DecodeHfma2(NodeBlock& bb, u32 pc) {
     op_b = GetOperandAbsNegHalf(UnpackHalfFloat(op_b, type_b), false, neg_b);
     op_c = GetOperandAbsNegHalf(UnpackHalfFloat(op_c, type_c), false, neg_c);
 
-    Node value = Operation(OperationCode::HFma, PRECISE, op_a, op_b, op_c);
+    Node value = Operation(node_pool, OperationCode::HFma, PRECISE, op_a, op_b, op_c);
     value = GetSaturatedHalfFloat(value, saturate);
     value = HalfMerge(GetRegister(instr.gpr0), value, instr.hfma2.merge);
 
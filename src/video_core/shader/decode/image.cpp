@@ -288,25 +288,28 @@ std::pair<Node, bool> ShaderIR::GetComponentValue(ComponentType component_type,
     switch (component_type) {
     case ComponentType::SNORM: {
         // range [-1.0, 1.0]
-        auto cnv_value = Operation(OperationCode::FMul, original_value,
-                                   Immediate(static_cast<float>(1 << component_size) / 2.f - 1.f));
-        cnv_value = Operation(OperationCode::ICastFloat, std::move(cnv_value));
+        auto cnv_value = Operation(node_pool, OperationCode::FMul, original_value,
+                                   Immediate(node_pool,
+                                             static_cast<float>(1 << component_size) / 2.f - 1.f));
+        cnv_value = Operation(node_pool, OperationCode::ICastFloat, std::move(cnv_value));
         return {BitfieldExtract(std::move(cnv_value), 0, component_size), true};
     }
     case ComponentType::SINT:
     case ComponentType::UNORM: {
         bool is_signed = component_type == ComponentType::SINT;
         // range [0.0, 1.0]
-        auto cnv_value = Operation(OperationCode::FMul, original_value,
-                                   Immediate(static_cast<float>(1 << component_size) - 1.f));
-        return {SignedOperation(OperationCode::ICastFloat, is_signed, std::move(cnv_value)),
+        auto cnv_value =
+            Operation(node_pool, OperationCode::FMul, original_value,
+                      Immediate(node_pool, static_cast<float>(1 << component_size) - 1.f));
+        return {SignedOperation(node_pool, OperationCode::ICastFloat, is_signed,
+                                std::move(cnv_value)),
                 is_signed};
     }
     case ComponentType::UINT: // range [0, (1 << component_size) - 1]
         return {std::move(original_value), false};
     case ComponentType::FLOAT:
         if (component_size == 16) {
-            return {Operation(OperationCode::HCastFloat, original_value), true};
+            return {Operation(node_pool, OperationCode::HCastFloat, original_value), true};
         } else {
             return {std::move(original_value), true};
         }
@@ -347,7 +350,8 @@ u32 ShaderIR::DecodeImage(NodeBlock& bb, u32 pc) {
                     continue;
                 }
                 MetaImage meta{image, {}, element};
-                Node value = Operation(OperationCode::ImageLoad, meta, GetCoordinates(type));
+                Node value =
+                    Operation(node_pool, OperationCode::ImageLoad, meta, GetCoordinates(type));
                 SetTemporary(bb, indexer++, std::move(value));
             }
             for (u32 i = 0; i < indexer; ++i) {
@@ -383,7 +387,7 @@ u32 ShaderIR::DecodeImage(NodeBlock& bb, u32 pc) {
             case StoreType::Bits64: {
                 u32 indexer = 0;
                 u32 shifted_counter = 0;
-                Node value = Immediate(0);
+                Node value = Immediate(node_pool, 0);
                 for (u32 element = 0; element < 4; ++element) {
                     if (!IsComponentEnabled(comp_mask, element)) {
                         continue;
@@ -394,25 +398,26 @@ u32 ShaderIR::DecodeImage(NodeBlock& bb, u32 pc) {
 
                     auto [converted_value, is_signed] = GetComponentValue(
                         component_type, component_size,
-                        Operation(OperationCode::ImageLoad, meta, GetCoordinates(type)));
+                        Operation(node_pool, OperationCode::ImageLoad, meta, GetCoordinates(type)));
 
                     // shift element to correct position
                     const auto shifted = shifted_counter;
                     if (shifted > 0) {
-                        converted_value =
-                            SignedOperation(OperationCode::ILogicalShiftLeft, is_signed,
-                                            std::move(converted_value), Immediate(shifted));
+                        converted_value = SignedOperation(
+                            node_pool, OperationCode::ILogicalShiftLeft, is_signed,
+                            std::move(converted_value), Immediate(node_pool, shifted));
                     }
                     shifted_counter += component_size;
 
                     // add value into result
-                    value = Operation(OperationCode::UBitwiseOr, value, std::move(converted_value));
+                    value = Operation(node_pool, OperationCode::UBitwiseOr, value,
+                                      std::move(converted_value));
 
                     // if we shifted enough for 1 byte -> we save it into temp
                     if (shifted_counter >= 32) {
                         SetTemporary(bb, indexer++, std::move(value));
                         // reset counter and value to prepare pack next byte
-                        value = Immediate(0);
+                        value = Immediate(node_pool, 0);
                         shifted_counter = 0;
                     }
                 }
@@ -446,7 +451,7 @@ u32 ShaderIR::DecodeImage(NodeBlock& bb, u32 pc) {
         image.MarkWrite();
 
         MetaImage meta{image, std::move(values)};
-        bb.push_back(Operation(OperationCode::ImageStore, meta, GetCoordinates(type)));
+        bb.push_back(Operation(node_pool, OperationCode::ImageStore, meta, GetCoordinates(type)));
         break;
     }
     case OpCode::Id::SUATOM: {
@@ -487,7 +492,8 @@ u32 ShaderIR::DecodeImage(NodeBlock& bb, u32 pc) {
         image.MarkAtomic();
 
         MetaImage meta{image, {std::move(value)}};
-        SetRegister(bb, instr.gpr0, Operation(operation_code, meta, GetCoordinates(type)));
+        SetRegister(bb, instr.gpr0,
+                    Operation(node_pool, operation_code, meta, GetCoordinates(type)));
         break;
     }
     default:
@@ -18,7 +18,7 @@ u32 ShaderIR::DecodeIntegerSet(NodeBlock& bb, u32 pc) {
     const Node op_a = GetRegister(instr.gpr8);
     const Node op_b = [&]() {
         if (instr.is_b_imm) {
-            return Immediate(instr.alu.GetSignedImm20_20());
+            return Immediate(node_pool, instr.alu.GetSignedImm20_20());
         } else if (instr.is_b_gpr) {
             return GetRegister(instr.gpr20);
         } else {
@@ -34,12 +34,12 @@ u32 ShaderIR::DecodeIntegerSet(NodeBlock& bb, u32 pc) {
 
     const OperationCode combiner = GetPredicateCombiner(instr.iset.op);
 
-    const Node predicate = Operation(combiner, first_pred, second_pred);
+    const Node predicate = Operation(node_pool, combiner, first_pred, second_pred);
 
-    const Node true_value = instr.iset.bf ? Immediate(1.0f) : Immediate(-1);
-    const Node false_value = instr.iset.bf ? Immediate(0.0f) : Immediate(0);
+    const Node true_value = instr.iset.bf ? Immediate(node_pool, 1.0f) : Immediate(node_pool, -1);
+    const Node false_value = instr.iset.bf ? Immediate(node_pool, 0.0f) : Immediate(node_pool, 0);
     const Node value =
-        Operation(OperationCode::Select, PRECISE, predicate, true_value, false_value);
+        Operation(node_pool, OperationCode::Select, PRECISE, predicate, true_value, false_value);
 
     SetRegister(bb, instr.gpr0, value);
 
@@ -21,7 +21,7 @@ u32 ShaderIR::DecodeIntegerSetPredicate(NodeBlock& bb, u32 pc) {
 
     const Node op_b = [&]() {
         if (instr.is_b_imm) {
-            return Immediate(instr.alu.GetSignedImm20_20());
+            return Immediate(node_pool, instr.alu.GetSignedImm20_20());
         } else if (instr.is_b_gpr) {
             return GetRegister(instr.gpr20);
         } else {
@@ -38,13 +38,14 @@ u32 ShaderIR::DecodeIntegerSetPredicate(NodeBlock& bb, u32 pc) {
 
     // Set the primary predicate to the result of Predicate OP SecondPredicate
     const OperationCode combiner = GetPredicateCombiner(instr.isetp.op);
-    const Node value = Operation(combiner, predicate, second_pred);
+    const Node value = Operation(node_pool, combiner, predicate, second_pred);
     SetPredicate(bb, instr.isetp.pred3, value);
 
     if (instr.isetp.pred0 != static_cast<u64>(Pred::UnusedIndex)) {
         // Set the secondary predicate to the result of !Predicate OP SecondPredicate, if enabled
-        const Node negated_pred = Operation(OperationCode::LogicalNegate, predicate);
-        SetPredicate(bb, instr.isetp.pred0, Operation(combiner, negated_pred, second_pred));
+        const Node negated_pred = Operation(node_pool, OperationCode::LogicalNegate, predicate);
+        SetPredicate(bb, instr.isetp.pred0,
+                     Operation(node_pool, combiner, negated_pred, second_pred));
     }
 
     return pc;
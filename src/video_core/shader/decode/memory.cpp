@@ -88,24 +88,27 @@ u32 GetMemorySize(Tegra::Shader::UniformType uniform_type) {
     }
 }
 
-Node ExtractUnaligned(Node value, Node address, u32 mask, u32 size) {
-    Node offset = Operation(OperationCode::UBitwiseAnd, address, Immediate(mask));
-    offset = Operation(OperationCode::ULogicalShiftLeft, move(offset), Immediate(3));
-    return Operation(OperationCode::UBitfieldExtract, move(value), move(offset), Immediate(size));
+Node ExtractUnaligned(NodePool& pool, Node value, Node address, u32 mask, u32 size) {
+    Node offset = Operation(pool, OperationCode::UBitwiseAnd, address, Immediate(pool, mask));
+    offset = Operation(pool, OperationCode::ULogicalShiftLeft, move(offset), Immediate(pool, 3));
+    return Operation(pool, OperationCode::UBitfieldExtract, move(value), move(offset),
+                     Immediate(pool, size));
 }
 
-Node InsertUnaligned(Node dest, Node value, Node address, u32 mask, u32 size) {
-    Node offset = Operation(OperationCode::UBitwiseAnd, move(address), Immediate(mask));
-    offset = Operation(OperationCode::ULogicalShiftLeft, move(offset), Immediate(3));
-    return Operation(OperationCode::UBitfieldInsert, move(dest), move(value), move(offset),
-                     Immediate(size));
+Node InsertUnaligned(NodePool& pool, Node dest, Node value, Node address, u32 mask, u32 size) {
+    Node offset = Operation(pool, OperationCode::UBitwiseAnd, move(address), Immediate(pool, mask));
+    offset = Operation(pool, OperationCode::ULogicalShiftLeft, move(offset), Immediate(pool, 3));
+    return Operation(pool, OperationCode::UBitfieldInsert, move(dest), move(value), move(offset),
+                     Immediate(pool, size));
 }
 
-Node Sign16Extend(Node value) {
-    Node sign = Operation(OperationCode::UBitwiseAnd, value, Immediate(1U << 15));
-    Node is_sign = Operation(OperationCode::LogicalUEqual, move(sign), Immediate(1U << 15));
-    Node extend = Operation(OperationCode::Select, is_sign, Immediate(0xFFFF0000), Immediate(0));
-    return Operation(OperationCode::UBitwiseOr, move(value), move(extend));
+Node Sign16Extend(NodePool& pool, Node value) {
+    Node sign = Operation(pool, OperationCode::UBitwiseAnd, value, Immediate(pool, 1U << 15));
+    Node is_sign =
+        Operation(pool, OperationCode::LogicalUEqual, move(sign), Immediate(pool, 1U << 15));
+    Node extend = Operation(pool, OperationCode::Select, is_sign, Immediate(pool, 0xFFFF0000),
+                            Immediate(pool, 0));
+    return Operation(pool, OperationCode::UBitwiseOr, move(value), move(extend));
 }
 
 } // Anonymous namespace
@@ -185,8 +188,10 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
     case OpCode::Id::LD_S: {
         const auto GetAddress = [&](s32 offset) {
             ASSERT(offset % 4 == 0);
-            const Node immediate_offset = Immediate(static_cast<s32>(instr.smem_imm) + offset);
-            return Operation(OperationCode::IAdd, GetRegister(instr.gpr8), immediate_offset);
+            const Node immediate_offset =
+                Immediate(node_pool, static_cast<s32>(instr.smem_imm) + offset);
+            return Operation(node_pool, OperationCode::IAdd, GetRegister(instr.gpr8),
+                             immediate_offset);
         };
         const auto GetMemory = [&](s32 offset) {
             return opcode->get().GetId() == OpCode::Id::LD_S ? GetSharedMemory(GetAddress(offset))
@@ -196,7 +201,8 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
         switch (instr.ldst_sl.type.Value()) {
         case StoreType::Signed16:
             SetRegister(bb, instr.gpr0,
-                        Sign16Extend(ExtractUnaligned(GetMemory(0), GetAddress(0), 0b10, 16)));
+                        Sign16Extend(node_pool, ExtractUnaligned(node_pool, GetMemory(0),
+                                                                 GetAddress(0), 0b10, 16)));
             break;
         case StoreType::Bits32:
         case StoreType::Bits64:
@@ -251,20 +257,22 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
         if (!real_address_base || !base_address) {
             // Tracking failed, load zeroes.
             for (u32 i = 0; i < count; ++i) {
-                SetRegister(bb, instr.gpr0.Value() + i, Immediate(0.0f));
+                SetRegister(bb, instr.gpr0.Value() + i, Immediate(node_pool, 0.0f));
             }
             break;
         }
 
         for (u32 i = 0; i < count; ++i) {
-            const Node it_offset = Immediate(i * 4);
-            const Node real_address = Operation(OperationCode::UAdd, real_address_base, it_offset);
-            Node gmem = MakeNode<GmemNode>(real_address, base_address, descriptor);
+            const Node it_offset = Immediate(node_pool, i * 4);
+            const Node real_address =
+                Operation(node_pool, OperationCode::UAdd, real_address_base, it_offset);
+            Node gmem = MakeNode<GmemNode>(node_pool, real_address, base_address, descriptor);
 
             // To handle unaligned loads get the bytes used to dereference global memory and extract
             // those bytes from the loaded u32.
             if (IsUnaligned(type)) {
-                gmem = ExtractUnaligned(gmem, real_address, GetUnalignedMask(type), size);
+                gmem =
+                    ExtractUnaligned(node_pool, gmem, real_address, GetUnalignedMask(type), size);
             }
 
             SetTemporary(bb, i, gmem);
@@ -289,14 +297,14 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
             Node dest;
             if (instr.attribute.fmt20.patch) {
                 const u32 offset = static_cast<u32>(index) * 4 + static_cast<u32>(element);
-                dest = MakeNode<PatchNode>(offset);
+                dest = MakeNode<PatchNode>(node_pool, offset);
             } else {
                 dest = GetOutputAttribute(static_cast<Attribute::Index>(index), element,
                                           GetRegister(instr.gpr39));
             }
             const auto src = GetRegister(instr.gpr0.Value() + reg_offset);
 
-            bb.push_back(Operation(OperationCode::Assign, dest, src));
+            bb.push_back(Operation(node_pool, OperationCode::Assign, dest, src));
 
             // Load the next attribute element into the following register. If the element to load
             // goes beyond the vec4 size, load the first element of the next attribute.
@@ -311,8 +319,9 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
     case OpCode::Id::ST_S: {
         const auto GetAddress = [&](s32 offset) {
             ASSERT(offset % 4 == 0);
-            const Node immediate = Immediate(static_cast<s32>(instr.smem_imm) + offset);
-            return Operation(OperationCode::IAdd, NO_PRECISE, GetRegister(instr.gpr8), immediate);
+            const Node immediate = Immediate(node_pool, static_cast<s32>(instr.smem_imm) + offset);
+            return Operation(node_pool, OperationCode::IAdd, NO_PRECISE, GetRegister(instr.gpr8),
+                             immediate);
         };
 
         const bool is_local = opcode->get().GetId() == OpCode::Id::ST_L;
@@ -334,8 +343,9 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
         case StoreType::Signed16: {
             Node address = GetAddress(0);
             Node memory = (this->*get_memory)(address);
-            (this->*set_memory)(
-                bb, address, InsertUnaligned(memory, GetRegister(instr.gpr0), address, 0b10, 16));
+            (this->*set_memory)(bb, address,
+                                InsertUnaligned(node_pool, memory, GetRegister(instr.gpr0), address,
+                                                0b10, 16));
             break;
         }
         default:
@@ -371,17 +381,18 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
         const u32 size = GetMemorySize(type);
         const u32 count = Common::AlignUp(size, 32) / 32;
         for (u32 i = 0; i < count; ++i) {
-            const Node it_offset = Immediate(i * 4);
-            const Node real_address = Operation(OperationCode::UAdd, real_address_base, it_offset);
-            const Node gmem = MakeNode<GmemNode>(real_address, base_address, descriptor);
+            const Node it_offset = Immediate(node_pool, i * 4);
+            const Node real_address =
+                Operation(node_pool, OperationCode::UAdd, real_address_base, it_offset);
+            const Node gmem = MakeNode<GmemNode>(node_pool, real_address, base_address, descriptor);
             Node value = GetRegister(instr.gpr0.Value() + i);
 
             if (IsUnaligned(type)) {
                 const u32 mask = GetUnalignedMask(type);
-                value = InsertUnaligned(gmem, move(value), real_address, mask, size);
+                value = InsertUnaligned(node_pool, gmem, move(value), real_address, mask, size);
             }
 
-            bb.push_back(Operation(OperationCode::Assign, gmem, value));
+            bb.push_back(Operation(node_pool, OperationCode::Assign, gmem, value));
         }
         break;
     }
@@ -394,9 +405,10 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
             // Tracking failed, skip atomic.
             break;
         }
-        Node gmem = MakeNode<GmemNode>(real_address, base_address, descriptor);
+        Node gmem = MakeNode<GmemNode>(node_pool, real_address, base_address, descriptor);
         Node value = GetRegister(instr.gpr0);
-        bb.push_back(Operation(GetAtomOperation(instr.red.operation), move(gmem), move(value)));
+        bb.push_back(Operation(node_pool, GetAtomOperation(instr.red.operation), move(gmem),
+                               move(value)));
         break;
     }
     case OpCode::Id::ATOM: {
@@ -419,10 +431,10 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
 
         const bool is_signed =
             instr.atom.type == GlobalAtomicType::S32 || instr.atom.type == GlobalAtomicType::S64;
-        Node gmem = MakeNode<GmemNode>(real_address, base_address, descriptor);
+        Node gmem = MakeNode<GmemNode>(node_pool, real_address, base_address, descriptor);
         SetRegister(bb, instr.gpr0,
-                    SignedOperation(GetAtomOperation(instr.atom.operation), is_signed, gmem,
-                                    GetRegister(instr.gpr20)));
+                    SignedOperation(node_pool, GetAtomOperation(instr.atom.operation), is_signed,
+                                    gmem, GetRegister(instr.gpr20)));
         break;
     }
     case OpCode::Id::ATOMS: {
@@ -436,9 +448,10 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
             instr.atoms.type == AtomicType::S32 || instr.atoms.type == AtomicType::S64;
         const s32 offset = instr.atoms.GetImmediateOffset();
         Node address = GetRegister(instr.gpr8);
-        address = Operation(OperationCode::IAdd, move(address), Immediate(offset));
+        address =
+            Operation(node_pool, OperationCode::IAdd, move(address), Immediate(node_pool, offset));
         SetRegister(bb, instr.gpr0,
-                    SignedOperation(GetAtomOperation(instr.atoms.operation), is_signed,
+                    SignedOperation(node_pool, GetAtomOperation(instr.atoms.operation), is_signed,
                                     GetSharedMemory(move(address)), GetRegister(instr.gpr20)));
         break;
     }
@@ -446,9 +459,10 @@ u32 ShaderIR::DecodeMemory(NodeBlock& bb, u32 pc) {
         // Ignore al2p.direction since we don't care about it.
 
         // Calculate emulation fake physical address.
-        const Node fixed_address{Immediate(static_cast<u32>(instr.al2p.address))};
+        const Node fixed_address{Immediate(node_pool, static_cast<u32>(instr.al2p.address))};
         const Node reg{GetRegister(instr.gpr8)};
-        const Node fake_address{Operation(OperationCode::IAdd, NO_PRECISE, reg, fixed_address)};
+        const Node fake_address{
+            Operation(node_pool, OperationCode::IAdd, NO_PRECISE, reg, fixed_address)};
 
         // Set the fake address to target register.
         SetRegister(bb, instr.gpr0, fake_address);
@@ -476,7 +490,8 @@ std::tuple<Node, Node, GlobalMemoryBase> ShaderIR::TrackGlobalMemory(NodeBlock&
         base_address != nullptr, { return std::make_tuple(nullptr, nullptr, GlobalMemoryBase{}); },
         "Global memory tracking failed");
 
-    bb.push_back(Comment(fmt::format("Base address is c[0x{:x}][0x{:x}]", index, offset)));
+    bb.push_back(
+        Comment(node_pool, fmt::format("Base address is c[0x{:x}][0x{:x}]", index, offset)));
 
     const GlobalMemoryBase descriptor{index, offset};
     const auto& entry = used_global_memory.try_emplace(descriptor).first;
@@ -484,8 +499,8 @@ std::tuple<Node, Node, GlobalMemoryBase> ShaderIR::TrackGlobalMemory(NodeBlock&
     usage.is_written |= is_write;
     usage.is_read |= is_read;
 
-    const auto real_address =
-        Operation(OperationCode::UAdd, NO_PRECISE, Immediate(immediate_offset), addr_register);
+    const auto real_address = Operation(node_pool, OperationCode::UAdd, NO_PRECISE,
+                                        Immediate(node_pool, immediate_offset), addr_register);
 
     return {real_address, base_address, descriptor};
 }
@@ -39,7 +39,7 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
 
         switch (instr.flow.cond) {
         case Tegra::Shader::FlowCondition::Always:
-            bb.push_back(Operation(OperationCode::Exit));
+            bb.push_back(Operation(node_pool, OperationCode::Exit));
             if (instr.pred.pred_index == static_cast<u64>(Pred::UnusedIndex)) {
                 // If this is an unconditional exit then just end processing here,
                 // otherwise we have to account for the possibility of the condition
@@ -65,47 +65,50 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
         const ConditionCode cc = instr.flow_condition_code;
         UNIMPLEMENTED_IF_MSG(cc != ConditionCode::T, "KIL condition code used: {}", cc);
 
-        bb.push_back(Operation(OperationCode::Discard));
+        bb.push_back(Operation(node_pool, OperationCode::Discard));
         break;
     }
     case OpCode::Id::S2R: {
         const Node value = [this, instr] {
             switch (instr.sys20) {
             case SystemVariable::LaneId:
-                return Operation(OperationCode::ThreadId);
+                return Operation(node_pool, OperationCode::ThreadId);
             case SystemVariable::InvocationId:
-                return Operation(OperationCode::InvocationId);
+                return Operation(node_pool, OperationCode::InvocationId);
             case SystemVariable::Ydirection:
                 uses_y_negate = true;
-                return Operation(OperationCode::YNegate);
+                return Operation(node_pool, OperationCode::YNegate);
             case SystemVariable::InvocationInfo:
                 LOG_WARNING(HW_GPU, "S2R instruction with InvocationInfo is incomplete");
-                return Immediate(0x00ff'0000U);
+                return Immediate(node_pool, 0x00ff'0000U);
             case SystemVariable::WscaleFactorXY:
                 UNIMPLEMENTED_MSG("S2R WscaleFactorXY is not implemented");
-                return Immediate(0U);
+                return Immediate(node_pool, 0U);
             case SystemVariable::WscaleFactorZ:
                 UNIMPLEMENTED_MSG("S2R WscaleFactorZ is not implemented");
-                return Immediate(0U);
+                return Immediate(node_pool, 0U);
             case SystemVariable::Tid: {
-                Node val = Immediate(0);
-                val = BitfieldInsert(val, Operation(OperationCode::LocalInvocationIdX), 0, 9);
-                val = BitfieldInsert(val, Operation(OperationCode::LocalInvocationIdY), 16, 9);
-                val = BitfieldInsert(val, Operation(OperationCode::LocalInvocationIdZ), 26, 5);
+                Node val = Immediate(node_pool, 0);
+                val = BitfieldInsert(val, Operation(node_pool, OperationCode::LocalInvocationIdX),
+                                     0, 9);
+                val = BitfieldInsert(val, Operation(node_pool, OperationCode::LocalInvocationIdY),
+                                     16, 9);
+                val = BitfieldInsert(val, Operation(node_pool, OperationCode::LocalInvocationIdZ),
+                                     26, 5);
                 return val;
             }
             case SystemVariable::TidX:
-                return Operation(OperationCode::LocalInvocationIdX);
+                return Operation(node_pool, OperationCode::LocalInvocationIdX);
             case SystemVariable::TidY:
-                return Operation(OperationCode::LocalInvocationIdY);
+                return Operation(node_pool, OperationCode::LocalInvocationIdY);
             case SystemVariable::TidZ:
-                return Operation(OperationCode::LocalInvocationIdZ);
+                return Operation(node_pool, OperationCode::LocalInvocationIdZ);
             case SystemVariable::CtaIdX:
-                return Operation(OperationCode::WorkGroupIdX);
+                return Operation(node_pool, OperationCode::WorkGroupIdX);
             case SystemVariable::CtaIdY:
-                return Operation(OperationCode::WorkGroupIdY);
+                return Operation(node_pool, OperationCode::WorkGroupIdY);
             case SystemVariable::CtaIdZ:
-                return Operation(OperationCode::WorkGroupIdZ);
+                return Operation(node_pool, OperationCode::WorkGroupIdZ);
             case SystemVariable::EqMask:
             case SystemVariable::LtMask:
             case SystemVariable::LeMask:
@@ -114,22 +117,22 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
                 uses_warps = true;
                 switch (instr.sys20) {
                 case SystemVariable::EqMask:
-                    return Operation(OperationCode::ThreadEqMask);
+                    return Operation(node_pool, OperationCode::ThreadEqMask);
                 case SystemVariable::LtMask:
-                    return Operation(OperationCode::ThreadLtMask);
+                    return Operation(node_pool, OperationCode::ThreadLtMask);
                 case SystemVariable::LeMask:
-                    return Operation(OperationCode::ThreadLeMask);
+                    return Operation(node_pool, OperationCode::ThreadLeMask);
                 case SystemVariable::GtMask:
-                    return Operation(OperationCode::ThreadGtMask);
+                    return Operation(node_pool, OperationCode::ThreadGtMask);
                 case SystemVariable::GeMask:
-                    return Operation(OperationCode::ThreadGeMask);
+                    return Operation(node_pool, OperationCode::ThreadGeMask);
                 default:
                     UNREACHABLE();
-                    return Immediate(0u);
+                    return Immediate(node_pool, 0u);
                 }
             default:
                 UNIMPLEMENTED_MSG("Unhandled system move: {}", instr.sys20.Value());
-                return Immediate(0u);
+                return Immediate(node_pool, 0u);
             }
         }();
         SetRegister(bb, instr.gpr0, value);
@@ -140,20 +143,20 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
         Node branch;
         if (instr.bra.constant_buffer == 0) {
             const u32 target = pc + instr.bra.GetBranchTarget();
-            branch = Operation(OperationCode::Branch, Immediate(target));
+            branch = Operation(node_pool, OperationCode::Branch, Immediate(node_pool, target));
         } else {
             const u32 target = pc + 1;
             const Node op_a = GetConstBuffer(instr.cbuf36.index, instr.cbuf36.GetOffset());
-            const Node convert = SignedOperation(OperationCode::IArithmeticShiftRight, true,
-                                                 PRECISE, op_a, Immediate(3));
-            const Node operand =
-                Operation(OperationCode::IAdd, PRECISE, convert, Immediate(target));
-            branch = Operation(OperationCode::BranchIndirect, operand);
+            const Node convert = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight,
+                                                 true, PRECISE, op_a, Immediate(node_pool, 3));
+            const Node operand = Operation(node_pool, OperationCode::IAdd, PRECISE, convert,
+                                           Immediate(node_pool, target));
+            branch = Operation(node_pool, OperationCode::BranchIndirect, operand);
         }
 
         const Tegra::Shader::ConditionCode cc = instr.flow_condition_code;
         if (cc != Tegra::Shader::ConditionCode::T) {
-            bb.push_back(Conditional(GetConditionCode(cc), {branch}));
+            bb.push_back(Conditional(node_pool, GetConditionCode(cc), {branch}));
         } else {
             bb.push_back(branch);
         }
@@ -166,21 +169,23 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
             const Node index = GetRegister(instr.gpr8);
             const Node op_a =
                 GetConstBufferIndirect(instr.cbuf36.index, instr.cbuf36.GetOffset() + 0, index);
-            const Node convert = SignedOperation(OperationCode::IArithmeticShiftRight, true,
-                                                 PRECISE, op_a, Immediate(3));
-            operand = Operation(OperationCode::IAdd, PRECISE, convert, Immediate(target));
+            const Node convert = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight,
+                                                 true, PRECISE, op_a, Immediate(node_pool, 3));
+            operand = Operation(node_pool, OperationCode::IAdd, PRECISE, convert,
+                                Immediate(node_pool, target));
         } else {
             const s32 target = pc + instr.brx.GetBranchExtend();
             const Node op_a = GetRegister(instr.gpr8);
-            const Node convert = SignedOperation(OperationCode::IArithmeticShiftRight, true,
-                                                 PRECISE, op_a, Immediate(3));
-            operand = Operation(OperationCode::IAdd, PRECISE, convert, Immediate(target));
+            const Node convert = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight,
+                                                 true, PRECISE, op_a, Immediate(node_pool, 3));
+            operand = Operation(node_pool, OperationCode::IAdd, PRECISE, convert,
+                                Immediate(node_pool, target));
         }
-        const Node branch = Operation(OperationCode::BranchIndirect, operand);
+        const Node branch = Operation(node_pool, OperationCode::BranchIndirect, operand);
 
         const ConditionCode cc = instr.flow_condition_code;
         if (cc != ConditionCode::T) {
-            bb.push_back(Conditional(GetConditionCode(cc), {branch}));
+            bb.push_back(Conditional(node_pool, GetConditionCode(cc), {branch}));
         } else {
             bb.push_back(branch);
         }
@@ -196,8 +201,8 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
 
         // The SSY opcode tells the GPU where to re-converge divergent execution paths with SYNC.
         const u32 target = pc + instr.bra.GetBranchTarget();
-        bb.push_back(
-            Operation(OperationCode::PushFlowStack, MetaStackClass::Ssy, Immediate(target)));
+        bb.push_back(Operation(node_pool, OperationCode::PushFlowStack, MetaStackClass::Ssy,
+                               Immediate(node_pool, target)));
         break;
     }
     case OpCode::Id::PBK: {
@@ -210,8 +215,8 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
 
         // PBK pushes to a stack the address where BRK will jump to.
         const u32 target = pc + instr.bra.GetBranchTarget();
-        bb.push_back(
-            Operation(OperationCode::PushFlowStack, MetaStackClass::Pbk, Immediate(target)));
+        bb.push_back(Operation(node_pool, OperationCode::PushFlowStack, MetaStackClass::Pbk,
+                               Immediate(node_pool, target)));
         break;
     }
     case OpCode::Id::SYNC: {
@@ -223,7 +228,7 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
         }
 
         // The SYNC opcode jumps to the address previously set by the SSY opcode
-        bb.push_back(Operation(OperationCode::PopFlowStack, MetaStackClass::Ssy));
+        bb.push_back(Operation(node_pool, OperationCode::PopFlowStack, MetaStackClass::Ssy));
         break;
     }
     case OpCode::Id::BRK: {
@@ -234,7 +239,7 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
         }
 
         // The BRK opcode jumps to the address previously set by the PBK opcode
-        bb.push_back(Operation(OperationCode::PopFlowStack, MetaStackClass::Pbk));
+        bb.push_back(Operation(node_pool, OperationCode::PopFlowStack, MetaStackClass::Pbk));
         break;
     }
     case OpCode::Id::IPA: {
@@ -250,12 +255,13 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
             const u32 location = static_cast<u32>(index) - static_cast<u32>(Index::Attribute_0);
             if (header.ps.GetPixelImap(location) == PixelImap::Perspective) {
                 Node position_w = GetInputAttribute(Index::Position, 3);
-                value = Operation(OperationCode::FMul, move(value), move(position_w));
+                value = Operation(node_pool, OperationCode::FMul, move(value), move(position_w));
             }
         }
 
         if (instr.ipa.interp_mode == IpaInterpMode::Multiply) {
-            value = Operation(OperationCode::FMul, move(value), GetRegister(instr.gpr20));
+            value =
+                Operation(node_pool, OperationCode::FMul, move(value), GetRegister(instr.gpr20));
         }
 
         value = GetSaturatedFloat(move(value), instr.ipa.saturate);
@@ -270,11 +276,11 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
         if (instr.out.emit) {
             // gpr0 is used to store the next address and gpr8 contains the address to emit.
             // Hardware uses pointers here but we just ignore it
-            bb.push_back(Operation(OperationCode::EmitVertex));
-            SetRegister(bb, instr.gpr0, Immediate(0));
+            bb.push_back(Operation(node_pool, OperationCode::EmitVertex));
+            SetRegister(bb, instr.gpr0, Immediate(node_pool, 0));
         }
         if (instr.out.cut) {
-            bb.push_back(Operation(OperationCode::EndPrimitive));
+            bb.push_back(Operation(node_pool, OperationCode::EndPrimitive));
         }
         break;
     }
@@ -289,7 +295,7 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
     }
     case OpCode::Id::BAR: {
         UNIMPLEMENTED_IF_MSG(instr.value != 0xF0A81B8000070000ULL, "BAR is not BAR.SYNC 0x0");
-        bb.push_back(Operation(OperationCode::Barrier));
+        bb.push_back(Operation(node_pool, OperationCode::Barrier));
         break;
     }
     case OpCode::Id::MEMBAR: {
@@ -305,7 +311,7 @@ u32 ShaderIR::DecodeOther(NodeBlock& bb, u32 pc) {
                 return OperationCode::MemoryBarrierGlobal;
             }
         }();
-        bb.push_back(Operation(type));
+        bb.push_back(Operation(node_pool, type));
         break;
     }
     case OpCode::Id::DEPBAR: {
@@ -29,16 +29,17 @@ u32 ShaderIR::DecodePredicateSetPredicate(NodeBlock& bb, u32 pc) {
         const Node second_pred = GetPredicate(instr.psetp.pred39, instr.psetp.neg_pred39 != 0);
 
         const OperationCode combiner = GetPredicateCombiner(instr.psetp.op);
-        const Node predicate = Operation(combiner, op_a, op_b);
+        const Node predicate = Operation(node_pool, combiner, op_a, op_b);
 
         // Set the primary predicate to the result of Predicate OP SecondPredicate
-        SetPredicate(bb, instr.psetp.pred3, Operation(combiner, predicate, second_pred));
+        SetPredicate(bb, instr.psetp.pred3, Operation(node_pool, combiner, predicate, second_pred));
 
         if (instr.psetp.pred0 != static_cast<u64>(Pred::UnusedIndex)) {
             // Set the secondary predicate to the result of !Predicate OP SecondPredicate, if
             // enabled
             SetPredicate(bb, instr.psetp.pred0,
-                         Operation(combiner, Operation(OperationCode::LogicalNegate, predicate),
+                         Operation(node_pool, combiner,
+                                   Operation(node_pool, OperationCode::LogicalNegate, predicate),
                                    second_pred));
         }
         break;
@@ -50,11 +51,12 @@ u32 ShaderIR::DecodePredicateSetPredicate(NodeBlock& bb, u32 pc) {
         const OperationCode combiner = GetPredicateCombiner(instr.csetp.op);
 
         if (instr.csetp.pred3 != static_cast<u64>(Pred::UnusedIndex)) {
-            SetPredicate(bb, instr.csetp.pred3, Operation(combiner, condition_code, pred));
+            SetPredicate(bb, instr.csetp.pred3,
+                         Operation(node_pool, combiner, condition_code, pred));
         }
         if (instr.csetp.pred0 != static_cast<u64>(Pred::UnusedIndex)) {
-            const Node neg_cc = Operation(OperationCode::LogicalNegate, condition_code);
-            SetPredicate(bb, instr.csetp.pred0, Operation(combiner, neg_cc, pred));
+            const Node neg_cc = Operation(node_pool, OperationCode::LogicalNegate, condition_code);
+            SetPredicate(bb, instr.csetp.pred0, Operation(node_pool, combiner, neg_cc, pred));
         }
         break;
     }
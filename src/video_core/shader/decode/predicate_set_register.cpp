@@ -21,17 +21,18 @@ u32 ShaderIR::DecodePredicateSetRegister(NodeBlock& bb, u32 pc) {
 
     const Node op_a = GetPredicate(instr.pset.pred12, instr.pset.neg_pred12 != 0);
     const Node op_b = GetPredicate(instr.pset.pred29, instr.pset.neg_pred29 != 0);
-    const Node first_pred = Operation(GetPredicateCombiner(instr.pset.cond), op_a, op_b);
+    const Node first_pred = Operation(node_pool, GetPredicateCombiner(instr.pset.cond), op_a, op_b);
 
     const Node second_pred = GetPredicate(instr.pset.pred39, instr.pset.neg_pred39 != 0);
 
     const OperationCode combiner = GetPredicateCombiner(instr.pset.op);
-    const Node predicate = Operation(combiner, first_pred, second_pred);
+    const Node predicate = Operation(node_pool, combiner, first_pred, second_pred);
 
-    const Node true_value = instr.pset.bf ? Immediate(1.0f) : Immediate(0xffffffff);
-    const Node false_value = instr.pset.bf ? Immediate(0.0f) : Immediate(0);
+    const Node true_value =
+        instr.pset.bf ? Immediate(node_pool, 1.0f) : Immediate(node_pool, 0xffffffff);
+    const Node false_value = instr.pset.bf ? Immediate(node_pool, 0.0f) : Immediate(node_pool, 0);
     const Node value =
-        Operation(OperationCode::Select, PRECISE, predicate, true_value, false_value);
+        Operation(node_pool, OperationCode::Select, PRECISE, predicate, true_value, false_value);
 
     if (instr.pset.bf) {
         SetInternalFlagsFromFloat(bb, value, instr.generates_cc);
@@ -29,10 +29,10 @@ u32 ShaderIR::DecodeRegisterSetPredicate(NodeBlock& bb, u32 pc) {
         switch (opcode->get().GetId()) {
         case OpCode::Id::R2P_IMM:
         case OpCode::Id::P2R_IMM:
-            return Immediate(static_cast<u32>(instr.p2r_r2p.immediate_mask));
+            return Immediate(node_pool, static_cast<u32>(instr.p2r_r2p.immediate_mask));
         default:
             UNREACHABLE();
-            return Immediate(0);
+            return Immediate(node_pool, 0);
         }
     }();
 
@@ -52,24 +52,27 @@ u32 ShaderIR::DecodeRegisterSetPredicate(NodeBlock& bb, u32 pc) {
             const u32 shift = static_cast<u32>(entry);
 
             Node apply = BitfieldExtract(apply_mask, shift, 1);
-            Node condition = Operation(OperationCode::LogicalUNotEqual, apply, Immediate(0));
+            Node condition = Operation(node_pool, OperationCode::LogicalUNotEqual, apply,
+                                       Immediate(node_pool, 0));
 
             Node compare = BitfieldExtract(mask, offset + shift, 1);
-            Node value = Operation(OperationCode::LogicalUNotEqual, move(compare), Immediate(0));
+            Node value = Operation(node_pool, OperationCode::LogicalUNotEqual, move(compare),
+                                   Immediate(node_pool, 0));
 
-            Node code = Operation(OperationCode::LogicalAssign, get_entry(entry), move(value));
-            bb.push_back(Conditional(condition, {move(code)}));
+            Node code =
+                Operation(node_pool, OperationCode::LogicalAssign, get_entry(entry), move(value));
+            bb.push_back(Conditional(node_pool, condition, {move(code)}));
         }
         break;
     }
     case OpCode::Id::P2R_IMM: {
-        Node value = Immediate(0);
+        Node value = Immediate(node_pool, 0);
         for (u64 entry = 0; entry < num_entries; ++entry) {
-            Node bit = Operation(OperationCode::Select, get_entry(entry), Immediate(1U << entry),
-                                 Immediate(0));
-            value = Operation(OperationCode::UBitwiseOr, move(value), move(bit));
+            Node bit = Operation(node_pool, OperationCode::Select, get_entry(entry),
+                                 Immediate(node_pool, 1U << entry), Immediate(node_pool, 0));
+            value = Operation(node_pool, OperationCode::UBitwiseOr, move(value), move(bit));
         }
-        value = Operation(OperationCode::UBitwiseAnd, move(value), apply_mask);
+        value = Operation(node_pool, OperationCode::UBitwiseAnd, move(value), apply_mask);
         value = BitfieldInsert(GetRegister(instr.gpr8), move(value), offset, 8);
 
         SetRegister(bb, instr.gpr0, move(value));
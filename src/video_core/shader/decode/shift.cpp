@@ -18,68 +18,71 @@ using Tegra::Shader::ShfXmode;
 
 namespace {
 
-Node IsFull(Node shift) {
-    return Operation(OperationCode::LogicalIEqual, move(shift), Immediate(32));
+Node IsFull(NodePool& pool, Node shift) {
+    return Operation(pool, OperationCode::LogicalIEqual, move(shift), Immediate(pool, 32));
 }
 
-Node Shift(OperationCode opcode, Node value, Node shift) {
-    Node shifted = Operation(opcode, move(value), shift);
-    return Operation(OperationCode::Select, IsFull(move(shift)), Immediate(0), move(shifted));
+Node Shift(NodePool& pool, OperationCode opcode, Node value, Node shift) {
+    Node shifted = Operation(pool, opcode, move(value), shift);
+    return Operation(pool, OperationCode::Select, IsFull(pool, move(shift)), Immediate(pool, 0),
+                     move(shifted));
 }
 
-Node ClampShift(Node shift, s32 size = 32) {
-    shift = Operation(OperationCode::IMax, move(shift), Immediate(0));
-    return Operation(OperationCode::IMin, move(shift), Immediate(size));
+Node ClampShift(NodePool& pool, Node shift, s32 size = 32) {
+    shift = Operation(pool, OperationCode::IMax, move(shift), Immediate(pool, 0));
+    return Operation(pool, OperationCode::IMin, move(shift), Immediate(pool, size));
 }
 
-Node WrapShift(Node shift, s32 size = 32) {
-    return Operation(OperationCode::UBitwiseAnd, move(shift), Immediate(size - 1));
+Node WrapShift(NodePool& pool, Node shift, s32 size = 32) {
+    return Operation(pool, OperationCode::UBitwiseAnd, move(shift), Immediate(pool, size - 1));
 }
 
-Node ShiftRight(Node low, Node high, Node shift, Node low_shift, ShfType type) {
+Node ShiftRight(NodePool& pool, Node low, Node high, Node shift, Node low_shift, ShfType type) {
     // These values are used when the shift value is less than 32
-    Node less_low = Shift(OperationCode::ILogicalShiftRight, low, shift);
-    Node less_high = Shift(OperationCode::ILogicalShiftLeft, high, low_shift);
-    Node less = Operation(OperationCode::IBitwiseOr, move(less_high), move(less_low));
+    Node less_low = Shift(pool, OperationCode::ILogicalShiftRight, low, shift);
+    Node less_high = Shift(pool, OperationCode::ILogicalShiftLeft, high, low_shift);
+    Node less = Operation(pool, OperationCode::IBitwiseOr, move(less_high), move(less_low));
 
     if (type == ShfType::Bits32) {
         // On 32 bit shifts we are either full (shifting 32) or shifting less than 32 bits
-        return Operation(OperationCode::Select, IsFull(move(shift)), move(high), move(less));
+        return Operation(pool, OperationCode::Select, IsFull(pool, move(shift)), move(high),
+                         move(less));
     }
 
     // And these when it's larger than or 32
     const bool is_signed = type == ShfType::S64;
     const auto opcode = SignedToUnsignedCode(OperationCode::IArithmeticShiftRight, is_signed);
-    Node reduced = Operation(OperationCode::IAdd, shift, Immediate(-32));
-    Node greater = Shift(opcode, high, move(reduced));
+    Node reduced = Operation(pool, OperationCode::IAdd, shift, Immediate(pool, -32));
+    Node greater = Shift(pool, opcode, high, move(reduced));
 
-    Node is_less = Operation(OperationCode::LogicalILessThan, shift, Immediate(32));
-    Node is_zero = Operation(OperationCode::LogicalIEqual, move(shift), Immediate(0));
+    Node is_less = Operation(pool, OperationCode::LogicalILessThan, shift, Immediate(pool, 32));
+    Node is_zero = Operation(pool, OperationCode::LogicalIEqual, move(shift), Immediate(pool, 0));
 
-    Node value = Operation(OperationCode::Select, move(is_less), move(less), move(greater));
-    return Operation(OperationCode::Select, move(is_zero), move(high), move(value));
+    Node value = Operation(pool, OperationCode::Select, move(is_less), move(less), move(greater));
+    return Operation(pool, OperationCode::Select, move(is_zero), move(high), move(value));
 }
 
-Node ShiftLeft(Node low, Node high, Node shift, Node low_shift, ShfType type) {
+Node ShiftLeft(NodePool& pool, Node low, Node high, Node shift, Node low_shift, ShfType type) {
     // These values are used when the shift value is less than 32
-    Node less_low = Operation(OperationCode::ILogicalShiftRight, low, low_shift);
-    Node less_high = Operation(OperationCode::ILogicalShiftLeft, high, shift);
-    Node less = Operation(OperationCode::IBitwiseOr, move(less_low), move(less_high));
+    Node less_low = Operation(pool, OperationCode::ILogicalShiftRight, low, low_shift);
+    Node less_high = Operation(pool, OperationCode::ILogicalShiftLeft, high, shift);
+    Node less = Operation(pool, OperationCode::IBitwiseOr, move(less_low), move(less_high));
 
     if (type == ShfType::Bits32) {
         // On 32 bit shifts we are either full (shifting 32) or shifting less than 32 bits
-        return Operation(OperationCode::Select, IsFull(move(shift)), move(low), move(less));
+        return Operation(pool, OperationCode::Select, IsFull(pool, move(shift)), move(low),
+                         move(less));
     }
 
     // And these when it's larger than or 32
-    Node reduced = Operation(OperationCode::IAdd, shift, Immediate(-32));
-    Node greater = Shift(OperationCode::ILogicalShiftLeft, move(low), move(reduced));
+    Node reduced = Operation(pool, OperationCode::IAdd, shift, Immediate(pool, -32));
+    Node greater = Shift(pool, OperationCode::ILogicalShiftLeft, move(low), move(reduced));
 
-    Node is_less = Operation(OperationCode::LogicalILessThan, shift, Immediate(32));
-    Node is_zero = Operation(OperationCode::LogicalIEqual, move(shift), Immediate(0));
+    Node is_less = Operation(pool, OperationCode::LogicalILessThan, shift, Immediate(pool, 32));
+    Node is_zero = Operation(pool, OperationCode::LogicalIEqual, move(shift), Immediate(pool, 0));
 
-    Node value = Operation(OperationCode::Select, move(is_less), move(less), move(greater));
-    return Operation(OperationCode::Select, move(is_zero), move(high), move(value));
+    Node value = Operation(pool, OperationCode::Select, move(is_less), move(less), move(greater));
+    return Operation(pool, OperationCode::Select, move(is_zero), move(high), move(value));
 }
 
 } // Anonymous namespace
@@ -91,7 +94,7 @@ u32 ShaderIR::DecodeShift(NodeBlock& bb, u32 pc) {
     Node op_a = GetRegister(instr.gpr8);
     Node op_b = [this, instr] {
         if (instr.is_b_imm) {
-            return Immediate(instr.alu.GetSignedImm20_20());
+            return Immediate(node_pool, instr.alu.GetSignedImm20_20());
         } else if (instr.is_b_gpr) {
             return GetRegister(instr.gpr20);
         } else {
@@ -103,10 +106,11 @@ u32 ShaderIR::DecodeShift(NodeBlock& bb, u32 pc) {
     case OpCode::Id::SHR_C:
     case OpCode::Id::SHR_R:
     case OpCode::Id::SHR_IMM: {
-        op_b = instr.shr.wrap ? WrapShift(move(op_b)) : ClampShift(move(op_b));
+        op_b = instr.shr.wrap ? WrapShift(node_pool, move(op_b))
+                              : ClampShift(node_pool, move(op_b));
 
-        Node value = SignedOperation(OperationCode::IArithmeticShiftRight, instr.shift.is_signed,
-                                     move(op_a), move(op_b));
+        Node value = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight,
+                                     instr.shift.is_signed, move(op_a), move(op_b));
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
         SetRegister(bb, instr.gpr0, move(value));
         break;
@@ -114,7 +118,7 @@ u32 ShaderIR::DecodeShift(NodeBlock& bb, u32 pc) {
     case OpCode::Id::SHL_C:
     case OpCode::Id::SHL_R:
     case OpCode::Id::SHL_IMM: {
-        Node value = Operation(OperationCode::ILogicalShiftLeft, op_a, op_b);
+        Node value = Operation(node_pool, OperationCode::ILogicalShiftLeft, op_a, op_b);
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
         SetRegister(bb, instr.gpr0, move(value));
         break;
@@ -128,17 +132,20 @@ u32 ShaderIR::DecodeShift(NodeBlock& bb, u32 pc) {
                              instr.shf.xmode.Value());
 
         if (instr.is_b_imm) {
-            op_b = Immediate(static_cast<u32>(instr.shf.immediate));
+            op_b = Immediate(node_pool, static_cast<u32>(instr.shf.immediate));
         }
         const s32 size = instr.shf.type == ShfType::Bits32 ? 32 : 64;
-        Node shift = instr.shf.wrap ? WrapShift(move(op_b), size) : ClampShift(move(op_b), size);
+        Node shift = instr.shf.wrap ? WrapShift(node_pool, move(op_b), size)
+                                    : ClampShift(node_pool, move(op_b), size);
 
-        Node negated_shift = Operation(OperationCode::INegate, shift);
-        Node low_shift = Operation(OperationCode::IAdd, move(negated_shift), Immediate(32));
+        Node negated_shift = Operation(node_pool, OperationCode::INegate, shift);
+        Node low_shift = Operation(node_pool, OperationCode::IAdd, move(negated_shift),
+                                   Immediate(node_pool, 32));
 
         const bool is_right = opid == OpCode::Id::SHF_RIGHT_R || opid == OpCode::Id::SHF_RIGHT_IMM;
-        Node value = (is_right ? ShiftRight : ShiftLeft)(
-            move(op_a), GetRegister(instr.gpr39), move(shift), move(low_shift), instr.shf.type);
+        Node value = (is_right ? ShiftRight : ShiftLeft)(node_pool, move(op_a),
+                                                          GetRegister(instr.gpr39), move(shift),
+                                                          move(low_shift), instr.shf.type);
 
         SetRegister(bb, instr.gpr0, move(value));
         break;
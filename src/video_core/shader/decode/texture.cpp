@@ -137,7 +137,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                 coords.push_back(op_b);
             }
         }
-        const Node component = Immediate(static_cast<u32>(instr.tld4s.component));
+        const Node component = Immediate(node_pool, static_cast<u32>(instr.tld4s.component));
 
         SamplerInfo info;
         info.is_shadow = is_depth_compare;
@@ -147,7 +147,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
         for (u32 element = 0; element < values.size(); ++element) {
             MetaTexture meta{*sampler, {}, depth_compare, aoffi,   {}, {},
                              {},       {}, component,     element, {}};
-            values[element] = Operation(OperationCode::TextureGather, meta, coords);
+            values[element] = Operation(node_pool, OperationCode::TextureGather, meta, coords);
         }
 
         if (instr.tld4s.fp16_flag) {
@@ -178,7 +178,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                         : GetSampler(instr.sampler, info);
         Node4 values;
         if (!sampler) {
-            std::generate(values.begin(), values.end(), [this] { return Immediate(0); });
+            std::generate(values.begin(), values.end(), [this] { return Immediate(node_pool, 0); });
             WriteTexInstructionFloat(bb, instr, values);
             break;
         }
@@ -205,7 +205,8 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
         for (u32 element = 0; element < values.size(); ++element) {
             MetaTexture meta{*sampler, array_node, {}, {},      {},       derivates,
                              {},       {},         {}, element, index_var};
-            values[element] = Operation(OperationCode::TextureGradient, std::move(meta), coords);
+            values[element] =
+                Operation(node_pool, OperationCode::TextureGradient, std::move(meta), coords);
         }
 
         WriteTexInstructionFloat(bb, instr, values);
@@ -227,7 +228,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                 if (!instr.txq.IsComponentEnabled(element)) {
                     continue;
                 }
-                const Node value = Immediate(0);
+                const Node value = Immediate(node_pool, 0);
                 SetTemporary(bb, indexer++, value);
             }
             for (u32 i = 0; i < indexer; ++i) {
@@ -245,7 +246,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                 }
                 MetaTexture meta{*sampler, {}, {}, {}, {}, {}, {}, {}, {}, element, index_var};
                 const Node value =
-                    Operation(OperationCode::TextureQueryDimensions, meta,
+                    Operation(node_pool, OperationCode::TextureQueryDimensions, meta,
                               GetRegister(instr.gpr8.Value() + (is_bindless ? 1 : 0)));
                 SetTemporary(bb, indexer++, value);
             }
@@ -282,7 +283,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                 if (!instr.tmml.IsComponentEnabled(element)) {
                     continue;
                 }
-                const Node value = Immediate(0);
+                const Node value = Immediate(node_pool, 0);
                 SetTemporary(bb, indexer++, value);
             }
             for (u32 i = 0; i < indexer; ++i) {
@@ -319,7 +320,7 @@ u32 ShaderIR::DecodeTexture(NodeBlock& bb, u32 pc) {
                 continue;
             }
             MetaTexture meta{*sampler, {}, {}, {}, {}, {}, {}, {}, {}, element, index_var};
-            Node value = Operation(OperationCode::TextureQueryLod, meta, coords);
+            Node value = Operation(node_pool, OperationCode::TextureQueryLod, meta, coords);
             SetTemporary(bb, indexer++, std::move(value));
         }
         for (u32 i = 0; i < indexer; ++i) {
@@ -533,16 +534,17 @@ void ShaderIR::WriteTexsInstructionHalfFloat(NodeBlock& bb, Instruction instr,
     if (dest_elem == 0)
         return;
 
-    std::generate(values.begin() + dest_elem, values.end(), [&]() { return Immediate(0); });
+    std::generate(values.begin() + dest_elem, values.end(),
+                  [&]() { return Immediate(node_pool, 0); });
 
-    const Node first_value = Operation(OperationCode::HPack2, values[0], values[1]);
+    const Node first_value = Operation(node_pool, OperationCode::HPack2, values[0], values[1]);
     if (dest_elem <= 2) {
         SetRegister(bb, instr.gpr0, first_value);
         return;
     }
 
     SetTemporary(bb, 0, first_value);
-    SetTemporary(bb, 1, Operation(OperationCode::HPack2, values[2], values[3]));
+    SetTemporary(bb, 1, Operation(node_pool, OperationCode::HPack2, values[2], values[3]));
 
     SetRegister(bb, instr.gpr0, GetTemporary(0));
     SetRegister(bb, instr.gpr28, GetTemporary(1));
@@ -571,7 +573,8 @@ Node4 ShaderIR::GetTextureCode(Instruction instr, TextureType texture_type,
         is_bindless ? GetBindlessSampler(*bindless_reg, info, index_var)
                     : GetSampler(instr.sampler, info);
     if (!sampler) {
-        return {Immediate(0), Immediate(0), Immediate(0), Immediate(0)};
+        return {Immediate(node_pool, 0), Immediate(node_pool, 0), Immediate(node_pool, 0),
+                Immediate(node_pool, 0)};
     }
 
     const bool lod_needed = process_mode == TextureProcessMode::LZ ||
@@ -585,7 +588,7 @@ Node4 ShaderIR::GetTextureCode(Instruction instr, TextureType texture_type,
     case TextureProcessMode::None:
         break;
     case TextureProcessMode::LZ:
-        lod = Immediate(0.0f);
+        lod = Immediate(node_pool, 0.0f);
         break;
     case TextureProcessMode::LB:
         // If present, lod or bias are always stored in the register indexed by the gpr20 field with
@@ -604,7 +607,7 @@ Node4 ShaderIR::GetTextureCode(Instruction instr, TextureType texture_type,
     for (u32 element = 0; element < values.size(); ++element) {
         MetaTexture meta{*sampler, array, depth_compare, aoffi,    {}, {}, bias,
                          lod,      {},    element,       index_var};
-        values[element] = Operation(opcode, meta, coords);
+        values[element] = Operation(node_pool, opcode, meta, coords);
     }
 
     return values;
@@ -642,7 +645,7 @@ Node4 ShaderIR::GetTexCode(Instruction instr, TextureType texture_type,
     }
     // 1D.DC in OpenGL the 2nd component is ignored.
     if (depth_compare && !is_array && texture_type == TextureType::Texture1D) {
-        coords.push_back(Immediate(0.0f));
+        coords.push_back(Immediate(node_pool, 0.0f));
     }
 
     const Node array = is_array ? GetRegister(array_register) : nullptr;
@@ -732,7 +735,7 @@ Node4 ShaderIR::GetTld4Code(Instruction instr, TextureType texture_type, bool de
     Node4 values;
     if (!sampler) {
         for (u32 element = 0; element < values.size(); ++element) {
-            values[element] = Immediate(0);
+            values[element] = Immediate(node_pool, 0);
         }
         return values;
     }
@@ -750,15 +753,17 @@ Node4 ShaderIR::GetTld4Code(Instruction instr, TextureType texture_type, bool de
         dc = GetRegister(parameter_register++);
     }
 
-    const Node component = is_bindless ? Immediate(static_cast<u32>(instr.tld4_b.component))
-                                       : Immediate(static_cast<u32>(instr.tld4.component));
+    const Node component = is_bindless
+                               ? Immediate(node_pool, static_cast<u32>(instr.tld4_b.component))
+                               : Immediate(node_pool, static_cast<u32>(instr.tld4.component));
 
     for (u32 element = 0; element < values.size(); ++element) {
         auto coords_copy = coords;
         MetaTexture meta{
             *sampler, GetRegister(array_register), dc, aoffi, ptp, {}, {}, {}, component, element,
             index_var};
-        values[element] = Operation(OperationCode::TextureGather, meta, std::move(coords_copy));
+        values[element] =
+            Operation(node_pool, OperationCode::TextureGather, meta, std::move(coords_copy));
     }
 
     return values;
@@ -781,7 +786,7 @@ Node4 ShaderIR::GetTldCode(Tegra::Shader::Instruction instr) {
 
     u64 gpr20_cursor{instr.gpr20.Value()};
     // const Node bindless_register{is_bindless ? GetRegister(gpr20_cursor++) : nullptr};
-    const Node lod{lod_enabled ? GetRegister(gpr20_cursor++) : Immediate(0u)};
+    const Node lod{lod_enabled ? GetRegister(gpr20_cursor++) : Immediate(node_pool, 0u)};
     // const Node aoffi_register{is_aoffi ? GetRegister(gpr20_cursor++) : nullptr};
     // const Node multisample{is_multisample ? GetRegister(gpr20_cursor++) : nullptr};
 
@@ -791,7 +796,8 @@ Node4 ShaderIR::GetTldCode(Tegra::Shader::Instruction instr) {
     for (u32 element = 0; element < values.size(); ++element) {
         auto coords_copy = coords;
         MetaTexture meta{*sampler, array_register, {}, {}, {}, {}, {}, lod, {}, element, {}};
-        values[element] = Operation(OperationCode::TexelFetch, meta, std::move(coords_copy));
+        values[element] =
+            Operation(node_pool, OperationCode::TexelFetch, meta, std::move(coords_copy));
     }
 
     return values;
@@ -827,7 +833,7 @@ Node4 ShaderIR::GetTldsCode(Instruction instr, TextureType texture_type, bool is
 
     const Node array = is_array ? GetRegister(array_register) : nullptr;
     // When lod is used always is in gpr20
-    const Node lod = lod_enabled ? GetRegister(instr.gpr20) : Immediate(0);
+    const Node lod = lod_enabled ? GetRegister(instr.gpr20) : Immediate(node_pool, 0);
 
     std::vector<Node> aoffi;
     if (aoffi_enabled) {
@@ -838,7 +844,8 @@ Node4 ShaderIR::GetTldsCode(Instruction instr, TextureType texture_type, bool is
     for (u32 element = 0; element < values.size(); ++element) {
         auto coords_copy = coords;
         MetaTexture meta{*sampler, array, {}, aoffi, {}, {}, {}, lod, {}, element, {}};
-        values[element] = Operation(OperationCode::TexelFetch, meta, std::move(coords_copy));
+        values[element] =
+            Operation(node_pool, OperationCode::TexelFetch, meta, std::move(coords_copy));
     }
     return values;
 }
@@ -880,10 +887,12 @@ std::vector<Node> ShaderIR::GetAoffiCoordinates(Node aoffi_reg, std::size_t coor
                     "AOFFI constant folding failed, some hardware might have graphical issues");
         for (std::size_t coord = 0; coord < coord_count; ++coord) {
             const Node value = BitfieldExtract(aoffi_reg, coord_offsets[coord], size);
-            const Node condition =
-                Operation(OperationCode::LogicalIGreaterEqual, value, Immediate(wrap_value));
-            const Node negative = Operation(OperationCode::IAdd, value, Immediate(-diff_value));
-            aoffi.push_back(Operation(OperationCode::Select, condition, negative, value));
+            const Node condition = Operation(node_pool, OperationCode::LogicalIGreaterEqual, value,
+                                             Immediate(node_pool, wrap_value));
+            const Node negative =
+                Operation(node_pool, OperationCode::IAdd, value, Immediate(node_pool, -diff_value));
+            aoffi.push_back(Operation(node_pool, OperationCode::Select, condition, negative,
+                                      value));
         }
         return aoffi;
     }
@@ -893,7 +902,7 @@ std::vector<Node> ShaderIR::GetAoffiCoordinates(Node aoffi_reg, std::size_t coor
         if (value >= wrap_value) {
             value -= diff_value;
         }
-        aoffi.push_back(Immediate(value));
+        aoffi.push_back(Immediate(node_pool, value));
     }
     return aoffi;
 }
@@ -912,10 +921,11 @@ std::vector<Node> ShaderIR::GetPtpCoordinates(std::array<Node, 2> ptp_regs) {
             const u32 reg = entry / 4;
             const u32 offset = entry % 4;
             const Node value = BitfieldExtract(ptp_regs[reg], offset * 8, 6);
-            const Node condition =
-                Operation(OperationCode::LogicalIGreaterEqual, value, Immediate(32));
-            const Node negative = Operation(OperationCode::IAdd, value, Immediate(-64));
-            ptp.push_back(Operation(OperationCode::Select, condition, negative, value));
+            const Node condition = Operation(node_pool, OperationCode::LogicalIGreaterEqual, value,
+                                             Immediate(node_pool, 32));
+            const Node negative =
+                Operation(node_pool, OperationCode::IAdd, value, Immediate(node_pool, -64));
+            ptp.push_back(Operation(node_pool, OperationCode::Select, condition, negative, value));
         }
         return ptp;
     }
@@ -926,7 +936,7 @@ std::vector<Node> ShaderIR::GetPtpCoordinates(std::array<Node, 2> ptp_regs) {
         if (value >= 32) {
             value -= 64;
         }
-        ptp.push_back(Immediate(value));
+        ptp.push_back(Immediate(node_pool, value));
     }
 
     return ptp;
@@ -39,9 +39,9 @@ u32 ShaderIR::DecodeVideo(NodeBlock& bb, u32 pc) {
         }
         if (instr.video.signed_b) {
             const auto imm = static_cast<s16>(instr.alu.GetImm20_16());
-            return Immediate(static_cast<u32>(imm));
+            return Immediate(node_pool, static_cast<u32>(imm));
         } else {
-            return Immediate(instr.alu.GetImm20_16());
+            return Immediate(node_pool, instr.alu.GetImm20_16());
         }
     }();
 
@@ -50,13 +50,15 @@ u32 ShaderIR::DecodeVideo(NodeBlock& bb, u32 pc) {
         const bool result_signed = instr.video.signed_a == 1 || instr.video.signed_b == 1;
         const Node op_c = GetRegister(instr.gpr39);
 
-        Node value = SignedOperation(OperationCode::IMul, result_signed, NO_PRECISE, op_a, op_b);
-        value = SignedOperation(OperationCode::IAdd, result_signed, NO_PRECISE, value, op_c);
+        Node value =
+            SignedOperation(node_pool, OperationCode::IMul, result_signed, NO_PRECISE, op_a, op_b);
+        value =
+            SignedOperation(node_pool, OperationCode::IAdd, result_signed, NO_PRECISE, value, op_c);
 
         if (instr.vmad.shr == VmadShr::Shr7 || instr.vmad.shr == VmadShr::Shr15) {
-            const Node shift = Immediate(instr.vmad.shr == VmadShr::Shr7 ? 7 : 15);
-            value =
-                SignedOperation(OperationCode::IArithmeticShiftRight, result_signed, value, shift);
+            const Node shift = Immediate(node_pool, instr.vmad.shr == VmadShr::Shr7 ? 7 : 15);
+            value = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight, result_signed,
+                                    value, shift);
         }
 
         SetInternalFlagsFromInteger(bb, value, instr.generates_cc);
@@ -74,13 +76,15 @@ u32 ShaderIR::DecodeVideo(NodeBlock& bb, u32 pc) {
         const OperationCode combiner = GetPredicateCombiner(instr.vsetp.op);
 
         // Set the primary predicate to the result of Predicate OP SecondPredicate
-        SetPredicate(bb, instr.vsetp.pred3, Operation(combiner, first_pred, second_pred));
+        SetPredicate(bb, instr.vsetp.pred3,
+                     Operation(node_pool, combiner, first_pred, second_pred));
 
         if (instr.vsetp.pred0 != static_cast<u64>(Pred::UnusedIndex)) {
             // Set the secondary predicate to the result of !Predicate OP SecondPredicate,
             // if enabled
-            const Node negate_pred = Operation(OperationCode::LogicalNegate, first_pred);
-            SetPredicate(bb, instr.vsetp.pred0, Operation(combiner, negate_pred, second_pred));
+            const Node negate_pred = Operation(node_pool, OperationCode::LogicalNegate, first_pred);
+            SetPredicate(bb, instr.vsetp.pred0,
+                         Operation(node_pool, combiner, negate_pred, second_pred));
         }
         break;
     }
@@ -106,13 +110,13 @@ Node ShaderIR::GetVideoOperand(Node op, bool is_chunk, bool is_signed, VideoType
         // TODO(Rodrigo): From my hardware tests it becomes a bit "mad" when this type is used
         // (1 * 1 + 0 == 0x5b800000). Until a better explanation is found: abort.
         UNIMPLEMENTED();
-        return Immediate(0);
+        return Immediate(node_pool, 0);
     case VideoType::Invalid:
         UNREACHABLE_MSG("Invalid instruction encoding");
-        return Immediate(0);
+        return Immediate(node_pool, 0);
     default:
         UNREACHABLE();
-        return Immediate(0);
+        return Immediate(node_pool, 0);
     }
 }
 
@@ -132,7 +136,7 @@ void ShaderIR::DecodeVMNMX(NodeBlock& bb, Tegra::Shader::Instruction instr) {
     const bool is_oper2_signed = instr.vmnmx.is_dest_signed;
 
     const auto operation_a = instr.vmnmx.mx ? OperationCode::IMax : OperationCode::IMin;
-    Node value = SignedOperation(operation_a, is_oper1_signed, move(op_a), move(op_b));
+    Node value = SignedOperation(node_pool, operation_a, is_oper1_signed, move(op_a), move(op_b));
 
     switch (instr.vmnmx.operation) {
     case VmnmxOperation::Mrg_16H:
@@ -148,13 +152,15 @@ void ShaderIR::DecodeVMNMX(NodeBlock& bb, Tegra::Shader::Instruction instr) {
         value = BitfieldInsert(move(op_c), move(value), 16, 8);
         break;
     case VmnmxOperation::Acc:
-        value = Operation(OperationCode::IAdd, move(value), move(op_c));
+        value = Operation(node_pool, OperationCode::IAdd, move(value), move(op_c));
         break;
     case VmnmxOperation::Min:
-        value = SignedOperation(OperationCode::IMin, is_oper2_signed, move(value), move(op_c));
+        value = SignedOperation(node_pool, OperationCode::IMin, is_oper2_signed, move(value),
+                                move(op_c));
         break;
     case VmnmxOperation::Max:
-        value = SignedOperation(OperationCode::IMax, is_oper2_signed, move(value), move(op_c));
+        value = SignedOperation(node_pool, OperationCode::IMax, is_oper2_signed, move(value),
+                                move(op_c));
         break;
     case VmnmxOperation::Nop:
         break;
@@ -44,57 +44,62 @@ u32 ShaderIR::DecodeWarp(NodeBlock& bb, u32 pc) {
     switch (opcode->get().GetId()) {
     case OpCode::Id::VOTE: {
         const Node value = GetPredicate(instr.vote.value, instr.vote.negate_value != 0);
-        const Node active = Operation(OperationCode::BallotThread, value);
-        const Node vote = Operation(GetOperationCode(instr.vote.operation), value);
+        const Node active = Operation(node_pool, OperationCode::BallotThread, value);
+        const Node vote = Operation(node_pool, GetOperationCode(instr.vote.operation), value);
         SetRegister(bb, instr.gpr0, active);
         SetPredicate(bb, instr.vote.dest_pred, vote);
         break;
     }
     case OpCode::Id::SHFL: {
-        Node mask = instr.shfl.is_mask_imm ? Immediate(static_cast<u32>(instr.shfl.mask_imm))
-                                           : GetRegister(instr.gpr39);
-        Node index = instr.shfl.is_index_imm ? Immediate(static_cast<u32>(instr.shfl.index_imm))
-                                             : GetRegister(instr.gpr20);
-
-        Node thread_id = Operation(OperationCode::ThreadId);
-        Node clamp = Operation(OperationCode::IBitwiseAnd, mask, Immediate(0x1FU));
+        Node mask = instr.shfl.is_mask_imm
+                        ? Immediate(node_pool, static_cast<u32>(instr.shfl.mask_imm))
+                        : GetRegister(instr.gpr39);
+        Node index = instr.shfl.is_index_imm
+                         ? Immediate(node_pool, static_cast<u32>(instr.shfl.index_imm))
+                         : GetRegister(instr.gpr20);
+
+        Node thread_id = Operation(node_pool, OperationCode::ThreadId);
+        Node clamp =
+            Operation(node_pool, OperationCode::IBitwiseAnd, mask, Immediate(node_pool, 0x1FU));
         Node seg_mask = BitfieldExtract(mask, 8, 16);
 
-        Node neg_seg_mask = Operation(OperationCode::IBitwiseNot, seg_mask);
-        Node min_thread_id = Operation(OperationCode::IBitwiseAnd, thread_id, seg_mask);
-        Node max_thread_id = Operation(OperationCode::IBitwiseOr, min_thread_id,
-                                       Operation(OperationCode::IBitwiseAnd, clamp, neg_seg_mask));
+        Node neg_seg_mask = Operation(node_pool, OperationCode::IBitwiseNot, seg_mask);
+        Node min_thread_id = Operation(node_pool, OperationCode::IBitwiseAnd, thread_id, seg_mask);
+        Node max_thread_id = Operation(node_pool, OperationCode::IBitwiseOr, min_thread_id,
+                                       Operation(node_pool, OperationCode::IBitwiseAnd, clamp,
+                                                 neg_seg_mask));
 
-        Node src_thread_id = [instr, index, neg_seg_mask, min_thread_id, thread_id] {
+        Node src_thread_id = [this, instr, index, neg_seg_mask, min_thread_id, thread_id] {
             switch (instr.shfl.operation) {
             case ShuffleOperation::Idx:
-                return Operation(OperationCode::IBitwiseOr,
-                                 Operation(OperationCode::IBitwiseAnd, index, neg_seg_mask),
-                                 min_thread_id);
+                return Operation(node_pool, OperationCode::IBitwiseOr,
+                                 Operation(node_pool, OperationCode::IBitwiseAnd, index,
+                                           neg_seg_mask), min_thread_id);
             case ShuffleOperation::Down:
-                return Operation(OperationCode::IAdd, thread_id, index);
+                return Operation(node_pool, OperationCode::IAdd, thread_id, index);
             case ShuffleOperation::Up:
-                return Operation(OperationCode::IAdd, thread_id,
-                                 Operation(OperationCode::INegate, index));
+                return Operation(node_pool, OperationCode::IAdd, thread_id,
+                                 Operation(node_pool, OperationCode::INegate, index));
             case ShuffleOperation::Bfly:
-                return Operation(OperationCode::IBitwiseXor, thread_id, index);
+                return Operation(node_pool, OperationCode::IBitwiseXor, thread_id, index);
             }
             UNREACHABLE();
-            return Immediate(0U);
+            return Immediate(node_pool, 0U);
         }();
 
-        Node in_bounds = [instr, src_thread_id, min_thread_id, max_thread_id] {
+        Node in_bounds = [this, instr, src_thread_id, min_thread_id, max_thread_id] {
             if (instr.shfl.operation == ShuffleOperation::Up) {
-                return Operation(OperationCode::LogicalIGreaterEqual, src_thread_id, min_thread_id);
+                return Operation(node_pool, OperationCode::LogicalIGreaterEqual, src_thread_id,
+                                 min_thread_id);
             } else {
-                return Operation(OperationCode::LogicalILessEqual, src_thread_id, max_thread_id);
+                return Operation(node_pool, OperationCode::LogicalILessEqual, src_thread_id,
+                                 max_thread_id);
             }
         }();
 
         SetPredicate(bb, instr.shfl.pred48, in_bounds);
-        SetRegister(
-            bb, instr.gpr0,
-            Operation(OperationCode::ShuffleIndexed, GetRegister(instr.gpr8), src_thread_id));
+        SetRegister(bb, instr.gpr0, Operation(node_pool, OperationCode::ShuffleIndexed,
+                                              GetRegister(instr.gpr8), src_thread_id));
         break;
     }
     case OpCode::Id::FSWZADD: {
@@ -102,8 +107,9 @@ u32 ShaderIR::DecodeWarp(NodeBlock& bb, u32 pc) {
 
         Node op_a = GetRegister(instr.gpr8);
         Node op_b = GetRegister(instr.gpr20);
-        Node mask = Immediate(static_cast<u32>(instr.fswzadd.swizzle));
-        SetRegister(bb, instr.gpr0, Operation(OperationCode::FSwizzleAdd, op_a, op_b, mask));
+        Node mask = Immediate(node_pool, static_cast<u32>(instr.fswzadd.swizzle));
+        SetRegister(bb, instr.gpr0,
+                    Operation(node_pool, OperationCode::FSwizzleAdd, op_a, op_b, mask));
         break;
     }
     default:
@@ -56,27 +56,35 @@ u32 ShaderIR::DecodeXmad(NodeBlock& bb, u32 pc) {
                     instr.xmad.product_shift_left,
                     false,
                     instr.xmad.mode,
-                    Immediate(static_cast<u32>(instr.xmad.imm20_16)),
+                    Immediate(node_pool, static_cast<u32>(instr.xmad.imm20_16)),
                     GetRegister(instr.gpr39)};
         default:
             UNIMPLEMENTED_MSG("Unhandled XMAD instruction: {}", opcode->get().GetName());
-            return {false, false, false, Tegra::Shader::XmadMode::None, Immediate(0), Immediate(0)};
+            return {false,
+                    false,
+                    false,
+                    Tegra::Shader::XmadMode::None,
+                    Immediate(node_pool, 0),
+                    Immediate(node_pool, 0)};
         }
     }();
 
-    op_a = SignedOperation(OperationCode::IBitfieldExtract, is_signed_a, std::move(op_a),
-                           instr.xmad.high_a ? Immediate(16) : Immediate(0), Immediate(16));
+    op_a = SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed_a, std::move(op_a),
+                           instr.xmad.high_a ? Immediate(node_pool, 16) : Immediate(node_pool, 0),
+                           Immediate(node_pool, 16));
 
     const Node original_b = op_b_binding;
     const Node op_b =
-        SignedOperation(OperationCode::IBitfieldExtract, is_signed_b, std::move(op_b_binding),
-                        is_high_b ? Immediate(16) : Immediate(0), Immediate(16));
+        SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed_b,
+                        std::move(op_b_binding),
+                        is_high_b ? Immediate(node_pool, 16) : Immediate(node_pool, 0),
+                        Immediate(node_pool, 16));
 
     // we already check sign_a and sign_b is difference or not before so just use one in here.
-    Node product = SignedOperation(OperationCode::IMul, is_signed_a, op_a, op_b);
+    Node product = SignedOperation(node_pool, OperationCode::IMul, is_signed_a, op_a, op_b);
     if (is_psl) {
-        product =
-            SignedOperation(OperationCode::ILogicalShiftLeft, is_signed_a, product, Immediate(16));
+        product = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft, is_signed_a, product,
+                                  Immediate(node_pool, 16));
     }
     SetTemporary(bb, 0, product);
     product = GetTemporary(0);
@@ -92,43 +100,42 @@ u32 ShaderIR::DecodeXmad(NodeBlock& bb, u32 pc) {
         case Tegra::Shader::XmadMode::CHi:
             return BitfieldExtract(std::move(original_c), 16, 16);
         case Tegra::Shader::XmadMode::CBcc: {
-            Node shifted_b = SignedOperation(OperationCode::ILogicalShiftLeft, is_signed_b,
-                                             original_b, Immediate(16));
-            return SignedOperation(OperationCode::IAdd, is_signed_c, std::move(original_c),
-                                   std::move(shifted_b));
+            Node shifted_b = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft,
+                                             is_signed_b, original_b, Immediate(node_pool, 16));
+            return SignedOperation(node_pool, OperationCode::IAdd, is_signed_c,
+                                   std::move(original_c), std::move(shifted_b));
         }
         case Tegra::Shader::XmadMode::CSfu: {
-            const Node comp_a =
-                GetPredicateComparisonInteger(PredCondition::EQ, is_signed_a, op_a, Immediate(0));
-            const Node comp_b =
-                GetPredicateComparisonInteger(PredCondition::EQ, is_signed_b, op_b, Immediate(0));
-            const Node comp = Operation(OperationCode::LogicalOr, comp_a, comp_b);
+            const Node comp_a = GetPredicateComparisonInteger(PredCondition::EQ, is_signed_a, op_a,
+                                                              Immediate(node_pool, 0));
+            const Node comp_b = GetPredicateComparisonInteger(PredCondition::EQ, is_signed_b, op_b,
+                                                              Immediate(node_pool, 0));
+            const Node comp = Operation(node_pool, OperationCode::LogicalOr, comp_a, comp_b);
 
             const Node comp_minus_a = GetPredicateComparisonInteger(
                 PredCondition::NE, is_signed_a,
-                SignedOperation(OperationCode::IBitwiseAnd, is_signed_a, op_a,
-                                Immediate(0x80000000)),
-                Immediate(0));
+                SignedOperation(node_pool, OperationCode::IBitwiseAnd, is_signed_a, op_a,
+                                Immediate(node_pool, 0x80000000)),
+                Immediate(node_pool, 0));
             const Node comp_minus_b = GetPredicateComparisonInteger(
                 PredCondition::NE, is_signed_b,
-                SignedOperation(OperationCode::IBitwiseAnd, is_signed_b, op_b,
-                                Immediate(0x80000000)),
-                Immediate(0));
-
-            Node new_c = Operation(
-                OperationCode::Select, comp_minus_a,
-                SignedOperation(OperationCode::IAdd, is_signed_c, original_c, Immediate(-65536)),
-                original_c);
-            new_c = Operation(
-                OperationCode::Select, comp_minus_b,
-                SignedOperation(OperationCode::IAdd, is_signed_c, new_c, Immediate(-65536)),
-                std::move(new_c));
-
-            return Operation(OperationCode::Select, comp, original_c, std::move(new_c));
+                SignedOperation(node_pool, OperationCode::IBitwiseAnd, is_signed_b, op_b,
+                                Immediate(node_pool, 0x80000000)),
+                Immediate(node_pool, 0));
+
+            Node new_c = Operation(node_pool, OperationCode::Select, comp_minus_a,
+                                   SignedOperation(node_pool, OperationCode::IAdd, is_signed_c,
+                                                   original_c, Immediate(node_pool, -65536)),
+                                   original_c);
+            new_c = Operation(node_pool, OperationCode::Select, comp_minus_b,
+                              SignedOperation(node_pool, OperationCode::IAdd, is_signed_c, new_c,
+                                              Immediate(node_pool, -65536)), std::move(new_c));
+
+            return Operation(node_pool, OperationCode::Select, comp, original_c, std::move(new_c));
         }
         default:
             UNREACHABLE();
-            return Immediate(0);
+            return Immediate(node_pool, 0);
         }
     }();
 
@@ -136,15 +143,17 @@ u32 ShaderIR::DecodeXmad(NodeBlock& bb, u32 pc) {
     op_c = GetTemporary(1);
 
     // TODO(Rodrigo): Use an appropiate sign for this operation
-    Node sum = SignedOperation(OperationCode::IAdd, is_signed_a, product, std::move(op_c));
+    Node sum =
+        SignedOperation(node_pool, OperationCode::IAdd, is_signed_a, product, std::move(op_c));
     SetTemporary(bb, 2, sum);
     sum = GetTemporary(2);
     if (is_merge) {
-        const Node a = SignedOperation(OperationCode::IBitfieldExtract, is_signed_a, std::move(sum),
-                                       Immediate(0), Immediate(16));
-        const Node b = SignedOperation(OperationCode::ILogicalShiftLeft, is_signed_b, original_b,
-                                       Immediate(16));
-        sum = SignedOperation(OperationCode::IBitwiseOr, is_signed_a, a, b);
+        const Node a = SignedOperation(node_pool, OperationCode::IBitfieldExtract, is_signed_a,
+                                       std::move(sum), Immediate(node_pool, 0),
+                                       Immediate(node_pool, 16));
+        const Node b = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft, is_signed_b,
+                                       original_b, Immediate(node_pool, 16));
+        sum = SignedOperation(node_pool, OperationCode::IBitwiseOr, is_signed_a, a, b);
     }
 
     SetInternalFlagsFromInteger(bb, sum, instr.generates_cc);
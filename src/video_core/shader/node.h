@@ -271,7 +271,8 @@ class CommentNode;
 using NodeData = std::variant<OperationNode, ConditionalNode, GprNode, CustomVarNode, ImmediateNode,
                               InternalFlagNode, PredicateNode, AbufNode, PatchNode, CbufNode,
                               LmemNode, SmemNode, GmemNode, CommentNode>;
-using Node = std::shared_ptr<NodeData>;
+/// Nodes are owned by the node pool of the ShaderIR that created them
+using Node = NodeData*;
 using Node4 = std::array<Node, 4>;
 using NodeBlock = std::vector<Node>;
 
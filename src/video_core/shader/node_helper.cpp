@@ -11,26 +11,26 @@
 
 namespace VideoCommon::Shader {
 
-Node Conditional(Node condition, std::vector<Node> code) {
-    return MakeNode<ConditionalNode>(std::move(condition), std::move(code));
+Node Conditional(NodePool& pool, Node condition, std::vector<Node> code) {
+    return MakeNode<ConditionalNode>(pool, std::move(condition), std::move(code));
 }
 
-Node Comment(std::string text) {
-    return MakeNode<CommentNode>(std::move(text));
+Node Comment(NodePool& pool, std::string text) {
+    return MakeNode<CommentNode>(pool, std::move(text));
 }
 
-Node Immediate(u32 value) {
-    return MakeNode<ImmediateNode>(value);
+Node Immediate(NodePool& pool, u32 value) {
+    return MakeNode<ImmediateNode>(pool, value);
 }
 
-Node Immediate(s32 value) {
-    return Immediate(static_cast<u32>(value));
+Node Immediate(NodePool& pool, s32 value) {
+    return Immediate(pool, static_cast<u32>(value));
 }
 
-Node Immediate(f32 value) {
+Node Immediate(NodePool& pool, f32 value) {
     u32 integral;
     std::memcpy(&integral, &value, sizeof(u32));
-    return Immediate(integral);
+    return Immediate(pool, integral);
 }
 
 OperationCode SignedToUnsignedCode(OperationCode operation_code, bool is_signed) {
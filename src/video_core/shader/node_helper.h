@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/object_pool.h"
 #include "video_core/shader/node.h"
 
 namespace VideoCommon::Shader {
@@ -21,28 +22,31 @@ inline constexpr MetaArithmetic PRECISE = {true};
 /// This arithmetic operation can be optimized away
 inline constexpr MetaArithmetic NO_PRECISE = {false};
 
+/// Pool owning the nodes of a ShaderIR
+using NodePool = Common::ObjectPool<NodeData>;
+
 /// Creates a conditional node
-Node Conditional(Node condition, std::vector<Node> code);
+Node Conditional(NodePool& pool, Node condition, std::vector<Node> code);
 
 /// Creates a commentary node
-Node Comment(std::string text);
+Node Comment(NodePool& pool, std::string text);
 
 /// Creates an u32 immediate
-Node Immediate(u32 value);
+Node Immediate(NodePool& pool, u32 value);
 
 /// Creates a s32 immediate
-Node Immediate(s32 value);
+Node Immediate(NodePool& pool, s32 value);
 
 /// Creates a f32 immediate
-Node Immediate(f32 value);
+Node Immediate(NodePool& pool, f32 value);
 
 /// Converts an signed operation code to an unsigned operation code
 OperationCode SignedToUnsignedCode(OperationCode operation_code, bool is_signed);
 
 template <typename T, typename... Args>
-Node MakeNode(Args&&... args) {
+Node MakeNode(NodePool& pool, Args&&... args) {
     static_assert(std::is_convertible_v<T, NodeData>);
-    return std::make_shared<NodeData>(T(std::forward<Args>(args)...));
+    return pool.Create(T(std::forward<Args>(args)...));
 }
 
 template <typename T, typename... Args>
@@ -52,20 +56,20 @@ TrackSampler MakeTrackSampler(Args&&... args) {
 }
 
 template <typename... Args>
-Node Operation(OperationCode code, Args&&... args) {
+Node Operation(NodePool& pool, OperationCode code, Args&&... args) {
     if constexpr (sizeof...(args) == 0) {
-        return MakeNode<OperationNode>(code);
+        return MakeNode<OperationNode>(pool, code);
     } else if constexpr (std::is_convertible_v<std::tuple_element_t<0, std::tuple<Args...>>,
                                                Meta>) {
-        return MakeNode<OperationNode>(code, std::forward<Args>(args)...);
+        return MakeNode<OperationNode>(pool, code, std::forward<Args>(args)...);
     } else {
-        return MakeNode<OperationNode>(code, Meta{}, std::forward<Args>(args)...);
+        return MakeNode<OperationNode>(pool, code, Meta{}, std::forward<Args>(args)...);
     }
 }
 
 template <typename... Args>
-Node SignedOperation(OperationCode code, bool is_signed, Args&&... args) {
-    return Operation(SignedToUnsignedCode(code, is_signed), std::forward<Args>(args)...);
+Node SignedOperation(NodePool& pool, OperationCode code, bool is_signed, Args&&... args) {
+    return Operation(pool, SignedToUnsignedCode(code, is_signed), std::forward<Args>(args)...);
 }
 
 } // namespace VideoCommon::Shader
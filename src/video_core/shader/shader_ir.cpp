@@ -29,6 +29,8 @@ ShaderIR::ShaderIR(const ProgramCode& program_code_, u32 main_offset_, CompilerS
                    Registry& registry_)
     : program_code{program_code_}, main_offset{main_offset_}, settings{settings_}, registry{
                                                                                        registry_} {
+    condition_code_neu = GetInternalFlag(InternalFlag::Zero, true);
+    condition_code_never = MakeNode<PredicateNode>(node_pool, Pred::NeverExecute, false);
     Decode();
     PostDecode();
 }
@@ -39,19 +41,19 @@ Node ShaderIR::GetRegister(Register reg) {
     if (reg != Register::ZeroIndex) {
         used_registers.insert(static_cast<u32>(reg));
     }
-    return MakeNode<GprNode>(reg);
+    return MakeNode<GprNode>(node_pool, reg);
 }
 
 Node ShaderIR::GetCustomVariable(u32 id) {
-    return MakeNode<CustomVarNode>(id);
+    return MakeNode<CustomVarNode>(node_pool, id);
 }
 
 Node ShaderIR::GetImmediate19(Instruction instr) {
-    return Immediate(instr.alu.GetImm20_19());
+    return Immediate(node_pool, instr.alu.GetImm20_19());
 }
 
 Node ShaderIR::GetImmediate32(Instruction instr) {
-    return Immediate(instr.alu.GetImm20_32());
+    return Immediate(node_pool, instr.alu.GetImm20_32());
 }
 
 Node ShaderIR::GetConstBuffer(u64 index_, u64 offset_) {
@@ -60,7 +62,7 @@ Node ShaderIR::GetConstBuffer(u64 index_, u64 offset_) {
 
     used_cbufs.try_emplace(index).first->second.MarkAsUsed(offset);
 
-    return MakeNode<CbufNode>(index, Immediate(offset));
+    return MakeNode<CbufNode>(node_pool, index, Immediate(node_pool, offset));
 }
 
 Node ShaderIR::GetConstBufferIndirect(u64 index_, u64 offset_, Node node) {
@@ -74,12 +76,13 @@ Node ShaderIR::GetConstBufferIndirect(u64 index_, u64 offset_, Node node) {
         // tracking LDC calls.
         if (const auto gpr = std::get_if<GprNode>(&*node)) {
             if (gpr->GetIndex() == Register::ZeroIndex) {
-                return Immediate(offset);
+                return Immediate(node_pool, offset);
             }
         }
-        return Operation(OperationCode::UAdd, NO_PRECISE, std::move(node), Immediate(offset));
+        return Operation(node_pool, OperationCode::UAdd, NO_PRECISE, std::move(node),
+                         Immediate(node_pool, offset));
     }();
-    return MakeNode<CbufNode>(index, std::move(final_offset));
+    return MakeNode<CbufNode>(node_pool, index, std::move(final_offset));
 }
 
 Node ShaderIR::GetPredicate(u64 pred_, bool negated) {
@@ -88,7 +91,7 @@ Node ShaderIR::GetPredicate(u64 pred_, bool negated) {
         used_predicates.insert(pred);
     }
 
-    return MakeNode<PredicateNode>(pred, negated);
+    return MakeNode<PredicateNode>(node_pool, pred, negated);
 }
 
 Node ShaderIR::GetPredicate(bool immediate) {
@@ -98,34 +101,34 @@ Node ShaderIR::GetPredicate(bool immediate) {
 Node ShaderIR::GetInputAttribute(Attribute::Index index, u64 element, Node buffer) {
     MarkAttributeUsage(index, element);
     used_input_attributes.emplace(index);
-    return MakeNode<AbufNode>(index, static_cast<u32>(element), std::move(buffer));
+    return MakeNode<AbufNode>(node_pool, index, static_cast<u32>(element), std::move(buffer));
 }
 
 Node ShaderIR::GetPhysicalInputAttribute(Tegra::Shader::Register physical_address, Node buffer) {
     uses_physical_attributes = true;
-    return MakeNode<AbufNode>(GetRegister(physical_address), buffer);
+    return MakeNode<AbufNode>(node_pool, GetRegister(physical_address), buffer);
 }
 
 Node ShaderIR::GetOutputAttribute(Attribute::Index index, u64 element, Node buffer) {
     MarkAttributeUsage(index, element);
     used_output_attributes.insert(index);
-    return MakeNode<AbufNode>(index, static_cast<u32>(element), std::move(buffer));
+    return MakeNode<AbufNode>(node_pool, index, static_cast<u32>(element), std::move(buffer));
 }
 
 Node ShaderIR::GetInternalFlag(InternalFlag flag, bool negated) const {
-    Node node = MakeNode<InternalFlagNode>(flag);
+    Node node = MakeNode<InternalFlagNode>(node_pool, flag);
     if (negated) {
-        return Operation(OperationCode::LogicalNegate, std::move(node));
+        return Operation(node_pool, OperationCode::LogicalNegate, std::move(node));
     }
     return node;
 }
 
 Node ShaderIR::GetLocalMemory(Node address) {
-    return MakeNode<LmemNode>(std::move(address));
+    return MakeNode<LmemNode>(node_pool, std::move(address));
 }
 
 Node ShaderIR::GetSharedMemory(Node address) {
-    return MakeNode<SmemNode>(std::move(address));
+    return MakeNode<SmemNode>(node_pool, std::move(address));
 }
 
 Node ShaderIR::GetTemporary(u32 id) {
@@ -134,10 +137,10 @@ Node ShaderIR::GetTemporary(u32 id) {
 
 Node ShaderIR::GetOperandAbsNegFloat(Node value, bool absolute, bool negate) {
     if (absolute) {
-        value = Operation(OperationCode::FAbsolute, NO_PRECISE, std::move(value));
+        value = Operation(node_pool, OperationCode::FAbsolute, NO_PRECISE, std::move(value));
     }
     if (negate) {
-        value = Operation(OperationCode::FNegate, NO_PRECISE, std::move(value));
+        value = Operation(node_pool, OperationCode::FNegate, NO_PRECISE, std::move(value));
     }
     return value;
 }
@@ -147,25 +150,25 @@ Node ShaderIR::GetSaturatedFloat(Node value, bool saturate) {
         return value;
     }
 
-    Node positive_zero = Immediate(std::copysignf(0, 1));
-    Node positive_one = Immediate(1.0f);
-    return Operation(OperationCode::FClamp, NO_PRECISE, std::move(value), std::move(positive_zero),
-                     std::move(positive_one));
+    Node positive_zero = Immediate(node_pool, std::copysignf(0, 1));
+    Node positive_one = Immediate(node_pool, 1.0f);
+    return Operation(node_pool, OperationCode::FClamp, NO_PRECISE, std::move(value),
+                     std::move(positive_zero), std::move(positive_one));
 }
 
 Node ShaderIR::ConvertIntegerSize(Node value, Register::Size size, bool is_signed) {
     switch (size) {
     case Register::Size::Byte:
-        value = SignedOperation(OperationCode::ILogicalShiftLeft, is_signed, NO_PRECISE,
-                                std::move(value), Immediate(24));
-        value = SignedOperation(OperationCode::IArithmeticShiftRight, is_signed, NO_PRECISE,
-                                std::move(value), Immediate(24));
+        value = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft, is_signed, NO_PRECISE,
+                                std::move(value), Immediate(node_pool, 24));
+        value = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight, is_signed,
+                                NO_PRECISE, std::move(value), Immediate(node_pool, 24));
         return value;
     case Register::Size::Short:
-        value = SignedOperation(OperationCode::ILogicalShiftLeft, is_signed, NO_PRECISE,
-                                std::move(value), Immediate(16));
-        value = SignedOperation(OperationCode::IArithmeticShiftRight, is_signed, NO_PRECISE,
-                                std::move(value), Immediate(16));
+        value = SignedOperation(node_pool, OperationCode::ILogicalShiftLeft, is_signed, NO_PRECISE,
+                                std::move(value), Immediate(node_pool, 16));
+        value = SignedOperation(node_pool, OperationCode::IArithmeticShiftRight, is_signed,
+                                NO_PRECISE, std::move(value), Immediate(node_pool, 16));
         return value;
     case Register::Size::Word:
         // Default - do nothing
@@ -182,16 +185,16 @@ Node ShaderIR::GetOperandAbsNegInteger(Node value, bool absolute, bool negate, b
         return value;
     }
     if (absolute) {
-        value = Operation(OperationCode::IAbsolute, NO_PRECISE, std::move(value));
+        value = Operation(node_pool, OperationCode::IAbsolute, NO_PRECISE, std::move(value));
     }
     if (negate) {
-        value = Operation(OperationCode::INegate, NO_PRECISE, std::move(value));
+        value = Operation(node_pool, OperationCode::INegate, NO_PRECISE, std::move(value));
     }
     return value;
 }
 
 Node ShaderIR::UnpackHalfImmediate(Instruction instr, bool has_negation) {
-    Node value = Immediate(instr.half_imm.PackImmediates());
+    Node value = Immediate(node_pool, instr.half_imm.PackImmediates());
     if (!has_negation) {
         return value;
     }
@@ -199,12 +202,12 @@ Node ShaderIR::UnpackHalfImmediate(Instruction instr, bool has_negation) {
     Node first_negate = GetPredicate(instr.half_imm.first_negate != 0);
     Node second_negate = GetPredicate(instr.half_imm.second_negate != 0);
 
-    return Operation(OperationCode::HNegate, NO_PRECISE, std::move(value), std::move(first_negate),
-                     std::move(second_negate));
+    return Operation(node_pool, OperationCode::HNegate, NO_PRECISE, std::move(value),
+                     std::move(first_negate), std::move(second_negate));
 }
 
 Node ShaderIR::UnpackHalfFloat(Node value, Tegra::Shader::HalfType type) {
-    return Operation(OperationCode::HUnpack, type, std::move(value));
+    return Operation(node_pool, OperationCode::HUnpack, type, std::move(value));
 }
 
 Node ShaderIR::HalfMerge(Node dest, Node src, Tegra::Shader::HalfMerge merge) {
@@ -212,11 +215,11 @@ Node ShaderIR::HalfMerge(Node dest, Node src, Tegra::Shader::HalfMerge merge) {
     case Tegra::Shader::HalfMerge::H0_H1:
         return src;
     case Tegra::Shader::HalfMerge::F32:
-        return Operation(OperationCode::HMergeF32, std::move(src));
+        return Operation(node_pool, OperationCode::HMergeF32, std::move(src));
     case Tegra::Shader::HalfMerge::Mrg_H0:
-        return Operation(OperationCode::HMergeH0, std::move(dest), std::move(src));
+        return Operation(node_pool, OperationCode::HMergeH0, std::move(dest), std::move(src));
     case Tegra::Shader::HalfMerge::Mrg_H1:
-        return Operation(OperationCode::HMergeH1, std::move(dest), std::move(src));
+        return Operation(node_pool, OperationCode::HMergeH1, std::move(dest), std::move(src));
     }
     UNREACHABLE();
     return src;
@@ -224,11 +227,11 @@ Node ShaderIR::HalfMerge(Node dest, Node src, Tegra::Shader::HalfMerge merge) {
 
 Node ShaderIR::GetOperandAbsNegHalf(Node value, bool absolute, bool negate) {
     if (absolute) {
-        value = Operation(OperationCode::HAbsolute, NO_PRECISE, std::move(value));
+        value = Operation(node_pool, OperationCode::HAbsolute, NO_PRECISE, std::move(value));
     }
     if (negate) {
-        value = Operation(OperationCode::HNegate, NO_PRECISE, std::move(value), GetPredicate(true),
-                          GetPredicate(true));
+        value = Operation(node_pool, OperationCode::HNegate, NO_PRECISE, std::move(value),
+                          GetPredicate(true), GetPredicate(true));
     }
     return value;
 }
@@ -238,10 +241,10 @@ Node ShaderIR::GetSaturatedHalfFloat(Node value, bool saturate) {
         return value;
     }
 
-    Node positive_zero = Immediate(std::copysignf(0, 1));
-    Node positive_one = Immediate(1.0f);
-    return Operation(OperationCode::HClamp, NO_PRECISE, std::move(value), std::move(positive_zero),
-                     std::move(positive_one));
+    Node positive_zero = Immediate(node_pool, std::copysignf(0, 1));
+    Node positive_one = Immediate(node_pool, 1.0f);
+    return Operation(node_pool, OperationCode::HClamp, NO_PRECISE, std::move(value),
+                     std::move(positive_zero), std::move(positive_one));
 }
 
 Node ShaderIR::GetPredicateComparisonFloat(PredCondition condition, Node op_a, Node op_b) {
@@ -271,7 +274,7 @@ Node ShaderIR::GetPredicateComparisonFloat(PredCondition condition, Node op_a, N
     const std::size_t index = static_cast<std::size_t>(condition);
     ASSERT_MSG(index < std::size(comparison_table), "Invalid condition={}", index);
 
-    return Operation(comparison_table[index], op_a, op_b);
+    return Operation(node_pool, comparison_table[index], op_a, op_b);
 }
 
 Node ShaderIR::GetPredicateComparisonInteger(PredCondition condition, bool is_signed, Node op_a,
@@ -291,7 +294,7 @@ Node ShaderIR::GetPredicateComparisonInteger(PredCondition condition, bool is_si
     UNIMPLEMENTED_IF_MSG(comparison == comparison_table.cend(),
                          "Unknown predicate comparison operation");
 
-    return SignedOperation(comparison->second, is_signed, NO_PRECISE, std::move(op_a),
+    return SignedOperation(node_pool, comparison->second, is_signed, NO_PRECISE, std::move(op_a),
                            std::move(op_b));
 }
 
@@ -317,7 +320,7 @@ Node ShaderIR::GetPredicateComparisonHalf(Tegra::Shader::PredCondition condition
     UNIMPLEMENTED_IF_MSG(comparison == comparison_table.cend(),
                          "Unknown predicate comparison operation");
 
-    return Operation(comparison->second, NO_PRECISE, std::move(op_a), std::move(op_b));
+    return Operation(node_pool, comparison->second, NO_PRECISE, std::move(op_a), std::move(op_b));
 }
 
 OperationCode ShaderIR::GetPredicateCombiner(PredOperation operation) {
@@ -339,36 +342,38 @@ OperationCode ShaderIR::GetPredicateCombiner(PredOperation operation) {
 Node ShaderIR::GetConditionCode(ConditionCode cc) const {
     switch (cc) {
     case ConditionCode::NEU:
-        return GetInternalFlag(InternalFlag::Zero, true);
+        return condition_code_neu;
     case ConditionCode::FCSM_TR:
         UNIMPLEMENTED_MSG("EXIT.FCSM_TR is not implemented");
-        return MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        return condition_code_never;
     default:
         UNIMPLEMENTED_MSG("Unimplemented condition code: {}", cc);
-        return MakeNode<PredicateNode>(Pred::NeverExecute, false);
+        return condition_code_never;
     }
 }
 
 void ShaderIR::SetRegister(NodeBlock& bb, Register dest, Node src) {
-    bb.push_back(Operation(OperationCode::Assign, GetRegister(dest), std::move(src)));
+    bb.push_back(Operation(node_pool, OperationCode::Assign, GetRegister(dest), std::move(src)));
 }
 
 void ShaderIR::SetPredicate(NodeBlock& bb, u64 dest, Node src) {
-    bb.push_back(Operation(OperationCode::LogicalAssign, GetPredicate(dest), std::move(src)));
+    bb.push_back(Operation(node_pool, OperationCode::LogicalAssign, GetPredicate(dest),
+                           std::move(src)));
 }
 
 void ShaderIR::SetInternalFlag(NodeBlock& bb, InternalFlag flag, Node value) {
-    bb.push_back(Operation(OperationCode::LogicalAssign, GetInternalFlag(flag), std::move(value)));
+    bb.push_back(Operation(node_pool, OperationCode::LogicalAssign, GetInternalFlag(flag),
+                           std::move(value)));
 }
 
 void ShaderIR::SetLocalMemory(NodeBlock& bb, Node address, Node value) {
-    bb.push_back(
-        Operation(OperationCode::Assign, GetLocalMemory(std::move(address)), std::move(value)));
+    bb.push_back(Operation(node_pool, OperationCode::Assign, GetLocalMemory(std::move(address)),
+                           std::move(value)));
 }
 
 void ShaderIR::SetSharedMemory(NodeBlock& bb, Node address, Node value) {
-    bb.push_back(
-        Operation(OperationCode::Assign, GetSharedMemory(std::move(address)), std::move(value)));
+    bb.push_back(Operation(node_pool, OperationCode::Assign, GetSharedMemory(std::move(address)),
+                           std::move(value)));
 }
 
 void ShaderIR::SetTemporary(NodeBlock& bb, u32 id, Node value) {
@@ -379,7 +384,8 @@ void ShaderIR::SetInternalFlagsFromFloat(NodeBlock& bb, Node value, bool sets_cc
     if (!sets_cc) {
         return;
     }
-    Node zerop = Operation(OperationCode::LogicalFOrdEqual, std::move(value), Immediate(0.0f));
+    Node zerop = Operation(node_pool, OperationCode::LogicalFOrdEqual, std::move(value),
+                           Immediate(node_pool, 0.0f));
     SetInternalFlag(bb, InternalFlag::Zero, std::move(zerop));
     LOG_WARNING(HW_GPU, "Condition codes implementation is incomplete");
 }
@@ -388,19 +394,20 @@ void ShaderIR::SetInternalFlagsFromInteger(NodeBlock& bb, Node value, bool sets_
     if (!sets_cc) {
         return;
     }
-    Node zerop = Operation(OperationCode::LogicalIEqual, std::move(value), Immediate(0));
+    Node zerop = Operation(node_pool, OperationCode::LogicalIEqual, std::move(value),
+                           Immediate(node_pool, 0));
     SetInternalFlag(bb, InternalFlag::Zero, std::move(zerop));
     LOG_WARNING(HW_GPU, "Condition codes implementation is incomplete");
 }
 
 Node ShaderIR::BitfieldExtract(Node value, u32 offset, u32 bits) {
-    return Operation(OperationCode::UBitfieldExtract, NO_PRECISE, std::move(value),
-                     Immediate(offset), Immediate(bits));
+    return Operation(node_pool, OperationCode::UBitfieldExtract, NO_PRECISE, std::move(value),
+                     Immediate(node_pool, offset), Immediate(node_pool, bits));
 }
 
 Node ShaderIR::BitfieldInsert(Node base, Node insert, u32 offset, u32 bits) {
-    return Operation(OperationCode::UBitfieldInsert, NO_PRECISE, base, insert, Immediate(offset),
-                     Immediate(bits));
+    return Operation(node_pool, OperationCode::UBitfieldInsert, NO_PRECISE, base, insert,
+                     Immediate(node_pool, offset), Immediate(node_pool, bits));
 }
 
 void ShaderIR::MarkAttributeUsage(Attribute::Index index, u64 element) {
@@ -20,6 +20,7 @@
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/memory_util.h"
 #include "video_core/shader/node.h"
+#include "video_core/shader/node_helper.h"
 #include "video_core/shader/registry.h"
 
 namespace VideoCommon::Shader {
@@ -441,6 +442,12 @@ private:
     const CompilerSettings settings;
     Registry& registry;
 
+    /// Owns all the nodes of the IR, they are freed at once when the IR is destroyed
+    mutable NodePool node_pool;
+    /// Condition codes are prebuilt, decompilers query them without allocating nodes
+    Node condition_code_neu{};
+    Node condition_code_never{};
+
     bool decompiled{};
     bool disable_flow_stack{};
 
@@ -148,10 +148,11 @@ std::pair<Node, TrackSampler> ShaderIR::HandleBindlessIndirectRead(
     const auto& gpu_driver = registry.AccessGuestDriverProfile();
     const u32 bindless_cv = NewCustomVariable();
     const u32 texture_handler_size = gpu_driver.GetTextureHandlerSize();
-    Node op = Operation(OperationCode::UDiv, gpr, Immediate(texture_handler_size));
+    Node op =
+        Operation(node_pool, OperationCode::UDiv, gpr, Immediate(node_pool, texture_handler_size));
 
     Node cv_node = GetCustomVariable(bindless_cv);
-    Node amend_op = Operation(OperationCode::Assign, std::move(cv_node), std::move(op));
+    Node amend_op = Operation(node_pool, OperationCode::Assign, std::move(cv_node), std::move(op));
     const std::size_t amend_index = DeclareAmend(std::move(amend_op));
     AmendNodeCv(amend_index, code[cursor]);
 
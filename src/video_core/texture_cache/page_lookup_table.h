@@ -0,0 +1,74 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+/**
+ * Maps pages to the ids of the objects overlapping them.
+ * Pages are stored in blocks that are allocated the first time one of their pages is written,
+ * finding a page is two array lookups instead of hashing into a node based map.
+ *
+ * @tparam Id             Type of the stored ids
+ * @tparam num_page_bits  log2 of the number of addressable pages
+ */
+template <typename Id, size_t num_page_bits>
+class PageLookupTable {
+    static constexpr size_t BLOCK_BITS = 10;
+    static constexpr size_t BLOCK_SIZE = size_t{1} << BLOCK_BITS;
+    static constexpr size_t NUM_PAGES = size_t{1} << num_page_bits;
+    static_assert(num_page_bits >= BLOCK_BITS);
+
+public:
+    /// Most pages are overlapped by a handful of objects, keep those inline
+    using IdList = boost::container::small_vector<Id, 4>;
+
+    PageLookupTable() : blocks(NUM_PAGES / BLOCK_SIZE) {}
+
+    /// Returns the ids registered in a page, or nullptr when nothing was registered near it
+    [[nodiscard]] IdList* Find(u64 page) noexcept {
+        const size_t index = PageIndex(page);
+        Block* const block = blocks[index / BLOCK_SIZE].get();
+        return block ? &(*block)[index % BLOCK_SIZE] : nullptr;
+    }
+
+    /// Returns the ids registered in a page, or nullptr when nothing was registered near it
+    [[nodiscard]] const IdList* Find(u64 page) const noexcept {
+        const size_t index = PageIndex(page);
+        const Block* const block = blocks[index / BLOCK_SIZE].get();
+        return block ? &(*block)[index % BLOCK_SIZE] : nullptr;
+    }
+
+    /// Returns the ids registered in a page, allocating its block if needed
+    [[nodiscard]] IdList& operator[](u64 page) {
+        const size_t index = PageIndex(page);
+        std::unique_ptr<Block>& block = blocks[index / BLOCK_SIZE];
+        if (!block) {
+            block = std::make_unique<Block>();
+        }
+        return (*block)[index % BLOCK_SIZE];
+    }
+
+private:
+    using Block = std::array<IdList, BLOCK_SIZE>;
+
+    /// Pages out of range wrap around, users have to check the objects overlap anyway
+    [[nodiscard]] static constexpr size_t PageIndex(u64 page) noexcept {
+        return static_cast<size_t>(page & (NUM_PAGES - 1));
+    }
+
+    std::vector<std::unique_ptr<Block>> blocks;
+};
+
+} // namespace VideoCommon
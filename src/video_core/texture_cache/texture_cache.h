@@ -40,6 +40,7 @@
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
 #include "video_core/texture_cache/image_view_info.h"
+#include "video_core/texture_cache/page_lookup_table.h"
 #include "video_core/texture_cache/render_targets.h"
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/slot_vector.h"
@@ -63,8 +64,10 @@ using namespace Common::Literals;
 
 template <class P>
 class TextureCache {
-    /// Address shift for caching images into a hash table
+    /// Address shift for caching images into the page tables
     static constexpr u64 PAGE_BITS = 20;
+    /// Number of bits of the cpu and gpu addresses covered by the page tables
+    static constexpr u64 ADDRESS_BITS = 40;
 
     /// Enables debugging features to the texture cache
     static constexpr bool ENABLE_VALIDATION = P::ENABLE_VALIDATION;
@@ -97,13 +100,6 @@ class TextureCache {
         PixelFormat src_format;
     };
 
-    template <typename T>
-    struct IdentityHash {
-        [[nodiscard]] size_t operator()(T value) const noexcept {
-            return static_cast<size_t>(value);
-        }
-    };
-
 public:
     explicit TextureCache(Runtime&, VideoCore::RasterizerInterface&, Tegra::Engines::Maxwell3D&,
                           Tegra::Engines::KeplerCompute&, Tegra::MemoryManager&);
@@ -367,9 +363,12 @@ private:
     std::unordered_map<TSCEntry, SamplerId> samplers;
     std::unordered_map<RenderTargets, FramebufferId> framebuffers;
 
-    std::unordered_map<u64, std::vector<ImageMapId>, IdentityHash<u64>> page_table;
-    std::unordered_map<u64, std::vector<ImageId>, IdentityHash<u64>> gpu_page_table;
-    std::unordered_map<u64, std::vector<ImageId>, IdentityHash<u64>> sparse_page_table;
+    using ImageMapPageTable = PageLookupTable<ImageMapId, ADDRESS_BITS - PAGE_BITS>;
+    using ImagePageTable = PageLookupTable<ImageId, ADDRESS_BITS - PAGE_BITS>;
+
+    ImageMapPageTable page_table;
+    ImagePageTable gpu_page_table;
+    ImagePageTable sparse_page_table;
 
     std::unordered_map<ImageId, std::vector<ImageViewId>> sparse_views;
 
@@ -843,12 +842,11 @@ void TextureCache<P>::InvalidateDepthBuffer() {
 template <class P>
 typename P::ImageView* TextureCache<P>::TryFindFramebufferImageView(VAddr cpu_addr) {
     // TODO: Properly implement this
-    const auto it = page_table.find(cpu_addr >> PAGE_BITS);
-    if (it == page_table.end()) {
+    const auto* const image_map_ids = page_table.Find(cpu_addr >> PAGE_BITS);
+    if (!image_map_ids) {
         return nullptr;
     }
-    const auto& image_map_ids = it->second;
-    for (const ImageMapId map_id : image_map_ids) {
+    for (const ImageMapId map_id : *image_map_ids) {
         const ImageMapView& map = slot_map_views[map_id];
         const ImageBase& image = slot_images[map.image_id];
         if (image.cpu_addr != cpu_addr) {
@@ -1306,15 +1304,15 @@ void TextureCache<P>::ForEachImageInRegion(VAddr cpu_addr, size_t size, Func&& f
     boost::container::small_vector<ImageId, 32> images;
     boost::container::small_vector<ImageMapId, 32> maps;
     ForEachCPUPage(cpu_addr, size, [this, &images, &maps, cpu_addr, size, func](u64 page) {
-        const auto it = page_table.find(page);
-        if (it == page_table.end()) {
+        const auto* const map_ids = page_table.Find(page);
+        if (!map_ids) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageMapId map_id : it->second) {
+        for (const ImageMapId map_id : *map_ids) {
             ImageMapView& map = slot_map_views[map_id];
             if (map.picked) {
                 continue;
@@ -1357,15 +1355,15 @@ void TextureCache<P>::ForEachImageInRegionGPU(GPUVAddr gpu_addr, size_t size, Fu
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<ImageId, 8> images;
     ForEachGPUPage(gpu_addr, size, [this, &images, gpu_addr, size, func](u64 page) {
-        const auto it = gpu_page_table.find(page);
-        if (it == gpu_page_table.end()) {
+        const auto* const image_ids = gpu_page_table.Find(page);
+        if (!image_ids) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageId image_id : it->second) {
+        for (const ImageId image_id : *image_ids) {
             Image& image = slot_images[image_id];
             if (True(image.flags & ImageFlagBits::Picked)) {
                 continue;
@@ -1399,15 +1397,15 @@ void TextureCache<P>::ForEachSparseImageInRegion(GPUVAddr gpu_addr, size_t size,
     static constexpr bool BOOL_BREAK = std::is_same_v<FuncReturn, bool>;
     boost::container::small_vector<ImageId, 8> images;
     ForEachGPUPage(gpu_addr, size, [this, &images, gpu_addr, size, func](u64 page) {
-        const auto it = sparse_page_table.find(page);
-        if (it == sparse_page_table.end()) {
+        const auto* const image_ids = sparse_page_table.Find(page);
+        if (!image_ids) {
             if constexpr (BOOL_BREAK) {
                 return false;
             } else {
                 return;
             }
         }
-        for (const ImageId image_id : it->second) {
+        for (const ImageId image_id : *image_ids) {
             Image& image = slot_images[image_id];
             if (True(image.flags & ImageFlagBits::Picked)) {
                 continue;
@@ -1516,42 +1514,37 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
         tentative_size = EstimatedDecompressedSize(tentative_size, image.info.format);
     }
     total_used_memory -= Common::AlignUp(tentative_size, 1024);
-    const auto& clear_page_table =
-        [this, image_id](
-            u64 page,
-            std::unordered_map<u64, std::vector<ImageId>, IdentityHash<u64>>& selected_page_table) {
-            const auto page_it = selected_page_table.find(page);
-            if (page_it == selected_page_table.end()) {
-                UNREACHABLE_MSG("Unregistering unregistered page=0x{:x}", page << PAGE_BITS);
-                return;
-            }
-            std::vector<ImageId>& image_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_ids, image_id);
-            if (vector_it == image_ids.end()) {
-                UNREACHABLE_MSG("Unregistering unregistered image in page=0x{:x}",
-                                page << PAGE_BITS);
-                return;
-            }
-            image_ids.erase(vector_it);
-        };
+    const auto& clear_page_table = [this, image_id](u64 page,
+                                                    ImagePageTable& selected_page_table) {
+        auto* const image_ids = selected_page_table.Find(page);
+        if (!image_ids) {
+            UNREACHABLE_MSG("Unregistering unregistered page=0x{:x}", page << PAGE_BITS);
+            return;
+        }
+        const auto vector_it = std::ranges::find(*image_ids, image_id);
+        if (vector_it == image_ids->end()) {
+            UNREACHABLE_MSG("Unregistering unregistered image in page=0x{:x}", page << PAGE_BITS);
+            return;
+        }
+        image_ids->erase(vector_it);
+    };
     ForEachGPUPage(image.gpu_addr, image.guest_size_bytes,
                    [this, &clear_page_table](u64 page) { clear_page_table(page, gpu_page_table); });
     if (False(image.flags & ImageFlagBits::Sparse)) {
         const auto map_id = image.map_view_id;
         ForEachCPUPage(image.cpu_addr, image.guest_size_bytes, [this, map_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
+            auto* const image_map_ids = page_table.Find(page);
+            if (!image_map_ids) {
                 UNREACHABLE_MSG("Unregistering unregistered page=0x{:x}", page << PAGE_BITS);
                 return;
             }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            const auto vector_it = std::ranges::find(image_map_ids, map_id);
-            if (vector_it == image_map_ids.end()) {
+            const auto vector_it = std::ranges::find(*image_map_ids, map_id);
+            if (vector_it == image_map_ids->end()) {
                 UNREACHABLE_MSG("Unregistering unregistered image in page=0x{:x}",
                                 page << PAGE_BITS);
                 return;
             }
-            image_map_ids.erase(vector_it);
+            image_map_ids->erase(vector_it);
         });
         slot_map_views.erase(map_id);
         return;
@@ -1567,14 +1560,13 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
         const VAddr cpu_addr = map_range.cpu_addr;
         const std::size_t size = map_range.size;
         ForEachCPUPage(cpu_addr, size, [this, image_id](u64 page) {
-            const auto page_it = page_table.find(page);
-            if (page_it == page_table.end()) {
+            auto* const image_map_ids = page_table.Find(page);
+            if (!image_map_ids) {
                 UNREACHABLE_MSG("Unregistering unregistered page=0x{:x}", page << PAGE_BITS);
                 return;
             }
-            std::vector<ImageMapId>& image_map_ids = page_it->second;
-            auto vector_it = image_map_ids.begin();
-            while (vector_it != image_map_ids.end()) {
+            auto vector_it = image_map_ids->begin();
+            while (vector_it != image_map_ids->end()) {
                 ImageMapView& map = slot_map_views[*vector_it];
                 if (map.image_id != image_id) {
                     vector_it++;
@@ -1583,7 +1575,7 @@ void TextureCache<P>::UnregisterImage(ImageId image_id) {
                 if (!map.picked) {
                     map.picked = true;
                 }
-                vector_it = image_map_ids.erase(vector_it);
+                vector_it = image_map_ids->erase(vector_it);
             }
         });
         slot_map_views.erase(map_view_id);
@@ -16,6 +16,7 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <span>
@@ -24,6 +25,8 @@
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "video_core/textures/astc.h"
 
 class InputBitStream {
@@ -50,20 +53,35 @@ public:
     }
 
     constexpr u32 ReadBits(std::size_t nBits) {
+        if (bits_read + nBits > total_bits * 8) {
+            // Bits past the end of the stream read as zero
+            u32 ret = 0;
+            for (std::size_t i = 0; i < nBits; ++i) {
+                ret |= (ReadBit() & 1) << i;
+            }
+            return ret;
+        }
+        // Take as many bits as possible from each byte
         u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
+        std::size_t ret_bit = 0;
+        while (ret_bit < nBits) {
+            const std::size_t count = std::min<std::size_t>(8 - next_bit, nBits - ret_bit);
+            const u32 bits = (static_cast<u32>(*cur_byte) >> next_bit) & ((1U << count) - 1);
+            ret |= bits << ret_bit;
+            ret_bit += count;
+            next_bit += count;
+            if (next_bit == 8) {
+                next_bit = 0;
+                ++cur_byte;
+            }
         }
+        bits_read += nBits;
         return ret;
     }
 
     template <std::size_t nBits>
     constexpr u32 ReadBits() {
-        u32 ret = 0;
-        for (std::size_t i = 0; i < nBits; ++i) {
-            ret |= (ReadBit() & 1) << i;
-        }
-        return ret;
+        return ReadBits(nBits);
     }
 
 private:
@@ -1028,47 +1046,47 @@ static void UnquantizeTexelWeights(u32 out[2][144], const IntegerEncodedVector&
     u32 Ds = (1024 + (blockWidth / 2)) / (blockWidth - 1);
     u32 Dt = (1024 + (blockHeight / 2)) / (blockHeight - 1);
 
-    const u32 kPlaneScale = params.m_bDualPlane ? 2U : 1U;
-    for (u32 plane = 0; plane < kPlaneScale; plane++)
-        for (u32 t = 0; t < blockHeight; t++)
-            for (u32 s = 0; s < blockWidth; s++) {
-                u32 cs = Ds * s;
-                u32 ct = Dt * t;
-
-                u32 gs = (cs * (params.m_Width - 1) + 32) >> 6;
-                u32 gt = (ct * (params.m_Height - 1) + 32) >> 6;
-
-                u32 js = gs >> 4;
-                u32 fs = gs & 0xF;
-
-                u32 jt = gt >> 4;
-                u32 ft = gt & 0x0F;
-
-                u32 w11 = (fs * ft + 8) >> 4;
-                u32 w10 = ft - w11;
-                u32 w01 = fs - w11;
-                u32 w00 = 16 - fs - ft + w11;
-
-                u32 v0 = js + jt * params.m_Width;
+    // The grid position of a texel only depends on its column and row, so compute it once per
+    // axis instead of once per texel and plane.
+    u32 js[12], fs[12];
+    for (u32 s = 0; s < blockWidth; s++) {
+        u32 cs = Ds * s;
+        u32 gs = (cs * (params.m_Width - 1) + 32) >> 6;
+        js[s] = gs >> 4;
+        fs[s] = gs & 0xF;
+    }
+    u32 jt[12], ft[12];
+    for (u32 t = 0; t < blockHeight; t++) {
+        u32 ct = Dt * t;
+        u32 gt = (ct * (params.m_Height - 1) + 32) >> 6;
+        jt[t] = (gt >> 4) * params.m_Width;
+        ft[t] = gt & 0x0F;
+    }
 
-#define FIND_TEXEL(tidx, bidx)                                                                     \
-    u32 p##bidx = 0;                                                                               \
-    do {                                                                                           \
-        if ((tidx) < (params.m_Width * params.m_Height)) {                                         \
-            p##bidx = unquantized[plane][(tidx)];                                                  \
-        }                                                                                          \
-    } while (0)
+    const u32 numWeights = params.m_Width * params.m_Height;
+    const u32 kPlaneScale = params.m_bDualPlane ? 2U : 1U;
+    for (u32 plane = 0; plane < kPlaneScale; plane++) {
+        const u32* const planeWeights = unquantized[plane];
+        const auto findTexel = [&](u32 tidx) { return tidx < numWeights ? planeWeights[tidx] : 0; };
 
-                FIND_TEXEL(v0, 00);
-                FIND_TEXEL(v0 + 1, 01);
-                FIND_TEXEL(v0 + params.m_Width, 10);
-                FIND_TEXEL(v0 + params.m_Width + 1, 11);
+        for (u32 t = 0; t < blockHeight; t++) {
+            for (u32 s = 0; s < blockWidth; s++) {
+                u32 w11 = (fs[s] * ft[t] + 8) >> 4;
+                u32 w10 = ft[t] - w11;
+                u32 w01 = fs[s] - w11;
+                u32 w00 = 16 - fs[s] - ft[t] + w11;
 
-#undef FIND_TEXEL
+                u32 v0 = js[s] + jt[t];
+                u32 p00 = findTexel(v0);
+                u32 p01 = findTexel(v0 + 1);
+                u32 p10 = findTexel(v0 + params.m_Width);
+                u32 p11 = findTexel(v0 + params.m_Width + 1);
 
                 out[plane][t * blockWidth + s] =
                     (p00 * w00 + p01 * w01 + p10 * w10 + p11 * w11 + 8) >> 4;
             }
+        }
+    }
 }
 
 // Transfers a bit as described in C.2.14
@@ -1514,66 +1532,115 @@ static void DecompressBlock(std::span<const u8, 16> inBuf, const u32 blockWidth,
     u32 weights[2][144];
     UnquantizeTexelWeights(weights, texelWeightValues, weightParams, blockWidth, blockHeight);
 
+    // Expand the endpoints to 16 bits once per block instead of once per texel
+    u32 expandedEndpoints[4][2][4];
+    for (u32 i = 0; i < nPartitions; i++) {
+        for (u32 c = 0; c < 4; c++) {
+            expandedEndpoints[i][0][c] = ReplicateByteTo16(endpoints[i][0].Component(c));
+            expandedEndpoints[i][1][c] = ReplicateByteTo16(endpoints[i][1].Component(c));
+        }
+    }
+
+    // Component that takes its weights from the second plane, none when there is a single plane
+    const u32 dualPlaneComponent = weightParams.m_bDualPlane ? ((planeIdx + 1) & 3) : 4;
+    const s32 smallBlock = (blockHeight * blockWidth) < 32;
+
     // Now that we have endpoints and weights, we can interpolate and generate
     // the proper decoding...
     for (u32 j = 0; j < blockHeight; j++)
         for (u32 i = 0; i < blockWidth; i++) {
-            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                              (blockHeight * blockWidth) < 32);
+            u32 partition = Select2DPartition(partitionIndex, i, j, nPartitions, smallBlock);
             assert(partition < nPartitions);
 
-            Pixel p;
+            const u32 texelIdx = j * blockWidth + i;
+            u32 texel = 0;
             for (u32 c = 0; c < 4; c++) {
-                u32 C0 = endpoints[partition][0].Component(c);
-                C0 = ReplicateByteTo16(C0);
-                u32 C1 = endpoints[partition][1].Component(c);
-                C1 = ReplicateByteTo16(C1);
-
-                u32 plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
-
-                u32 weight = weights[plane][j * blockWidth + i];
-                u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<u16>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+                const u32 C0 = expandedEndpoints[partition][0][c];
+                const u32 C1 = expandedEndpoints[partition][1][c];
+                const u32 weight = weights[c == dualPlaneComponent ? 1 : 0][texelIdx];
+                const u32 C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
+
+                // Same as rounding 255 * C / 65536 in floating point, the product is exact.
+                // Components are packed as R8G8B8A8, with alpha (component 0) in the top byte.
+                const u32 component = (C * 255 + 32768) >> 16;
+                texel |= component << (((c + 3) & 3) * 8);
             }
 
-            outBuf[j * blockWidth + i] = p.Pack();
+            outBuf[texelIdx] = texel;
+        }
+}
+
+static void DecompressRows(std::span<const uint8_t> data, uint32_t width, uint32_t height,
+                           uint32_t block_width, uint32_t block_height, std::span<uint8_t> output,
+                           uint32_t first_row, uint32_t end_row) {
+    const u32 blocks_per_row = (width + block_width - 1) / block_width;
+    const u32 rows_per_slice = (height + block_height - 1) / block_height;
+    for (u32 row = first_row; row < end_row; ++row) {
+        const u32 z = row / rows_per_slice;
+        const u32 y = (row % rows_per_slice) * block_height;
+        const std::size_t depth_offset = static_cast<std::size_t>(z) * height * width * 4;
+        u32 block_index = row * blocks_per_row;
+        for (u32 x = 0; x < width; x += block_width) {
+            const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
+
+            // Blocks can be at most 12x12
+            std::array<u32, 12 * 12> uncompData;
+            DecompressBlock(blockPtr, block_width, block_height, uncompData);
+
+            u32 decompWidth = std::min(block_width, width - x);
+            u32 decompHeight = std::min(block_height, height - y);
+
+            const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
+            for (u32 jj = 0; jj < decompHeight; jj++) {
+                std::memcpy(outRow.data() + jj * width * 4, uncompData.data() + jj * block_width,
+                            decompWidth * 4);
+            }
+            ++block_index;
         }
+    }
 }
 
 void Decompress(std::span<const uint8_t> data, uint32_t width, uint32_t height, uint32_t depth,
                 uint32_t block_width, uint32_t block_height, std::span<uint8_t> output) {
-    u32 block_index = 0;
-    std::size_t depth_offset = 0;
-    for (u32 z = 0; z < depth; z++) {
-        for (u32 y = 0; y < height; y += block_height) {
-            for (u32 x = 0; x < width; x += block_width) {
-                const std::span<const u8, 16> blockPtr{data.subspan(block_index * 16, 16)};
-
-                // Blocks can be at most 12x12
-                std::array<u32, 12 * 12> uncompData;
-                DecompressBlock(blockPtr, block_width, block_height, uncompData);
-
-                u32 decompWidth = std::min(block_width, width - x);
-                u32 decompHeight = std::min(block_height, height - y);
-
-                const std::span<u8> outRow = output.subspan(depth_offset + (y * width + x) * 4);
-                for (u32 jj = 0; jj < decompHeight; jj++) {
-                    std::memcpy(outRow.data() + jj * width * 4,
-                                uncompData.data() + jj * block_width, decompWidth * 4);
-                }
-                ++block_index;
-            }
+    // Images smaller than this are not worth waking up the decoder threads for
+    static constexpr u32 MIN_PARALLEL_BLOCKS = 1024;
+    // Block rows are handed out in batches to keep contention on the row counter low
+    static constexpr u32 ROWS_PER_BATCH = 2;
+
+    const u32 blocks_per_row = (width + block_width - 1) / block_width;
+    const u32 num_rows = ((height + block_height - 1) / block_height) * depth;
+    const u32 num_batches = (num_rows + ROWS_PER_BATCH - 1) / ROWS_PER_BATCH;
+    Common::ThreadWorker& workers = Common::SharedThreadWorker();
+    const u32 num_helpers = std::min(static_cast<u32>(workers.NumWorkers()), num_batches - 1);
+    if (num_rows * blocks_per_row < MIN_PARALLEL_BLOCKS || num_helpers == 0) {
+        DecompressRows(data, width, height, block_width, block_height, output, 0, num_rows);
+        return;
+    }
+
+    // Blocks are independent from each other, the calling thread and the helpers pull batches of
+    // rows until the image is done.
+    std::atomic<u32> next_batch{0};
+    const auto decode_batches = [&] {
+        for (u32 batch = next_batch++; batch < num_batches; batch = next_batch++) {
+            const u32 first_row = batch * ROWS_PER_BATCH;
+            const u32 end_row = std::min(first_row + ROWS_PER_BATCH, num_rows);
+            DecompressRows(data, width, height, block_width, block_height, output, first_row,
+                           end_row);
         }
-        depth_offset += height * width * 4;
+    };
+
+    Common::WaitGroup helpers;
+    helpers.Add(num_helpers);
+    for (u32 helper = 0; helper < num_helpers; ++helper) {
+        workers.QueueWork([&] {
+            decode_batches();
+            helpers.Done();
+        });
     }
+    decode_batches();
+
+    // Helpers reference this stack frame, wait for all of them even if they found no work
+    helpers.Wait();
 }
 
 } // namespace Tegra::Texture::ASTC
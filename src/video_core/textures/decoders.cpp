@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <cstring>
 #include <span>
@@ -12,12 +15,100 @@
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/div_ceil.h"
+#include "common/thread.h"
+#include "common/thread_worker.h"
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
 #include "video_core/textures/texture.h"
 
 namespace Tegra::Texture {
 namespace {
+/// Size in bytes of the runs that are contiguous in both linear and swizzled memory.
+constexpr u32 SWIZZLE_RUN_SIZE = 16;
+constexpr u32 RUNS_PER_GOB_ROW = GOB_SIZE_X / SWIZZLE_RUN_SIZE;
+
+/// Offset of each run of a GOB row relative to the start of the row.
+constexpr std::array<u32, RUNS_PER_GOB_ROW> SWIZZLE_RUN_OFFSETS = [] {
+    std::array<u32, RUNS_PER_GOB_ROW> offsets{};
+    for (u32 run = 0; run < RUNS_PER_GOB_ROW; ++run) {
+        offsets[run] = SWIZZLE_TABLE[0][run * SWIZZLE_RUN_SIZE];
+    }
+    return offsets;
+}();
+
+/// Textures smaller than this are swizzled on the calling thread, waking up helpers costs more.
+constexpr u64 MIN_PARALLEL_BYTES = 2ULL << 20;
+/// Rows are handed out in batches to keep the shared counter out of the copy loop.
+constexpr u32 ROWS_PER_BATCH = 32;
+
+/// Pixels never straddle a run when their size divides it, so whole runs can be copied at once.
+constexpr bool CanCopyRuns(u32 bytes_per_pixel) {
+    return bytes_per_pixel != 0 && bytes_per_pixel <= SWIZZLE_RUN_SIZE &&
+           std::has_single_bit(bytes_per_pixel);
+}
+
+/**
+ * Copies a row of bytes between linear and swizzled memory one 16 byte run at a time.
+ * Within a GOB row, every 16 byte aligned run is contiguous in both layouts. Full runs are copied
+ * with a fixed size memcpy, which compiles down to a single unaligned vector load and store.
+ * @param swizzled  Pointer to the start of the row in swizzled memory, at x = 0 of the first GOB
+ * @param linear    Pointer to the row in linear memory, at byte x_begin
+ * @param x_begin   First byte of the row to copy, must be pixel aligned
+ * @param x_end     One past the last byte of the row to copy
+ * @param x_shift   Log2 of the distance in bytes between horizontally adjacent GOBs
+ */
+template <bool TO_LINEAR, typename SwizzledPtr, typename LinearPtr>
+void CopyRuns(SwizzledPtr swizzled, LinearPtr linear, u32 x_begin, u32 x_end, u32 x_shift) {
+    const auto copy = [&](u32 x, u32 size) {
+        const std::size_t swizzled_offset = (static_cast<std::size_t>(x >> GOB_SIZE_X_SHIFT)
+                                             << x_shift) +
+                                            SWIZZLE_TABLE[0][x % GOB_SIZE_X];
+        const std::size_t linear_offset = x - x_begin;
+        if constexpr (TO_LINEAR) {
+            std::memcpy(swizzled + swizzled_offset, linear + linear_offset, size);
+        } else {
+            std::memcpy(linear + linear_offset, swizzled + swizzled_offset, size);
+        }
+    };
+    const auto copy_run = [&](u32 x, u32 size) {
+        // Give the compiler a constant size for the common case
+        if (size == SWIZZLE_RUN_SIZE) {
+            copy(x, SWIZZLE_RUN_SIZE);
+        } else {
+            copy(x, size);
+        }
+    };
+    u32 x = x_begin;
+    // Copy single runs until the start of a GOB
+    while (x < x_end && x % GOB_SIZE_X != 0) {
+        const u32 size = std::min(SWIZZLE_RUN_SIZE - x % SWIZZLE_RUN_SIZE, x_end - x);
+        copy_run(x, size);
+        x += size;
+    }
+    // Whole GOB rows, the run offsets are known at compile time
+    for (; x + GOB_SIZE_X <= x_end; x += GOB_SIZE_X) {
+        const std::size_t gob_offset = static_cast<std::size_t>(x >> GOB_SIZE_X_SHIFT) << x_shift;
+        const std::size_t linear_offset = x - x_begin;
+        for (u32 run = 0; run < RUNS_PER_GOB_ROW; ++run) {
+            const std::size_t swizzled_offset = gob_offset + SWIZZLE_RUN_OFFSETS[run];
+            const std::size_t run_linear_offset = linear_offset + run * SWIZZLE_RUN_SIZE;
+            if constexpr (TO_LINEAR) {
+                std::memcpy(swizzled + swizzled_offset, linear + run_linear_offset,
+                            SWIZZLE_RUN_SIZE);
+            } else {
+                std::memcpy(linear + run_linear_offset, swizzled + swizzled_offset,
+                            SWIZZLE_RUN_SIZE);
+            }
+        }
+    }
+    // Remaining runs of the last GOB
+    while (x < x_end) {
+        const u32 size = std::min(SWIZZLE_RUN_SIZE, x_end - x);
+        copy_run(x, size);
+        x += size;
+    }
+}
+
 template <bool TO_LINEAR>
 void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixel, u32 width,
              u32 height, u32 depth, u32 block_height, u32 block_depth, u32 stride_alignment) {
@@ -41,11 +132,20 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
     const u32 block_depth_mask = (1U << block_depth) - 1;
     const u32 x_shift = GOB_SIZE_SHIFT + block_height + block_depth;
 
-    for (u32 slice = 0; slice < depth; ++slice) {
-        const u32 z = slice + origin_z;
-        const u32 offset_z = (z >> block_depth) * slice_size +
-                             ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
-        for (u32 line = 0; line < height; ++line) {
+    const bool copy_runs = CanCopyRuns(bytes_per_pixel);
+    const u32 x_begin = origin_x * bytes_per_pixel;
+    const u32 x_end = x_begin + pitch;
+    // Offset of the GOB holding the last byte of a row, used to check for out of bounds accesses
+    const u32 last_gob_offset = width == 0 ? 0 : ((x_end - 1) >> GOB_SIZE_X_SHIFT) << x_shift;
+
+    // Rows are numbered across all slices, each one is copied to its own range of the output
+    const auto swizzle_rows = [&](u32 first_row, u32 end_row) {
+        for (u32 row = first_row; row < end_row; ++row) {
+            const u32 slice = row / height;
+            const u32 line = row % height;
+            const u32 z = slice + origin_z;
+            const u32 offset_z = (z >> block_depth) * slice_size +
+                                 ((z & block_depth_mask) << (GOB_SIZE_SHIFT + block_height));
             const u32 y = line + origin_y;
             const auto& table = SWIZZLE_TABLE[y % GOB_SIZE_Y];
 
@@ -53,6 +153,25 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
             const u32 offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
 
+            const u32 swizzled_row = offset_z + offset_y + table[0];
+            const u32 unswizzled_row = slice * pitch * height + line * pitch;
+
+            // Rows that fit in the input take the fast path, the rest go pixel by pixel to stop
+            // exactly at the first out of bounds access.
+            const u32 row_input_end = TO_LINEAR ? unswizzled_row + pitch
+                                                : swizzled_row + last_gob_offset +
+                                                    SWIZZLE_RUN_OFFSETS.back() + SWIZZLE_RUN_SIZE;
+            if (copy_runs && row_input_end <= input.size()) {
+                if constexpr (TO_LINEAR) {
+                    CopyRuns<true>(output.data() + swizzled_row, input.data() + unswizzled_row,
+                                   x_begin, x_end, x_shift);
+                } else {
+                    CopyRuns<false>(input.data() + swizzled_row, output.data() + unswizzled_row,
+                                    x_begin, x_end, x_shift);
+                }
+                continue;
+            }
+
             for (u32 column = 0; column < width; ++column) {
                 const u32 x = (column + origin_x) * bytes_per_pixel;
                 const u32 offset_x = (x >> GOB_SIZE_X_SHIFT) << x_shift;
@@ -76,7 +195,40 @@ void Swizzle(std::span<u8> output, std::span<const u8> input, u32 bytes_per_pixe
                 std::memcpy(dst, src, bytes_per_pixel);
             }
         }
+    };
+
+    const u32 num_rows = height * depth;
+    const u32 num_batches = Common::DivCeil(num_rows, ROWS_PER_BATCH);
+    // Pixels that straddle a run are copied as a whole and spill into bytes of other rows, those
+    // formats stay on the calling thread to keep the result identical.
+    if (!copy_runs || static_cast<u64>(pitch) * num_rows < MIN_PARALLEL_BYTES || num_batches < 2) {
+        swizzle_rows(0, num_rows);
+        return;
+    }
+
+    // The calling thread and the helpers take batches of rows until the texture is done
+    std::atomic<u32> next_batch{0};
+    const auto swizzle_batches = [&] {
+        for (u32 batch = next_batch++; batch < num_batches; batch = next_batch++) {
+            const u32 first_row = batch * ROWS_PER_BATCH;
+            swizzle_rows(first_row, std::min(first_row + ROWS_PER_BATCH, num_rows));
+        }
+    };
+
+    Common::ThreadWorker& workers = Common::SharedThreadWorker();
+    const u32 num_helpers = std::min(static_cast<u32>(workers.NumWorkers()), num_batches - 1);
+    Common::WaitGroup helpers;
+    helpers.Add(num_helpers);
+    for (u32 helper = 0; helper < num_helpers; ++helper) {
+        workers.QueueWork([&] {
+            swizzle_batches();
+            helpers.Done();
+        });
     }
+    swizzle_batches();
+
+    // Helpers reference this stack frame, wait for all of them even if they found no work
+    helpers.Wait();
 }
 } // Anonymous namespace
 
@@ -106,6 +258,14 @@ void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32
             (dst_y / (GOB_SIZE_Y * block_height)) * GOB_SIZE * block_height * image_width_in_gobs +
             ((dst_y % (GOB_SIZE_Y * block_height)) / GOB_SIZE_Y) * GOB_SIZE;
         const auto& table = SWIZZLE_TABLE[dst_y % GOB_SIZE_Y];
+        if (CanCopyRuns(bytes_per_pixel)) {
+            const u32 x_begin = offset_x * bytes_per_pixel;
+            CopyRuns<true>(swizzled_data + gob_address_y + table[0],
+                           unswizzled_data + line * source_pitch, x_begin,
+                           x_begin + subrect_width * bytes_per_pixel,
+                           GOB_SIZE_SHIFT + block_height_bit);
+            continue;
+        }
         for (u32 x = 0; x < subrect_width; ++x) {
             const u32 dst_x = x + offset_x;
             const u32 gob_address =
@@ -136,6 +296,12 @@ void UnswizzleSubrect(u32 line_length_in, u32 line_count, u32 pitch, u32 width,
         const u32 block_y = src_y >> GOB_SIZE_Y_SHIFT;
         const u32 src_offset_y = (block_y >> block_height) * block_size +
                                  ((block_y & block_height_mask) << GOB_SIZE_SHIFT);
+        if (CanCopyRuns(bytes_per_pixel)) {
+            const u32 x_begin = origin_x * bytes_per_pixel;
+            CopyRuns<false>(input + src_offset_y + table[0], output + line * pitch, x_begin,
+                            x_begin + line_length_in * bytes_per_pixel, x_shift);
+            continue;
+        }
         for (u32 column = 0; column < line_length_in; ++column) {
             const u32 src_x = (column + origin_x) * bytes_per_pixel;
             const u32 src_offset_x = (src_x >> GOB_SIZE_X_SHIFT) << x_shift;
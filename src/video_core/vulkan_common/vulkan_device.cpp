@@ -430,6 +430,16 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
     use_asynchronous_shaders = Settings::values.use_asynchronous_shaders.GetValue();
 }
 
+Device::Device(std::nullptr_t) : instance{}, properties{} {
+    properties.limits.maxComputeSharedMemorySize = 0xc000;
+    driver_id = VK_DRIVER_ID_NVIDIA_PROPRIETARY_KHR;
+    is_float16_supported = true;
+    is_formatless_image_load_supported = true;
+    khr_uniform_buffer_standard_layout = true;
+    ext_shader_viewport_index_layer = true;
+    ext_transform_feedback = true;
+}
+
 Device::~Device() = default;
 
 VkFormat Device::GetSupportedFormat(VkFormat wanted_format, VkFormatFeatureFlags wanted_usage,
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -27,6 +28,11 @@ class Device {
 public:
     explicit Device(VkInstance instance, vk::PhysicalDevice physical, VkSurfaceKHR surface,
                     const vk::InstanceDispatch& dld);
+
+    /// Creates a device without a physical device, reporting the features of a desktop GPU.
+    /// It can only be used to compile shaders.
+    explicit Device(std::nullptr_t);
+
     ~Device();
 
     /**
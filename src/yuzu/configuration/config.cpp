@@ -634,6 +634,7 @@ void Config::ReadDataStorageValues() {
         ReadSetting(QStringLiteral("gamecard_current_game"), false).toBool();
     Settings::values.gamecard_path =
         ReadSetting(QStringLiteral("gamecard_path"), QString{}).toString().toStdString();
+    Settings::values.vfs_cache_size = ReadSetting(QStringLiteral("vfs_cache_size"), 256).toUInt();
 
     qt_config->endGroup();
 }
@@ -655,6 +656,9 @@ void Config::ReadDebuggingValues() {
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
     Settings::values.disable_macro_jit =
         ReadSetting(QStringLiteral("disable_macro_jit"), false).toBool();
+    Settings::values.dump_macro_statistics =
+        ReadSetting(QStringLiteral("dump_macro_statistics"), false).toBool();
+    Settings::values.dump_nvdec = ReadSetting(QStringLiteral("dump_nvdec"), false).toBool();
     Settings::values.extended_logging =
         ReadSetting(QStringLiteral("extended_logging"), false).toBool();
     Settings::values.use_debug_asserts =
@@ -1254,6 +1258,7 @@ void Config::SaveDataStorageValues() {
                  false);
     WriteSetting(QStringLiteral("gamecard_path"),
                  QString::fromStdString(Settings::values.gamecard_path), QString{});
+    WriteSetting(QStringLiteral("vfs_cache_size"), Settings::values.vfs_cache_size, 256);
 
     qt_config->endGroup();
 }
@@ -1272,6 +1277,9 @@ void Config::SaveDebuggingValues() {
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
     WriteSetting(QStringLiteral("use_debug_asserts"), Settings::values.use_debug_asserts, false);
     WriteSetting(QStringLiteral("disable_macro_jit"), Settings::values.disable_macro_jit, false);
+    WriteSetting(QStringLiteral("dump_macro_statistics"), Settings::values.dump_macro_statistics,
+                 false);
+    WriteSetting(QStringLiteral("dump_nvdec"), Settings::values.dump_nvdec, false);
 
     qt_config->endGroup();
 }
@@ -386,6 +386,8 @@ void Config::ReadValues() {
     Settings::values.gamecard_current_game =
         sdl2_config->GetBoolean("Data Storage", "gamecard_current_game", false);
     Settings::values.gamecard_path = sdl2_config->Get("Data Storage", "gamecard_path", "");
+    Settings::values.vfs_cache_size = static_cast<u32>(
+        sdl2_config->GetInteger("Data Storage", "vfs_cache_size", 256));
 
     // System
     Settings::values.use_docked_mode.SetValue(
@@ -492,6 +494,9 @@ void Config::ReadValues() {
 
     Settings::values.disable_macro_jit =
         sdl2_config->GetBoolean("Debugging", "disable_macro_jit", false);
+    Settings::values.dump_macro_statistics =
+        sdl2_config->GetBoolean("Debugging", "dump_macro_statistics", false);
+    Settings::values.dump_nvdec = sdl2_config->GetBoolean("Debugging", "dump_nvdec", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
@@ -303,6 +303,10 @@ gamecard_current_game =
 # If 'gamecard_current_game' is 1 this setting is irrelevant
 gamecard_path =
 
+# Size in MiB of the cache of decrypted game data, 0 disables it
+# 256 (default)
+vfs_cache_size =
+
 [System]
 # Whether the system is docked
 # 1 (default): Yes, 0: No
@@ -366,6 +370,12 @@ use_debug_asserts =
 use_auto_stub =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
+# Logs how often each GPU macro was called and the time spent in it when emulation stops
+# false: Disabled (default), true: Enabled
+dump_macro_statistics=false
+# Records the video bitstreams decoded by NVDEC to the dump directory, they can be replayed by nvdec_bench
+# false: Disabled (default), true: Enabled
+dump_nvdec=false
 # Presents guest frames as they become available. Experimental.
 # false: Disabled (default), true: Enabled
 disable_fps_limit=false